@@ -80,3 +80,9 @@ set -x
 [ $BUILD_TARGET != posix-ncp ] || {
     COVERAGE=1 NODE_TYPE=ncp-sim BuildJobs=10 make -f examples/Makefile-posix check || die
 }
+
+[ $BUILD_TARGET != posix-binary-log ] || {
+    export CPPFLAGS="-DOPENTHREAD_CONFIG_LOG_BINARY=1 -DOPENTHREAD_CONFIG_LOG_LEVEL=OPENTHREAD_LOG_LEVEL_INFO"
+    BuildJobs=10 make -f examples/Makefile-posix || die
+    make -C build/*/tools/log-decoder check || die
+}
@@ -428,6 +428,17 @@ RadioPacket *otPlatRadioGetTransmitBuffer(_In_ otInstance *otCtx)
     return &pFilter->otTransmitFrame;
 }
 
+RadioPacket *otPlatRadioGetNextTransmitBuffer(_In_ otInstance *otCtx)
+{
+    UNREFERENCED_PARAMETER(otCtx);
+    return NULL;
+}
+
+void otPlatRadioSwapTransmitBuffers(_In_ otInstance *otCtx)
+{
+    UNREFERENCED_PARAMETER(otCtx);
+}
+
 int8_t otPlatRadioGetRssi(_In_ otInstance *otCtx)
 {
     NT_ASSERT(otCtx);
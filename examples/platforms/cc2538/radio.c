@@ -305,6 +305,17 @@ RadioPacket *otPlatRadioGetTransmitBuffer(otInstance *aInstance)
     return &sTransmitFrame;
 }
 
+RadioPacket *otPlatRadioGetNextTransmitBuffer(otInstance *aInstance)
+{
+    (void)aInstance;
+    return NULL;
+}
+
+void otPlatRadioSwapTransmitBuffers(otInstance *aInstance)
+{
+    (void)aInstance;
+}
+
 int8_t otPlatRadioGetRssi(otInstance *aInstance)
 {
     (void)aInstance;
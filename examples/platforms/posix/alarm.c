@@ -31,6 +31,7 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 
 #include <platform/alarm.h>
 #include <platform/diag.h>
@@ -39,9 +40,19 @@ static bool s_is_running = false;
 static uint32_t s_alarm = 0;
 static struct timeval s_start;
 
+#if OPENTHREAD_ENABLE_PLATFORM_USEC_TIMER
+static bool s_is_micro_running = false;
+static uint32_t s_micro_alarm = 0;
+static struct timespec s_micro_start;
+#endif
+
 void platformAlarmInit(void)
 {
     gettimeofday(&s_start, NULL);
+
+#if OPENTHREAD_ENABLE_PLATFORM_USEC_TIMER
+    clock_gettime(CLOCK_MONOTONIC, &s_micro_start);
+#endif
 }
 
 uint32_t otPlatAlarmGetNow(void)
@@ -67,9 +78,35 @@ void otPlatAlarmStop(otInstance *aInstance)
     s_is_running = false;
 }
 
+#if OPENTHREAD_ENABLE_PLATFORM_USEC_TIMER
+uint32_t otPlatAlarmMicroGetNow(void)
+{
+    // The microsecond timers measure short intervals, which must not jump with wall clock adjustments.
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint32_t)(((int64_t)(now.tv_sec - s_micro_start.tv_sec) * 1000000) +
+                      ((now.tv_nsec - s_micro_start.tv_nsec) / 1000));
+}
+
+void otPlatAlarmMicroStartAt(otInstance *aInstance, uint32_t t0, uint32_t dt)
+{
+    (void)aInstance;
+    s_micro_alarm = t0 + dt;
+    s_is_micro_running = true;
+}
+
+void otPlatAlarmMicroStop(otInstance *aInstance)
+{
+    (void)aInstance;
+    s_is_micro_running = false;
+}
+#endif  // OPENTHREAD_ENABLE_PLATFORM_USEC_TIMER
+
 void platformAlarmUpdateTimeout(struct timeval *aTimeout)
 {
-    int32_t remaining;
+    int64_t remaining = 10000000;  // microseconds
 
     if (aTimeout == NULL)
     {
@@ -78,22 +115,31 @@ void platformAlarmUpdateTimeout(struct timeval *aTimeout)
 
     if (s_is_running)
     {
-        remaining = (int32_t)(s_alarm - otPlatAlarmGetNow());
+        remaining = (int64_t)((int32_t)(s_alarm - otPlatAlarmGetNow())) * 1000;
+    }
 
-        if (remaining > 0)
-        {
-            aTimeout->tv_sec = remaining / 1000;
-            aTimeout->tv_usec = (remaining % 1000) * 1000;
-        }
-        else
+#if OPENTHREAD_ENABLE_PLATFORM_USEC_TIMER
+
+    if (s_is_micro_running)
+    {
+        int32_t microRemaining = (int32_t)(s_micro_alarm - otPlatAlarmMicroGetNow());
+
+        if (microRemaining < remaining)
         {
-            aTimeout->tv_sec = 0;
-            aTimeout->tv_usec = 0;
+            remaining = microRemaining;
         }
     }
+
+#endif
+
+    if (remaining > 0)
+    {
+        aTimeout->tv_sec = (time_t)(remaining / 1000000);
+        aTimeout->tv_usec = (suseconds_t)(remaining % 1000000);
+    }
     else
     {
-        aTimeout->tv_sec = 10;
+        aTimeout->tv_sec = 0;
         aTimeout->tv_usec = 0;
     }
 }
@@ -123,4 +169,19 @@ void platformAlarmProcess(otInstance *aInstance)
             }
         }
     }
+
+#if OPENTHREAD_ENABLE_PLATFORM_USEC_TIMER
+
+    if (s_is_micro_running)
+    {
+        remaining = (int32_t)(s_micro_alarm - otPlatAlarmMicroGetNow());
+
+        if (remaining <= 0)
+        {
+            s_is_micro_running = false;
+            otPlatAlarmMicroFired(aInstance);
+        }
+    }
+
+#endif
 }
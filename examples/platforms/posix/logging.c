@@ -36,6 +36,8 @@
 #include <string.h>
 #include <time.h>
 
+#include <openthread-core-config.h>
+#include <openthread.h>
 #include <platform/logging.h>
 
 // Macro to append content to end of the log string.
@@ -141,3 +143,17 @@ exit:
     fprintf(stderr, "%s\r\n", logString);
 }
 
+void platformLogProcess(void)
+{
+#if OPENTHREAD_CONFIG_LOG_BINARY
+    uint8_t buf[128];
+    uint16_t length;
+
+    while ((length = otLogBinaryRead(buf, sizeof(buf))) > 0)
+    {
+        fwrite(buf, 1, length, stderr);
+    }
+
+    fflush(stderr);
+#endif
+}
@@ -117,6 +117,12 @@ void platformAlarmUpdateTimeout(struct timeval *tv);
  */
 void platformAlarmProcess(otInstance *aInstance);
 
+/**
+ * This function forwards the binary log records to the standard error when OPENTHREAD_CONFIG_LOG_BINARY is set.
+ *
+ */
+void platformLogProcess(void);
+
 /**
  * This function initializes the radio service used by OpenThread.
  *
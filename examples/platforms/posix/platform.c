@@ -111,5 +111,6 @@ void PlatformProcessDrivers(otInstance *aInstance)
     platformUartProcess();
     platformRadioProcess(aInstance);
     platformAlarmProcess(aInstance);
+    platformLogProcess();
 }
 
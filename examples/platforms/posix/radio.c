@@ -87,11 +87,14 @@ static void radioProcessFrame(otInstance *aInstance);
 
 static PhyState sState = kStateDisabled;
 static struct RadioMessage sReceiveMessage;
-static struct RadioMessage sTransmitMessage;
+static struct RadioMessage sTransmitMessages[2];
 static struct RadioMessage sAckMessage;
 static RadioPacket sReceiveFrame;
-static RadioPacket sTransmitFrame;
+static RadioPacket sTransmitFrames[2];
 static RadioPacket sAckFrame;
+static uint8_t sTransmitIndex = 0;
+static struct RadioMessage *sTransmitMessage = &sTransmitMessages[0];
+static RadioPacket *sTransmitFrame = &sTransmitFrames[0];
 
 static uint8_t sExtendedAddress[OT_EXT_ADDRESS_SIZE];
 static uint16_t sShortAddress;
@@ -367,7 +370,8 @@ void platformRadioInit(void)
     bind(sSockFd, (struct sockaddr *)&sockaddr, sizeof(sockaddr));
 
     sReceiveFrame.mPsdu = sReceiveMessage.mPsdu;
-    sTransmitFrame.mPsdu = sTransmitMessage.mPsdu;
+    sTransmitFrames[0].mPsdu = sTransmitMessages[0].mPsdu;
+    sTransmitFrames[1].mPsdu = sTransmitMessages[1].mPsdu;
     sAckFrame.mPsdu = sAckMessage.mPsdu;
 }
 
@@ -444,7 +448,21 @@ ThreadError otPlatRadioTransmit(otInstance *aInstance)
 RadioPacket *otPlatRadioGetTransmitBuffer(otInstance *aInstance)
 {
     (void)aInstance;
-    return &sTransmitFrame;
+    return sTransmitFrame;
+}
+
+RadioPacket *otPlatRadioGetNextTransmitBuffer(otInstance *aInstance)
+{
+    (void)aInstance;
+    return &sTransmitFrames[sTransmitIndex ^ 1];
+}
+
+void otPlatRadioSwapTransmitBuffers(otInstance *aInstance)
+{
+    (void)aInstance;
+    sTransmitIndex ^= 1;
+    sTransmitMessage = &sTransmitMessages[sTransmitIndex];
+    sTransmitFrame = &sTransmitFrames[sTransmitIndex];
 }
 
 int8_t otPlatRadioGetRssi(otInstance *aInstance)
@@ -456,7 +474,7 @@ int8_t otPlatRadioGetRssi(otInstance *aInstance)
 otRadioCaps otPlatRadioGetCaps(otInstance *aInstance)
 {
     (void)aInstance;
-    return kRadioCapsNone;
+    return kRadioCapsTransmitPipeline;
 }
 
 bool otPlatRadioGetPromiscuous(otInstance *aInstance)
@@ -478,9 +496,9 @@ void radioReceive(otInstance *aInstance)
     sReceiveFrame.mLength = (uint8_t)(rval - 1);
 
     if (sAckWait &&
-        sTransmitFrame.mChannel == sReceiveMessage.mChannel &&
+        sTransmitFrame->mChannel == sReceiveMessage.mChannel &&
         isFrameTypeAck(sReceiveFrame.mPsdu) &&
-        getDsn(sReceiveFrame.mPsdu) == getDsn(sTransmitFrame.mPsdu))
+        getDsn(sReceiveFrame.mPsdu) == getDsn(sTransmitFrame->mPsdu))
     {
         sState = kStateReceive;
         sAckWait = false;
@@ -506,11 +524,11 @@ void radioReceive(otInstance *aInstance)
 
 void radioSendMessage(otInstance *aInstance)
 {
-    sTransmitMessage.mChannel = sTransmitFrame.mChannel;
+    sTransmitMessage->mChannel = sTransmitFrame->mChannel;
 
-    radioTransmit(&sTransmitMessage, &sTransmitFrame);
+    radioTransmit(sTransmitMessage, sTransmitFrame);
 
-    sAckWait = isAckRequested(sTransmitFrame.mPsdu);
+    sAckWait = isAckRequested(sTransmitFrame->mPsdu);
 
     if (!sAckWait)
     {
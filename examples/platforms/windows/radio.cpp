@@ -422,6 +422,15 @@ RadioPacket *otPlatRadioGetTransmitBuffer(otInstance *)
     return &sTransmitFrame;
 }
 
+RadioPacket *otPlatRadioGetNextTransmitBuffer(otInstance *)
+{
+    return NULL;
+}
+
+void otPlatRadioSwapTransmitBuffers(otInstance *)
+{
+}
+
 int8_t otPlatRadioGetRssi(otInstance *)
 {
     return 0;
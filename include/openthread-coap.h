@@ -71,13 +71,18 @@ typedef enum otCoapType
  */
 typedef enum otCoapCode
 {
-    kCoapCodeEmpty       = 0x00,  ///< Empty message code
-    kCoapRequestGet      = 0x01,  ///< Get
-    kCoapRequestPost     = 0x02,  ///< Post
-    kCoapRequestPut      = 0x03,  ///< Put
-    kCoapRequestDelete   = 0x04,  ///< Delete
-    kCoapResponseChanged = 0x44,  ///< Changed
-    kCoapResponseContent = 0x45,  ///< Content
+    kCoapCodeEmpty        = 0x00,  ///< Empty message code
+    kCoapRequestGet       = 0x01,  ///< Get
+    kCoapRequestPost      = 0x02,  ///< Post
+    kCoapRequestPut       = 0x03,  ///< Put
+    kCoapRequestDelete    = 0x04,  ///< Delete
+    kCoapResponseChanged  = 0x44,  ///< Changed
+    kCoapResponseContent  = 0x45,  ///< Content
+    kCoapResponseContinue = 0x5f,  ///< Continue
+    kCoapResponseNotFound = 0x84,  ///< Not Found
+    kCoapResponseRequestEntityIncomplete = 0x88,  ///< Request Entity Incomplete
+    kCoapResponseRequestEntityTooLarge   = 0x8d,  ///< Request Entity Too Large
+    kCoapResponseServiceUnavailable      = 0xa3,  ///< Service Unavailable
 } otCoapCode;
 
 /**
@@ -87,8 +92,24 @@ typedef enum otCoapOptionType
 {
     kCoapOptionUriPath       = 11,   ///< Uri-Path
     kCoapOptionContentFormat = 12,   ///< Content-Format
+    kCoapOptionBlock2        = 23,   ///< Block2
+    kCoapOptionBlock1        = 27,   ///< Block1
 } otCoapOptionType;
 
+/**
+ * CoAP Block Size Exponents (RFC 7959)
+ */
+typedef enum otCoapBlockSize
+{
+    kCoapBlockSize16   = 0,  ///< 16 bytes
+    kCoapBlockSize32   = 1,  ///< 32 bytes
+    kCoapBlockSize64   = 2,  ///< 64 bytes
+    kCoapBlockSize128  = 3,  ///< 128 bytes
+    kCoapBlockSize256  = 4,  ///< 256 bytes
+    kCoapBlockSize512  = 5,  ///< 512 bytes
+    kCoapBlockSize1024 = 6,  ///< 1024 bytes
+} otCoapBlockSize;
+
 /**
  * This structure represents a CoAP option.
  *
@@ -385,8 +385,11 @@ typedef struct otActiveScanResult
  */
 typedef struct otEnergyScanResult
 {
-    uint8_t mChannel;                ///< IEEE 802.15.4 Channel
-    int8_t  mMaxRssi;                ///< The max RSSI (dBm)
+    uint8_t  mChannel;               ///< IEEE 802.15.4 Channel
+    int8_t   mMaxRssi;               ///< The max RSSI (dBm)
+    int8_t   mAverageRssi;           ///< The mean RSSI (dBm), equal to mMaxRssi if no samples were taken
+    int8_t   mPercentileRssi;        ///< The RSSI percentile (dBm), equal to mMaxRssi if no samples were taken
+    uint16_t mSampleCount;           ///< The number of RSSI samples, zero if the radio performed the scan
 } otEnergyScanResult;
 
 /**
@@ -852,6 +855,121 @@ typedef struct otMacCounters
     uint32_t mRxErrOther;             ///< The number of received packets with other error.
 } otMacCounters;
 
+/**
+ * This enumeration represents the transmit priority classes of a message.
+ *
+ */
+typedef enum otMessagePriority
+{
+    kMessagePriorityLow     = 0,  ///< Bulk traffic that may be delayed behind everything else.
+    kMessagePriorityNormal  = 1,  ///< Default priority of application and forwarded traffic.
+    kMessagePriorityHigh    = 2,  ///< Thread management (CoAP) traffic.
+    kMessagePriorityNetwork = 3,  ///< Network control traffic such as MLE and MAC data polls.
+} otMessagePriority;
+
+#define OT_NUM_MESSAGE_PRIORITIES 4  ///< The number of message priority classes.
+
+/**
+ * This structure represents the per-priority counters of the mesh forwarder send queue.
+ *
+ * Both arrays are indexed by otMessagePriority.
+ *
+ */
+typedef struct otSendQueueCounters
+{
+    uint16_t mQueued[OT_NUM_MESSAGE_PRIORITIES];   ///< The number of messages currently in the send queue.
+    uint32_t mDropped[OT_NUM_MESSAGE_PRIORITIES];  ///< The number of messages dropped from the send queue.
+} otSendQueueCounters;
+
+/**
+ * This structure represents the per-priority usage counters of the message buffer pool.
+ *
+ * All arrays are indexed by otMessagePriority.
+ *
+ */
+typedef struct otBufferCounters
+{
+    uint16_t mFreeBuffers;                            ///< The number of free buffers.
+    uint16_t mInUse[OT_NUM_MESSAGE_PRIORITIES];      ///< The number of buffers currently held by messages.
+    uint16_t mHighWater[OT_NUM_MESSAGE_PRIORITIES];  ///< The largest number of buffers held at once.
+    uint32_t mEvicted[OT_NUM_MESSAGE_PRIORITIES];    ///< The number of queued messages evicted to free buffers.
+    uint32_t mFailed[OT_NUM_MESSAGE_PRIORITIES];     ///< The number of buffer requests that were refused.
+} otBufferCounters;
+
+/**
+ * This structure represents the counters of the CoAP server response cache, which answers retransmitted
+ * Confirmable requests without invoking the resource handler again.
+ *
+ */
+typedef struct otCoapResponseCacheCounters
+{
+    uint16_t mCachedResponses;  ///< The number of responses currently held in the cache.
+    uint32_t mHits;             ///< The number of duplicate requests answered from the cache.
+    uint32_t mMisses;           ///< The number of Confirmable requests not found in the cache.
+    uint32_t mEvictions;        ///< The number of responses removed before expiring to make room.
+} otCoapResponseCacheCounters;
+
+#define OT_PERF_HISTOGRAM_BUCKETS 16  ///< The number of buckets of a latency histogram.
+
+/**
+ * This structure represents a latency histogram in milliseconds.
+ *
+ * Bucket 0 counts latencies of 0 ms, bucket i counts latencies in [2^(i-1), 2^i) ms and the last bucket also counts
+ * all longer latencies.
+ *
+ */
+typedef struct otPerfHistogram
+{
+    uint32_t mCount;                                ///< The number of recorded latencies.
+    uint32_t mSum;                                  ///< The sum of the recorded latencies.
+    uint32_t mMax;                                  ///< The largest recorded latency.
+    uint32_t mBuckets[OT_PERF_HISTOGRAM_BUCKETS];  ///< The number of latencies recorded per bucket.
+} otPerfHistogram;
+
+/**
+ * This structure represents the stack performance counters.
+ *
+ * Message latencies are measured from the time a message enters the stack, i.e. when it is sent to the IPv6 layer
+ * or when its first frame is received.
+ *
+ */
+typedef struct otPerfCounters
+{
+    otPerfHistogram mMacTxLatency;         ///< From the first CSMA backoff of a frame to its final transmit result.
+    otPerfHistogram mSendQueueLatency;     ///< From entering the stack to the first frame request of a message.
+    otPerfHistogram mSendLatency;          ///< From entering the stack to the transmit result of the last frame.
+    otPerfHistogram mReceiveLatency;       ///< From the first received frame to the delivery to a UDP socket.
+    otPerfHistogram mCoapResponseLatency;  ///< From the first transmission of a CoAP request to its response.
+    uint32_t mMacTxFrames;                 ///< The number of data frames transmitted.
+    uint32_t mMacTxFailures;               ///< The number of data frames that failed after all attempts.
+    uint32_t mMeshTxMessages;              ///< The number of messages whose frames were all transmitted.
+    uint32_t mMeshRxMessages;              ///< The number of received messages passed to the IPv6 layer.
+    uint32_t mMeshForwardedFrames;         ///< The number of mesh header frames relayed to the next hop.
+    uint32_t mIp6TxDatagrams;              ///< The number of datagrams sent by the stack or the host.
+    uint32_t mIp6RxDatagrams;              ///< The number of datagrams received for this node.
+    uint32_t mIp6ForwardedDatagrams;       ///< The number of received datagrams forwarded to another node.
+    uint32_t mUdpTxDatagrams;              ///< The number of UDP datagrams sent.
+    uint32_t mUdpRxDatagrams;              ///< The number of UDP datagrams received.
+    uint32_t mCoapRequests;                ///< The number of CoAP requests and confirmable messages sent.
+    uint32_t mCoapRetransmissions;         ///< The number of CoAP request retransmissions.
+    uint32_t mCoapResponses;               ///< The number of CoAP responses matched to a request.
+    uint32_t mCoapTimeouts;                ///< The number of CoAP requests that timed out.
+    uint32_t mMleTxMessages;               ///< The number of MLE messages sent.
+    uint32_t mMleRxMessages;               ///< The number of MLE messages received.
+} otPerfCounters;
+
+/**
+ * This structure represents the Data Poll counters of a sleepy end device.
+ */
+typedef struct otDataPollCounters
+{
+    uint32_t mTxPolls;                ///< The total number of Data Polls sent.
+    uint32_t mTxFastPolls;            ///< The number of Data Polls sent at the fast Data Poll period.
+    uint32_t mTxBackoffPolls;         ///< The number of Data Polls sent while backing off towards the regular period.
+    uint32_t mTrafficTriggers;        ///< The number of times an outbound message started fast polling.
+    uint32_t mFramePendingTriggers;   ///< The number of times a frame pending indication started fast polling.
+} otDataPollCounters;
+
 /**
  * @}
  *
@@ -38,6 +38,9 @@
 /* Define to 1 to enable the joiner role. */
 #define OPENTHREAD_ENABLE_JOINER 1
 
+/* Define to 1 if you want to enable performance counters */
+#define OPENTHREAD_ENABLE_PERF_COUNTERS 0
+
 /* Name of package */
 #define PACKAGE "openthread"
 
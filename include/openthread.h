@@ -146,6 +146,22 @@ bool otAreTaskletsPending(otInstance *aInstance);
  */
 extern void otSignalTaskletPending(otInstance *aInstance);
 
+/**
+ * This function removes encoded records from the binary log buffer.
+ *
+ * It is only available when OpenThread is built with OPENTHREAD_CONFIG_LOG_BINARY, in which case the log calls
+ * store compact binary records instead of calling otPlatLog(). The platform calls this function to forward the
+ * records to the host, which decodes them with tools/log-decoder. It may be called from another context than the
+ * one running OpenThread.
+ *
+ * @param[out]  aBuffer  A pointer to the output buffer.
+ * @param[in]   aLength  The size of @p aBuffer in bytes.
+ *
+ * @returns The number of bytes copied to @p aBuffer.
+ *
+ */
+uint16_t otLogBinaryRead(uint8_t *aBuffer, uint16_t aLength);
+
 #endif
 
 /**
@@ -1130,6 +1146,43 @@ OTAPI uint32_t otGetPollPeriod(otInstance *aInstance);
  */
 OTAPI void otSetPollPeriod(otInstance *aInstance, uint32_t aPollPeriod);
 
+/**
+ * Get the period until the next data poll of sleepy end device.
+ *
+ * The effective period is shortened after the device sends a message or its parent indicates a pending frame, and
+ * then backs off exponentially towards the regular data poll period.
+ *
+ * @param[in]  aInstance A pointer to an OpenThread instance.
+ *
+ * @returns  The effective data poll period in milliseconds.
+ *
+ */
+OTAPI uint32_t otGetEffectivePollPeriod(otInstance *aInstance);
+
+/**
+ * Get the coordinated sampled listening (CSL) period of sleepy end device.
+ *
+ * @param[in]  aInstance A pointer to an OpenThread instance.
+ *
+ * @returns  The CSL period in milliseconds, or zero if CSL is disabled.
+ *
+ * @sa otSetCslPeriod
+ */
+OTAPI uint16_t otGetCslPeriod(otInstance *aInstance);
+
+/**
+ * Set the coordinated sampled listening (CSL) period of sleepy end device.
+ *
+ * A sleepy end device with a CSL period turns its receiver on periodically and announces the period and phase to
+ * its parent, which then transmits queued frames at the child's next sample instead of waiting for a data poll.
+ *
+ * @param[in]  aInstance   A pointer to an OpenThread instance.
+ * @param[in]  aCslPeriod  The CSL period in milliseconds, or zero to disable CSL.
+ *
+ * @sa otGetCslPeriod
+ */
+OTAPI void otSetCslPeriod(otInstance *aInstance, uint16_t aCslPeriod);
+
 /**
  * Set the preferred Router Id.
  *
@@ -2055,6 +2108,64 @@ ThreadError otSetLinkPromiscuous(otInstance *aInstance, bool aPromiscuous);
  */
 OTAPI const otMacCounters *otGetMacCounters(otInstance *aInstance);
 
+/**
+ * Get the data poll counters of sleepy end device.
+ *
+ * @param[in]  aInstance A pointer to an OpenThread instance.
+ *
+ * @returns A pointer to the data poll counters.
+ */
+OTAPI const otDataPollCounters *otGetDataPollCounters(otInstance *aInstance);
+
+/**
+ * Get the per-priority counters of the mesh forwarder send queue.
+ *
+ * @param[in]  aInstance A pointer to an OpenThread instance.
+ *
+ * @returns A pointer to the send queue counters.
+ */
+OTAPI const otSendQueueCounters *otGetSendQueueCounters(otInstance *aInstance);
+
+/**
+ * Get the per-priority usage counters of the message buffer pool.
+ *
+ * @param[in]  aInstance A pointer to an OpenThread instance.
+ *
+ * @returns A pointer to the message buffer counters.
+ */
+OTAPI const otBufferCounters *otGetBufferCounters(otInstance *aInstance);
+
+/**
+ * Get the counters of the Thread management CoAP server response cache.
+ *
+ * @param[in]  aInstance A pointer to an OpenThread instance.
+ *
+ * @returns A pointer to the response cache counters.
+ */
+OTAPI const otCoapResponseCacheCounters *otGetCoapResponseCacheCounters(otInstance *aInstance);
+
+/**
+ * Get the stack performance counters.
+ *
+ * This function is only available when OpenThread is built with performance counters enabled
+ * (`--enable-perf-counters`).
+ *
+ * @param[in]  aInstance A pointer to an OpenThread instance.
+ *
+ * @returns A pointer to the performance counters.
+ */
+OTAPI const otPerfCounters *otGetPerfCounters(otInstance *aInstance);
+
+/**
+ * Reset the stack performance counters.
+ *
+ * This function is only available when OpenThread is built with performance counters enabled
+ * (`--enable-perf-counters`).
+ *
+ * @param[in]  aInstance A pointer to an OpenThread instance.
+ */
+OTAPI void otResetPerfCounters(otInstance *aInstance);
+
 /**
  * @}
  *
@@ -2200,6 +2311,34 @@ uint16_t otGetMessageOffset(otMessage aMessage);
  */
 ThreadError otSetMessageOffset(otMessage aMessage, uint16_t aOffset);
 
+/**
+ * Get the transmit priority class of a message.
+ *
+ * @param[in]  aMessage  A pointer to a message buffer.
+ *
+ * @returns The priority class of the message.
+ *
+ * @sa otSetMessagePriority
+ */
+otMessagePriority otGetMessagePriority(otMessage aMessage);
+
+/**
+ * Set the transmit priority class of a message.
+ *
+ * Messages of a higher class are transmitted ahead of queued messages of a lower class.  New messages have
+ * kMessagePriorityNormal.
+ *
+ * @param[in]  aMessage   A pointer to a message buffer.
+ * @param[in]  aPriority  The priority class.
+ *
+ * @retval kThreadErrorNone        Successfully set the message priority.
+ * @retval kThreadErrorInvalidArg  @p aPriority is not a valid priority class.
+ * @retval kThreadErrorNoBufs      The priority class has reached its message buffer limit.
+ *
+ * @sa otGetMessagePriority
+ */
+ThreadError otSetMessagePriority(otMessage aMessage, otMessagePriority aPriority);
+
 /**
  * Append bytes to a message.
  *
@@ -84,6 +84,40 @@ uint32_t otPlatAlarmGetNow(void);
  */
 extern void otPlatAlarmFired(otInstance *aInstance);
 
+/**
+ * Set the microsecond alarm to fire at @p aDt microseconds after @p aT0.
+ *
+ * The microsecond alarm is optional and only used when OPENTHREAD_ENABLE_PLATFORM_USEC_TIMER is enabled.
+ *
+ * @param[in] aInstance  The OpenThread instance structure.
+ * @param[in] aT0        The reference time.
+ * @param[in] aDt        The time delay in microseconds from @p aT0.
+ */
+void otPlatAlarmMicroStartAt(otInstance *aInstance, uint32_t aT0, uint32_t aDt);
+
+/**
+ * Stop the microsecond alarm.
+ *
+ * @param[in] aInstance  The OpenThread instance structure.
+ */
+void otPlatAlarmMicroStop(otInstance *aInstance);
+
+/**
+ * Get the current time of the microsecond alarm.
+ *
+ * The value must increase monotonically and wrap around at 2^32 microseconds.
+ *
+ * @returns The current time in microseconds.
+ */
+uint32_t otPlatAlarmMicroGetNow(void);
+
+/**
+ * Signal that the microsecond alarm has fired.
+ *
+ * @param[in] aInstance  The OpenThread instance structure.
+ */
+extern void otPlatAlarmMicroFired(otInstance *aInstance);
+
 /**
  * Signal diagnostics module that the alarm has fired.
  *
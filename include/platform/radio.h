@@ -88,8 +88,25 @@ typedef enum otRadioCaps
     kRadioCapsNone          = 0,  ///< None
     kRadioCapsAckTimeout    = 1,  ///< Radio supports AckTime event
     kRadioCapsEnergyScan    = 2,  ///< Radio supports Enegery Scans
+    kRadioCapsTransmitPipeline = 4,  ///< Radio provides a second transmit buffer (otPlatRadioGetNextTransmitBuffer)
 } otRadioCaps;
 
+/**
+ * This structure holds the location of the IEEE 802.15.4 MAC header fields within a radio frame.
+ *
+ * OpenThread fills it in once when it forms or parses a frame.  It is ignored by the radio driver.
+ */
+typedef struct RadioPacketHeaderInfo
+{
+    uint8_t  mDstPanId;        ///< Offset of the Destination PAN ID, or zero if not present.
+    uint8_t  mDstAddr;         ///< Offset of the Destination Address, or zero if not present.
+    uint8_t  mSrcPanId;        ///< Offset of the (possibly elided) Source PAN ID, or zero if not present.
+    uint8_t  mSrcAddr;         ///< Offset of the Source Address, or zero if not present.
+    uint8_t  mSecurityHeader;  ///< Offset of the Auxiliary Security Header, or zero if not present.
+    uint8_t  mPayload;         ///< Offset of the MAC payload.
+    uint8_t  mFooterLength;    ///< Length of the MIC and FCS.
+} RadioPacketHeaderInfo;
+
 /**
  * This structure represents an IEEE 802.15.4 radio frame.
  */
@@ -102,6 +119,7 @@ typedef struct RadioPacket
     uint8_t  mLqi;             ///< Link Quality Indicator for received frames.
     bool     mSecurityValid: 1; ///< Security Enabled flag is set and frame passes security checks.
     bool     mDidTX: 1;        ///< Set to true if this packet sent from the radio. Ignored by radio driver.
+    RadioPacketHeaderInfo mHeaderInfo;  ///< MAC header field offsets. Ignored by radio driver.
 } RadioPacket;
 
 /**
@@ -340,6 +358,32 @@ extern void otPlatRadioReceiveDone(otInstance *aInstance, RadioPacket *aPacket,
  */
 RadioPacket *otPlatRadioGetTransmitBuffer(otInstance *aInstance);
 
+/**
+ * This method returns a pointer to the standby transmit buffer.
+ *
+ * Radios that report ::kRadioCapsTransmitPipeline provide two transmit buffers.  While the frame in the transmit
+ * buffer is in flight, the caller may form and secure the next frame in the standby buffer.  Other radios return
+ * NULL.
+ *
+ * @param[in] aInstance  The OpenThread instance structure.
+ *
+ * @returns A pointer to the standby transmit buffer, or NULL if the radio has a single transmit buffer.
+ *
+ */
+RadioPacket *otPlatRadioGetNextTransmitBuffer(otInstance *aInstance);
+
+/**
+ * This method exchanges the transmit buffer and the standby transmit buffer.
+ *
+ * After this call, otPlatRadioGetTransmitBuffer() returns the previous standby buffer and
+ * otPlatRadioGetNextTransmitBuffer() returns the previous transmit buffer.  It is only called between transmissions
+ * and only on radios that report ::kRadioCapsTransmitPipeline.
+ *
+ * @param[in] aInstance  The OpenThread instance structure.
+ *
+ */
+void otPlatRadioSwapTransmitBuffers(otInstance *aInstance);
+
 /**
  * This method begins the transmit sequence on the radio.
  *
@@ -85,6 +85,9 @@ const struct Command Interpreter::sCommands[] =
 #endif
     { "contextreusedelay", &Interpreter::ProcessContextIdReuseDelay },
     { "counter", &Interpreter::ProcessCounters },
+#ifndef OTDLL
+    { "cslperiod", &Interpreter::ProcessCslPeriod },
+#endif
     { "dataset", &Interpreter::ProcessDataset },
 #if OPENTHREAD_ENABLE_DIAG
     { "diag", &Interpreter::ProcessDiag },
@@ -121,6 +124,9 @@ const struct Command Interpreter::sCommands[] =
     { "networkname", &Interpreter::ProcessNetworkName },
     { "panid", &Interpreter::ProcessPanId },
     { "parent", &Interpreter::ProcessParent },
+#if OPENTHREAD_ENABLE_PERF_COUNTERS
+    { "perf", &Interpreter::ProcessPerf },
+#endif
 #ifndef OTDLL
     { "ping", &Interpreter::ProcessPing },
 #endif
@@ -516,6 +522,12 @@ void Interpreter::ProcessCounters(int argc, char *argv[])
     if (argc == 0)
     {
         sServer->OutputFormat("mac\r\n");
+#ifndef OTDLL
+        sServer->OutputFormat("buffers\r\n");
+        sServer->OutputFormat("coap\r\n");
+        sServer->OutputFormat("poll\r\n");
+        sServer->OutputFormat("queue\r\n");
+#endif
         sServer->OutputFormat("Done\r\n");
     }
     else
@@ -552,6 +564,52 @@ void Interpreter::ProcessCounters(int argc, char *argv[])
             otFreeMemory(counters);
 #endif
         }
+#ifndef OTDLL
+        else if (strcmp(argv[0], "buffers") == 0)
+        {
+            const otBufferCounters *counters = otGetBufferCounters(mInstance);
+            const char *const names[OT_NUM_MESSAGE_PRIORITIES] = {"Low", "Normal", "High", "Network"};
+
+            sServer->OutputFormat("Free: %d\r\n", counters->mFreeBuffers);
+
+            for (int i = OT_NUM_MESSAGE_PRIORITIES - 1; i >= 0; i--)
+            {
+                sServer->OutputFormat("%s: InUse %d HighWater %d Evicted %d Failed %d\r\n", names[i],
+                                      counters->mInUse[i], counters->mHighWater[i], counters->mEvicted[i],
+                                      counters->mFailed[i]);
+            }
+        }
+        else if (strcmp(argv[0], "coap") == 0)
+        {
+            const otCoapResponseCacheCounters *counters = otGetCoapResponseCacheCounters(mInstance);
+
+            sServer->OutputFormat("CachedResponses: %d\r\n", counters->mCachedResponses);
+            sServer->OutputFormat("Hits: %d\r\n", counters->mHits);
+            sServer->OutputFormat("Misses: %d\r\n", counters->mMisses);
+            sServer->OutputFormat("Evictions: %d\r\n", counters->mEvictions);
+        }
+        else if (strcmp(argv[0], "poll") == 0)
+        {
+            const otDataPollCounters *counters = otGetDataPollCounters(mInstance);
+            sServer->OutputFormat("EffectivePollPeriod: %d\r\n", otGetEffectivePollPeriod(mInstance));
+            sServer->OutputFormat("TxPolls: %d\r\n", counters->mTxPolls);
+            sServer->OutputFormat("    TxFastPolls: %d\r\n", counters->mTxFastPolls);
+            sServer->OutputFormat("    TxBackoffPolls: %d\r\n", counters->mTxBackoffPolls);
+            sServer->OutputFormat("TrafficTriggers: %d\r\n", counters->mTrafficTriggers);
+            sServer->OutputFormat("FramePendingTriggers: %d\r\n", counters->mFramePendingTriggers);
+        }
+        else if (strcmp(argv[0], "queue") == 0)
+        {
+            const otSendQueueCounters *counters = otGetSendQueueCounters(mInstance);
+            const char *const names[OT_NUM_MESSAGE_PRIORITIES] = {"Low", "Normal", "High", "Network"};
+
+            for (int i = OT_NUM_MESSAGE_PRIORITIES - 1; i >= 0; i--)
+            {
+                sServer->OutputFormat("%s: Queued %d Dropped %d\r\n", names[i], counters->mQueued[i],
+                                      counters->mDropped[i]);
+            }
+        }
+#endif
     }
 }
 
@@ -1119,6 +1177,61 @@ exit:
     AppendResult(error);
 }
 
+#if OPENTHREAD_ENABLE_PERF_COUNTERS
+void Interpreter::OutputPerfHistogram(const char *aName, const otPerfHistogram &aHistogram)
+{
+    sServer->OutputFormat("%s: Count %d Avg %d Max %d\r\n", aName, aHistogram.mCount,
+                          (aHistogram.mCount > 0) ? aHistogram.mSum / aHistogram.mCount : 0, aHistogram.mMax);
+    sServer->OutputFormat("   ");
+
+    for (int i = 0; i < OT_PERF_HISTOGRAM_BUCKETS; i++)
+    {
+        sServer->OutputFormat(" %d", aHistogram.mBuckets[i]);
+    }
+
+    sServer->OutputFormat("\r\n");
+}
+
+void Interpreter::ProcessPerf(int argc, char *argv[])
+{
+    ThreadError error = kThreadError_None;
+    const otPerfCounters *counters;
+
+    if (argc > 0)
+    {
+        VerifyOrExit(strcmp(argv[0], "reset") == 0, error = kThreadError_Parse);
+        otResetPerfCounters(mInstance);
+        ExitNow();
+    }
+
+    counters = otGetPerfCounters(mInstance);
+    sServer->OutputFormat("MacTxFrames: %d\r\n", counters->mMacTxFrames);
+    sServer->OutputFormat("MacTxFailures: %d\r\n", counters->mMacTxFailures);
+    sServer->OutputFormat("MeshTxMessages: %d\r\n", counters->mMeshTxMessages);
+    sServer->OutputFormat("MeshRxMessages: %d\r\n", counters->mMeshRxMessages);
+    sServer->OutputFormat("MeshForwardedFrames: %d\r\n", counters->mMeshForwardedFrames);
+    sServer->OutputFormat("Ip6TxDatagrams: %d\r\n", counters->mIp6TxDatagrams);
+    sServer->OutputFormat("Ip6RxDatagrams: %d\r\n", counters->mIp6RxDatagrams);
+    sServer->OutputFormat("Ip6ForwardedDatagrams: %d\r\n", counters->mIp6ForwardedDatagrams);
+    sServer->OutputFormat("UdpTxDatagrams: %d\r\n", counters->mUdpTxDatagrams);
+    sServer->OutputFormat("UdpRxDatagrams: %d\r\n", counters->mUdpRxDatagrams);
+    sServer->OutputFormat("CoapRequests: %d\r\n", counters->mCoapRequests);
+    sServer->OutputFormat("CoapRetransmissions: %d\r\n", counters->mCoapRetransmissions);
+    sServer->OutputFormat("CoapResponses: %d\r\n", counters->mCoapResponses);
+    sServer->OutputFormat("CoapTimeouts: %d\r\n", counters->mCoapTimeouts);
+    sServer->OutputFormat("MleTxMessages: %d\r\n", counters->mMleTxMessages);
+    sServer->OutputFormat("MleRxMessages: %d\r\n", counters->mMleRxMessages);
+    OutputPerfHistogram("MacTxLatency", counters->mMacTxLatency);
+    OutputPerfHistogram("SendQueueLatency", counters->mSendQueueLatency);
+    OutputPerfHistogram("SendLatency", counters->mSendLatency);
+    OutputPerfHistogram("ReceiveLatency", counters->mReceiveLatency);
+    OutputPerfHistogram("CoapResponseLatency", counters->mCoapResponseLatency);
+
+exit:
+    AppendResult(error);
+}
+#endif
+
 #ifndef OTDLL
 void Interpreter::s_HandleEchoResponse(void *aContext, Message &aMessage, const Ip6::MessageInfo &aMessageInfo)
 {
@@ -1236,6 +1349,28 @@ exit:
 }
 #endif
 
+#ifndef OTDLL
+void Interpreter::ProcessCslPeriod(int argc, char *argv[])
+{
+    ThreadError error = kThreadError_None;
+    long value;
+
+    if (argc == 0)
+    {
+        sServer->OutputFormat("%d\r\n", otGetCslPeriod(mInstance));
+    }
+    else
+    {
+        SuccessOrExit(error = ParseLong(argv[0], value));
+        VerifyOrExit(value >= 0 && value <= 0xffff, error = kThreadError_InvalidArgs);
+        otSetCslPeriod(mInstance, static_cast<uint16_t>(value));
+    }
+
+exit:
+    AppendResult(error);
+}
+#endif
+
 void Interpreter::ProcessPollPeriod(int argc, char *argv[])
 {
     ThreadError error = kThreadError_None;
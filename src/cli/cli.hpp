@@ -163,6 +163,9 @@ private:
 #endif  // OPENTHREAD_ENABLE_COMMISSIONER
     void ProcessContextIdReuseDelay(int argc, char *argv[]);
     void ProcessCounters(int argc, char *argv[]);
+#ifndef OTDLL
+    void ProcessCslPeriod(int argc, char *argv[]);
+#endif
     void ProcessDataset(int argc, char *argv[]);
 #if OPENTHREAD_ENABLE_DIAG
     void ProcessDiag(int argc, char *argv[]);
@@ -197,6 +200,10 @@ private:
     void ProcessNetworkName(int argc, char *argv[]);
     void ProcessPanId(int argc, char *argv[]);
     void ProcessParent(int argc, char *argv[]);
+#if OPENTHREAD_ENABLE_PERF_COUNTERS
+    void ProcessPerf(int argc, char *argv[]);
+    void OutputPerfHistogram(const char *aName, const otPerfHistogram &aHistogram);
+#endif
     void ProcessPing(int argc, char *argv[]);
     void ProcessPollPeriod(int argc, char *argv[]);
     void ProcessPrefix(int argc, char *argv[]);
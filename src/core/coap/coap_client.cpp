@@ -45,8 +45,16 @@ namespace Coap {
 Client::Client(Ip6::Netif &aNetif):
     mSocket(aNetif.GetIp6().mUdp),
     mRetransmissionTimer(aNetif.GetIp6().mTimerScheduler, &Client::HandleRetransmissionTimer, this)
+#if OPENTHREAD_ENABLE_PERF_COUNTERS
+    , mPerfCounters(aNetif.GetIp6().mPerfCounters)
+#endif
 {
     mMessageId = static_cast<uint16_t>(otPlatRandomGet());
+
+    for (PeerState *peer = &mPeers[0]; peer < &mPeers[kMaxPeers]; peer++)
+    {
+        peer->mValid = false;
+    }
 }
 
 ThreadError Client::Start()
@@ -80,7 +88,7 @@ Message *Client::NewMessage(const Header &aHeader)
     // Ensure that header has minimum required length.
     VerifyOrExit(aHeader.GetLength() >= Header::kMinHeaderLength, ;);
 
-    VerifyOrExit((message = mSocket.NewMessage(aHeader.GetLength())) != NULL, ;);
+    VerifyOrExit((message = mSocket.NewMessage(aHeader.GetLength(), Message::kPriorityHigh)) != NULL, ;);
     message->Prepend(aHeader.GetBytes(), aHeader.GetLength());
     message->SetOffset(0);
 
@@ -90,12 +98,106 @@ exit:
 
 ThreadError Client::SendMessage(Message &aMessage, const Ip6::MessageInfo &aMessageInfo,
                                 otCoapResponseHandler aHandler, void *aContext)
+{
+    return SendMessage(aMessage, aMessageInfo, aHandler, aContext, NULL, NULL, NULL);
+}
+
+ThreadError Client::SendBlockwiseRequest(Message &aMessage, const Ip6::MessageInfo &aMessageInfo,
+                                         BlockProducer aProducer, BlockConsumer aConsumer, void *aBlockContext,
+                                         otCoapResponseHandler aHandler, void *aContext)
+{
+    ThreadError error;
+    Header header;
+    Message *message = NULL;
+
+    SuccessOrExit(error = header.FromMessage(aMessage));
+    VerifyOrExit(header.IsConfirmable() && header.IsRequest() && aMessage.GetLength() == header.GetLength(),
+                 error = kThreadError_InvalidArgs);
+
+    // Start with the first request block, or ask for the preferred response block size.
+    SuccessOrExit(error = NewBlockRequest(header, (aProducer != NULL) ? kCoapOptionBlock1 : kCoapOptionBlock2, 0,
+                                          static_cast<Header::BlockSize>(kBlockSize), aProducer, aBlockContext,
+                                          &message));
+    SuccessOrExit(error = SendMessage(*message, aMessageInfo, aHandler, aContext, aProducer, aConsumer,
+                                      aBlockContext));
+
+    aMessage.Free();
+
+exit:
+
+    if (error != kThreadError_None && message != NULL)
+    {
+        message->Free();
+    }
+
+    return error;
+}
+
+ThreadError Client::NewBlockRequest(Header &aRequestHeader, Header::Option::Type aType, uint32_t aNumber,
+                                    Header::BlockSize aSize, BlockProducer aProducer, void *aBlockContext,
+                                    Message **aMessage)
+{
+    ThreadError error = kThreadError_None;
+    Message *message = NULL;
+    Header header;
+    const Header::Option *coapOption;
+    uint16_t blockSize = Header::GetBlockSize(aSize);
+    bool more = false;
+
+    header.Init(aRequestHeader.GetType(), aRequestHeader.GetCode());
+    header.SetToken(aRequestHeader.GetToken(), aRequestHeader.GetTokenLength());
+
+    // Repeat the request options that precede the Block options.
+    for (coapOption = aRequestHeader.GetFirstOption(); coapOption != NULL && coapOption->mNumber < kCoapOptionBlock2;
+         coapOption = aRequestHeader.GetNextOption())
+    {
+        SuccessOrExit(error = header.AppendOption(*coapOption));
+    }
+
+    // Generate the payload first, the M flag is only known once the block has been produced.
+    VerifyOrExit((message = mSocket.NewMessage(header.GetLength() + kMaxBlockOverhead, Message::kPriorityHigh)) != NULL,
+                 error = kThreadError_NoBufs);
+
+    if (aType == kCoapOptionBlock1)
+    {
+        SuccessOrExit(error = aProducer(aBlockContext, *message, aNumber * blockSize, blockSize, more));
+        VerifyOrExit(message->GetLength() == blockSize || (!more && message->GetLength() < blockSize),
+                     error = kThreadError_Failed);
+    }
+
+    SuccessOrExit(error = header.AppendBlockOption(aType, aNumber, more, aSize));
+
+    if (message->GetLength() > 0)
+    {
+        SuccessOrExit(error = header.SetPayloadMarker());
+    }
+
+    SuccessOrExit(error = message->Prepend(header.GetBytes(), header.GetLength()));
+    message->SetOffset(0);
+
+exit:
+
+    if (error != kThreadError_None && message != NULL)
+    {
+        message->Free();
+        message = NULL;
+    }
+
+    *aMessage = message;
+    return error;
+}
+
+ThreadError Client::SendMessage(Message &aMessage, const Ip6::MessageInfo &aMessageInfo,
+                                otCoapResponseHandler aHandler, void *aContext,
+                                BlockProducer aProducer, BlockConsumer aConsumer, void *aBlockContext)
 {
     ThreadError error;
     Header header;
     RequestMetadata requestMetadata;
     Message *storedCopy = NULL;
     uint16_t copyLength = 0;
+    PeerState *peer = NULL;
+    uint32_t retransmissionTimeout = kDefaultRetransmissionTimeout;
 
     SuccessOrExit(error = header.FromMessage(aMessage));
 
@@ -119,29 +221,69 @@ ThreadError Client::SendMessage(Message &aMessage, const Ip6::MessageInfo &aMess
 
     if (copyLength > 0)
     {
-        requestMetadata = RequestMetadata(header.IsConfirmable(), aMessageInfo, aHandler, aContext);
-        VerifyOrExit((storedCopy = CopyAndEnqueueMessage(aMessage, copyLength, requestMetadata)) != NULL,
-                     error = kThreadError_NoBufs);
+        if (header.IsConfirmable() && (peer = GetPeerState(aMessageInfo.GetPeerAddr(), true)) != NULL)
+        {
+            retransmissionTimeout = peer->GetRetransmissionTimeout(Timer::GetNow());
+        }
+
+        requestMetadata = RequestMetadata(header.IsConfirmable(), aMessageInfo, aHandler, aContext,
+                                          retransmissionTimeout);
+        requestMetadata.mBlockProducer = aProducer;
+        requestMetadata.mBlockConsumer = aConsumer;
+        requestMetadata.mBlockContext = aBlockContext;
+
+        if (peer != NULL)
+        {
+            // Requests beyond the congestion window are held back until an outstanding one completes.
+            if (peer->CanSend())
+            {
+                requestMetadata.mInFlight = true;
+                peer->mOutstanding++;
+            }
+            else
+            {
+                requestMetadata.mDeferred = true;
+                peer->mDeferred++;
+            }
+        }
+
+        storedCopy = CopyAndEnqueueMessage(aMessage, copyLength, header, requestMetadata);
+        VerifyOrExit(storedCopy != NULL, error = kThreadError_NoBufs);
+
+        otPerfCount(mPerfCounters, mCoapRequests);
+    }
+
+    if (requestMetadata.mDeferred)
+    {
+        // The stored copy is transmitted once the congestion window opens.
+        aMessage.Free();
+        ExitNow();
     }
 
     SuccessOrExit(error = mSocket.SendTo(aMessage, aMessageInfo));
 
 exit:
 
-    if (error != kThreadError_None && storedCopy != NULL)
+    if (error != kThreadError_None)
     {
-        DequeueMessage(*storedCopy);
+        if (storedCopy != NULL)
+        {
+            DequeueMessage(*storedCopy);
+        }
+        else
+        {
+            ReleaseCongestionWindow(requestMetadata);
+        }
     }
 
     return error;
 }
 
-Message *Client::CopyAndEnqueueMessage(const Message &aMessage, uint16_t aCopyLength,
+Message *Client::CopyAndEnqueueMessage(const Message &aMessage, uint16_t aCopyLength, const Header &aHeader,
                                        const RequestMetadata &aRequestMetadata)
 {
     ThreadError error = kThreadError_None;
     Message *messageCopy = NULL;
-    uint32_t alarmFireTime;
 
     // Create a message copy of requested size.
     VerifyOrExit((messageCopy = aMessage.Clone(aCopyLength)) != NULL, error = kThreadError_NoBufs);
@@ -149,20 +291,12 @@ Message *Client::CopyAndEnqueueMessage(const Message &aMessage, uint16_t aCopyLe
     // Append the copy with retransmission data.
     SuccessOrExit(error = aRequestMetadata.AppendTo(*messageCopy));
 
-    // Setup the timer.
-    if (mRetransmissionTimer.IsRunning())
-    {
-        // If timer is already running, check if it should be restarted with earlier fire time.
-        alarmFireTime = mRetransmissionTimer.Gett0() + mRetransmissionTimer.Getdt();
+    // Index the copy for matching responses.
+    mRequestIndex.Add(*messageCopy, aHeader);
 
-        if (aRequestMetadata.IsEarlier(alarmFireTime))
-        {
-            mRetransmissionTimer.Start(aRequestMetadata.mRetransmissionTimeout);
-        }
-    }
-    else
+    if (!aRequestMetadata.mDeferred)
     {
-        mRetransmissionTimer.Start(aRequestMetadata.mRetransmissionTimeout);
+        StartRetransmissionTimer(aRequestMetadata.mNextTimerShot - Timer::GetNow());
     }
 
     // Enqueue the message.
@@ -181,6 +315,12 @@ exit:
 
 void Client::DequeueMessage(Message &aMessage)
 {
+    RequestMetadata requestMetadata;
+
+    requestMetadata.ReadFrom(aMessage);
+    ReleaseCongestionWindow(requestMetadata);
+
+    mRequestIndex.Remove(aMessage);
     mPendingRequests.Dequeue(aMessage);
 
     if (mRetransmissionTimer.IsRunning() && (mPendingRequests.GetHead() == NULL))
@@ -196,6 +336,164 @@ void Client::DequeueMessage(Message &aMessage)
     // the timer would just shoot earlier and then it'd be setup again.
 }
 
+void Client::StartRetransmissionTimer(uint32_t aDelay)
+{
+    uint32_t now = Timer::GetNow();
+
+    // Restart the timer only if it should fire earlier than currently scheduled.
+    if (!mRetransmissionTimer.IsRunning() ||
+        static_cast<int32_t>((now + aDelay) - (mRetransmissionTimer.Gett0() + mRetransmissionTimer.Getdt())) < 0)
+    {
+        mRetransmissionTimer.Start(aDelay);
+    }
+}
+
+PeerState *Client::GetPeerState(const Ip6::Address &aAddress, bool aAllocate)
+{
+    uint32_t now = Timer::GetNow();
+    PeerState *freeEntry = NULL;
+    PeerState *oldestEntry = NULL;
+    PeerState *rval = NULL;
+
+    // Confirmable messages are never sent to multicast destinations.
+    VerifyOrExit(!aAddress.IsMulticast(), ;);
+
+    for (PeerState *peer = &mPeers[0]; peer < &mPeers[kMaxPeers]; peer++)
+    {
+        if (!peer->IsValid())
+        {
+            freeEntry = peer;
+        }
+        else if (peer->mAddress == aAddress)
+        {
+            peer->mLastUsed = now;
+            ExitNow(rval = peer);
+        }
+        else if (peer->IsIdle() &&
+                 (oldestEntry == NULL || static_cast<int32_t>(peer->mLastUsed - oldestEntry->mLastUsed) < 0))
+        {
+            oldestEntry = peer;
+        }
+    }
+
+    VerifyOrExit(aAllocate, ;);
+
+    // Prefer a free entry, otherwise replace the least recently used idle one.
+    rval = (freeEntry != NULL) ? freeEntry : oldestEntry;
+
+    if (rval != NULL)
+    {
+        rval->Init(aAddress, now);
+    }
+
+exit:
+    return rval;
+}
+
+void Client::ReleaseCongestionWindow(RequestMetadata &aRequestMetadata)
+{
+    PeerState *peer;
+
+    VerifyOrExit(aRequestMetadata.mInFlight || aRequestMetadata.mDeferred, ;);
+    VerifyOrExit((peer = GetPeerState(aRequestMetadata.mDestinationAddress, false)) != NULL, ;);
+
+    if (aRequestMetadata.mInFlight)
+    {
+        peer->mOutstanding--;
+    }
+    else
+    {
+        peer->mDeferred--;
+    }
+
+exit:
+    aRequestMetadata.mInFlight = false;
+    aRequestMetadata.mDeferred = false;
+}
+
+void Client::HandleAcknowledgment(Message &aMessage, RequestMetadata &aRequestMetadata, bool aSampleRtt)
+{
+    uint32_t now = Timer::GetNow();
+    PeerState *peer;
+
+    VerifyOrExit(aRequestMetadata.mConfirmable && !aRequestMetadata.mAcknowledged, ;);
+
+    aRequestMetadata.mAcknowledged = true;
+
+    if (aRequestMetadata.mInFlight && (peer = GetPeerState(aRequestMetadata.mDestinationAddress, false)) != NULL)
+    {
+        if (aSampleRtt)
+        {
+            peer->UpdateRtt(now - aRequestMetadata.mTransmitTime, aRequestMetadata.mRetransmissionCount, now);
+        }
+
+        // Open the congestion window by one for each exchange completed without retransmissions.
+        if (aRequestMetadata.mRetransmissionCount == 0 && peer->mCongestionWindow < kMaxCongestionWindow)
+        {
+            peer->mCongestionWindow++;
+        }
+    }
+
+    ReleaseCongestionWindow(aRequestMetadata);
+    aRequestMetadata.UpdateIn(aMessage);
+
+exit:
+    return;
+}
+
+void Client::SendDeferredRequests(void)
+{
+    uint32_t now = Timer::GetNow();
+    bool pending = false;
+    RequestMetadata requestMetadata;
+    Ip6::MessageInfo messageInfo;
+    PeerState *peer;
+
+    for (peer = &mPeers[0]; peer < &mPeers[kMaxPeers]; peer++)
+    {
+        if (peer->IsValid() && peer->mDeferred > 0 && peer->CanSend())
+        {
+            pending = true;
+            break;
+        }
+    }
+
+    VerifyOrExit(pending, ;);
+
+    for (Message *message = mPendingRequests.GetHead(); message; message = message->GetNext())
+    {
+        requestMetadata.ReadFrom(*message);
+
+        if (!requestMetadata.mDeferred)
+        {
+            continue;
+        }
+
+        if ((peer = GetPeerState(requestMetadata.mDestinationAddress, false)) == NULL || !peer->CanSend())
+        {
+            continue;
+        }
+
+        peer->mDeferred--;
+        peer->mOutstanding++;
+        requestMetadata.mDeferred = false;
+        requestMetadata.mInFlight = true;
+        requestMetadata.StartTransmission(peer->GetRetransmissionTimeout(now));
+        requestMetadata.UpdateIn(*message);
+
+        StartRetransmissionTimer(requestMetadata.mRetransmissionTimeout);
+
+        memset(&messageInfo, 0, sizeof(messageInfo));
+        messageInfo.GetPeerAddr() = requestMetadata.mDestinationAddress;
+        messageInfo.mPeerPort = requestMetadata.mDestinationPort;
+
+        SendCopy(*message, messageInfo);
+    }
+
+exit:
+    return;
+}
+
 ThreadError Client::SendCopy(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo)
 {
     ThreadError error;
@@ -257,13 +555,18 @@ void Client::HandleRetransmissionTimer(void)
     Message *message = mPendingRequests.GetHead();
     Message *nextMessage = NULL;
     Ip6::MessageInfo messageInfo;
+    PeerState *peer;
 
     while (message != NULL)
     {
         nextMessage = message->GetNext();
         requestMetadata.ReadFrom(*message);
 
-        if (requestMetadata.IsLater(now))
+        if (requestMetadata.mDeferred)
+        {
+            // Not transmitted yet, waiting for the congestion window.
+        }
+        else if (requestMetadata.IsLater(now))
         {
             // Calculate the next delay and choose the lowest.
             if (requestMetadata.mNextTimerShot - now < nextDelta)
@@ -274,9 +577,18 @@ void Client::HandleRetransmissionTimer(void)
         else if ((requestMetadata.mConfirmable) &&
                  (requestMetadata.mRetransmissionCount < kMaxRetransmit))
         {
-            // Increment retransmission counter and timer.
+            // A first retransmission is a congestion signal, shrink the window (draft-ietf-core-cocoa).
+            if (!requestMetadata.mAcknowledged && requestMetadata.mRetransmissionCount == 0 &&
+                (peer = GetPeerState(requestMetadata.mDestinationAddress, false)) != NULL &&
+                peer->mCongestionWindow > 1)
+            {
+                peer->mCongestionWindow /= 2;
+            }
+
+            // Increment retransmission counter and apply the variable backoff factor.
             requestMetadata.mRetransmissionCount++;
-            requestMetadata.mRetransmissionTimeout *= 2;
+            requestMetadata.mRetransmissionTimeout = requestMetadata.mRetransmissionTimeout *
+                                                     requestMetadata.mBackoffFactor / kBackoffFactorDenominator;
             requestMetadata.mNextTimerShot = now + requestMetadata.mRetransmissionTimeout;
             requestMetadata.UpdateIn(*message);
 
@@ -293,12 +605,14 @@ void Client::HandleRetransmissionTimer(void)
                 messageInfo.GetPeerAddr() = requestMetadata.mDestinationAddress;
                 messageInfo.mPeerPort = requestMetadata.mDestinationPort;
 
+                otPerfCount(mPerfCounters, mCoapRetransmissions);
                 SendCopy(*message, messageInfo);
             }
         }
         else
         {
             // No expected response or acknowledgment.
+            otPerfCount(mPerfCounters, mCoapTimeouts);
             FinalizeCoapTransaction(*message, requestMetadata, NULL, NULL, kThreadError_ResponseTimeout);
         }
 
@@ -307,63 +621,142 @@ void Client::HandleRetransmissionTimer(void)
 
     if (nextDelta != 0xffffffff)
     {
-        mRetransmissionTimer.Start(nextDelta);
+        StartRetransmissionTimer(nextDelta);
     }
+
+    SendDeferredRequests();
 }
 
 Message *Client::FindRelatedRequest(const Header &aResponseHeader, const Ip6::MessageInfo &aMessageInfo,
                                     Header &aRequestHeader, RequestMetadata &aRequestMetadata)
 {
-    Message *message = mPendingRequests.GetHead();
+    return mRequestIndex.Find(aResponseHeader, aMessageInfo, mPendingRequests, aRequestHeader, aRequestMetadata);
+}
 
-    while (message != NULL)
+void Client::FinalizeCoapTransaction(Message &aRequest, const RequestMetadata &aRequestMetadata,
+                                     Header *aResponseHeader, Message *aResponse, ThreadError aResult)
+{
+#if OPENTHREAD_ENABLE_PERF_COUNTERS
+
+    if (aResponseHeader != NULL)
     {
-        aRequestMetadata.ReadFrom(*message);
+        otPerfRecordLatency(mPerfCounters, mCoapResponseLatency, aRequestMetadata.mTransmitTime);
+        otPerfCount(mPerfCounters, mCoapResponses);
+    }
 
-        if ((aRequestMetadata.mDestinationAddress == aMessageInfo.GetPeerAddr()) &&
-            (aRequestMetadata.mDestinationPort == aMessageInfo.mPeerPort))
-        {
-            assert(aRequestHeader.FromMessage(*message) == kThreadError_None);
+#endif
 
-            switch (aResponseHeader.GetType())
-            {
-            case kCoapTypeReset:
-            case kCoapTypeAcknowledgment:
-                if (aResponseHeader.GetMessageId() == aRequestHeader.GetMessageId())
-                {
-                    ExitNow();
-                }
-
-                break;
-
-            case kCoapTypeConfirmable:
-            case kCoapTypeNonConfirmable:
-                if (aResponseHeader.IsTokenEqual(aRequestHeader))
-                {
-                    ExitNow();
-                }
-
-                break;
-            }
-        }
+    DequeueMessage(aRequest);
 
-        message = message->GetNext();
+    if (aRequestMetadata.mResponseHandler != NULL)
+    {
+        aRequestMetadata.mResponseHandler(aRequestMetadata.mResponseContext, aResponseHeader,
+                                          aResponse, aResult);
+    }
+}
+
+void Client::HandleResponse(Message &aRequest, const RequestMetadata &aRequestMetadata,
+                            Header &aResponseHeader, Message &aResponse)
+{
+    ThreadError error = kThreadError_None;
+    Message *nextRequest = NULL;
+    Ip6::MessageInfo messageInfo;
+
+    if (aRequestMetadata.mBlockProducer != NULL || aRequestMetadata.mBlockConsumer != NULL)
+    {
+        error = ContinueBlockwiseTransfer(aRequest, aRequestMetadata, aResponseHeader, aResponse, &nextRequest);
+    }
+
+    VerifyOrExit(nextRequest != NULL,
+                 FinalizeCoapTransaction(aRequest, aRequestMetadata, &aResponseHeader, &aResponse, error));
+
+    // The exchange continues with the next block, the handler is called once the transfer completes.
+    DequeueMessage(aRequest);
+
+    memset(&messageInfo, 0, sizeof(messageInfo));
+    messageInfo.GetPeerAddr() = aRequestMetadata.mDestinationAddress;
+    messageInfo.mPeerPort = aRequestMetadata.mDestinationPort;
+
+    error = SendMessage(*nextRequest, messageInfo, aRequestMetadata.mResponseHandler,
+                        aRequestMetadata.mResponseContext, aRequestMetadata.mBlockProducer,
+                        aRequestMetadata.mBlockConsumer, aRequestMetadata.mBlockContext);
+
+    if (error != kThreadError_None)
+    {
+        nextRequest->Free();
+
+        if (aRequestMetadata.mResponseHandler != NULL)
+        {
+            aRequestMetadata.mResponseHandler(aRequestMetadata.mResponseContext, NULL, NULL, error);
+        }
     }
 
 exit:
-    return message;
+    return;
 }
 
-void Client::FinalizeCoapTransaction(Message &aRequest, const RequestMetadata &aRequestMetadata,
-                                     Header *aResponseHeader, Message *aResponse, ThreadError aResult)
+ThreadError Client::ContinueBlockwiseTransfer(Message &aRequest, const RequestMetadata &aRequestMetadata,
+                                              Header &aResponseHeader, const Message &aResponse,
+                                              Message **aNextRequest)
 {
-    DequeueMessage(aRequest);
+    ThreadError error = kThreadError_None;
+    Header requestHeader;
+    uint32_t number;
+    uint32_t responseNumber;
+    bool more;
+    bool responseMore;
+    Header::BlockSize size;
+    Header::BlockSize responseSize;
 
-    if (aRequestMetadata.mResponseHandler != NULL)
+    SuccessOrExit(error = requestHeader.FromMessage(aRequest, sizeof(RequestMetadata)));
+
+    if (aResponseHeader.GetCode() == kCoapResponseContinue)
     {
-        aRequestMetadata.mResponseHandler(aRequestMetadata.mResponseContext, aResponseHeader,
-                                          aResponse, aResult);
+        // The server asks for the next request block.
+        VerifyOrExit(aRequestMetadata.mBlockProducer != NULL &&
+                     requestHeader.GetBlockOption(kCoapOptionBlock1, number, more, size) == kThreadError_None &&
+                     more, error = kThreadError_Parse);
+
+        number++;
+
+        if (aResponseHeader.GetBlockOption(kCoapOptionBlock1, responseNumber, responseMore,
+                                           responseSize) == kThreadError_None && responseSize < size)
+        {
+            // Continue with the smaller block size preferred by the server (RFC 7959, p. 2.3).
+            number <<= (size - responseSize);
+            size = responseSize;
+        }
+
+        error = NewBlockRequest(requestHeader, kCoapOptionBlock1, number, size, aRequestMetadata.mBlockProducer,
+                                aRequestMetadata.mBlockContext, aNextRequest);
+    }
+    else if (aRequestMetadata.mBlockConsumer != NULL && (aResponseHeader.GetCode() >> 5) == 2)
+    {
+        // Only successful (2.xx) responses carry the response payload.
+        error = aResponseHeader.GetBlockOption(kCoapOptionBlock2, number, more, size);
+
+        if (error == kThreadError_NotFound)
+        {
+            number = 0;
+            more = false;
+            size = kCoapBlockSize16;
+        }
+        else
+        {
+            SuccessOrExit(error);
+        }
+
+        SuccessOrExit(error = aRequestMetadata.mBlockConsumer(aRequestMetadata.mBlockContext, aResponse,
+                                                             number * Header::GetBlockSize(size), more));
+
+        if (more)
+        {
+            error = NewBlockRequest(requestHeader, kCoapOptionBlock2, number + 1, size, NULL, NULL, aNextRequest);
+        }
     }
+
+exit:
+    return error;
 }
 
 void Client::HandleUdpReceive(void *aContext, otMessage aMessage, const otMessageInfo *aMessageInfo)
@@ -405,11 +798,7 @@ void Client::HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessag
         if (responseHeader.IsEmpty())
         {
             // Empty acknowledgment.
-            if (requestMetadata.mConfirmable)
-            {
-                requestMetadata.mAcknowledged = true;
-                requestMetadata.UpdateIn(*message);
-            }
+            HandleAcknowledgment(*message, requestMetadata, true);
 
             // Remove the message if response is not expected, otherwise await response.
             if (requestMetadata.mResponseHandler == NULL)
@@ -420,7 +809,8 @@ void Client::HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessag
         else if (responseHeader.IsResponse() && responseHeader.IsTokenEqual(requestHeader))
         {
             // Piggybacked response.
-            FinalizeCoapTransaction(*message, requestMetadata, &responseHeader, &aMessage, kThreadError_None);
+            HandleAcknowledgment(*message, requestMetadata, true);
+            HandleResponse(*message, requestMetadata, responseHeader, aMessage);
         }
 
         // Silently ignore acknowledgments carrying requests (RFC 7252, p. 4.2)
@@ -435,11 +825,14 @@ void Client::HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessag
             SendEmptyAck(aMessageInfo.GetPeerAddr(), aMessageInfo.mPeerPort, responseHeader.GetMessageId());
         }
 
-        FinalizeCoapTransaction(*message, requestMetadata, &responseHeader, &aMessage, kThreadError_None);
+        HandleResponse(*message, requestMetadata, responseHeader, aMessage);
 
         break;
     }
 
+    // Completed exchanges may have opened congestion windows.
+    SendDeferredRequests();
+
 exit:
 
     if (error == kThreadError_None && message == NULL)
@@ -453,31 +846,306 @@ exit:
 }
 
 RequestMetadata::RequestMetadata(bool aConfirmable, const Ip6::MessageInfo &aMessageInfo,
-                                 otCoapResponseHandler aHandler, void *aContext)
+                                 otCoapResponseHandler aHandler, void *aContext, uint32_t aRetransmissionTimeout)
 {
     mDestinationPort = aMessageInfo.mPeerPort;
     mDestinationAddress = aMessageInfo.GetPeerAddr();
     mResponseHandler = aHandler;
     mResponseContext = aContext;
     mRetransmissionCount = 0;
-    mRetransmissionTimeout = Timer::SecToMsec(kAckTimeout);
+    mAcknowledged = false;
+    mConfirmable = aConfirmable;
+    mDeferred = false;
+    mInFlight = false;
+
+    StartTransmission(aRetransmissionTimeout);
+}
+
+void RequestMetadata::StartTransmission(uint32_t aRetransmissionTimeout)
+{
+    // Randomize the initial timeout within [RTO, RTO * ACK_RANDOM_FACTOR] (RFC 7252, p. 4.2).
+    mRetransmissionTimeout = aRetransmissionTimeout;
     mRetransmissionTimeout += otPlatRandomGet() %
-                              (Timer::SecToMsec(kAckTimeout) * kAckRandomFactorNumerator / kAckRandomFactorDenominator -
-                               Timer::SecToMsec(kAckTimeout) + 1);
+                              (aRetransmissionTimeout * kAckRandomFactorNumerator / kAckRandomFactorDenominator -
+                               aRetransmissionTimeout + 1);
+    mBackoffFactor = PeerState::GetBackoffFactor(aRetransmissionTimeout);
+    mTransmitTime = Timer::GetNow();
 
-    if (aConfirmable)
+    if (mConfirmable)
     {
         // Set next retransmission timeout.
-        mNextTimerShot = Timer::GetNow() + mRetransmissionTimeout;
+        mNextTimerShot = mTransmitTime + mRetransmissionTimeout;
     }
     else
     {
         // Set overall response timeout.
-        mNextTimerShot = Timer::GetNow() + kMaxTransmitWait;
+        mNextTimerShot = mTransmitTime + Timer::SecToMsec(kMaxTransmitWait);
+    }
+}
+
+void PeerState::Init(const Ip6::Address &aAddress, uint32_t aNow)
+{
+    mAddress = aAddress;
+    mStrong.mValid = false;
+    mWeak.mValid = false;
+    mTimeout = kDefaultRetransmissionTimeout;
+    mLastUpdate = aNow;
+    mLastUsed = aNow;
+    mOutstanding = 0;
+    mDeferred = 0;
+    mCongestionWindow = kNStart;
+    mValid = true;
+}
+
+uint32_t PeerState::GetRetransmissionTimeout(uint32_t aNow)
+{
+    uint32_t elapsed = aNow - mLastUpdate;
+
+    // Age estimates that have not been updated recently (draft-ietf-core-cocoa, 4.3).
+    if (mTimeout < kSmallRetransmissionTimeout && elapsed > 16 * mTimeout)
+    {
+        mTimeout = Clamp(2 * mTimeout);
+        mLastUpdate = aNow;
+    }
+    else if (mTimeout > kLargeRetransmissionTimeout && elapsed > 4 * mTimeout)
+    {
+        mTimeout = Clamp((kDefaultRetransmissionTimeout + mTimeout) / 2);
+        mLastUpdate = aNow;
     }
 
-    mAcknowledged = false;
-    mConfirmable = aConfirmable;
+    return mTimeout;
+}
+
+void PeerState::UpdateRtt(uint32_t aRtt, uint8_t aRetransmissions, uint32_t aNow)
+{
+    if (aRetransmissions == 0)
+    {
+        mStrong.Update(aRtt, 4);
+        mTimeout = (mStrong.mTimeout + mTimeout) / 2;
+    }
+    else if (aRetransmissions <= kMaxWeakRetransmissions)
+    {
+        mWeak.Update(aRtt, 1);
+        mTimeout = (mWeak.mTimeout + 3 * mTimeout) / 4;
+    }
+    else
+    {
+        ExitNow();
+    }
+
+    mTimeout = Clamp(mTimeout);
+    mLastUpdate = aNow;
+
+exit:
+    return;
+}
+
+uint8_t PeerState::GetBackoffFactor(uint32_t aRetransmissionTimeout)
+{
+    uint8_t factor = 2 * kBackoffFactorDenominator;
+
+    if (aRetransmissionTimeout < kSmallRetransmissionTimeout)
+    {
+        factor = 3 * kBackoffFactorDenominator;
+    }
+    else if (aRetransmissionTimeout > kLargeRetransmissionTimeout)
+    {
+        factor = 3 * kBackoffFactorDenominator / 2;
+    }
+
+    return factor;
+}
+
+uint32_t PeerState::Clamp(uint32_t aTimeout)
+{
+    if (aTimeout < kMinRetransmissionTimeout)
+    {
+        aTimeout = kMinRetransmissionTimeout;
+    }
+    else if (aTimeout > kMaxRetransmissionTimeout)
+    {
+        aTimeout = kMaxRetransmissionTimeout;
+    }
+
+    return aTimeout;
+}
+
+void PeerState::Estimator::Update(uint32_t aRtt, uint8_t aK)
+{
+    uint32_t delta;
+
+    if (!mValid)
+    {
+        mSmoothedRtt = aRtt;
+        mRttVariation = aRtt / 2;
+        mValid = true;
+    }
+    else
+    {
+        // RFC 6298 with alpha = 1/8 and beta = 1/4.
+        delta = (mSmoothedRtt > aRtt) ? (mSmoothedRtt - aRtt) : (aRtt - mSmoothedRtt);
+        mRttVariation = (3 * mRttVariation + delta) / 4;
+        mSmoothedRtt = (7 * mSmoothedRtt + aRtt) / 8;
+    }
+
+    mTimeout = mSmoothedRtt + aK * mRttVariation;
+}
+
+RequestIndex::RequestIndex(void)
+{
+    for (uint8_t i = 0; i < kMaxEntries; i++)
+    {
+        mEntries[i].mMessage = NULL;
+        mEntries[i].mNextById = (i + 1 < kMaxEntries) ? i + 1 : static_cast<uint8_t>(kInvalidIndex);
+        mEntries[i].mNextByToken = kInvalidIndex;
+    }
+
+    memset(mIdBuckets, kInvalidIndex, sizeof(mIdBuckets));
+    memset(mTokenBuckets, kInvalidIndex, sizeof(mTokenBuckets));
+    mFreeList = 0;
+    mNumUnindexed = 0;
+}
+
+uint16_t RequestIndex::HashToken(const uint8_t *aToken, uint8_t aTokenLength)
+{
+    uint16_t hash = 0;
+
+    for (uint8_t i = 0; i < aTokenLength; i++)
+    {
+        hash = static_cast<uint16_t>((hash << 5) + hash + aToken[i]);
+    }
+
+    return hash;
+}
+
+bool RequestIndex::IsRelated(const Message &aRequest, const Header &aResponseHeader,
+                             const Ip6::MessageInfo &aMessageInfo, Header &aRequestHeader,
+                             RequestMetadata &aRequestMetadata)
+{
+    bool rval = false;
+
+    aRequestMetadata.ReadFrom(aRequest);
+
+    VerifyOrExit(aRequestMetadata.mDestinationAddress == aMessageInfo.GetPeerAddr() &&
+                 aRequestMetadata.mDestinationPort == aMessageInfo.mPeerPort, ;);
+    SuccessOrExit(aRequestHeader.FromMessage(aRequest, sizeof(RequestMetadata)));
+
+    if (aResponseHeader.IsAck() || aResponseHeader.IsReset())
+    {
+        rval = (aResponseHeader.GetMessageId() == aRequestHeader.GetMessageId());
+    }
+    else
+    {
+        rval = aResponseHeader.IsTokenEqual(aRequestHeader);
+    }
+
+exit:
+    return rval;
+}
+
+void RequestIndex::Add(Message &aMessage, const Header &aHeader)
+{
+    uint8_t index = mFreeList;
+    Entry *entry;
+
+    VerifyOrExit(index != kInvalidIndex, mNumUnindexed++);
+
+    entry = &mEntries[index];
+    mFreeList = entry->mNextById;
+
+    entry->mMessage = &aMessage;
+    entry->mMessageId = aHeader.GetMessageId();
+    entry->mTokenHash = HashToken(aHeader.GetToken(), aHeader.GetTokenLength());
+
+    entry->mNextById = mIdBuckets[GetBucket(entry->mMessageId)];
+    mIdBuckets[GetBucket(entry->mMessageId)] = index;
+
+    entry->mNextByToken = mTokenBuckets[GetBucket(entry->mTokenHash)];
+    mTokenBuckets[GetBucket(entry->mTokenHash)] = index;
+
+exit:
+    return;
+}
+
+void RequestIndex::Unlink(uint8_t &aHead, uint8_t aIndex, uint8_t Entry::*aNext)
+{
+    for (uint8_t *cur = &aHead; *cur != kInvalidIndex; cur = &(mEntries[*cur].*aNext))
+    {
+        if (*cur == aIndex)
+        {
+            *cur = mEntries[aIndex].*aNext;
+            break;
+        }
+    }
+}
+
+void RequestIndex::Remove(const Message &aMessage)
+{
+    Header header;
+    uint8_t index;
+
+    // The Message ID is part of the fixed-size header, no need to parse options.
+    aMessage.Read(0, Header::kMinHeaderLength, header.mHeader.mBytes);
+
+    for (index = mIdBuckets[GetBucket(header.GetMessageId())]; index != kInvalidIndex;
+         index = mEntries[index].mNextById)
+    {
+        if (mEntries[index].mMessage == &aMessage)
+        {
+            break;
+        }
+    }
+
+    // a request missing from the index was added while it was full
+    VerifyOrExit(index != kInvalidIndex, mNumUnindexed--);
+
+    Unlink(mIdBuckets[GetBucket(mEntries[index].mMessageId)], index, &Entry::mNextById);
+    Unlink(mTokenBuckets[GetBucket(mEntries[index].mTokenHash)], index, &Entry::mNextByToken);
+
+    mEntries[index].mMessage = NULL;
+    mEntries[index].mNextById = mFreeList;
+    mEntries[index].mNextByToken = kInvalidIndex;
+    mFreeList = index;
+
+exit:
+    return;
+}
+
+Message *RequestIndex::Find(const Header &aResponseHeader, const Ip6::MessageInfo &aMessageInfo,
+                            const MessageQueue &aPendingRequests, Header &aRequestHeader,
+                            RequestMetadata &aRequestMetadata) const
+{
+    bool byMessageId = (aResponseHeader.IsAck() || aResponseHeader.IsReset());
+    uint16_t key = byMessageId ? aResponseHeader.GetMessageId() :
+                   HashToken(aResponseHeader.GetToken(), aResponseHeader.GetTokenLength());
+    uint8_t index = byMessageId ? mIdBuckets[GetBucket(key)] : mTokenBuckets[GetBucket(key)];
+    Message *message = NULL;
+
+    while (index != kInvalidIndex)
+    {
+        const Entry &entry = mEntries[index];
+
+        if ((byMessageId ? entry.mMessageId : entry.mTokenHash) == key &&
+            IsRelated(*entry.mMessage, aResponseHeader, aMessageInfo, aRequestHeader, aRequestMetadata))
+        {
+            ExitNow(message = entry.mMessage);
+        }
+
+        index = byMessageId ? entry.mNextById : entry.mNextByToken;
+    }
+
+    VerifyOrExit(mNumUnindexed > 0, ;);
+
+    for (message = aPendingRequests.GetHead(); message != NULL; message = message->GetNext())
+    {
+        if (IsRelated(*message, aResponseHeader, aMessageInfo, aRequestHeader, aRequestMetadata))
+        {
+            break;
+        }
+    }
+
+exit:
+    return message;
 }
 
 }  // namespace Coap
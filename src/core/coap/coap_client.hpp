@@ -31,8 +31,10 @@
 
 #include <openthread-types.h>
 #include <openthread-coap.h>
+#include <openthread-core-config.h>
 #include <coap/coap_header.hpp>
 #include <common/message.hpp>
+#include <common/perf_counters.hpp>
 #include <common/timer.hpp>
 #include <net/netif.hpp>
 #include <net/udp6.hpp>
@@ -46,6 +48,7 @@ namespace Thread {
 namespace Coap {
 
 class Client;
+class RequestIndex;
 
 /**
  * Protocol Constants (RFC 7252).
@@ -57,7 +60,7 @@ enum
     kAckRandomFactorNumerator   = OPENTHREAD_CONFIG_COAP_ACK_RANDOM_FACTOR_NUMERATOR,
     kAckRandomFactorDenominator = OPENTHREAD_CONFIG_COAP_ACK_RANDOM_FACTOR_DENOMINATOR,
     kMaxRetransmit              = OPENTHREAD_CONFIG_COAP_MAX_RETRANSMIT,
-    kNStart                     = 1,
+    kNStart                     = OPENTHREAD_CONFIG_COAP_NSTART,
     kDefaultLeisure             = 5,
     kProbingRate                = 1,
 
@@ -73,6 +76,125 @@ enum
     kNonLifetime                = kMaxTransmitSpan + kMaxLatency
 };
 
+/**
+ * Congestion Control Constants (draft-ietf-core-cocoa).
+ *
+ */
+enum
+{
+    kDefaultRetransmissionTimeout = kAckTimeout * 1000u, ///< RTO used before any RTT sample (milliseconds).
+    kMinRetransmissionTimeout     = 250,                 ///< Lower bound for the RTO (milliseconds).
+    kMaxRetransmissionTimeout     = 32000,               ///< Upper bound for the RTO (milliseconds).
+    kSmallRetransmissionTimeout   = 1000,                ///< Below this RTO the backoff factor is 3 (milliseconds).
+    kLargeRetransmissionTimeout   = 3000,                ///< Above this RTO the backoff factor is 1.5 (milliseconds).
+    kMaxWeakRetransmissions       = 2,                   ///< Maximum retransmissions for a weak RTT sample.
+    kBackoffFactorDenominator     = 2,                   ///< Denominator of the variable backoff factor.
+    kMaxCongestionWindow          = OPENTHREAD_CONFIG_COAP_MAX_CONGESTION_WINDOW,
+};
+
+/**
+ * This class implements the per-destination RTT estimator and congestion window (draft-ietf-core-cocoa).
+ *
+ */
+class PeerState
+{
+    friend class Client;
+
+public:
+    /**
+     * This method initializes the state for a new destination.
+     *
+     * @param[in]  aAddress  The destination IPv6 address.
+     * @param[in]  aNow      The current time.
+     *
+     */
+    void Init(const Ip6::Address &aAddress, uint32_t aNow);
+
+    /**
+     * This method indicates whether the state is assigned to a destination.
+     *
+     * @retval TRUE   If the state is in use.
+     * @retval FALSE  If the state is free.
+     *
+     */
+    bool IsValid(void) const { return mValid; }
+
+    /**
+     * This method indicates whether the state may be reassigned to another destination.
+     *
+     * @retval TRUE   If no requests to the destination are outstanding or deferred.
+     * @retval FALSE  If requests to the destination are outstanding or deferred.
+     *
+     */
+    bool IsIdle(void) const { return (mOutstanding == 0 && mDeferred == 0); }
+
+    /**
+     * This method indicates whether another request may be sent to the destination.
+     *
+     * @retval TRUE   If the number of outstanding requests is below the congestion window.
+     * @retval FALSE  If the congestion window is full.
+     *
+     */
+    bool CanSend(void) const { return (mOutstanding < mCongestionWindow); }
+
+    /**
+     * This method returns the current retransmission timeout, applying RTO aging (draft-ietf-core-cocoa, 4.3).
+     *
+     * @param[in]  aNow  The current time.
+     *
+     * @returns The retransmission timeout in milliseconds.
+     *
+     */
+    uint32_t GetRetransmissionTimeout(uint32_t aNow);
+
+    /**
+     * This method updates the RTT estimators with a new sample.
+     *
+     * Samples from exchanges without retransmissions feed the strong estimator, samples from exchanges with up to
+     * @c kMaxWeakRetransmissions retransmissions feed the weak estimator, and other samples are discarded.
+     *
+     * @param[in]  aRtt              The measured round-trip time in milliseconds.
+     * @param[in]  aRetransmissions  The number of retransmissions of the request.
+     * @param[in]  aNow              The current time.
+     *
+     */
+    void UpdateRtt(uint32_t aRtt, uint8_t aRetransmissions, uint32_t aNow);
+
+    /**
+     * This method returns the numerator of the variable backoff factor for the given initial RTO.
+     *
+     * @param[in]  aRetransmissionTimeout  The initial retransmission timeout in milliseconds.
+     *
+     * @returns The numerator of the backoff factor, relative to @c kBackoffFactorDenominator.
+     *
+     */
+    static uint8_t GetBackoffFactor(uint32_t aRetransmissionTimeout);
+
+private:
+    struct Estimator
+    {
+        void Update(uint32_t aRtt, uint8_t aK);
+
+        uint32_t mSmoothedRtt;      ///< Smoothed RTT (milliseconds).
+        uint32_t mRttVariation;     ///< RTT variation (milliseconds).
+        uint32_t mTimeout;          ///< RTO computed from this estimator (milliseconds).
+        bool     mValid;            ///< Whether any sample has been taken.
+    };
+
+    static uint32_t Clamp(uint32_t aTimeout);
+
+    Ip6::Address mAddress;          ///< IPv6 address of the destination.
+    Estimator    mStrong;           ///< Estimator fed by exchanges without retransmissions.
+    Estimator    mWeak;             ///< Estimator fed by exchanges with retransmissions.
+    uint32_t     mTimeout;          ///< Overall RTO (milliseconds).
+    uint32_t     mLastUpdate;       ///< Time of the last RTO update.
+    uint32_t     mLastUsed;         ///< Time the state was last used, for replacement.
+    uint8_t      mOutstanding;      ///< Number of Confirmable requests awaiting an acknowledgment.
+    uint8_t      mDeferred;         ///< Number of Confirmable requests waiting for the congestion window.
+    uint8_t      mCongestionWindow; ///< Maximum number of outstanding Confirmable requests.
+    bool         mValid;            ///< Whether the state is assigned to a destination.
+};
+
 /**
  * This class implements metadata required for CoAP retransmission.
  *
@@ -81,6 +203,7 @@ OT_TOOL_PACKED_BEGIN
 class RequestMetadata
 {
     friend class Client;
+    friend class RequestIndex;
 
 public:
 
@@ -92,23 +215,39 @@ public:
         mDestinationPort(0),
         mResponseHandler(NULL),
         mResponseContext(NULL),
+        mBlockProducer(NULL),
+        mBlockConsumer(NULL),
+        mBlockContext(NULL),
         mNextTimerShot(0),
         mRetransmissionTimeout(0),
+        mTransmitTime(0),
         mRetransmissionCount(0),
+        mBackoffFactor(0),
         mAcknowledged(false),
-        mConfirmable(false) {};
+        mConfirmable(false),
+        mDeferred(false),
+        mInFlight(false) {};
 
     /**
      * This constructor initializes the object with specific values.
      *
-     * @param[in]  aConfirmable  Information if the request is confirmable or not.
-     * @param[in]  aMessageInfo  Addressing information.
-     * @param[in]  aHandler      Pointer to a handler function for the response.
-     * @param[in]  aContext      Context for the handler function.
+     * @param[in]  aConfirmable            Information if the request is confirmable or not.
+     * @param[in]  aMessageInfo            Addressing information.
+     * @param[in]  aHandler                Pointer to a handler function for the response.
+     * @param[in]  aContext                Context for the handler function.
+     * @param[in]  aRetransmissionTimeout  The estimated RTO for the destination (milliseconds).
      *
      */
     RequestMetadata(bool aConfirmable, const Ip6::MessageInfo &aMessageInfo,
-                    otCoapResponseHandler aHandler, void *aContext);
+                    otCoapResponseHandler aHandler, void *aContext, uint32_t aRetransmissionTimeout);
+
+    /**
+     * This method (re)starts the retransmission timing when the request is first transmitted.
+     *
+     * @param[in]  aRetransmissionTimeout  The estimated RTO for the destination (milliseconds).
+     *
+     */
+    void StartTransmission(uint32_t aRetransmissionTimeout);
 
     /**
      * This method appends request data to the message.
@@ -173,13 +312,111 @@ private:
     uint16_t              mDestinationPort;       ///< UDP port of the message destination.
     otCoapResponseHandler mResponseHandler;       ///< A function pointer that is called on response reception.
     void                  *mResponseContext;      ///< A pointer to arbitrary context information.
+    BlockProducer         mBlockProducer;         ///< A function pointer that generates the request blocks.
+    BlockConsumer         mBlockConsumer;         ///< A function pointer that processes the response blocks.
+    void                  *mBlockContext;         ///< A pointer to context information for the block handlers.
     uint32_t              mNextTimerShot;         ///< Time when the timer should shoot for this message.
     uint32_t              mRetransmissionTimeout; ///< Delay that is applied to next retransmission.
+    uint32_t              mTransmitTime;          ///< Time of the first transmission, for RTT measurement.
     uint8_t               mRetransmissionCount;   ///< Number of retransmissions.
+    uint8_t               mBackoffFactor;         ///< Numerator of the variable backoff factor.
     bool                  mAcknowledged: 1;       ///< Information that request was acknowledged.
     bool                  mConfirmable: 1;        ///< Information that message is confirmable.
+    bool                  mDeferred: 1;           ///< Information that request waits for the congestion window.
+    bool                  mInFlight: 1;           ///< Information that request counts against the congestion window.
 } OT_TOOL_PACKED_END;
 
+/**
+ * This class implements an index of pending requests by Message ID and token.
+ *
+ * The index holds up to OPENTHREAD_CONFIG_COAP_CLIENT_REQUEST_INDEX_SIZE requests.  Requests added beyond that are
+ * only counted, and are found by searching the list of pending requests as before.
+ *
+ */
+class RequestIndex
+{
+public:
+    /**
+     * This constructor initializes the object.
+     *
+     */
+    RequestIndex(void);
+
+    /**
+     * This method adds a pending request to the index.
+     *
+     * If the index is full, the request is only counted and is found by searching the pending list.
+     *
+     * @param[in]  aMessage  A reference to the pending request.
+     * @param[in]  aHeader   A reference to the CoAP header of @p aMessage.
+     *
+     */
+    void Add(Message &aMessage, const Header &aHeader);
+
+    /**
+     * This method removes a pending request from the index.
+     *
+     * @param[in]  aMessage  A reference to the pending request.
+     *
+     */
+    void Remove(const Message &aMessage);
+
+    /**
+     * This method finds the pending request a received message relates to.
+     *
+     * Acknowledgment and Reset messages are matched by Message ID, other messages are matched by token.
+     *
+     * @param[in]   aResponseHeader   A reference to the received CoAP header.
+     * @param[in]   aMessageInfo      A reference to the message info of the received message.
+     * @param[in]   aPendingRequests  A reference to the queue of all pending requests.
+     * @param[out]  aRequestHeader    The CoAP header of the matched request.
+     * @param[out]  aRequestMetadata  The metadata of the matched request.
+     *
+     * @returns A pointer to the matched request or NULL if none was found.
+     *
+     */
+    Message *Find(const Header &aResponseHeader, const Ip6::MessageInfo &aMessageInfo,
+                  const MessageQueue &aPendingRequests, Header &aRequestHeader,
+                  RequestMetadata &aRequestMetadata) const;
+
+    /**
+     * This method returns the number of pending requests that did not fit in the index.
+     *
+     * @returns The number of pending requests that are not indexed.
+     *
+     */
+    uint16_t GetNumUnindexed(void) const { return mNumUnindexed; }
+
+private:
+    enum
+    {
+        kMaxEntries = OPENTHREAD_CONFIG_COAP_CLIENT_REQUEST_INDEX_SIZE,
+        kNumBuckets = 8,     ///< Number of hash buckets (must be a power of two).
+        kInvalidIndex = 0xff,
+    };
+
+    struct Entry
+    {
+        Message *mMessage;
+        uint16_t mMessageId;
+        uint16_t mTokenHash;
+        uint8_t  mNextById;
+        uint8_t  mNextByToken;
+    };
+
+    static uint16_t HashToken(const uint8_t *aToken, uint8_t aTokenLength);
+    static bool IsRelated(const Message &aRequest, const Header &aResponseHeader, const Ip6::MessageInfo &aMessageInfo,
+                          Header &aRequestHeader, RequestMetadata &aRequestMetadata);
+    static uint8_t GetBucket(uint16_t aKey) { return aKey & (kNumBuckets - 1); }
+    void Unlink(uint8_t &aHead, uint8_t aIndex, uint8_t Entry::*aNext);
+
+    Entry mEntries[kMaxEntries];
+    uint8_t mIdBuckets[kNumBuckets];
+    uint8_t mTokenBuckets[kNumBuckets];
+    uint8_t mFreeList;
+    uint16_t mNumUnindexed;
+};
+
 /**
  * This class implements CoAP client.
  *
@@ -241,8 +478,45 @@ public:
     ThreadError SendMessage(Message &aMessage, const Ip6::MessageInfo &aMessageInfo,
                             otCoapResponseHandler aHandler = NULL, void *aContext = NULL);
 
+    /**
+     * This method sends a Confirmable CoAP request whose payloads are transferred block-wise (RFC 7959).
+     *
+     * @p aMessage carries the request header and options but no payload. The request payload is generated block by
+     * block with @p aProducer and sent using Block1 options, and the response payload is passed block by block to
+     * @p aConsumer, requesting further blocks using Block2 options. A response without a Block2 option is passed to
+     * @p aConsumer as a single block. @p aHandler is called once with the final response, or on failure.
+     *
+     * @param[in]  aMessage       A reference to the message to send, which is freed on success.
+     * @param[in]  aMessageInfo   A reference to the message info associated with @p aMessage.
+     * @param[in]  aProducer      A function pointer that generates the request payload, or NULL.
+     * @param[in]  aConsumer      A function pointer that processes the response payload, or NULL.
+     * @param[in]  aBlockContext  A pointer to arbitrary context information for @p aProducer and @p aConsumer.
+     * @param[in]  aHandler       A function pointer that shall be called on response reception or time-out.
+     * @param[in]  aContext       A pointer to arbitrary context information.
+     *
+     * @retval kThreadError_None         Successfully sent the first block.
+     * @retval kThreadError_InvalidArgs  @p aMessage is not a Confirmable request without payload.
+     * @retval kThreadError_NoBufs       Failed to allocate the first block or retransmission data.
+     *
+     */
+    ThreadError SendBlockwiseRequest(Message &aMessage, const Ip6::MessageInfo &aMessageInfo,
+                                     BlockProducer aProducer, BlockConsumer aConsumer, void *aBlockContext,
+                                     otCoapResponseHandler aHandler = NULL, void *aContext = NULL);
+
 private:
-    Message *CopyAndEnqueueMessage(const Message &aMessage, uint16_t aCopyLength,
+    ThreadError SendMessage(Message &aMessage, const Ip6::MessageInfo &aMessageInfo,
+                            otCoapResponseHandler aHandler, void *aContext,
+                            BlockProducer aProducer, BlockConsumer aConsumer, void *aBlockContext);
+    ThreadError NewBlockRequest(Header &aRequestHeader, Header::Option::Type aType, uint32_t aNumber,
+                                Header::BlockSize aSize, BlockProducer aProducer, void *aBlockContext,
+                                Message **aMessage);
+    ThreadError ContinueBlockwiseTransfer(Message &aRequest, const RequestMetadata &aRequestMetadata,
+                                          Header &aResponseHeader, const Message &aResponse,
+                                          Message **aNextRequest);
+    void HandleResponse(Message &aRequest, const RequestMetadata &aRequestMetadata,
+                        Header &aResponseHeader, Message &aResponse);
+
+    Message *CopyAndEnqueueMessage(const Message &aMessage, uint16_t aCopyLength, const Header &aHeader,
                                    const RequestMetadata &aRequestMetadata);
     void DequeueMessage(Message &aMessage);
     Message *FindRelatedRequest(const Header &aResponseHeader, const Ip6::MessageInfo &aMessageInfo,
@@ -250,6 +524,12 @@ private:
     void FinalizeCoapTransaction(Message &aRequest, const RequestMetadata &aRequestMetadata,
                                  Header *aResponseHeader, Message *aResponse, ThreadError aResult);
 
+    PeerState *GetPeerState(const Ip6::Address &aAddress, bool aAllocate);
+    void HandleAcknowledgment(Message &aMessage, RequestMetadata &aRequestMetadata, bool aSampleRtt);
+    void ReleaseCongestionWindow(RequestMetadata &aRequestMetadata);
+    void SendDeferredRequests(void);
+    void StartRetransmissionTimer(uint32_t aDelay);
+
     ThreadError SendCopy(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
     void SendEmptyMessage(const Ip6::Address &aAddress, uint16_t aPort, uint16_t aMessageId, Header::Type aType);
     void SendReset(const Ip6::Address &aAddress, uint16_t aPort, uint16_t aMessageId) {
@@ -265,10 +545,22 @@ private:
     static void HandleUdpReceive(void *aContext, otMessage aMessage, const otMessageInfo *aMessageInfo);
     void HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
 
+    enum
+    {
+        kMaxPeers = OPENTHREAD_CONFIG_COAP_CLIENT_MAX_PEERS,
+        kBlockSize = OPENTHREAD_CONFIG_COAP_BLOCK_SIZE,
+        kMaxBlockOverhead = 5,    ///< Maximum size of a Block option and the Payload Marker.
+    };
+
     Ip6::UdpSocket mSocket;
     MessageQueue mPendingRequests;
+    RequestIndex mRequestIndex;
+    PeerState mPeers[kMaxPeers];
     uint16_t mMessageId;
     Timer mRetransmissionTimer;
+#if OPENTHREAD_ENABLE_PERF_COUNTERS
+    PerfCounters &mPerfCounters;
+#endif
 };
 
 }  // namespace Coap
@@ -57,7 +57,7 @@ void Header::Init(Type aType, Code aCode)
     SetCode(aCode);
 }
 
-ThreadError Header::FromMessage(const Message &aMessage)
+ThreadError Header::FromMessage(const Message &aMessage, uint16_t aMetadataSize)
 {
     ThreadError error = kThreadError_Parse;
     uint16_t offset = aMessage.GetOffset();
@@ -67,7 +67,12 @@ ThreadError Header::FromMessage(const Message &aMessage)
     uint16_t optionDelta;
     uint16_t optionLength;
 
-    VerifyOrExit(length >= kTokenOffset, error = kThreadError_Parse);
+    memset(&mOption, 0, sizeof(mOption));
+    mNextOptionOffset = 0;
+    mOptionLast = 0;
+
+    VerifyOrExit(length >= kTokenOffset + aMetadataSize, error = kThreadError_Parse);
+    length -= aMetadataSize;
     aMessage.Read(offset, kTokenOffset, mHeader.mBytes);
     mHeaderLength = kTokenOffset;
     offset += kTokenOffset;
@@ -155,7 +160,8 @@ ThreadError Header::FromMessage(const Message &aMessage)
             firstOption = false;
         }
 
-        VerifyOrExit(optionLength <= length, error = kThreadError_Parse);
+        VerifyOrExit(optionLength <= length && mHeaderLength + optionLength <= kMaxHeaderLength,
+                     error = kThreadError_Parse);
         aMessage.Read(offset, optionLength, mHeader.mBytes + mHeaderLength);
         mHeaderLength += static_cast<uint8_t>(optionLength);
         offset += optionLength;
@@ -275,9 +281,77 @@ ThreadError Header::AppendContentFormatOption(MediaType aType)
     return AppendOption(coapOption);
 }
 
+ThreadError Header::AppendBlockOption(Option::Type aType, uint32_t aNumber, bool aMore, BlockSize aSize)
+{
+    ThreadError error = kThreadError_None;
+    uint32_t value;
+    uint8_t buf[kMaxBlockOptionLength];
+    Option coapOption;
+
+    VerifyOrExit(aNumber <= kMaxBlockNumber && aSize <= kCoapBlockSize1024, error = kThreadError_InvalidArgs);
+
+    value = (aNumber << kBlockNumberOffset) | (aMore ? kBlockMoreFlag : 0) | aSize;
+
+    // Use the shortest encoding of the value (RFC 7252, p. 3.2).
+    coapOption.mNumber = aType;
+    coapOption.mLength = (value == 0) ? 0 : (value <= 0xff) ? 1 : (value <= 0xffff) ? 2 : 3;
+
+    for (uint16_t i = 0; i < coapOption.mLength; i++)
+    {
+        buf[i] = static_cast<uint8_t>(value >> (8 * (coapOption.mLength - 1 - i)));
+    }
+
+    coapOption.mValue = buf;
+    error = AppendOption(coapOption);
+
+exit:
+    return error;
+}
+
+ThreadError Header::GetBlockOption(Option::Type aType, uint32_t &aNumber, bool &aMore, BlockSize &aSize)
+{
+    ThreadError error = kThreadError_NotFound;
+    const Option *coapOption;
+    uint32_t value = 0;
+
+    for (coapOption = GetFirstOption(); coapOption != NULL && coapOption->mNumber <= aType;
+         coapOption = GetNextOption())
+    {
+        if (coapOption->mNumber != aType)
+        {
+            continue;
+        }
+
+        VerifyOrExit(coapOption->mLength <= kMaxBlockOptionLength, error = kThreadError_Parse);
+
+        for (uint16_t i = 0; i < coapOption->mLength; i++)
+        {
+            value = (value << 8) | coapOption->mValue[i];
+        }
+
+        VerifyOrExit((value & kBlockSizeMask) <= kCoapBlockSize1024, error = kThreadError_Parse);
+
+        aNumber = value >> kBlockNumberOffset;
+        aMore = (value & kBlockMoreFlag) != 0;
+        aSize = static_cast<BlockSize>(value & kBlockSizeMask);
+        ExitNow(error = kThreadError_None);
+    }
+
+exit:
+    return error;
+}
+
 const Header::Option *Header::GetCurrentOption(void) const
 {
-    return static_cast<const Header::Option *>(&mOption);
+    return (mOption.mNumber != 0) ? static_cast<const Header::Option *>(&mOption) : NULL;
+}
+
+const Header::Option *Header::GetFirstOption(void)
+{
+    mOption.mNumber = 0;
+    mNextOptionOffset = kTokenOffset + GetTokenLength();
+
+    return GetNextOption();
 }
 
 const Header::Option *Header::GetNextOption(void)
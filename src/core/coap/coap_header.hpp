@@ -112,13 +112,14 @@ public:
     /**
      * This method parses the CoAP header from a message.
      *
-     * @param[in]  aMessage  A reference to the message.
+     * @param[in]  aMessage       A reference to the message.
+     * @param[in]  aMetadataSize  The number of metadata bytes appended to the end of the message.
      *
      * @retval kThreadError_None   Successfully parsed the message.
      * @retval kThreadError_Parse  Failed to parse the message.
      *
      */
-    ThreadError FromMessage(const Message &aMessage);
+    ThreadError FromMessage(const Message &aMessage, uint16_t aMetadataSize = 0);
 
     /**
      * This method returns the Version value.
@@ -309,14 +310,70 @@ public:
      */
     ThreadError AppendContentFormatOption(MediaType aType);
 
+    /**
+     * Block Size Exponents
+     *
+     */
+    typedef otCoapBlockSize BlockSize;
+
+    /**
+     * This method appends a Block1 or Block2 option (RFC 7959).
+     *
+     * @param[in]  aType    The option type, either @c kCoapOptionBlock1 or @c kCoapOptionBlock2.
+     * @param[in]  aNumber  The block number.
+     * @param[in]  aMore    TRUE if more blocks follow, FALSE otherwise.
+     * @param[in]  aSize    The block size exponent.
+     *
+     * @retval kThreadError_None         Successfully appended the option.
+     * @retval kThreadError_InvalidArgs  The option type is not equal or greater than the last option type.
+     * @retval kThreadError_NoBufs       The option length exceeds the buffer size.
+     *
+     */
+    ThreadError AppendBlockOption(Option::Type aType, uint32_t aNumber, bool aMore, BlockSize aSize);
+
+    /**
+     * This method searches the header for a Block1 or Block2 option and decodes its value (RFC 7959).
+     *
+     * This method restarts the option iteration of the header.
+     *
+     * @param[in]   aType    The option type, either @c kCoapOptionBlock1 or @c kCoapOptionBlock2.
+     * @param[out]  aNumber  The block number.
+     * @param[out]  aMore    TRUE if more blocks follow, FALSE otherwise.
+     * @param[out]  aSize    The block size exponent.
+     *
+     * @retval kThreadError_None      Successfully decoded the option.
+     * @retval kThreadError_NotFound  The header does not contain the option.
+     * @retval kThreadError_Parse     The option value is malformed.
+     *
+     */
+    ThreadError GetBlockOption(Option::Type aType, uint32_t &aNumber, bool &aMore, BlockSize &aSize);
+
+    /**
+     * This static method returns the number of bytes in a block of the given size exponent.
+     *
+     * @param[in]  aSize  The block size exponent.
+     *
+     * @returns The block size in bytes.
+     *
+     */
+    static uint16_t GetBlockSize(BlockSize aSize) { return static_cast<uint16_t>(16 << aSize); }
+
     /**
      * This method returns a pointer to the current option.
      *
-     * @returns A pointer to the current option.
+     * @returns A pointer to the current option, or NULL if the header has no options.
      *
      */
     const Option *GetCurrentOption(void) const;
 
+    /**
+     * This method restarts the option iteration and returns a pointer to the first option.
+     *
+     * @returns A pointer to the first option, or NULL if the header has no options.
+     *
+     */
+    const Option *GetFirstOption(void);
+
     /**
      * This method returns a pointer to the next option.
      *
@@ -446,8 +503,57 @@ private:
         kOption1ByteExtensionOffset = 13,    ///< Delta/Length offset as specified (RFC 7252).
         kOption2ByteExtensionOffset = 269,   ///< Delta/Length offset as specified (RFC 7252).
     };
+
+    /**
+     * Block Option Constants (RFC 7959).
+     *
+     */
+    enum
+    {
+        kBlockSizeMask              = 0x07,  ///< SZX mask as specified (RFC 7959).
+        kBlockMoreFlag              = 0x08,  ///< M flag as specified (RFC 7959).
+        kBlockNumberOffset          = 4,     ///< NUM offset as specified (RFC 7959).
+        kMaxBlockOptionLength       = 3,     ///< Max Block option length as specified (RFC 7959).
+        kMaxBlockNumber             = (1 << 20) - 1,  ///< Max NUM value as specified (RFC 7959).
+    };
 };
 
+/**
+ * This function pointer is called to generate the next block of a block-wise transfer.
+ *
+ * The function appends the payload bytes starting at @p aPosition to @p aMessage. It must append exactly
+ * @p aLength bytes unless the payload ends within the block, in which case it appends the remaining bytes and sets
+ * @p aMore to FALSE.
+ *
+ * @param[in]   aContext   A pointer to arbitrary context information.
+ * @param[in]   aMessage   A reference to the message to append the block to.
+ * @param[in]   aPosition  The offset of the block within the whole payload.
+ * @param[in]   aLength    The block size in bytes.
+ * @param[out]  aMore      TRUE if the payload continues after this block, FALSE otherwise.
+ *
+ * @retval kThreadError_None    Successfully appended the block.
+ * @retval kThreadError_NoBufs  Insufficient buffers available to append the block.
+ *
+ */
+typedef ThreadError(*BlockProducer)(void *aContext, Message &aMessage, uint32_t aPosition, uint16_t aLength,
+                                    bool &aMore);
+
+/**
+ * This function pointer is called to process a received block of a block-wise transfer.
+ *
+ * The block spans from the offset of @p aMessage to the end of the message.
+ *
+ * @param[in]  aContext   A pointer to arbitrary context information.
+ * @param[in]  aMessage   A reference to the message carrying the block.
+ * @param[in]  aPosition  The offset of the block within the whole payload.
+ * @param[in]  aMore      TRUE if more blocks follow, FALSE if this is the last block.
+ *
+ * @retval kThreadError_None    Successfully processed the block.
+ * @retval kThreadError_NoBufs  Insufficient resources to store the block, the transfer is aborted.
+ *
+ */
+typedef ThreadError(*BlockConsumer)(void *aContext, const Message &aMessage, uint32_t aPosition, bool aMore);
+
 /**
  * @}
  *
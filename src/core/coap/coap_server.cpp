@@ -31,17 +31,45 @@
  *   This file implements the CoAP server message dispatch.
  */
 
+#include <coap/coap_client.hpp>
 #include <coap/coap_server.hpp>
 #include <common/code_utils.hpp>
+#include <net/ip6.hpp>
 
 namespace Thread {
 namespace Coap {
 
-Server::Server(Ip6::Udp &aUdp, uint16_t aPort):
-    mSocket(aUdp)
+bool Resource::IsUriPathEqual(const Header::Option *aSegments, uint8_t aNumSegments) const
+{
+    const char *cur = mUriPath;
+
+    for (uint8_t i = 0; i < aNumSegments; i++)
+    {
+        if (i > 0)
+        {
+            VerifyOrExit(*cur == '/', ;);
+            cur++;
+        }
+
+        for (uint16_t j = 0; j < aSegments[i].mLength; j++, cur++)
+        {
+            VerifyOrExit(*cur != '\0' && *cur == static_cast<char>(aSegments[i].mValue[j]), ;);
+        }
+    }
+
+    return (*cur == '\0');
+
+exit:
+    return false;
+}
+
+Server::Server(Ip6::Netif &aNetif, uint16_t aPort):
+    mSocket(aNetif.GetIp6().mUdp),
+    mResponsesQueue(aNetif.GetIp6().mTimerScheduler)
 {
     mPort = aPort;
-    mResources = NULL;
+    memset(mResources, 0, sizeof(mResources));
+    memset(mBlock1Transfers, 0, sizeof(mBlock1Transfers));
 }
 
 ThreadError Server::Start()
@@ -59,20 +87,26 @@ exit:
 
 ThreadError Server::Stop()
 {
+    mResponsesQueue.DequeueAllResponses();
+    memset(mBlock1Transfers, 0, sizeof(mBlock1Transfers));
     return mSocket.Close();
 }
 
 ThreadError Server::AddResource(Resource &aResource)
 {
     ThreadError error = kThreadError_None;
+    uint32_t hash = HashUriPath(kUriPathHashBasis, reinterpret_cast<const uint8_t *>(aResource.mUriPath),
+                                static_cast<uint16_t>(strlen(aResource.mUriPath)));
+    Resource **bucket = &mResources[GetResourceBucket(hash)];
 
-    for (Resource *cur = mResources; cur; cur = cur->mNext)
+    for (Resource *cur = *bucket; cur; cur = cur->mNext)
     {
         VerifyOrExit(cur != &aResource, error = kThreadError_Already);
     }
 
-    aResource.mNext = mResources;
-    mResources = &aResource;
+    aResource.mUriPathHash = hash;
+    aResource.mNext = *bucket;
+    *bucket = &aResource;
 
 exit:
     return error;
@@ -80,13 +114,23 @@ exit:
 
 void Server::RemoveResource(Resource &aResource)
 {
-    if (mResources == &aResource)
+    Resource **bucket = &mResources[GetResourceBucket(aResource.mUriPathHash)];
+
+    for (uint8_t i = 0; i < kMaxBlock1Transfers; i++)
     {
-        mResources = aResource.mNext;
+        if (mBlock1Transfers[i].mResource == &aResource)
+        {
+            mBlock1Transfers[i].mResource = NULL;
+        }
+    }
+
+    if (*bucket == &aResource)
+    {
+        *bucket = aResource.mNext;
     }
     else
     {
-        for (Resource *cur = mResources; cur; cur = cur->mNext)
+        for (Resource *cur = *bucket; cur; cur = cur->mNext)
         {
             if (cur->mNext == &aResource)
             {
@@ -100,6 +144,31 @@ exit:
     aResource.mNext = NULL;
 }
 
+uint32_t Server::HashUriPath(uint32_t aHash, const uint8_t *aBuf, uint16_t aLength)
+{
+    for (uint16_t i = 0; i < aLength; i++)
+    {
+        aHash = (aHash ^ aBuf[i]) * kUriPathHashPrime;
+    }
+
+    return aHash;
+}
+
+Resource *Server::FindResource(uint32_t aUriPathHash, const Header::Option *aSegments, uint8_t aNumSegments) const
+{
+    Resource *resource;
+
+    for (resource = mResources[GetResourceBucket(aUriPathHash)]; resource; resource = resource->mNext)
+    {
+        if (resource->mUriPathHash == aUriPathHash && resource->IsUriPathEqual(aSegments, aNumSegments))
+        {
+            break;
+        }
+    }
+
+    return resource;
+}
+
 void Server::HandleUdpReceive(void *aContext, otMessage aMessage, const otMessageInfo *aMessageInfo)
 {
     static_cast<Server *>(aContext)->HandleUdpReceive(*static_cast<Message *>(aMessage),
@@ -108,14 +177,25 @@ void Server::HandleUdpReceive(void *aContext, otMessage aMessage, const otMessag
 
 void Server::HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessageInfo)
 {
+    static const uint8_t kUriPathSeparator = '/';
     Header header;
-    char uriPath[kMaxReceivedUriPath];
-    char *curUriPath = uriPath;
+    Header::Option uriPath[kMaxUriPathSegments];
+    uint8_t numSegments = 0;
+    uint32_t hash = kUriPathHashBasis;
     const Header::Option *coapOption;
+    Resource *resource;
+    uint32_t number;
+    bool more;
+    Header::BlockSize size;
 
     SuccessOrExit(header.FromMessage(aMessage));
     aMessage.MoveOffset(header.GetLength());
 
+    if (header.IsConfirmable() && header.IsRequest())
+    {
+        VerifyOrExit(!ResendCachedResponse(header, aMessageInfo), ;);
+    }
+
     coapOption = header.GetCurrentOption();
 
     while (coapOption != NULL)
@@ -123,13 +203,21 @@ void Server::HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessag
         switch (coapOption->mNumber)
         {
         case kCoapOptionUriPath:
-            VerifyOrExit(coapOption->mLength < sizeof(uriPath) - static_cast<size_t>(curUriPath - uriPath), ;);
-            memcpy(curUriPath, coapOption->mValue, coapOption->mLength);
-            curUriPath[coapOption->mLength] = '/';
-            curUriPath += coapOption->mLength + 1;
+            VerifyOrExit(numSegments < kMaxUriPathSegments,
+                         SendErrorResponse(header, aMessageInfo, kCoapResponseNotFound));
+
+            if (numSegments > 0)
+            {
+                hash = HashUriPath(hash, &kUriPathSeparator, sizeof(kUriPathSeparator));
+            }
+
+            hash = HashUriPath(hash, coapOption->mValue, coapOption->mLength);
+            uriPath[numSegments++] = *coapOption;
             break;
 
         case kCoapOptionContentFormat:
+        case kCoapOptionBlock2:
+        case kCoapOptionBlock1:
             break;
 
         default:
@@ -139,30 +227,441 @@ void Server::HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessag
         coapOption = header.GetNextOption();
     }
 
-    curUriPath[-1] = '\0';
+    resource = FindResource(hash, uriPath, numSegments);
+    VerifyOrExit(resource != NULL, SendErrorResponse(header, aMessageInfo, kCoapResponseNotFound));
 
-    for (Resource *resource = mResources; resource; resource = resource->mNext)
+    if (resource->mBlockConsumer != NULL && header.IsConfirmable() &&
+        header.GetBlockOption(kCoapOptionBlock1, number, more, size) == kThreadError_None)
     {
-        if (strcmp(resource->mUriPath, uriPath) == 0)
+        // The handler only sees the last block, earlier ones are acknowledged with 2.31 Continue.
+        VerifyOrExit(ConsumeBlock(*resource, header, aMessage, aMessageInfo, number, more, size) == kThreadError_None &&
+                     !more, ;);
+    }
+
+    if (resource->mBlockProducer != NULL && header.IsConfirmable() && header.GetCode() == kCoapRequestGet)
+    {
+        if (header.GetBlockOption(kCoapOptionBlock2, number, more, size) != kThreadError_None)
+        {
+            number = 0;
+            size = static_cast<Header::BlockSize>(kBlockSize);
+        }
+        else if (size > static_cast<Header::BlockSize>(kBlockSize))
+        {
+            // Answer with smaller blocks, keeping the requested position (RFC 7959, p. 2.4).
+            number <<= (size - static_cast<Header::BlockSize>(kBlockSize));
+            size = static_cast<Header::BlockSize>(kBlockSize);
+        }
+
+        if (number == 0)
         {
             resource->HandleRequest(header, aMessage, aMessageInfo);
-            ExitNow();
         }
+
+        SendBlock(*resource, header, aMessageInfo, number, size);
+        ExitNow();
     }
 
+    resource->HandleRequest(header, aMessage, aMessageInfo);
+
 exit:
     {}
 }
 
+bool Server::Block1Transfer::Matches(const Header &aHeader, const Ip6::MessageInfo &aMessageInfo) const
+{
+    return (mPeerPort == aMessageInfo.mPeerPort && mPeerAddress == aMessageInfo.GetPeerAddr() &&
+            mTokenLength == aHeader.GetTokenLength() && memcmp(mToken, aHeader.GetToken(), mTokenLength) == 0);
+}
+
+Server::Block1Transfer *Server::FindBlock1Transfer(const Resource &aResource, const Header &aRequestHeader,
+                                                   const Ip6::MessageInfo &aMessageInfo, uint32_t aNumber,
+                                                   Header::Code &aCode)
+{
+    uint32_t now = Timer::GetNow();
+    Block1Transfer *transfer = NULL;
+    Block1Transfer *freeTransfer = NULL;
+
+    for (uint8_t i = 0; i < kMaxBlock1Transfers; i++)
+    {
+        Block1Transfer &cur = mBlock1Transfers[i];
+
+        if (cur.mResource != NULL && cur.IsExpired(now))
+        {
+            // The requester has given up on the transfer.
+            cur.mResource = NULL;
+        }
+
+        if (cur.mResource == &aResource)
+        {
+            transfer = &cur;
+        }
+        else if (cur.mResource == NULL && freeTransfer == NULL)
+        {
+            freeTransfer = &cur;
+        }
+    }
+
+    if (transfer != NULL && !transfer->Matches(aRequestHeader, aMessageInfo))
+    {
+        // The consumer is handed one transfer at a time, other requesters have to wait for it to finish.
+        aCode = kCoapResponseServiceUnavailable;
+        ExitNow(transfer = NULL);
+    }
+    else if (transfer == NULL)
+    {
+        // Only the first block may start a transfer (RFC 7959, p. 2.3).
+        VerifyOrExit(aNumber == 0, aCode = kCoapResponseRequestEntityIncomplete);
+        VerifyOrExit((transfer = freeTransfer) != NULL, aCode = kCoapResponseServiceUnavailable);
+
+        transfer->mResource = const_cast<Resource *>(&aResource);
+        transfer->mPeerAddress = aMessageInfo.GetPeerAddr();
+        transfer->mPeerPort = aMessageInfo.mPeerPort;
+        transfer->mTokenLength = aRequestHeader.GetTokenLength();
+        memcpy(transfer->mToken, aRequestHeader.GetToken(), transfer->mTokenLength);
+    }
+
+    if (aNumber == 0)
+    {
+        // A new transfer from the same requester replaces its incomplete one.
+        transfer->mPosition = 0;
+    }
+
+    // The requester abandons a block once it has waited this long for its acknowledgment.
+    transfer->mExpireTime = now + Timer::SecToMsec(kMaxTransmitWait);
+
+exit:
+    return transfer;
+}
+
+ThreadError Server::ConsumeBlock(Resource &aResource, const Header &aRequestHeader, const Message &aMessage,
+                                 const Ip6::MessageInfo &aMessageInfo, uint32_t aNumber, bool aMore,
+                                 Header::BlockSize aSize)
+{
+    ThreadError error = kThreadError_None;
+    Block1Transfer *transfer;
+    Header responseHeader;
+    Header::Code code = kCoapResponseContinue;
+    uint16_t blockSize = Header::GetBlockSize(aSize);
+    uint16_t length = aMessage.GetLength() - aMessage.GetOffset();
+    uint32_t position = aNumber * blockSize;
+
+    VerifyOrExit((transfer = FindBlock1Transfer(aResource, aRequestHeader, aMessageInfo, aNumber, code)) != NULL,
+                 error = kThreadError_Drop);
+
+    // Blocks must arrive in order and all but the last one must be full (RFC 7959, p. 2.3).
+    if (position != transfer->mPosition || (aMore && length != blockSize))
+    {
+        code = kCoapResponseRequestEntityIncomplete;
+        ExitNow(error = kThreadError_Drop);
+    }
+
+    if (aResource.mBlockConsumer(aResource.mContext, aMessage, position, aMore) != kThreadError_None)
+    {
+        code = kCoapResponseRequestEntityTooLarge;
+        ExitNow(error = kThreadError_NoBufs);
+    }
+
+    transfer->mPosition = position + length;
+
+exit:
+
+    if (transfer != NULL && (error != kThreadError_None || !aMore))
+    {
+        transfer->mResource = NULL;
+    }
+
+    if (error != kThreadError_None)
+    {
+        SendErrorResponse(aRequestHeader, aMessageInfo, code);
+    }
+    else if (aMore)
+    {
+        responseHeader.SetDefaultResponseHeader(aRequestHeader);
+        responseHeader.SetCode(code);
+
+        if (responseHeader.AppendBlockOption(kCoapOptionBlock1, aNumber, true, aSize) == kThreadError_None)
+        {
+            SendResponse(responseHeader, aMessageInfo);
+        }
+    }
+
+    return error;
+}
+
+ThreadError Server::SendBlock(Resource &aResource, const Header &aRequestHeader, const Ip6::MessageInfo &aMessageInfo,
+                              uint32_t aNumber, Header::BlockSize aSize)
+{
+    ThreadError error = kThreadError_None;
+    Message *message = NULL;
+    Header responseHeader;
+    uint16_t blockSize = Header::GetBlockSize(aSize);
+    bool more = false;
+
+    // Generate the payload first, the M flag is only known once the block has been produced.
+    VerifyOrExit((message = NewMessage(aRequestHeader.GetLength() + kMaxBlockOverhead)) != NULL,
+                 error = kThreadError_NoBufs);
+    SuccessOrExit(error = aResource.mBlockProducer(aResource.mContext, *message, aNumber * blockSize, blockSize, more));
+    VerifyOrExit(message->GetLength() == blockSize || (!more && message->GetLength() < blockSize),
+                 error = kThreadError_Failed);
+
+    responseHeader.SetDefaultResponseHeader(aRequestHeader);
+    responseHeader.SetCode(kCoapResponseContent);
+    SuccessOrExit(error = responseHeader.AppendBlockOption(kCoapOptionBlock2, aNumber, more, aSize));
+
+    if (message->GetLength() > 0)
+    {
+        SuccessOrExit(error = responseHeader.SetPayloadMarker());
+    }
+
+    SuccessOrExit(error = message->Prepend(responseHeader.GetBytes(), responseHeader.GetLength()));
+    message->SetOffset(0);
+    SuccessOrExit(error = SendResponse(*message, aMessageInfo));
+
+exit:
+
+    if (error != kThreadError_None && message != NULL)
+    {
+        message->Free();
+    }
+
+    return error;
+}
+
+ThreadError Server::SendErrorResponse(const Header &aRequestHeader, const Ip6::MessageInfo &aMessageInfo,
+                                      Header::Code aCode)
+{
+    ThreadError error = kThreadError_None;
+    Header responseHeader;
+
+    // Only unicast confirmable requests are rejected, multicast requests are silently ignored.
+    VerifyOrExit(aRequestHeader.IsConfirmable() && aRequestHeader.IsRequest() &&
+                 !aMessageInfo.GetSockAddr().IsMulticast(), error = kThreadError_Drop);
+
+    responseHeader.SetDefaultResponseHeader(aRequestHeader);
+    responseHeader.SetCode(aCode);
+    error = SendResponse(responseHeader, aMessageInfo);
+
+exit:
+    return error;
+}
+
+ThreadError Server::SendResponse(const Header &aResponseHeader, const Ip6::MessageInfo &aMessageInfo)
+{
+    ThreadError error = kThreadError_None;
+    Message *message = NULL;
+
+    VerifyOrExit((message = NewMessage(0)) != NULL, error = kThreadError_NoBufs);
+
+    SuccessOrExit(error = message->Append(aResponseHeader.GetBytes(), aResponseHeader.GetLength()));
+    SuccessOrExit(error = SendResponse(*message, aMessageInfo));
+
+exit:
+
+    if (error != kThreadError_None && message != NULL)
+    {
+        message->Free();
+    }
+
+    return error;
+}
+
+ThreadError Server::SendResponse(Message &aMessage, const Ip6::MessageInfo &aMessageInfo)
+{
+    Ip6::MessageInfo responseInfo;
+
+    memcpy(&responseInfo, &aMessageInfo, sizeof(responseInfo));
+    memset(&responseInfo.mSockAddr, 0, sizeof(responseInfo.mSockAddr));
+
+    return SendMessage(aMessage, responseInfo);
+}
+
 Message *Server::NewMessage(uint16_t aReserved)
 {
-    return mSocket.NewMessage(aReserved);
+    return mSocket.NewMessage(aReserved, Message::kPriorityHigh);
 }
 
 ThreadError Server::SendMessage(Message &aMessage, const Ip6::MessageInfo &aMessageInfo)
 {
+    Header header;
+
+    // Only piggy-backed responses to Confirmable requests are cached for duplicate detection.
+    if (header.FromMessage(aMessage) == kThreadError_None && header.IsAck() && !header.IsEmpty())
+    {
+        mResponsesQueue.EnqueueResponse(aMessage, aMessageInfo);
+    }
+
     return mSocket.SendTo(aMessage, aMessageInfo);
 }
 
+bool Server::ResendCachedResponse(const Header &aRequestHeader, const Ip6::MessageInfo &aMessageInfo)
+{
+    Message *response = NULL;
+    Ip6::MessageInfo responseInfo;
+
+    SuccessOrExit(mResponsesQueue.GetMatchedResponseCopy(aRequestHeader, aMessageInfo, &response));
+
+    memcpy(&responseInfo, &aMessageInfo, sizeof(responseInfo));
+    memset(&responseInfo.mSockAddr, 0, sizeof(responseInfo.mSockAddr));
+
+    if (mSocket.SendTo(*response, responseInfo) != kThreadError_None)
+    {
+        response->Free();
+    }
+
+exit:
+    // A matching cached response means the request is a duplicate, even if the copy could not be sent.
+    return (response != NULL);
+}
+
+EnqueuedResponseHeader::EnqueuedResponseHeader(const Ip6::MessageInfo &aMessageInfo)
+{
+    mDequeueTime = Timer::GetNow() + Timer::SecToMsec(kExchangeLifetime);
+    mPeerAddress = aMessageInfo.GetPeerAddr();
+    mPeerPort = aMessageInfo.mPeerPort;
+}
+
+ResponsesQueue::ResponsesQueue(TimerScheduler &aScheduler):
+    mTimer(aScheduler, &ResponsesQueue::HandleTimer, this)
+{
+    memset(&mCounters, 0, sizeof(mCounters));
+}
+
+void ResponsesQueue::EnqueueResponse(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo)
+{
+    EnqueuedResponseHeader enqueuedResponseHeader(aMessageInfo);
+    Message *responseCopy;
+
+    VerifyOrExit(kMaxCachedResponses > 0, ;);
+
+    if (mCounters.mCachedResponses >= kMaxCachedResponses && mQueue.GetHead() != NULL)
+    {
+        // Make room by evicting the oldest response.
+        DequeueResponse(*mQueue.GetHead());
+        mCounters.mEvictions++;
+    }
+
+    VerifyOrExit((responseCopy = aMessage.Clone()) != NULL, ;);
+
+    // The copy only serves duplicates, so it must not hold buffers needed by higher priority traffic.
+    if (responseCopy->SetPriority(Message::kPriorityLow) != kThreadError_None ||
+        enqueuedResponseHeader.AppendTo(*responseCopy) != kThreadError_None)
+    {
+        responseCopy->Free();
+        ExitNow();
+    }
+
+    mQueue.Enqueue(*responseCopy);
+    mCounters.mCachedResponses++;
+
+    if (!mTimer.IsRunning())
+    {
+        mTimer.Start(Timer::SecToMsec(kExchangeLifetime));
+    }
+
+exit:
+    return;
+}
+
+ThreadError ResponsesQueue::GetMatchedResponseCopy(const Header &aHeader, const Ip6::MessageInfo &aMessageInfo,
+                                                   Message **aResponse)
+{
+    ThreadError error = kThreadError_NotFound;
+    EnqueuedResponseHeader enqueuedResponseHeader;
+    Header cachedHeader;
+
+    for (Message *message = mQueue.GetHead(); message; message = message->GetNext())
+    {
+        enqueuedResponseHeader.ReadFrom(*message);
+
+        if (!enqueuedResponseHeader.IsPeerEqual(aMessageInfo))
+        {
+            continue;
+        }
+
+        // The Message ID is part of the fixed-size header, no need to parse options.
+        message->Read(0, Header::kMinHeaderLength, cachedHeader.mHeader.mBytes);
+
+        if (cachedHeader.GetMessageId() != aHeader.GetMessageId())
+        {
+            continue;
+        }
+
+        *aResponse = message->Clone(message->GetLength() - sizeof(EnqueuedResponseHeader));
+        VerifyOrExit(*aResponse != NULL, error = kThreadError_NoBufs);
+
+        mCounters.mHits++;
+        ExitNow(error = kThreadError_None);
+    }
+
+    mCounters.mMisses++;
+
+exit:
+    return error;
+}
+
+void ResponsesQueue::DequeueResponse(Message &aMessage)
+{
+    mQueue.Dequeue(aMessage);
+    aMessage.Free();
+    mCounters.mCachedResponses--;
+}
+
+Message *ResponsesQueue::EvictResponse(uint8_t aPriority)
+{
+    Message *message = mQueue.GetHead();
+
+    VerifyOrExit(message != NULL && message->GetPriority() < aPriority, message = NULL);
+
+    mQueue.Dequeue(*message);
+    mCounters.mCachedResponses--;
+    mCounters.mEvictions++;
+
+    if (mQueue.GetHead() == NULL)
+    {
+        mTimer.Stop();
+    }
+
+exit:
+    return message;
+}
+
+void ResponsesQueue::DequeueAllResponses(void)
+{
+    Message *message;
+
+    while ((message = mQueue.GetHead()) != NULL)
+    {
+        DequeueResponse(*message);
+    }
+
+    mTimer.Stop();
+}
+
+void ResponsesQueue::HandleTimer(void *aContext)
+{
+    static_cast<ResponsesQueue *>(aContext)->HandleTimer();
+}
+
+void ResponsesQueue::HandleTimer(void)
+{
+    uint32_t now = Timer::GetNow();
+    EnqueuedResponseHeader enqueuedResponseHeader;
+    Message *message;
+
+    // Responses are enqueued in order, so the head always expires first.
+    while ((message = mQueue.GetHead()) != NULL)
+    {
+        enqueuedResponseHeader.ReadFrom(*message);
+
+        if (!enqueuedResponseHeader.IsExpired(now))
+        {
+            mTimer.Start(enqueuedResponseHeader.GetRemainingTime(now));
+            break;
+        }
+
+        DequeueResponse(*message);
+    }
+}
+
 }  // namespace Coap
 }  // namespace Thread
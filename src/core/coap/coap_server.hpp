@@ -34,8 +34,11 @@
 #ifndef COAP_SERVER_HPP_
 #define COAP_SERVER_HPP_
 
+#include <openthread-core-config.h>
 #include <coap/coap_header.hpp>
 #include <common/message.hpp>
+#include <common/timer.hpp>
+#include <net/netif.hpp>
 #include <net/udp6.hpp>
 
 namespace Thread {
@@ -78,22 +81,229 @@ public:
      */
     Resource(const char *aUriPath, CoapMessageHandler aHandler, void *aContext) {
         mUriPath = aUriPath;
+        mUriPathHash = 0;
         mHandler = aHandler;
+        mBlockConsumer = NULL;
+        mBlockProducer = NULL;
+        mContext = aContext;
+        mNext = NULL;
+    }
+
+    /**
+     * This constructor initializes a resource that transfers its payloads block-wise (RFC 7959).
+     *
+     * Confirmable requests carrying a Block1 option are passed to @p aConsumer block by block, and @p aHandler is
+     * called with the last block once it has been consumed. The blocks of one transfer are matched by peer address,
+     * port and token, and a resource receives one transfer at a time, other peers are answered with 5.03 until it
+     * completes or expires.
+     *
+     * Confirmable GET requests are answered with blocks generated by @p aProducer. @p aHandler is called before the
+     * first block is generated, so that it may prepare the payload, and must not send a response itself.
+     *
+     * @param[in]  aUriPath   A pointer to a NULL-terminated string for the Uri-Path.
+     * @param[in]  aHandler   A function pointer that is called when receiving a CoAP message for @p aUriPath.
+     * @param[in]  aConsumer  A function pointer that is called for each received request block, or NULL.
+     * @param[in]  aProducer  A function pointer that is called to generate each response block, or NULL.
+     * @param[in]  aContext   A pointer to arbitrary context information.
+     */
+    Resource(const char *aUriPath, CoapMessageHandler aHandler, BlockConsumer aConsumer, BlockProducer aProducer,
+             void *aContext) {
+        mUriPath = aUriPath;
+        mUriPathHash = 0;
+        mHandler = aHandler;
+        mBlockConsumer = aConsumer;
+        mBlockProducer = aProducer;
         mContext = aContext;
         mNext = NULL;
     }
 
 private:
     void HandleRequest(Header &aHeader, Message &aMessage, const Ip6::MessageInfo &aMessageInfo) {
-        mHandler(mContext, aHeader, aMessage, aMessageInfo);
+        if (mHandler != NULL) {
+            mHandler(mContext, aHeader, aMessage, aMessageInfo);
+        }
     }
 
+    bool IsUriPathEqual(const Header::Option *aSegments, uint8_t aNumSegments) const;
+
     const char *mUriPath;
+    uint32_t mUriPathHash;
     CoapMessageHandler mHandler;
+    BlockConsumer mBlockConsumer;
+    BlockProducer mBlockProducer;
     void *mContext;
     Resource *mNext;
 };
 
+/**
+ * This class implements metadata appended to a cached CoAP response.
+ *
+ */
+OT_TOOL_PACKED_BEGIN
+class EnqueuedResponseHeader
+{
+public:
+    /**
+     * Default constructor creating empty object.
+     *
+     */
+    EnqueuedResponseHeader(void): mDequeueTime(0), mPeerPort(0) {}
+
+    /**
+     * Constructor creating object for the response sent with @p aMessageInfo.
+     *
+     * @param[in]  aMessageInfo  The message info of the response.
+     *
+     */
+    EnqueuedResponseHeader(const Ip6::MessageInfo &aMessageInfo);
+
+    /**
+     * This method appends the metadata to the message.
+     *
+     * @param[in]  aMessage  A reference to the message.
+     *
+     */
+    ThreadError AppendTo(Message &aMessage) const {
+        return aMessage.Append(this, sizeof(*this));
+    }
+
+    /**
+     * This method reads the metadata from the end of the message.
+     *
+     * @param[in]  aMessage  A reference to the message.
+     *
+     * @returns The number of bytes read.
+     *
+     */
+    uint16_t ReadFrom(const Message &aMessage) {
+        return aMessage.Read(aMessage.GetLength() - sizeof(*this), sizeof(*this), this);
+    }
+
+    /**
+     * This method checks if the cached response should be removed at @p aTime.
+     *
+     * @param[in]  aTime  The time to compare with.
+     *
+     * @retval TRUE   If the response has expired at @p aTime.
+     * @retval FALSE  If the response is still valid at @p aTime.
+     *
+     */
+    bool IsExpired(uint32_t aTime) const { return (static_cast<int32_t>(aTime - mDequeueTime) >= 0); }
+
+    /**
+     * This method returns the time remaining until the response expires.
+     *
+     * @param[in]  aTime  The current time.
+     *
+     * @returns The number of milliseconds until the response expires.
+     *
+     */
+    uint32_t GetRemainingTime(uint32_t aTime) const { return IsExpired(aTime) ? 0 : mDequeueTime - aTime; }
+
+    /**
+     * This method checks if the cached response was sent to the peer in @p aMessageInfo.
+     *
+     * @param[in]  aMessageInfo  The message info of a received request.
+     *
+     * @retval TRUE   If the peer address and port match.
+     * @retval FALSE  If the peer address or port do not match.
+     *
+     */
+    bool IsPeerEqual(const Ip6::MessageInfo &aMessageInfo) const {
+        return (mPeerPort == aMessageInfo.mPeerPort && mPeerAddress == aMessageInfo.GetPeerAddr());
+    }
+
+private:
+    uint32_t     mDequeueTime;  ///< Time when the response should be removed from the cache.
+    Ip6::Address mPeerAddress;  ///< IPv6 address of the requester.
+    uint16_t     mPeerPort;     ///< UDP port of the requester.
+} OT_TOOL_PACKED_END;
+
+/**
+ * This class implements a cache of CoAP responses used to answer duplicate Confirmable requests.
+ *
+ * Cached copies are held as low priority messages, so they only use the low priority share of the message buffers
+ * and are released first when a message of higher priority needs a buffer (see EvictResponse()).
+ *
+ */
+class ResponsesQueue
+{
+public:
+    /**
+     * This constructor initializes the object.
+     *
+     * @param[in]  aScheduler  A reference to the timer scheduler.
+     *
+     */
+    ResponsesQueue(TimerScheduler &aScheduler);
+
+    /**
+     * This method adds a copy of the response to the cache.
+     *
+     * If the cache is full, the oldest cached response is evicted.
+     *
+     * @param[in]  aMessage      A reference to the response message.
+     * @param[in]  aMessageInfo  The message info of @p aMessage.
+     *
+     */
+    void EnqueueResponse(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
+
+    /**
+     * This method returns a copy of the cached response matching the request.
+     *
+     * @param[in]   aHeader       A reference to the request header.
+     * @param[in]   aMessageInfo  The message info of the request.
+     * @param[out]  aResponse     A pointer to the response copy.
+     *
+     * @retval kThreadError_None      A matching response was found and copied.
+     * @retval kThreadError_NotFound  No matching response was found.
+     * @retval kThreadError_NoBufs    Insufficient buffers available to copy the response.
+     *
+     */
+    ThreadError GetMatchedResponseCopy(const Header &aHeader, const Ip6::MessageInfo &aMessageInfo,
+                                       Message **aResponse);
+
+    /**
+     * This method removes all responses from the cache.
+     *
+     */
+    void DequeueAllResponses(void);
+
+    /**
+     * This method removes the oldest cached response from the cache, without freeing it, to make room for a message
+     * of priority @p aPriority.
+     *
+     * @param[in]  aPriority  The priority class of the message that needs the buffers.
+     *
+     * @returns A pointer to the removed response or NULL if no cached response may be evicted.
+     *
+     */
+    Message *EvictResponse(uint8_t aPriority);
+
+    /**
+     * This method returns the cache counters.
+     *
+     * @returns A reference to the cache counters.
+     *
+     */
+    const otCoapResponseCacheCounters &GetCounters(void) const { return mCounters; }
+
+private:
+    enum
+    {
+        kMaxCachedResponses = OPENTHREAD_CONFIG_COAP_SERVER_MAX_CACHED_RESPONSES,
+    };
+
+    void DequeueResponse(Message &aMessage);
+
+    static void HandleTimer(void *aContext);
+    void HandleTimer(void);
+
+    MessageQueue mQueue;
+    Timer mTimer;
+    otCoapResponseCacheCounters mCounters;
+};
+
 /**
  * This class implements the CoAP server.
  *
@@ -104,11 +314,11 @@ public:
     /**
      * This constructor initializes the object.
      *
-     * @param[in]  aUdp   A reference to the UDP object.
-     * @param[in]  aPort  The port to listen on.
+     * @param[in]  aNetif  A reference to the network interface that CoAP server should be assigned to.
+     * @param[in]  aPort   The port to listen on.
      *
      */
-    Server(Ip6::Udp &aUdp, uint16_t aPort);
+    Server(Ip6::Netif &aNetif, uint16_t aPort);
 
     /**
      * This method starts the CoAP server.
@@ -167,18 +377,84 @@ public:
      */
     ThreadError SendMessage(Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
 
+    /**
+     * This method returns the response cache counters.
+     *
+     * @returns A reference to the response cache counters.
+     *
+     */
+    const otCoapResponseCacheCounters &GetResponsesQueueCounters(void) const { return mResponsesQueue.GetCounters(); }
+
+    /**
+     * This method removes the oldest cached response to make room for a message of priority @p aPriority.
+     *
+     * @param[in]  aPriority  The priority class of the message that needs the buffers.
+     *
+     * @returns A pointer to the removed response, which the caller frees, or NULL if none may be evicted.
+     *
+     */
+    Message *EvictCachedResponse(uint8_t aPriority) { return mResponsesQueue.EvictResponse(aPriority); }
+
 private:
     enum
     {
-        kMaxReceivedUriPath = 32,   ///< Maximum supported URI path on received messages.
+        kMaxUriPathSegments = 4,    ///< Maximum supported Uri-Path segments on received messages.
+        kNumResourceBuckets = 8,    ///< Number of Uri-Path hash buckets (must be a power of two).
+        kBlockSize          = OPENTHREAD_CONFIG_COAP_BLOCK_SIZE,  ///< Largest block size exponent in responses.
+        kMaxBlockOverhead   = 5,    ///< Maximum size of a Block option and the Payload Marker.
+        kMaxTokenLength     = 8,    ///< Maximum token length (RFC 7252).
+        kMaxBlock1Transfers = OPENTHREAD_CONFIG_COAP_SERVER_MAX_BLOCK1_TRANSFERS,
+    };
+
+    enum
+    {
+        kUriPathHashBasis = 2166136261u,  ///< FNV-1a offset basis.
+        kUriPathHashPrime = 16777619u,    ///< FNV-1a prime.
+    };
+
+    /**
+     * This structure holds the state of an incoming Block1 transfer.
+     *
+     */
+    struct Block1Transfer
+    {
+        bool IsExpired(uint32_t aTime) const { return (static_cast<int32_t>(aTime - mExpireTime) >= 0); }
+        bool Matches(const Header &aHeader, const Ip6::MessageInfo &aMessageInfo) const;
+
+        Resource     *mResource;                  ///< The receiving resource, or NULL if the entry is free.
+        Ip6::Address  mPeerAddress;               ///< IPv6 address of the sender.
+        uint16_t      mPeerPort;                  ///< UDP port of the sender.
+        uint8_t       mToken[kMaxTokenLength];    ///< Token of the request blocks.
+        uint8_t       mTokenLength;               ///< Token length.
+        uint32_t      mPosition;                  ///< Position of the next expected block.
+        uint32_t      mExpireTime;                ///< Time when the transfer is abandoned.
     };
 
     static void HandleUdpReceive(void *aContext, otMessage aMessage, const otMessageInfo *aMessageInfo);
     void HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
 
+    static uint32_t HashUriPath(uint32_t aHash, const uint8_t *aBuf, uint16_t aLength);
+    static uint8_t GetResourceBucket(uint32_t aUriPathHash) { return aUriPathHash & (kNumResourceBuckets - 1); }
+
+    bool ResendCachedResponse(const Header &aRequestHeader, const Ip6::MessageInfo &aMessageInfo);
+    Resource *FindResource(uint32_t aUriPathHash, const Header::Option *aSegments, uint8_t aNumSegments) const;
+    Block1Transfer *FindBlock1Transfer(const Resource &aResource, const Header &aRequestHeader,
+                                       const Ip6::MessageInfo &aMessageInfo, uint32_t aNumber, Header::Code &aCode);
+    ThreadError ConsumeBlock(Resource &aResource, const Header &aRequestHeader, const Message &aMessage,
+                             const Ip6::MessageInfo &aMessageInfo, uint32_t aNumber, bool aMore,
+                             Header::BlockSize aSize);
+    ThreadError SendBlock(Resource &aResource, const Header &aRequestHeader, const Ip6::MessageInfo &aMessageInfo,
+                          uint32_t aNumber, Header::BlockSize aSize);
+    ThreadError SendErrorResponse(const Header &aRequestHeader, const Ip6::MessageInfo &aMessageInfo,
+                                  Header::Code aCode);
+    ThreadError SendResponse(Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
+    ThreadError SendResponse(const Header &aResponseHeader, const Ip6::MessageInfo &aMessageInfo);
+
     Ip6::UdpSocket mSocket;
     uint16_t mPort;
-    Resource *mResources;
+    Resource *mResources[kNumResourceBuckets];
+    Block1Transfer mBlock1Transfers[kMaxBlock1Transfers];
+    ResponsesQueue mResponsesQueue;
 };
 
 /**
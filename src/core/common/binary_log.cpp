@@ -0,0 +1,260 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the binary log buffer.
+ */
+
+#include <string.h>
+
+#include <common/binary_log.hpp>
+#include <common/code_utils.hpp>
+
+namespace Thread {
+
+uint32_t BinaryLog::GetFormatId(const char *aFormat)
+{
+    uint32_t formatId = kFnvOffsetBasis;
+
+    for (; *aFormat != '\0'; aFormat++)
+    {
+        formatId = (formatId ^ static_cast<uint8_t>(*aFormat)) * kFnvPrime;
+    }
+
+    return formatId;
+}
+
+uint8_t *BinaryLog::AppendUint32(uint8_t *aCur, uint32_t aValue)
+{
+    for (uint8_t i = 0; i < sizeof(aValue); i++)
+    {
+        *aCur++ = static_cast<uint8_t>(aValue >> (8 * i));
+    }
+
+    return aCur;
+}
+
+uint8_t BinaryLog::EncodeHeader(uint8_t *aRecord, otLogLevel aLogLevel, otLogRegion aLogRegion, uint32_t aFormatId)
+{
+    aRecord[1] = static_cast<uint8_t>((aLogLevel & 0x07) | ((aLogRegion & 0x0f) << 3));
+    AppendUint32(&aRecord[2], aFormatId);
+    return kHeaderLength;
+}
+
+void BinaryLog::Write(otLogLevel aLogLevel, otLogRegion aLogRegion, const char *aFormat, va_list aArgs)
+{
+    uint8_t record[kMaxRecordLength];
+    uint8_t *cur = record + kHeaderLength;
+    uint8_t *end = record + sizeof(record);
+    uint32_t formatId = kFnvOffsetBasis;
+    bool conversion = false;
+    bool full = false;
+    uint8_t longs = 0;
+    unsigned long long value;
+    const char *string;
+
+    // The format ID is computed in the same pass that collects the arguments.
+    for (const char *format = aFormat; *format != '\0'; format++)
+    {
+        formatId = (formatId ^ static_cast<uint8_t>(*format)) * kFnvPrime;
+
+        if (!conversion)
+        {
+            conversion = (*format == '%');
+            longs = 0;
+            continue;
+        }
+
+        if (full)
+        {
+            conversion = false;
+            continue;
+        }
+
+        switch (*format)
+        {
+        case 'l':
+        case 'z':
+            longs++;
+            break;
+
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'o':
+        case 'c':
+        case 'p':
+        case '*':
+            if (*format == 'p')
+            {
+                value = reinterpret_cast<uintptr_t>(va_arg(aArgs, void *));
+            }
+            else if (longs >= 2)
+            {
+                value = va_arg(aArgs, unsigned long long);
+            }
+            else if (longs == 1)
+            {
+                value = va_arg(aArgs, unsigned long);
+            }
+            else
+            {
+                value = va_arg(aArgs, unsigned int);
+            }
+
+            if (longs >= 2 && *format != 'p')
+            {
+                if (end - cur < 8)
+                {
+                    full = true;
+                    break;
+                }
+
+                cur = AppendUint32(cur, static_cast<uint32_t>(value));
+                cur = AppendUint32(cur, static_cast<uint32_t>(value >> 32));
+            }
+            else
+            {
+                if (end - cur < 4)
+                {
+                    full = true;
+                    break;
+                }
+
+                cur = AppendUint32(cur, static_cast<uint32_t>(value));
+            }
+
+            // A '*' width or precision is followed by the rest of the conversion.
+            conversion = (*format == '*');
+            break;
+
+        case 's':
+            string = va_arg(aArgs, const char *);
+
+            if (string == NULL)
+            {
+                string = "(null)";
+            }
+
+            for (uint8_t i = 0; string[i] != '\0' && i < kMaxStringLength && end - cur > 1; i++)
+            {
+                *cur++ = static_cast<uint8_t>(string[i]);
+            }
+
+            if (cur == end)
+            {
+                full = true;
+                break;
+            }
+
+            *cur++ = 0;
+            conversion = false;
+            break;
+
+        case '%':
+            conversion = false;
+            break;
+
+        default:
+            // Flags, width, precision and the remaining length modifiers.
+            break;
+        }
+    }
+
+    record[0] = static_cast<uint8_t>(cur - record - 1);
+    EncodeHeader(record, aLogLevel, aLogRegion, formatId);
+    Commit(record, static_cast<uint16_t>(cur - record), NULL, 0);
+}
+
+void BinaryLog::WriteDump(otLogLevel aLogLevel, otLogRegion aLogRegion, const char *aId, const void *aBuf,
+                          size_t aLength)
+{
+    uint8_t record[kHeaderLength + sizeof(uint16_t)];
+    uint16_t length = (aLength < kMaxDumpLength + 1 - sizeof(record)) ?
+                      static_cast<uint16_t>(aLength) : static_cast<uint16_t>(kMaxDumpLength + 1 - sizeof(record));
+
+    record[0] = static_cast<uint8_t>(sizeof(record) + length - 1);
+    EncodeHeader(record, aLogLevel, aLogRegion, GetFormatId(aId));
+    record[1] |= kDumpFlag;
+    record[kHeaderLength] = static_cast<uint8_t>(aLength);
+    record[kHeaderLength + 1] = static_cast<uint8_t>(aLength >> 8);
+
+    Commit(record, sizeof(record), static_cast<const uint8_t *>(aBuf), length);
+}
+
+void BinaryLog::Commit(const uint8_t *aRecord, uint16_t aRecordLength, const uint8_t *aData, uint16_t aDataLength)
+{
+    uint16_t head = mHead;
+
+    if (aRecordLength + aDataLength > kBufferSize - static_cast<uint16_t>(head - mTail))
+    {
+        mDropped++;
+        ExitNow();
+    }
+
+    for (uint16_t i = 0; i < aRecordLength; i++)
+    {
+        mBuffer[head++ & (kBufferSize - 1)] = aRecord[i];
+    }
+
+    for (uint16_t i = 0; i < aDataLength; i++)
+    {
+        mBuffer[head++ & (kBufferSize - 1)] = aData[i];
+    }
+
+    // Publish the record only once all of its bytes are in the buffer.
+    mHead = head;
+
+exit:
+    return;
+}
+
+uint16_t BinaryLog::Read(uint8_t *aBuffer, uint16_t aLength)
+{
+    uint16_t tail = mTail;
+    uint16_t count = static_cast<uint16_t>(mHead - tail);
+
+    if (count > aLength)
+    {
+        count = aLength;
+    }
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        aBuffer[i] = mBuffer[(tail + i) & (kBufferSize - 1)];
+    }
+
+    mTail = static_cast<uint16_t>(tail + count);
+
+    return count;
+}
+
+}  // namespace Thread
@@ -0,0 +1,160 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the binary log buffer.
+ */
+
+#ifndef BINARY_LOG_HPP_
+#define BINARY_LOG_HPP_
+
+#include <stdarg.h>
+#include <stddef.h>
+
+#include <openthread-types.h>
+#include <openthread-core-config.h>
+#include <platform/logging.h>
+
+namespace Thread {
+
+/**
+ * @addtogroup core-logging
+ *
+ * @{
+ *
+ */
+
+/**
+ * This class implements a ring buffer of compact binary log records.
+ *
+ * Instead of formatting a log line, a record holds the format ID, the log level and region, and the raw arguments.
+ * The host decodes the records offline (see tools/log-decoder).
+ *
+ * A record is a length byte, which counts the bytes that follow it, a byte holding the level in bits 0-2, the region
+ * in bits 3-6 and the dump flag in bit 7, and the 32-bit format ID in little-endian byte order. The format ID is the
+ * FNV-1a hash of the format string. The arguments follow in the order of the format specification: integers as
+ * 32-bit values, or 64-bit values for `ll` conversions, and strings NULL-terminated. A dump record holds the 16-bit
+ * length of the dumped buffer followed by its first bytes.
+ *
+ * The buffer has a single producer, the OpenThread context, and a single consumer, which may run in another context.
+ * Records that do not fit are dropped whole.
+ *
+ * Zero-initialized storage is an empty buffer.
+ *
+ */
+class BinaryLog
+{
+public:
+    enum
+    {
+        kBufferSize       = OPENTHREAD_CONFIG_LOG_BINARY_BUFFER_SIZE,  ///< Buffer size in bytes, a power of two.
+        kMaxRecordLength  = 64,                                        ///< Maximum log record length in bytes.
+        kMaxDumpLength    = 255,                                       ///< Maximum dump record length in bytes.
+        kMaxStringLength  = 32,                                        ///< Maximum length of a string argument.
+        kHeaderLength     = 6,                                         ///< Record header length in bytes.
+        kDumpFlag         = 0x80,                                      ///< Flags a dump record.
+    };
+
+    /**
+     * This method appends a log record.
+     *
+     * @param[in]  aLogLevel   The log level.
+     * @param[in]  aLogRegion  The log region.
+     * @param[in]  aFormat     A pointer to the format string.
+     * @param[in]  aArgs       Arguments for the format specification.
+     *
+     */
+    void Write(otLogLevel aLogLevel, otLogRegion aLogRegion, const char *aFormat, va_list aArgs);
+
+    /**
+     * This method appends a memory dump record.
+     *
+     * @param[in]  aLogLevel   The log level.
+     * @param[in]  aLogRegion  The log region.
+     * @param[in]  aId         A pointer to a NULL-terminated string that is printed before the bytes.
+     * @param[in]  aBuf        A pointer to the buffer.
+     * @param[in]  aLength     Number of bytes in the buffer.
+     *
+     */
+    void WriteDump(otLogLevel aLogLevel, otLogRegion aLogRegion, const char *aId, const void *aBuf, size_t aLength);
+
+    /**
+     * This method removes bytes from the buffer.
+     *
+     * @param[out]  aBuffer  A pointer to the output buffer.
+     * @param[in]   aLength  The size of @p aBuffer in bytes.
+     *
+     * @returns The number of bytes copied to @p aBuffer.
+     *
+     */
+    uint16_t Read(uint8_t *aBuffer, uint16_t aLength);
+
+    /**
+     * This method returns the number of records dropped because the buffer was full.
+     *
+     * @returns The number of dropped records.
+     *
+     */
+    uint32_t GetDroppedCount(void) const { return mDropped; }
+
+    /**
+     * This static method computes the format ID of a format string.
+     *
+     * @param[in]  aFormat  A pointer to the format string.
+     *
+     * @returns The FNV-1a hash of @p aFormat.
+     *
+     */
+    static uint32_t GetFormatId(const char *aFormat);
+
+private:
+    enum
+    {
+        kFnvOffsetBasis = 2166136261u,
+        kFnvPrime       = 16777619u,
+    };
+
+    static uint8_t *AppendUint32(uint8_t *aCur, uint32_t aValue);
+    static uint8_t EncodeHeader(uint8_t *aRecord, otLogLevel aLogLevel, otLogRegion aLogRegion, uint32_t aFormatId);
+    void Commit(const uint8_t *aRecord, uint16_t aRecordLength, const uint8_t *aData, uint16_t aDataLength);
+
+    volatile uint8_t mBuffer[kBufferSize];
+    volatile uint16_t mHead;
+    volatile uint16_t mTail;
+    uint32_t mDropped;
+};
+
+/**
+ * @}
+ *
+ */
+
+}  // namespace Thread
+
+#endif  // BINARY_LOG_HPP_
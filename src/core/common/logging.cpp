@@ -39,16 +39,45 @@
 #include <openthread-config.h>
 #endif
 
+#include <openthread.h>
+#include <common/binary_log.hpp>
 #include <common/logging.hpp>
 
 #ifndef WINDOWS_LOGGING
 #define otLogDump(aFormat, ...) otPlatLog(aLogLevel, aLogRegion, aFormat, ## __VA_ARGS__)
 #endif
 
+#if OPENTHREAD_CONFIG_LOG_BINARY
+static Thread::BinaryLog sBinaryLog;
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#if OPENTHREAD_CONFIG_LOG_BINARY
+
+void otLogBinary(otLogLevel aLogLevel, otLogRegion aLogRegion, const char *aFormat, ...)
+{
+    va_list args;
+
+    va_start(args, aFormat);
+    sBinaryLog.Write(aLogLevel, aLogRegion, aFormat, args);
+    va_end(args);
+}
+
+uint16_t otLogBinaryRead(uint8_t *aBuffer, uint16_t aLength)
+{
+    return sBinaryLog.Read(aBuffer, aLength);
+}
+
+void otDump(otLogLevel aLogLevel, otLogRegion aLogRegion, const char *aId, const void *aBuf, const size_t aLength)
+{
+    sBinaryLog.WriteDump(aLogLevel, aLogRegion, aId, aBuf, aLength);
+}
+
+#else  // OPENTHREAD_CONFIG_LOG_BINARY
+
 /**
  * This static method outputs a line of the memory dump.
  *
@@ -148,6 +177,8 @@ void otDump(otLogLevel aLogLevel, otLogRegion aLogRegion, const char *aId, const
     otLogDump("%s", buf);
 }
 
+#endif  // OPENTHREAD_CONFIG_LOG_BINARY
+
 #ifdef __cplusplus
 };
 #endif
@@ -63,6 +63,19 @@ extern "C" {
 #define otLogFuncExitErr(error)
 #endif
 
+/**
+ * @def otLogOutput
+ *
+ * The function that receives the log calls, otLogBinary() when OPENTHREAD_CONFIG_LOG_BINARY is set and otPlatLog()
+ * otherwise.
+ *
+ */
+#if OPENTHREAD_CONFIG_LOG_BINARY
+#define otLogOutput otLogBinary
+#else
+#define otLogOutput otPlatLog
+#endif
+
 /**
  * @def otLogCrit
  *
@@ -74,7 +87,7 @@ extern "C" {
  *
  */
 #if OPENTHREAD_CONFIG_LOG_LEVEL >= OPENTHREAD_LOG_LEVEL_CRIT
-#define otLogCrit(aRegion, aFormat, ...)  otPlatLog(kLogLevelCrit, aRegion, aFormat, ## __VA_ARGS__)
+#define otLogCrit(aRegion, aFormat, ...)  otLogOutput(kLogLevelCrit, aRegion, aFormat, ## __VA_ARGS__)
 #else
 #define otLogCrit(aRegion, aFormat, ...)
 #endif
@@ -90,7 +103,7 @@ extern "C" {
  *
  */
 #if OPENTHREAD_CONFIG_LOG_LEVEL >= OPENTHREAD_LOG_LEVEL_WARN
-#define otLogWarn(aRegion, aFormat, ...)  otPlatLog(kLogLevelWarn, aRegion, aFormat, ## __VA_ARGS__)
+#define otLogWarn(aRegion, aFormat, ...)  otLogOutput(kLogLevelWarn, aRegion, aFormat, ## __VA_ARGS__)
 #else
 #define otLogWarn(aRegion, aFormat, ...)
 #endif
@@ -106,7 +119,7 @@ extern "C" {
  *
  */
 #if OPENTHREAD_CONFIG_LOG_LEVEL >= OPENTHREAD_LOG_LEVEL_INFO
-#define otLogInfo(aRegion, aFormat, ...)  otPlatLog(kLogLevelInfo, aRegion, aFormat, ## __VA_ARGS__)
+#define otLogInfo(aRegion, aFormat, ...)  otLogOutput(kLogLevelInfo, aRegion, aFormat, ## __VA_ARGS__)
 #else
 #define otLogInfo(aRegion, aFormat, ...)
 #endif
@@ -122,7 +135,7 @@ extern "C" {
  *
  */
 #if OPENTHREAD_CONFIG_LOG_LEVEL >= OPENTHREAD_LOG_LEVEL_DEBG
-#define otLogDebg(aRegion, aFormat, ...)  otPlatLog(kLogLevelDebg, aRegion, aFormat, ## __VA_ARGS__)
+#define otLogDebg(aRegion, aFormat, ...)  otLogOutput(kLogLevelDebg, aRegion, aFormat, ## __VA_ARGS__)
 #else
 #define otLogDebg(aRegion, aFormat, ...)
 #endif
@@ -1148,6 +1161,19 @@ extern "C" {
  */
 void otDump(otLogLevel aLevel, otLogRegion aRegion, const char *aId, const void *aBuf, const size_t aLength);
 
+#if OPENTHREAD_CONFIG_LOG_BINARY
+/**
+ * This function stores a log as a binary record for offline decoding.
+ *
+ * @param[in]  aLogLevel   The log level.
+ * @param[in]  aLogRegion  The log region.
+ * @param[in]  aFormat     A pointer to the format string.
+ * @param[in]  ...         Arguments for the format specification.
+ *
+ */
+void otLogBinary(otLogLevel aLogLevel, otLogRegion aLogRegion, const char *aFormat, ...);
+#endif
+
 #ifdef __cplusplus
 };
 #endif
@@ -38,6 +38,8 @@
 #include <common/logging.hpp>
 #include <common/message.hpp>
 #include <common/logging.hpp>
+#include <common/perf_counters.hpp>
+#include <common/timer.hpp>
 #include <net/ip6.hpp>
 
 #ifdef WINDOWS_LOGGING
@@ -50,8 +52,11 @@ MessagePool::MessagePool(void)
 {
     memset(mBuffers, 0, sizeof(mBuffers));
     memset(&mAll, 0, sizeof(mAll));
+    memset(&mBufferCounters, 0, sizeof(mBufferCounters));
 
     mFreeBuffers = mBuffers;
+    mEvictHandler = NULL;
+    mEvictContext = NULL;
 
     for (int i = 0; i < kNumBuffers - 1; i++)
     {
@@ -68,17 +73,21 @@ MessagePool::MessagePool(void)
 #endif
 }
 
-Message *MessagePool::New(uint8_t aType, uint16_t aReserved)
+Message *MessagePool::New(uint8_t aType, uint16_t aReserved, uint8_t aPriority)
 {
     Message *message = NULL;
 
-    VerifyOrExit((message = static_cast<Message *>(NewBuffer())) != NULL, ;);
+    assert(aPriority < Message::kNumPriorities);
+
+    VerifyOrExit((message = static_cast<Message *>(NewBuffer(aPriority))) != NULL, ;);
 
     memset(message, 0, sizeof(*message));
     message->SetMessagePool(this);
     message->SetType(aType);
     message->SetReserved(aReserved);
     message->SetLinkSecurityEnabled(true);
+    message->InitPriority(aPriority);
+    otPerfStampMessage(*message);
 
     if (message->SetLength(0) != kThreadError_None)
     {
@@ -94,40 +103,54 @@ ThreadError MessagePool::Free(Message *aMessage)
 {
     assert(aMessage->GetMessageList(MessageInfo::kListAll).mList == NULL &&
            aMessage->GetMessageList(MessageInfo::kListInterface).mList == NULL);
-    return FreeBuffers(static_cast<Buffer *>(aMessage));
+    return FreeBuffers(static_cast<Buffer *>(aMessage), aMessage->GetPriority());
+}
+
+void MessagePool::SetEvictHandler(EvictHandler aHandler, void *aContext)
+{
+    mEvictHandler = aHandler;
+    mEvictContext = aContext;
 }
 
-Buffer *MessagePool::NewBuffer(void)
+const otBufferCounters &MessagePool::GetBufferCounters(void)
+{
+    mBufferCounters.mFreeBuffers = static_cast<uint16_t>(mNumFreeBuffers);
+    return mBufferCounters;
+}
+
+Buffer *MessagePool::NewBuffer(uint8_t aPriority)
 {
     Buffer *buffer = NULL;
 
+    SuccessOrExit(ReclaimBuffers(1, aPriority));
+
 #if OPENTHREAD_CONFIG_PLATFORM_MESSAGE_MANAGEMENT
     buffer = static_cast<Buffer *>(otPlatMessagePoolNew());
 
     if (buffer == NULL)
     {
         otLogInfoMac("No available message buffer\n");
+        ExitNow();
     }
 
 #else // OPENTHREAD_CONFIG_PLATFORM_MESSAGE_MANAGEMENT
 
-    if (mFreeBuffers == NULL)
-    {
-        otLogInfoMac("No available message buffer");
-        ExitNow();
-    }
-
     buffer = mFreeBuffers;
     mFreeBuffers = mFreeBuffers->GetNextBuffer();
     buffer->SetNextBuffer(NULL);
     mNumFreeBuffers--;
 #endif // OPENTHREAD_CONFIG_PLATFORM_MESSAGE_MANAGEMENT
 
+    if (++mBufferCounters.mInUse[aPriority] > mBufferCounters.mHighWater[aPriority])
+    {
+        mBufferCounters.mHighWater[aPriority] = mBufferCounters.mInUse[aPriority];
+    }
+
 exit:
     return buffer;
 }
 
-ThreadError MessagePool::FreeBuffers(Buffer *aBuffer)
+ThreadError MessagePool::FreeBuffers(Buffer *aBuffer, uint8_t aPriority)
 {
     Buffer *tmpBuffer;
 
@@ -141,15 +164,77 @@ ThreadError MessagePool::FreeBuffers(Buffer *aBuffer)
         mFreeBuffers = aBuffer;
         mNumFreeBuffers++;
 #endif // OPENTHREAD_CONFIG_PLATFORM_MESSAGE_MANAGEMENT
+        mBufferCounters.mInUse[aPriority]--;
         aBuffer = tmpBuffer;
     }
 
     return kThreadError_None;
 }
 
-ThreadError MessagePool::ReclaimBuffers(int aNumBuffers)
+ThreadError MessagePool::ReclaimBuffers(int aNumBuffers, uint8_t aPriority)
+{
+    ThreadError error = kThreadError_None;
+    Message *message;
+
+    // a class limit cannot be relieved by evicting messages of other classes
+    VerifyOrExit(aNumBuffers <= GetMaxBuffers(aPriority) - mBufferCounters.mInUse[aPriority],
+                 error = kThreadError_NoBufs);
+
+    while (aNumBuffers > GetAvailableBuffers(aPriority))
+    {
+        VerifyOrExit(mEvictHandler != NULL && (message = mEvictHandler(mEvictContext, aPriority)) != NULL,
+                     error = kThreadError_NoBufs);
+
+        assert(message->GetPriority() < aPriority);
+        otLogInfoMac("Evicted message with priority %d", message->GetPriority());
+        mBufferCounters.mEvicted[message->GetPriority()]++;
+        Free(message);
+    }
+
+exit:
+
+    if (error != kThreadError_None)
+    {
+        otLogInfoMac("No available message buffer");
+        mBufferCounters.mFailed[aPriority]++;
+    }
+
+    return error;
+}
+
+int MessagePool::GetAvailableBuffers(uint8_t aPriority) const
 {
-    return (aNumBuffers <= mNumFreeBuffers) ? kThreadError_None : kThreadError_NoBufs;
+    int rval = mNumFreeBuffers;
+    int reserved = kNumReservedBuffers - mBufferCounters.mInUse[Message::kPriorityNetwork];
+
+    if (aPriority != Message::kPriorityNetwork && reserved > 0)
+    {
+        rval -= reserved;
+    }
+
+    return rval;
+}
+
+int MessagePool::GetMaxBuffers(uint8_t aPriority)
+{
+    int rval;
+
+    switch (aPriority)
+    {
+    case Message::kPriorityLow:
+        rval = kMaxLowPriorityBuffers;
+        break;
+
+    case Message::kPriorityHigh:
+        rval = kMaxHighPriorityBuffers;
+        break;
+
+    default:
+        rval = kNumBuffers;
+        break;
+    }
+
+    return rval;
 }
 
 ThreadError Message::ResizeMessage(uint16_t aLength)
@@ -165,7 +250,7 @@ ThreadError Message::ResizeMessage(uint16_t aLength)
     {
         if (curBuffer->GetNextBuffer() == NULL)
         {
-            curBuffer->SetNextBuffer(GetMessagePool()->NewBuffer());
+            curBuffer->SetNextBuffer(GetMessagePool()->NewBuffer(GetPriority()));
             VerifyOrExit(curBuffer->GetNextBuffer() != NULL, error = kThreadError_NoBufs);
         }
 
@@ -178,7 +263,7 @@ ThreadError Message::ResizeMessage(uint16_t aLength)
     curBuffer = curBuffer->GetNextBuffer();
     lastBuffer->SetNextBuffer(NULL);
 
-    GetMessagePool()->FreeBuffers(curBuffer);
+    GetMessagePool()->FreeBuffers(curBuffer, GetPriority());
 
 exit:
     return error;
@@ -216,7 +301,7 @@ ThreadError Message::SetLength(uint16_t aLength)
         bufs -= (((totalLengthCurrent - kHeadBufferDataSize) - 1) / kBufferDataSize) + 1;
     }
 
-    SuccessOrExit(error = GetMessagePool()->ReclaimBuffers(bufs));
+    SuccessOrExit(error = GetMessagePool()->ReclaimBuffers(bufs, GetPriority()));
 
     SuccessOrExit(error = ResizeMessage(totalLengthRequest));
     mInfo.mLength = aLength;
@@ -277,6 +362,53 @@ void Message::SetSubType(uint8_t aSubType)
     mInfo.mSubType = aSubType;
 }
 
+uint8_t Message::GetPriority(void) const
+{
+    return mInfo.mPriority;
+}
+
+ThreadError Message::SetPriority(uint8_t aPriority)
+{
+    ThreadError error = kThreadError_None;
+    bool enqueued = (GetMessageList(MessageInfo::kListInterface).mList != NULL);
+    otBufferCounters &counters = GetMessagePool()->mBufferCounters;
+    int numBuffers = 0;
+
+    VerifyOrExit(aPriority < kNumPriorities, error = kThreadError_InvalidArgs);
+    VerifyOrExit(aPriority != mInfo.mPriority, ;);
+
+    // move the buffers of the message to the new class
+    for (const Buffer *buffer = this; buffer != NULL; buffer = buffer->GetNextBuffer())
+    {
+        numBuffers++;
+    }
+
+    VerifyOrExit(numBuffers <= MessagePool::GetMaxBuffers(aPriority) - counters.mInUse[aPriority],
+                 error = kThreadError_NoBufs);
+    counters.mInUse[mInfo.mPriority] -= numBuffers;
+    counters.mInUse[aPriority] += numBuffers;
+
+    if (counters.mInUse[aPriority] > counters.mHighWater[aPriority])
+    {
+        counters.mHighWater[aPriority] = counters.mInUse[aPriority];
+    }
+
+    if (enqueued)
+    {
+        MessageQueue::RemoveFromList(MessageInfo::kListInterface, *this);
+    }
+
+    mInfo.mPriority = aPriority;
+
+    if (enqueued)
+    {
+        MessageQueue::AddToList(MessageInfo::kListInterface, *this);
+    }
+
+exit:
+    return error;
+}
+
 ThreadError Message::Append(const void *aBuf, uint16_t aLength)
 {
     ThreadError error = kThreadError_None;
@@ -300,7 +432,7 @@ ThreadError Message::Prepend(const void *aBuf, uint16_t aLength)
 
     while (aLength > GetReserved())
     {
-        VerifyOrExit((newBuffer = GetMessagePool()->NewBuffer()) != NULL, error = kThreadError_NoBufs);
+        VerifyOrExit((newBuffer = GetMessagePool()->NewBuffer(GetPriority())) != NULL, error = kThreadError_NoBufs);
 
         newBuffer->SetNextBuffer(GetNextBuffer());
         SetNextBuffer(newBuffer);
@@ -526,7 +658,8 @@ Message *Message::Clone(uint16_t aLength) const
     ThreadError error = kThreadError_None;
     Message *messageCopy;
 
-    VerifyOrExit((messageCopy = GetMessagePool()->New(GetType(), GetReserved())) != NULL, error = kThreadError_NoBufs);
+    VerifyOrExit((messageCopy = GetMessagePool()->New(GetType(), GetReserved(), GetPriority())) != NULL,
+                 error = kThreadError_NoBufs);
     SuccessOrExit(error = messageCopy->SetLength(aLength));
     CopyTo(0, 0, aLength, *messageCopy);
 
@@ -742,24 +875,45 @@ MessageQueue::MessageQueue(void)
 ThreadError MessageQueue::AddToList(uint8_t aList, Message &aMessage)
 {
     MessageList *list;
+    Message *prev;
 
     assert(aMessage.GetMessageList(aList).mNext == NULL &&
            aMessage.GetMessageList(aList).mPrev == NULL &&
            aMessage.GetMessageList(aList).mList != NULL);
 
     list = aMessage.GetMessageList(aList).mList;
+    prev = list->mTail;
+
+    // Interface queues are kept in priority order, the all messages list stays in allocation order.
+    if (aList == MessageInfo::kListInterface)
+    {
+        while (prev != NULL && prev->GetPriority() < aMessage.GetPriority())
+        {
+            prev = prev->GetMessageList(aList).mPrev;
+        }
+    }
 
-    if (list->mHead == NULL)
+    aMessage.GetMessageList(aList).mPrev = prev;
+
+    if (prev == NULL)
     {
+        aMessage.GetMessageList(aList).mNext = list->mHead;
         list->mHead = &aMessage;
-        list->mTail = &aMessage;
     }
     else
     {
-        list->mTail->GetMessageList(aList).mNext = &aMessage;
-        aMessage.GetMessageList(aList).mPrev = list->mTail;
+        aMessage.GetMessageList(aList).mNext = prev->GetMessageList(aList).mNext;
+        prev->GetMessageList(aList).mNext = &aMessage;
+    }
+
+    if (aMessage.GetMessageList(aList).mNext == NULL)
+    {
         list->mTail = &aMessage;
     }
+    else
+    {
+        aMessage.GetMessageList(aList).mNext->GetMessageList(aList).mPrev = &aMessage;
+    }
 
     return kThreadError_None;
 }
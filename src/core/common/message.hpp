@@ -67,8 +67,11 @@ namespace Thread {
 
 enum
 {
-    kNumBuffers = OPENTHREAD_CONFIG_NUM_MESSAGE_BUFFERS,
-    kBufferSize = OPENTHREAD_CONFIG_MESSAGE_BUFFER_SIZE,
+    kNumBuffers             = OPENTHREAD_CONFIG_NUM_MESSAGE_BUFFERS,
+    kBufferSize             = OPENTHREAD_CONFIG_MESSAGE_BUFFER_SIZE,
+    kNumReservedBuffers     = OPENTHREAD_CONFIG_MESSAGE_BUFFERS_RESERVED_NETWORK,
+    kMaxLowPriorityBuffers  = OPENTHREAD_CONFIG_MESSAGE_BUFFERS_MAX_LOW,
+    kMaxHighPriorityBuffers = OPENTHREAD_CONFIG_MESSAGE_BUFFERS_MAX_HIGH,
 };
 
 class Message;
@@ -128,6 +131,10 @@ struct MessageInfo
     uint8_t          mSubType : 3;       ///< Identifies the message sub type.
     bool             mDirectTx : 1;      ///< Used to indicate whether a direct transmission is required.
     bool             mLinkSecurity : 1;  ///< Indicates whether or not link security is enabled.
+    uint8_t          mPriority : 2;      ///< Identifies the transmit priority class of the message.
+#if OPENTHREAD_ENABLE_PERF_COUNTERS
+    uint32_t         mTimestamp;         ///< The time in milliseconds when the message entered the stack.
+#endif
 };
 
 /**
@@ -229,6 +236,15 @@ public:
         kSubTypeJoinerEntrust       = 4,  ///< Joiner Entrust
     };
 
+    enum
+    {
+        kPriorityLow     = kMessagePriorityLow,      ///< Bulk traffic
+        kPriorityNormal  = kMessagePriorityNormal,   ///< Default priority
+        kPriorityHigh    = kMessagePriorityHigh,     ///< Thread management traffic
+        kPriorityNetwork = kMessagePriorityNetwork,  ///< Network control traffic
+        kNumPriorities   = OT_NUM_MESSAGE_PRIORITIES,
+    };
+
     /**
      * This method frees this message buffer.
      *
@@ -316,6 +332,29 @@ public:
      */
     void SetSubType(uint8_t aSubType);
 
+    /**
+     * This method returns the transmit priority class of the message.
+     *
+     * @returns The priority class of the message.
+     *
+     */
+    uint8_t GetPriority(void) const;
+
+    /**
+     * This method sets the transmit priority class of the message.
+     *
+     * A message that is already enqueued is moved behind the other messages of its new class.  The buffers of the
+     * message are accounted to the new class.
+     *
+     * @param[in]  aPriority  The priority class.
+     *
+     * @retval kThreadError_None         Successfully set the priority.
+     * @retval kThreadError_InvalidArgs  @p aPriority is not a valid priority class.
+     * @retval kThreadError_NoBufs       The new class would exceed its buffer limit.
+     *
+     */
+    ThreadError SetPriority(uint8_t aPriority);
+
     /**
      * This method prepends bytes to the front of the message.
      *
@@ -571,6 +610,24 @@ public:
      */
     void SetLinkSecurityEnabled(bool aLinkSecurityEnabled);
 
+#if OPENTHREAD_ENABLE_PERF_COUNTERS
+    /**
+     * This method returns the time when the message entered the stack.
+     *
+     * @returns The time in milliseconds.
+     *
+     */
+    uint32_t GetTimestamp(void) const { return mInfo.mTimestamp; }
+
+    /**
+     * This method sets the time when the message entered the stack.
+     *
+     * @param[in]  aTimestamp  The time in milliseconds.
+     *
+     */
+    void SetTimestamp(uint32_t aTimestamp) { mInfo.mTimestamp = aTimestamp; }
+#endif  // OPENTHREAD_ENABLE_PERF_COUNTERS
+
     /**
      * This method is used to update a checksum value.
      *
@@ -588,6 +645,8 @@ private:
 
     void SetMessagePool(MessagePool *aMessagePool) { mInfo.mMessagePool = aMessagePool; }
 
+    void InitPriority(uint8_t aPriority) { mInfo.mPriority = aPriority; }
+
     /**
      * This method returns a reference to a message list.
      *
@@ -650,6 +709,8 @@ private:
  */
 class MessageQueue
 {
+    friend class Message;
+
 public:
     /**
      * This constructor initializes the message queue.
@@ -666,7 +727,10 @@ public:
     Message *GetHead(void) const;
 
     /**
-     * This method adds a message to the end of the list.
+     * This method adds a message to the list.
+     *
+     * The message is placed behind all messages of the same or a higher priority class and ahead of all messages
+     * of a lower one, so that walking the list from its head visits messages in priority order.
      *
      * @param[in]  aMessage  The message to add.
      *
@@ -721,6 +785,21 @@ class MessagePool
     friend class MessageQueue;
 
 public:
+    /**
+     * This function pointer is called when a buffer is needed for a message of a given priority class and none is
+     * available.
+     *
+     * The handler removes a queued message of lower priority from its queue and returns it.  The message pool then
+     * frees the message.
+     *
+     * @param[in]  aContext   A pointer to arbitrary context information.
+     * @param[in]  aPriority  The priority class of the message that needs the buffer.
+     *
+     * @returns A pointer to the dequeued message or NULL if no message may be evicted.
+     *
+     */
+    typedef Message *(*EvictHandler)(void *aContext, uint8_t aPriority);
+
     /**
      * This constructor initializes the object.
      *
@@ -730,13 +809,18 @@ public:
     /**
      * This method is used to obtain a new message.
      *
+     * Only network control messages may use the last kNumReservedBuffers free buffers.  Low and high priority
+     * messages are further limited to kMaxLowPriorityBuffers and kMaxHighPriorityBuffers buffers in total.  When no
+     * buffer is available, queued messages of lower priority are evicted.
+     *
      * @param[in]  aType           The message type.
      * @param[in]  aReserveHeader  The number of header bytes to reserve.
+     * @param[in]  aPriority       The priority class of the message.
      *
      * @returns A pointer to the message or NULL if no message buffers are available.
      *
      */
-    Message *New(uint8_t aType, uint16_t aReserveHeader);
+    Message *New(uint8_t aType, uint16_t aReserveHeader, uint8_t aPriority = Message::kPriorityNormal);
 
     /**
      * This method is used to free a message and return all message buffers to the buffer pool.
@@ -749,15 +833,37 @@ public:
      */
     ThreadError Free(Message *aMessage);
 
+    /**
+     * This method sets the handler which evicts queued messages when buffers run out.
+     *
+     * @param[in]  aHandler  A pointer to the function that evicts a message, or NULL to disable eviction.
+     * @param[in]  aContext  A pointer to arbitrary context information.
+     *
+     */
+    void SetEvictHandler(EvictHandler aHandler, void *aContext);
+
+    /**
+     * This method returns the per-priority buffer usage counters.
+     *
+     * @returns A reference to the buffer counters.
+     *
+     */
+    const otBufferCounters &GetBufferCounters(void);
+
 private:
-    Buffer *NewBuffer(void);
-    ThreadError FreeBuffers(Buffer *aBuffer);
-    ThreadError ReclaimBuffers(int aNumBuffers);
+    Buffer *NewBuffer(uint8_t aPriority);
+    ThreadError FreeBuffers(Buffer *aBuffer, uint8_t aPriority);
+    ThreadError ReclaimBuffers(int aNumBuffers, uint8_t aPriority);
+    int GetAvailableBuffers(uint8_t aPriority) const;
+    static int GetMaxBuffers(uint8_t aPriority);
 
     int mNumFreeBuffers;
     Buffer mBuffers[kNumBuffers];
     Buffer *mFreeBuffers;
     MessageList mAll;
+    EvictHandler mEvictHandler;
+    void *mEvictContext;
+    otBufferCounters mBufferCounters;
 };
 
 /**
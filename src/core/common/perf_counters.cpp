@@ -0,0 +1,76 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the stack performance counters.
+ */
+
+#include <string.h>
+
+#include <common/perf_counters.hpp>
+#include <common/timer.hpp>
+
+#if OPENTHREAD_ENABLE_PERF_COUNTERS
+
+namespace Thread {
+
+PerfCounters::PerfCounters(void)
+{
+    Reset();
+}
+
+void PerfCounters::Reset(void)
+{
+    memset(&mCounters, 0, sizeof(mCounters));
+}
+
+void PerfCounters::RecordLatency(otPerfHistogram &aHistogram, uint32_t aStartTime)
+{
+    uint32_t latency = Timer::GetNow() - aStartTime;
+    uint8_t bucket = 0;
+
+    // bucket i holds latencies in [2^(i-1), 2^i)
+    for (uint32_t value = latency; value != 0 && bucket < OT_PERF_HISTOGRAM_BUCKETS - 1; value >>= 1)
+    {
+        bucket++;
+    }
+
+    aHistogram.mCount++;
+    aHistogram.mSum += latency;
+    aHistogram.mBuckets[bucket]++;
+
+    if (latency > aHistogram.mMax)
+    {
+        aHistogram.mMax = latency;
+    }
+}
+
+}  // namespace Thread
+
+#endif  // OPENTHREAD_ENABLE_PERF_COUNTERS
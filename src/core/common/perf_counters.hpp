@@ -0,0 +1,143 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the stack performance counters.
+ */
+
+#ifndef PERF_COUNTERS_HPP_
+#define PERF_COUNTERS_HPP_
+
+#ifdef OPENTHREAD_CONFIG_FILE
+#include OPENTHREAD_CONFIG_FILE
+#else
+#include <openthread-config.h>
+#endif
+
+#include <openthread-types.h>
+
+namespace Thread {
+
+/**
+ * @addtogroup core-perf-counters
+ *
+ * @brief
+ *   This module includes definitions for the stack performance counters.
+ *
+ * @{
+ *
+ */
+
+#if OPENTHREAD_ENABLE_PERF_COUNTERS
+
+/**
+ * This macro increments a performance counter.
+ *
+ * @param[in]  aPerfCounters  A reference to the PerfCounters object.
+ * @param[in]  aCounter       The name of the otPerfCounters field.
+ *
+ */
+#define otPerfCount(aPerfCounters, aCounter) \
+    ((aPerfCounters).mCounters.aCounter++)
+
+/**
+ * This macro records the time elapsed since @p aStartTime in a latency histogram.
+ *
+ * @param[in]  aPerfCounters  A reference to the PerfCounters object.
+ * @param[in]  aHistogram     The name of the otPerfHistogram field.
+ * @param[in]  aStartTime     The start time in milliseconds.
+ *
+ */
+#define otPerfRecordLatency(aPerfCounters, aHistogram, aStartTime) \
+    (aPerfCounters).RecordLatency((aPerfCounters).mCounters.aHistogram, aStartTime)
+
+/**
+ * This macro stamps a message with the current time.
+ *
+ * @param[in]  aMessage  A reference to the message.
+ *
+ */
+#define otPerfStampMessage(aMessage) \
+    (aMessage).SetTimestamp(Timer::GetNow())
+
+/**
+ * This class implements the stack performance counters.
+ *
+ */
+class PerfCounters
+{
+public:
+    /**
+     * This constructor initializes the object.
+     *
+     */
+    PerfCounters(void);
+
+    /**
+     * This method returns the performance counters.
+     *
+     * @returns A reference to the performance counters.
+     *
+     */
+    const otPerfCounters &GetCounters(void) const { return mCounters; }
+
+    /**
+     * This method clears all counters and histograms.
+     *
+     */
+    void Reset(void);
+
+    /**
+     * This method records the time elapsed since @p aStartTime in @p aHistogram.
+     *
+     * @param[in]  aHistogram  A reference to the histogram.
+     * @param[in]  aStartTime  The start time in milliseconds.
+     *
+     */
+    static void RecordLatency(otPerfHistogram &aHistogram, uint32_t aStartTime);
+
+    otPerfCounters mCounters;
+};
+
+#else  // OPENTHREAD_ENABLE_PERF_COUNTERS
+
+#define otPerfCount(aPerfCounters, aCounter)
+#define otPerfRecordLatency(aPerfCounters, aHistogram, aStartTime)
+#define otPerfStampMessage(aMessage)
+
+#endif  // OPENTHREAD_ENABLE_PERF_COUNTERS
+
+/**
+ * @}
+ *
+ */
+
+}  // namespace Thread
+
+#endif  // PERF_COUNTERS_HPP_
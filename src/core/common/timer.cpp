@@ -45,7 +45,34 @@
 #include <timer.tmh>
 #endif
 
-TimerScheduler::TimerScheduler(void):
+namespace Thread {
+
+const TimerScheduler::AlarmApi TimerScheduler::sAlarmMilliApi =
+{
+    &otPlatAlarmStartAt,
+    &otPlatAlarmStop,
+    &otPlatAlarmGetNow,
+};
+
+#if OPENTHREAD_ENABLE_PLATFORM_USEC_TIMER
+const TimerScheduler::AlarmApi TimerMicroScheduler::sAlarmMicroApi =
+{
+    &otPlatAlarmMicroStartAt,
+    &otPlatAlarmMicroStop,
+    &otPlatAlarmMicroGetNow,
+};
+#endif
+
+TimerScheduler::TimerScheduler(Ip6::Ip6 &aIp6):
+    mIp6(aIp6),
+    mAlarmApi(sAlarmMilliApi),
+    mHead(NULL)
+{
+}
+
+TimerScheduler::TimerScheduler(Ip6::Ip6 &aIp6, const AlarmApi &aAlarmApi):
+    mIp6(aIp6),
+    mAlarmApi(aAlarmApi),
     mHead(NULL)
 {
 }
@@ -61,12 +88,13 @@ void TimerScheduler::Add(Timer &aTimer)
     }
     else
     {
+        uint32_t now = mAlarmApi.AlarmGetNow();
         Timer *prev = NULL;
         Timer *cur;
 
         for (cur = mHead; cur; cur = cur->mNext)
         {
-            if (TimerCompare(aTimer, *cur))
+            if (TimerCompare(aTimer, *cur, now))
             {
                 if (prev)
                 {
@@ -133,20 +161,20 @@ exit:
 
 void TimerScheduler::SetAlarm(void)
 {
-    uint32_t now = otPlatAlarmGetNow();
+    uint32_t now = mAlarmApi.AlarmGetNow();
     uint32_t elapsed;
     uint32_t remaining;
 
     if (mHead == NULL)
     {
-        otPlatAlarmStop(GetIp6()->GetInstance());
+        mAlarmApi.AlarmStop(mIp6.GetInstance());
     }
     else
     {
         elapsed = now - mHead->mT0;
         remaining = (mHead->mDt > elapsed) ? mHead->mDt - elapsed : 0;
 
-        otPlatAlarmStartAt(GetIp6()->GetInstance(), now, remaining);
+        mAlarmApi.AlarmStartAt(mIp6.GetInstance(), now, remaining);
     }
 }
 
@@ -157,9 +185,18 @@ extern "C" void otPlatAlarmFired(otInstance *aInstance)
     otLogFuncExit();
 }
 
+#if OPENTHREAD_ENABLE_PLATFORM_USEC_TIMER
+extern "C" void otPlatAlarmMicroFired(otInstance *aInstance)
+{
+    otLogFuncEntry();
+    aInstance->mIp6.mTimerMicroScheduler.FireTimers();
+    otLogFuncExit();
+}
+#endif
+
 void TimerScheduler::FireTimers()
 {
-    uint32_t now = otPlatAlarmGetNow();
+    uint32_t now = mAlarmApi.AlarmGetNow();
     uint32_t elapsed;
     Timer *timer = mHead;
 
@@ -183,16 +220,10 @@ void TimerScheduler::FireTimers()
     }
 }
 
-Ip6::Ip6 *TimerScheduler::GetIp6()
-{
-    return Ip6::Ip6FromTimerScheduler(this);
-}
-
-bool TimerScheduler::TimerCompare(const Timer &aTimerA, const Timer &aTimerB)
+bool TimerScheduler::TimerCompare(const Timer &aTimerA, const Timer &aTimerB, uint32_t aNow)
 {
-    uint32_t now = otPlatAlarmGetNow();
-    uint32_t elapsedA = now - aTimerA.mT0;
-    uint32_t elapsedB = now - aTimerB.mT0;
+    uint32_t elapsedA = aNow - aTimerA.mT0;
+    uint32_t elapsedB = aNow - aTimerB.mT0;
     bool retval = false;
 
     if (aTimerA.mDt >= elapsedA && aTimerB.mDt >= elapsedB)
@@ -36,6 +36,12 @@
 
 #include <stddef.h>
 
+#ifdef OPENTHREAD_CONFIG_FILE
+#include OPENTHREAD_CONFIG_FILE
+#else
+#include <openthread-config.h>
+#endif
+
 #include <openthread-types.h>
 #include <common/tasklet.hpp>
 #include <platform/alarm.h>
@@ -66,10 +72,12 @@ class TimerScheduler
 
 public:
     /**
-     * This constructor initializes the object.
+     * This constructor initializes the object on top of the millisecond alarm.
+     *
+     * @param[in]  aIp6  A reference to the parent Ip6 object.
      *
      */
-    TimerScheduler(void);
+    TimerScheduler(Ip6::Ip6 &aIp6);
 
     /**
      * This method adds a timer instance to the timer scheduler.
@@ -110,7 +118,28 @@ public:
      * @returns The pointer to the parent Ip6 structure.
      *
      */
-    Ip6::Ip6 *GetIp6();
+    Ip6::Ip6 *GetIp6() { return &mIp6; }
+
+protected:
+    /**
+     * This structure represents the platform alarm a timer scheduler runs on.
+     *
+     */
+    struct AlarmApi
+    {
+        void (*AlarmStartAt)(otInstance *aInstance, uint32_t aT0, uint32_t aDt);
+        void (*AlarmStop)(otInstance *aInstance);
+        uint32_t (*AlarmGetNow)(void);
+    };
+
+    /**
+     * This constructor initializes the object on top of a given alarm.
+     *
+     * @param[in]  aIp6       A reference to the parent Ip6 object.
+     * @param[in]  aAlarmApi  A reference to the alarm functions.
+     *
+     */
+    TimerScheduler(Ip6::Ip6 &aIp6, const AlarmApi &aAlarmApi);
 
 private:
     void SetAlarm(void);
@@ -121,15 +150,41 @@ private:
      *
      * @param[in] aTimerA   The first timer for comparison.
      * @param[in] aTimerB   The second timer for comparison.
+     * @param[in] aNow      The current time.
      *
      * @returns true if aTimerA will fire before aTimerB.
      * @returns false if aTimerA will fire at the same time or after aTimerB.
      */
-    static bool TimerCompare(const Timer &aTimerA, const Timer &aTimerB);
+    static bool TimerCompare(const Timer &aTimerA, const Timer &aTimerB, uint32_t aNow);
+
+    static const AlarmApi sAlarmMilliApi;
 
+    Ip6::Ip6 &mIp6;
+    const AlarmApi &mAlarmApi;
     Timer *mHead;
 };
 
+#if OPENTHREAD_ENABLE_PLATFORM_USEC_TIMER
+/**
+ * This class implements the timer scheduler for microsecond timers.
+ *
+ */
+class TimerMicroScheduler: public TimerScheduler
+{
+public:
+    /**
+     * This constructor initializes the object on top of the microsecond alarm.
+     *
+     * @param[in]  aIp6  A reference to the parent Ip6 object.
+     *
+     */
+    TimerMicroScheduler(Ip6::Ip6 &aIp6): TimerScheduler(aIp6, sAlarmMicroApi) {}
+
+private:
+    static const AlarmApi sAlarmMicroApi;
+};
+#endif  // OPENTHREAD_ENABLE_PLATFORM_USEC_TIMER
+
 /**
  * This class implements a timer.
  *
@@ -259,6 +314,45 @@ private:
     Timer          *mNext;
 };
 
+#if OPENTHREAD_ENABLE_PLATFORM_USEC_TIMER
+/**
+ * This class implements a timer with microsecond resolution.
+ *
+ * All times and delays of a microsecond timer are in microseconds.
+ *
+ */
+class TimerMicro: public Timer
+{
+public:
+    /**
+     * This constructor creates a microsecond timer instance.
+     *
+     * @param[in]  aScheduler  A refrence to the microsecond timer scheduler.
+     * @param[in]  aHandler    A pointer to a function that is called when the timer expires.
+     * @param[in]  aContext    A pointer to arbitrary context information.
+     *
+     */
+    TimerMicro(TimerMicroScheduler &aScheduler, Handler aHandler, void *aContext):
+        Timer(aScheduler, aHandler, aContext) {
+    }
+
+    /**
+     * This method schedules the timer to fire a @p dt microseconds from now.
+     *
+     * @param[in]  aDt  The expire time in microseconds from now.
+     */
+    void Start(uint32_t aDt) { StartAt(GetNow(), aDt); }
+
+    /**
+     * This static method returns the current time in microseconds.
+     *
+     * @returns The current time in microseconds.
+     *
+     */
+    static uint32_t GetNow(void) { return otPlatAlarmMicroGetNow(); }
+};
+#endif  // OPENTHREAD_ENABLE_PLATFORM_USEC_TIMER
+
 /**
  * @}
  *
@@ -0,0 +1,670 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements AES-128 encryption of several blocks at once.
+ */
+
+#include <string.h>
+
+#include <common/debug.hpp>
+#include <crypto/aes_batch.hpp>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define AES_BATCH_AESNI 1
+#include <cpuid.h>
+#include <wmmintrin.h>
+#else
+#define AES_BATCH_AESNI 0
+#endif
+
+#if defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES)
+#define AES_BATCH_ARM_CRYPTO 1
+#include <arm_neon.h>
+#else
+#define AES_BATCH_ARM_CRYPTO 0
+#endif
+
+namespace Thread {
+namespace Crypto {
+
+// The bitsliced implementation keeps four blocks in eight 64-bit words: word j holds bit j of every byte, and
+// byte i of block b is found at bit 16 * b + i.  Since AES numbers the bytes of a block column by column, each
+// 16-bit lane of a word is one block, each nibble of a lane one column, and each bit of a nibble one row.
+
+/**
+ * This function transposes the 8x8 bit matrix whose rows are the bytes of @p aValue.
+ *
+ */
+static uint64_t Transpose8x8(uint64_t aValue)
+{
+    uint64_t t;
+
+    t = (aValue ^ (aValue >> 7)) & 0x00aa00aa00aa00aaULL;
+    aValue ^= t ^ (t << 7);
+    t = (aValue ^ (aValue >> 14)) & 0x0000cccc0000ccccULL;
+    aValue ^= t ^ (t << 14);
+    t = (aValue ^ (aValue >> 28)) & 0x00000000f0f0f0f0ULL;
+    aValue ^= t ^ (t << 28);
+
+    return aValue;
+}
+
+static void Pack(const uint8_t *aBlocks, uint16_t aCount, uint64_t aPlanes[8])
+{
+    memset(aPlanes, 0, 8 * sizeof(aPlanes[0]));
+
+    // each half block is transposed on its own, giving one byte of each word
+    for (uint8_t half = 0; half < 2 * aCount; half++)
+    {
+        const uint8_t *bytes = aBlocks + 8 * half;
+        uint64_t x = 0;
+
+        for (uint8_t k = 0; k < 8; k++)
+        {
+            x |= static_cast<uint64_t>(bytes[k]) << (8 * k);
+        }
+
+        x = Transpose8x8(x);
+
+        for (uint8_t j = 0; j < 8; j++)
+        {
+            aPlanes[j] |= ((x >> (8 * j)) & 0xff) << (8 * half);
+        }
+    }
+}
+
+static void Unpack(const uint64_t aPlanes[8], uint8_t *aBlocks, uint16_t aCount)
+{
+    for (uint8_t half = 0; half < 2 * aCount; half++)
+    {
+        uint8_t *bytes = aBlocks + 8 * half;
+        uint64_t x = 0;
+
+        for (uint8_t j = 0; j < 8; j++)
+        {
+            x |= ((aPlanes[j] >> (8 * half)) & 0xff) << (8 * j);
+        }
+
+        x = Transpose8x8(x);
+
+        for (uint8_t k = 0; k < 8; k++)
+        {
+            bytes[k] = static_cast<uint8_t>(x >> (8 * k));
+        }
+    }
+}
+
+/**
+ * This function computes the AES S-box on every bit position of @p aPlanes, with the circuit of Boyar and Peralta.
+ *
+ */
+static void SubBytes(uint64_t aPlanes[8])
+{
+    uint64_t x0, x1, x2, x3, x4, x5, x6, x7;
+    uint64_t y1, y2, y3, y4, y5, y6, y7, y8, y9, y10, y11, y12, y13, y14, y15, y16, y17, y18, y19, y20, y21;
+    uint64_t z0, z1, z2, z3, z4, z5, z6, z7, z8, z9, z10, z11, z12, z13, z14, z15, z16, z17;
+    uint64_t t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11, t12, t13, t14, t15, t16, t17, t18, t19;
+    uint64_t t20, t21, t22, t23, t24, t25, t26, t27, t28, t29, t30, t31, t32, t33, t34, t35, t36, t37, t38, t39;
+    uint64_t t40, t41, t42, t43, t44, t45, t46, t47, t48, t49, t50, t51, t52, t53, t54, t55, t56, t57, t58, t59;
+    uint64_t t60, t61, t62, t63, t64, t65, t66, t67;
+    uint64_t s0, s1, s2, s3, s4, s5, s6, s7;
+
+    x0 = aPlanes[7];
+    x1 = aPlanes[6];
+    x2 = aPlanes[5];
+    x3 = aPlanes[4];
+    x4 = aPlanes[3];
+    x5 = aPlanes[2];
+    x6 = aPlanes[1];
+    x7 = aPlanes[0];
+
+    // top linear transformation
+    y14 = x3 ^ x5;
+    y13 = x0 ^ x6;
+    y9 = x0 ^ x3;
+    y8 = x0 ^ x5;
+    t0 = x1 ^ x2;
+    y1 = t0 ^ x7;
+    y4 = y1 ^ x3;
+    y12 = y13 ^ y14;
+    y2 = y1 ^ x0;
+    y5 = y1 ^ x6;
+    y3 = y5 ^ y8;
+    t1 = x4 ^ y12;
+    y15 = t1 ^ x5;
+    y20 = t1 ^ x1;
+    y6 = y15 ^ x7;
+    y10 = y15 ^ t0;
+    y11 = y20 ^ y9;
+    y7 = x7 ^ y11;
+    y17 = y10 ^ y11;
+    y19 = y10 ^ y8;
+    y16 = t0 ^ y11;
+    y21 = y13 ^ y16;
+    y18 = x0 ^ y16;
+
+    // non-linear section
+    t2 = y12 & y15;
+    t3 = y3 & y6;
+    t4 = t3 ^ t2;
+    t5 = y4 & x7;
+    t6 = t5 ^ t2;
+    t7 = y13 & y16;
+    t8 = y5 & y1;
+    t9 = t8 ^ t7;
+    t10 = y2 & y7;
+    t11 = t10 ^ t7;
+    t12 = y9 & y11;
+    t13 = y14 & y17;
+    t14 = t13 ^ t12;
+    t15 = y8 & y10;
+    t16 = t15 ^ t12;
+    t17 = t4 ^ t14;
+    t18 = t6 ^ t16;
+    t19 = t9 ^ t14;
+    t20 = t11 ^ t16;
+    t21 = t17 ^ y20;
+    t22 = t18 ^ y19;
+    t23 = t19 ^ y21;
+    t24 = t20 ^ y18;
+
+    t25 = t21 ^ t22;
+    t26 = t21 & t23;
+    t27 = t24 ^ t26;
+    t28 = t25 & t27;
+    t29 = t28 ^ t22;
+    t30 = t23 ^ t24;
+    t31 = t22 ^ t26;
+    t32 = t31 & t30;
+    t33 = t32 ^ t24;
+    t34 = t23 ^ t33;
+    t35 = t27 ^ t33;
+    t36 = t24 & t35;
+    t37 = t36 ^ t34;
+    t38 = t27 ^ t36;
+    t39 = t29 & t38;
+    t40 = t25 ^ t39;
+
+    t41 = t40 ^ t37;
+    t42 = t29 ^ t33;
+    t43 = t29 ^ t40;
+    t44 = t33 ^ t37;
+    t45 = t42 ^ t41;
+    z0 = t44 & y15;
+    z1 = t37 & y6;
+    z2 = t33 & x7;
+    z3 = t43 & y16;
+    z4 = t40 & y1;
+    z5 = t29 & y7;
+    z6 = t42 & y11;
+    z7 = t45 & y17;
+    z8 = t41 & y10;
+    z9 = t44 & y12;
+    z10 = t37 & y3;
+    z11 = t33 & y4;
+    z12 = t43 & y13;
+    z13 = t40 & y5;
+    z14 = t29 & y2;
+    z15 = t42 & y9;
+    z16 = t45 & y14;
+    z17 = t41 & y8;
+
+    // bottom linear transformation
+    t46 = z15 ^ z16;
+    t47 = z10 ^ z11;
+    t48 = z5 ^ z13;
+    t49 = z9 ^ z10;
+    t50 = z2 ^ z12;
+    t51 = z2 ^ z5;
+    t52 = z7 ^ z8;
+    t53 = z0 ^ z3;
+    t54 = z6 ^ z7;
+    t55 = z16 ^ z17;
+    t56 = z12 ^ t48;
+    t57 = t50 ^ t53;
+    t58 = z4 ^ t46;
+    t59 = z3 ^ t54;
+    t60 = t46 ^ t57;
+    t61 = z14 ^ t57;
+    t62 = t52 ^ t58;
+    t63 = t49 ^ t58;
+    t64 = z4 ^ t59;
+    t65 = t61 ^ t62;
+    t66 = z1 ^ t63;
+    s0 = t59 ^ t63;
+    s6 = t56 ^ ~t62;
+    s7 = t48 ^ ~t60;
+    t67 = t64 ^ t65;
+    s3 = t53 ^ t66;
+    s4 = t51 ^ t66;
+    s5 = t47 ^ t65;
+    s1 = t64 ^ ~s3;
+    s2 = t55 ^ ~t67;
+
+    aPlanes[7] = s0;
+    aPlanes[6] = s1;
+    aPlanes[5] = s2;
+    aPlanes[4] = s3;
+    aPlanes[3] = s4;
+    aPlanes[2] = s5;
+    aPlanes[1] = s6;
+    aPlanes[0] = s7;
+}
+
+/**
+ * This function computes the AES S-box on up to eight bytes, in constant time.
+ *
+ */
+static void SubBytes(uint8_t *aBytes, uint8_t aLength)
+{
+    uint64_t planes[8];
+    uint64_t x = 0;
+
+    for (uint8_t k = 0; k < aLength; k++)
+    {
+        x |= static_cast<uint64_t>(aBytes[k]) << (8 * k);
+    }
+
+    x = Transpose8x8(x);
+
+    for (uint8_t j = 0; j < 8; j++)
+    {
+        planes[j] = (x >> (8 * j)) & 0xff;
+    }
+
+    SubBytes(planes);
+    x = 0;
+
+    for (uint8_t j = 0; j < 8; j++)
+    {
+        x |= (planes[j] & 0xff) << (8 * j);
+    }
+
+    x = Transpose8x8(x);
+
+    for (uint8_t k = 0; k < aLength; k++)
+    {
+        aBytes[k] = static_cast<uint8_t>(x >> (8 * k));
+    }
+}
+
+static void ShiftRows(uint64_t aPlanes[8])
+{
+    // row r moves r columns to the left, that is 4 * r bits down its lane
+    for (uint8_t j = 0; j < 8; j++)
+    {
+        uint64_t q = aPlanes[j];
+
+        aPlanes[j] = (q & 0x1111111111111111ULL) |
+                     ((q >> 4) & 0x0222022202220222ULL) | ((q << 12) & 0x2000200020002000ULL) |
+                     ((q >> 8) & 0x0044004400440044ULL) | ((q << 8) & 0x4400440044004400ULL) |
+                     ((q >> 12) & 0x0008000800080008ULL) | ((q << 4) & 0x8880888088808880ULL);
+    }
+}
+
+/**
+ * This function returns, in each row of each column, the byte one row below (and the first row in the last one).
+ *
+ */
+static inline uint64_t RotateRows1(uint64_t aValue)
+{
+    return ((aValue >> 1) & 0x7777777777777777ULL) | ((aValue << 3) & 0x8888888888888888ULL);
+}
+
+static inline uint64_t RotateRows2(uint64_t aValue)
+{
+    return ((aValue >> 2) & 0x3333333333333333ULL) | ((aValue << 2) & 0xccccccccccccccccULL);
+}
+
+static void MixColumns(uint64_t aPlanes[8])
+{
+    uint64_t t[8];
+
+    // each byte becomes 2 * (a0 ^ a1) ^ a1 ^ a2 ^ a3, with a1, a2 and a3 the bytes below it in its column
+    for (uint8_t j = 0; j < 8; j++)
+    {
+        uint64_t a1 = RotateRows1(aPlanes[j]);
+
+        t[j] = aPlanes[j] ^ a1;
+        aPlanes[j] = a1 ^ RotateRows2(t[j]);
+    }
+
+    // multiplication by 2 in GF(2^8), reducing by x^8 + x^4 + x^3 + x + 1
+    aPlanes[0] ^= t[7];
+    aPlanes[1] ^= t[0] ^ t[7];
+    aPlanes[2] ^= t[1];
+    aPlanes[3] ^= t[2] ^ t[7];
+    aPlanes[4] ^= t[3] ^ t[7];
+    aPlanes[5] ^= t[4];
+    aPlanes[6] ^= t[5];
+    aPlanes[7] ^= t[6];
+}
+
+static inline void AddRoundKey(uint64_t aPlanes[8], const uint64_t aKey[8])
+{
+    for (uint8_t j = 0; j < 8; j++)
+    {
+        aPlanes[j] ^= aKey[j];
+    }
+}
+
+#if AES_BATCH_AESNI
+
+static inline __attribute__((target("aes,sse2"))) __m128i ExpandKeyAesNi(__m128i aKey, __m128i aAssist)
+{
+    aAssist = _mm_shuffle_epi32(aAssist, 0xff);
+    aKey = _mm_xor_si128(aKey, _mm_slli_si128(aKey, 4));
+    aKey = _mm_xor_si128(aKey, _mm_slli_si128(aKey, 4));
+    aKey = _mm_xor_si128(aKey, _mm_slli_si128(aKey, 4));
+    return _mm_xor_si128(aKey, aAssist);
+}
+
+static __attribute__((target("aes,sse2"))) void SetKeyAesNi(const uint8_t *aKey, uint8_t aRoundKeys[][16])
+{
+    __m128i key = _mm_loadu_si128(reinterpret_cast<const __m128i *>(aKey));
+
+    // the round constant of _mm_aeskeygenassist_si128() must be an immediate
+#define AES_BATCH_EXPAND_KEY(aRound, aRcon)                                          \
+    key = ExpandKeyAesNi(key, _mm_aeskeygenassist_si128(key, aRcon));                \
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(aRoundKeys[aRound]), key)
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(aRoundKeys[0]), key);
+    AES_BATCH_EXPAND_KEY(1, 0x01);
+    AES_BATCH_EXPAND_KEY(2, 0x02);
+    AES_BATCH_EXPAND_KEY(3, 0x04);
+    AES_BATCH_EXPAND_KEY(4, 0x08);
+    AES_BATCH_EXPAND_KEY(5, 0x10);
+    AES_BATCH_EXPAND_KEY(6, 0x20);
+    AES_BATCH_EXPAND_KEY(7, 0x40);
+    AES_BATCH_EXPAND_KEY(8, 0x80);
+    AES_BATCH_EXPAND_KEY(9, 0x1b);
+    AES_BATCH_EXPAND_KEY(10, 0x36);
+
+#undef AES_BATCH_EXPAND_KEY
+}
+
+static __attribute__((target("aes,sse2"))) void EncryptAesNi(const uint8_t aRoundKeys[][16], const uint8_t *aInput,
+                                                                uint8_t *aOutput, uint16_t aCount)
+{
+    __m128i keys[11];
+    __m128i state[4];
+
+    for (uint8_t r = 0; r < 11; r++)
+    {
+        keys[r] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(aRoundKeys[r]));
+    }
+
+    // up to four blocks go through each round together, so that one block's latency hides behind the others
+    while (aCount > 0)
+    {
+        uint8_t count = aCount < 4 ? static_cast<uint8_t>(aCount) : 4;
+
+        for (uint8_t i = 0; i < count; i++)
+        {
+            state[i] = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(aInput) + i), keys[0]);
+        }
+
+        for (uint8_t r = 1; r < 10; r++)
+        {
+            for (uint8_t i = 0; i < count; i++)
+            {
+                state[i] = _mm_aesenc_si128(state[i], keys[r]);
+            }
+        }
+
+        for (uint8_t i = 0; i < count; i++)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(aOutput) + i, _mm_aesenclast_si128(state[i], keys[10]));
+        }
+
+        aInput += count * AesBatch::kBlockSize;
+        aOutput += count * AesBatch::kBlockSize;
+        aCount -= count;
+    }
+}
+
+#endif  // AES_BATCH_AESNI
+
+#if AES_BATCH_ARM_CRYPTO
+
+static void EncryptArmCrypto(const uint8_t aRoundKeys[][16], const uint8_t *aInput, uint8_t *aOutput,
+                             uint16_t aCount)
+{
+    uint8x16_t keys[11];
+    uint8x16_t state[4];
+
+    for (uint8_t r = 0; r < 11; r++)
+    {
+        keys[r] = vld1q_u8(aRoundKeys[r]);
+    }
+
+    while (aCount > 0)
+    {
+        uint8_t count = aCount < 4 ? static_cast<uint8_t>(aCount) : 4;
+
+        for (uint8_t i = 0; i < count; i++)
+        {
+            state[i] = vld1q_u8(aInput + i * AesBatch::kBlockSize);
+        }
+
+        // AESE adds the round key before SubBytes and ShiftRows, so the last round key is added separately
+        for (uint8_t r = 0; r < 9; r++)
+        {
+            for (uint8_t i = 0; i < count; i++)
+            {
+                state[i] = vaesmcq_u8(vaeseq_u8(state[i], keys[r]));
+            }
+        }
+
+        for (uint8_t i = 0; i < count; i++)
+        {
+            vst1q_u8(aOutput + i * AesBatch::kBlockSize, veorq_u8(vaeseq_u8(state[i], keys[9]), keys[10]));
+        }
+
+        aInput += count * AesBatch::kBlockSize;
+        aOutput += count * AesBatch::kBlockSize;
+        aCount -= count;
+    }
+}
+
+#endif  // AES_BATCH_ARM_CRYPTO
+
+bool AesBatch::IsSupported(Backend aBackend)
+{
+    bool rval = false;
+
+    switch (aBackend)
+    {
+    case kBackendBitsliced:
+        rval = true;
+        break;
+
+    case kBackendAesNi:
+#if AES_BATCH_AESNI
+    {
+        static int8_t sSupported = -1;
+
+        if (sSupported < 0)
+        {
+            unsigned int eax, ebx, ecx, edx;
+
+            sSupported = (__get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_AES) && (edx & bit_SSE2)) ? 1 : 0;
+        }
+
+        rval = (sSupported == 1);
+    }
+#endif
+    break;
+
+    case kBackendArmCrypto:
+        rval = AES_BATCH_ARM_CRYPTO;
+        break;
+    }
+
+    return rval;
+}
+
+AesBatch::Backend AesBatch::GetBestBackend(void)
+{
+    Backend rval = kBackendBitsliced;
+
+    if (IsSupported(kBackendAesNi))
+    {
+        rval = kBackendAesNi;
+    }
+    else if (IsSupported(kBackendArmCrypto))
+    {
+        rval = kBackendArmCrypto;
+    }
+
+    return rval;
+}
+
+void AesBatch::ExpandKey(const uint8_t *aKey)
+{
+    static const uint8_t kRcon[kRounds] = { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36 };
+
+    memcpy(mRoundKeys[0], aKey, kKeySize);
+
+    for (uint8_t r = 1; r <= kRounds; r++)
+    {
+        uint8_t word[4];
+
+        // RotWord, SubWord and the round constant on the last word of the previous round key
+        word[0] = mRoundKeys[r - 1][13];
+        word[1] = mRoundKeys[r - 1][14];
+        word[2] = mRoundKeys[r - 1][15];
+        word[3] = mRoundKeys[r - 1][12];
+        SubBytes(word, sizeof(word));
+        word[0] ^= kRcon[r - 1];
+
+        for (uint8_t i = 0; i < kBlockSize; i++)
+        {
+            mRoundKeys[r][i] = mRoundKeys[r - 1][i] ^ (i < 4 ? word[i] : mRoundKeys[r][i - 4]);
+        }
+    }
+}
+
+void AesBatch::SetKey(const uint8_t *aKey, Backend aBackend)
+{
+    assert(IsSupported(aBackend));
+
+    mBackend = aBackend;
+
+    switch (aBackend)
+    {
+    case kBackendBitsliced:
+    {
+        uint8_t roundKeys[kRounds + 1][kBlockSize];
+        uint8_t key[kBitslicedBlocks * kBlockSize];
+
+        // the round keys are computed as bytes, then sliced with each byte repeated for the four blocks
+        ExpandKey(aKey);
+        memcpy(roundKeys, mRoundKeys, sizeof(roundKeys));
+
+        for (uint8_t r = 0; r <= kRounds; r++)
+        {
+            for (uint8_t b = 0; b < kBitslicedBlocks; b++)
+            {
+                memcpy(key + b * kBlockSize, roundKeys[r], kBlockSize);
+            }
+
+            Pack(key, kBitslicedBlocks, mSlicedKeys[r]);
+        }
+
+        break;
+    }
+
+    case kBackendAesNi:
+#if AES_BATCH_AESNI
+        SetKeyAesNi(aKey, mRoundKeys);
+#endif
+        break;
+
+    case kBackendArmCrypto:
+        ExpandKey(aKey);
+        break;
+    }
+}
+
+void AesBatch::EncryptBitsliced(const uint8_t *aInput, uint8_t *aOutput, uint16_t aCount) const
+{
+    uint64_t planes[8];
+
+    while (aCount > 0)
+    {
+        uint16_t count = aCount < kBitslicedBlocks ? aCount : static_cast<uint16_t>(kBitslicedBlocks);
+
+        Pack(aInput, count, planes);
+        AddRoundKey(planes, mSlicedKeys[0]);
+
+        for (uint8_t r = 1; r < kRounds; r++)
+        {
+            SubBytes(planes);
+            ShiftRows(planes);
+            MixColumns(planes);
+            AddRoundKey(planes, mSlicedKeys[r]);
+        }
+
+        SubBytes(planes);
+        ShiftRows(planes);
+        AddRoundKey(planes, mSlicedKeys[kRounds]);
+        Unpack(planes, aOutput, count);
+
+        aInput += count * kBlockSize;
+        aOutput += count * kBlockSize;
+        aCount -= count;
+    }
+}
+
+void AesBatch::Encrypt(const uint8_t *aInput, uint8_t *aOutput, uint16_t aCount) const
+{
+    switch (mBackend)
+    {
+    case kBackendBitsliced:
+        EncryptBitsliced(aInput, aOutput, aCount);
+        break;
+
+    case kBackendAesNi:
+#if AES_BATCH_AESNI
+        EncryptAesNi(mRoundKeys, aInput, aOutput, aCount);
+#endif
+        break;
+
+    case kBackendArmCrypto:
+#if AES_BATCH_ARM_CRYPTO
+        EncryptArmCrypto(mRoundKeys, aInput, aOutput, aCount);
+#endif
+        break;
+    }
+}
+
+}  // namespace Crypto
+}  // namespace Thread
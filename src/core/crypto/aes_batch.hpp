@@ -0,0 +1,158 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for encrypting several AES-128 blocks at once.
+ */
+
+#ifndef AES_BATCH_HPP_
+#define AES_BATCH_HPP_
+
+#include <stdint.h>
+
+namespace Thread {
+namespace Crypto {
+
+/**
+ * @addtogroup core-security
+ *
+ * @{
+ *
+ */
+
+/**
+ * This class implements AES-128 encryption of several independent blocks in one call.
+ *
+ * The blocks are encrypted with the AES instructions of the processor when available (AES-NI on x86, the ARMv8
+ * Cryptography Extensions on ARM), and otherwise with a constant-time bitsliced implementation that encrypts four
+ * blocks in one pass.  Either way, passing several blocks at once keeps the processor busy while each block waits
+ * for the result of its previous round.
+ *
+ */
+class AesBatch
+{
+public:
+    enum
+    {
+        kBlockSize = 16,  ///< AES block size (bytes).
+        kKeySize   = 16,  ///< AES-128 key size (bytes).
+    };
+
+    /**
+     * This enumeration represents the implementations of the block cipher.
+     *
+     */
+    enum Backend
+    {
+        kBackendBitsliced,  ///< Constant-time bitsliced implementation, available everywhere.
+        kBackendAesNi,      ///< x86 AES-NI instructions.
+        kBackendArmCrypto,  ///< ARMv8 Cryptography Extensions.
+    };
+
+    /**
+     * This method sets the key and selects the fastest implementation available.
+     *
+     * @param[in]  aKey  A pointer to the 128-bit key.
+     *
+     */
+    void SetKey(const uint8_t *aKey) { SetKey(aKey, GetBestBackend()); }
+
+    /**
+     * This method sets the key and selects the given implementation.
+     *
+     * @param[in]  aKey      A pointer to the 128-bit key.
+     * @param[in]  aBackend  The implementation, which must be supported (see IsSupported()).
+     *
+     */
+    void SetKey(const uint8_t *aKey, Backend aBackend);
+
+    /**
+     * This method returns the implementation selected by the last call to SetKey().
+     *
+     * @returns The implementation in use.
+     *
+     */
+    Backend GetBackend(void) const { return mBackend; }
+
+    /**
+     * This method encrypts consecutive blocks.
+     *
+     * @param[in]   aInput   A pointer to @p aCount blocks of input.
+     * @param[out]  aOutput  A pointer to @p aCount blocks of output, which may be the same as @p aInput.
+     * @param[in]   aCount   The number of blocks.
+     *
+     */
+    void Encrypt(const uint8_t *aInput, uint8_t *aOutput, uint16_t aCount) const;
+
+    /**
+     * This static method indicates whether an implementation is available on this processor.
+     *
+     * @param[in]  aBackend  The implementation.
+     *
+     * @retval TRUE   If @p aBackend is available.
+     * @retval FALSE  If @p aBackend is not available.
+     *
+     */
+    static bool IsSupported(Backend aBackend);
+
+    /**
+     * This static method returns the fastest implementation available on this processor.
+     *
+     * @returns The fastest implementation.
+     *
+     */
+    static Backend GetBestBackend(void);
+
+private:
+    enum
+    {
+        kRounds          = 10,
+        kBitslicedBlocks = 4,  ///< Blocks encrypted by one pass of the bitsliced implementation.
+    };
+
+    void ExpandKey(const uint8_t *aKey);
+    void EncryptBitsliced(const uint8_t *aInput, uint8_t *aOutput, uint16_t aCount) const;
+
+    union
+    {
+        uint8_t  mRoundKeys[kRounds + 1][kBlockSize];  ///< Round keys of the hardware implementations.
+        uint64_t mSlicedKeys[kRounds + 1][8];           ///< Round keys of the bitsliced implementation.
+    };
+    Backend mBackend;
+};
+
+/**
+ * @}
+ *
+ */
+
+}  // namespace Crypto
+}  // namespace Thread
+
+#endif  // AES_BATCH_HPP_
@@ -0,0 +1,345 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements AES-CCM on several frames at once.
+ */
+
+#include <string.h>
+
+#include <common/code_utils.hpp>
+#include <common/debug.hpp>
+#include <crypto/aes_ccm_batch.hpp>
+
+namespace Thread {
+namespace Crypto {
+
+// Each frame goes through 1 + h + n steps, with h the blocks of its header and n the blocks of its payload:
+//
+// - step 0 computes the first CBC-MAC block B0,
+// - steps 1 to h add the header blocks to the CBC-MAC,
+// - step h + i encrypts (or decrypts) payload block i and adds its plaintext to the CBC-MAC.
+//
+// The key stream block of payload block i is computed one step ahead, in step h + i - 1, and the one of the tag in
+// the last step, so that decrypting never waits for it.  A frame without a tag has no CBC-MAC, and h is then 0.
+
+ThreadError AesCcmBatch::SetKey(const uint8_t *aKey, uint16_t aKeyLength)
+{
+    return SetKey(aKey, aKeyLength, AesBatch::GetBestBackend());
+}
+
+ThreadError AesCcmBatch::SetKey(const uint8_t *aKey, uint16_t aKeyLength, AesBatch::Backend aBackend)
+{
+    ThreadError error = kThreadError_None;
+
+    VerifyOrExit(aKeyLength == AesBatch::kKeySize, error = kThreadError_InvalidArgs);
+    mAes.SetKey(aKey, aBackend);
+
+exit:
+    return error;
+}
+
+void AesCcmBatch::InitLane(Lane &aLane, const Frame &aFrame)
+{
+    const uint8_t *nonce = static_cast<const uint8_t *>(aFrame.mNonce);
+    uint8_t tagLength = aFrame.mTagLength & ~1;
+    uint8_t nonceLength = aFrame.mNonceLength;
+    uint32_t len;
+    uint8_t L = 0;
+
+    // the lengths are adjusted as in AesCcm::Init()
+    if (tagLength > AesBatch::kBlockSize)
+    {
+        tagLength = AesBatch::kBlockSize;
+    }
+
+    for (len = aFrame.mPayloadLength; len; len >>= 8)
+    {
+        L++;
+    }
+
+    if (L <= 1)
+    {
+        L = 2;
+    }
+
+    if (nonceLength > 13)
+    {
+        nonceLength = 13;
+    }
+
+    if (L < (15 - nonceLength))
+    {
+        L = 15 - nonceLength;
+    }
+
+    if (nonceLength > (15 - L))
+    {
+        nonceLength = 15 - L;
+    }
+
+    aLane.mFrame = &aFrame;
+    aLane.mNonceLength = nonceLength;
+    aLane.mTagLength = tagLength;
+
+    // counter block template
+    memset(aLane.mCounter, 0, sizeof(aLane.mCounter));
+    aLane.mCounter[0] = L - 1;
+    memcpy(aLane.mCounter + 1, nonce, nonceLength);
+
+    // first CBC-MAC block
+    aLane.mMac[0] = (static_cast<uint8_t>((aFrame.mHeaderLength != 0) << 6) |
+                     static_cast<uint8_t>(((tagLength - 2) >> 1) << 3) |
+                     static_cast<uint8_t>(L - 1));
+    memcpy(aLane.mMac + 1, nonce, nonceLength);
+    len = aFrame.mPayloadLength;
+
+    for (uint8_t i = sizeof(aLane.mMac) - 1; i > nonceLength; i--)
+    {
+        aLane.mMac[i] = len & 0xff;
+        len >>= 8;
+    }
+
+    // the header is preceded by its length
+    aLane.mPrefixLength = 0;
+
+    if (aFrame.mHeaderLength > 0)
+    {
+        if (aFrame.mHeaderLength < (65536U - 256U))
+        {
+            aLane.mPrefix[aLane.mPrefixLength++] = static_cast<uint8_t>(aFrame.mHeaderLength >> 8);
+            aLane.mPrefix[aLane.mPrefixLength++] = static_cast<uint8_t>(aFrame.mHeaderLength >> 0);
+        }
+        else
+        {
+            aLane.mPrefix[aLane.mPrefixLength++] = 0xff;
+            aLane.mPrefix[aLane.mPrefixLength++] = 0xfe;
+            aLane.mPrefix[aLane.mPrefixLength++] = static_cast<uint8_t>(aFrame.mHeaderLength >> 24);
+            aLane.mPrefix[aLane.mPrefixLength++] = static_cast<uint8_t>(aFrame.mHeaderLength >> 16);
+            aLane.mPrefix[aLane.mPrefixLength++] = static_cast<uint8_t>(aFrame.mHeaderLength >> 8);
+            aLane.mPrefix[aLane.mPrefixLength++] = static_cast<uint8_t>(aFrame.mHeaderLength >> 0);
+        }
+    }
+
+    aLane.mHeaderBlocks = 0;
+
+    if (tagLength > 0 && aFrame.mHeaderLength > 0)
+    {
+        aLane.mHeaderBlocks = (aLane.mPrefixLength + aFrame.mHeaderLength + AesBatch::kBlockSize - 1) /
+                              AesBatch::kBlockSize;
+    }
+
+    aLane.mPayloadBlocks = (aFrame.mPayloadLength + AesBatch::kBlockSize - 1) / AesBatch::kBlockSize;
+    aLane.mSteps = 1 + aLane.mHeaderBlocks + aLane.mPayloadBlocks;
+}
+
+void AesCcmBatch::AddHeaderBlock(const Lane &aLane, uint32_t aIndex, uint8_t *aBlock)
+{
+    const uint8_t *header = static_cast<const uint8_t *>(aLane.mFrame->mHeader);
+    uint32_t position = aIndex * AesBatch::kBlockSize;
+
+    for (uint8_t i = 0; i < AesBatch::kBlockSize; i++, position++)
+    {
+        if (position < aLane.mPrefixLength)
+        {
+            aBlock[i] ^= aLane.mPrefix[position];
+        }
+        else if (position - aLane.mPrefixLength < aLane.mFrame->mHeaderLength)
+        {
+            aBlock[i] ^= header[position - aLane.mPrefixLength];
+        }
+    }
+}
+
+void AesCcmBatch::CryptPayloadBlock(const Lane &aLane, uint32_t aIndex, bool aEncrypt, uint8_t *aPlainText)
+{
+    uint32_t offset = aIndex * AesBatch::kBlockSize;
+    uint8_t *plainText = static_cast<uint8_t *>(aLane.mFrame->mPlainText) + offset;
+    uint8_t *cipherText = static_cast<uint8_t *>(aLane.mFrame->mCipherText) + offset;
+    uint32_t length = aLane.mFrame->mPayloadLength - offset;
+    uint8_t byte;
+
+    if (length > AesBatch::kBlockSize)
+    {
+        length = AesBatch::kBlockSize;
+    }
+
+    memset(aPlainText, 0, AesBatch::kBlockSize);
+
+    for (uint8_t i = 0; i < length; i++)
+    {
+        if (aEncrypt)
+        {
+            byte = plainText[i];
+            cipherText[i] = byte ^ aLane.mPad[i];
+        }
+        else
+        {
+            byte = cipherText[i] ^ aLane.mPad[i];
+            plainText[i] = byte;
+        }
+
+        aPlainText[i] = byte;
+    }
+}
+
+void AesCcmBatch::SetCounter(const Lane &aLane, uint32_t aCounter, uint8_t *aBlock)
+{
+    memcpy(aBlock, aLane.mCounter, AesBatch::kBlockSize);
+
+    for (uint8_t i = AesBatch::kBlockSize - 1; i > aLane.mNonceLength && aCounter != 0; i--)
+    {
+        aBlock[i] = aCounter & 0xff;
+        aCounter >>= 8;
+    }
+}
+
+void AesCcmBatch::ProcessGroup(const Frame *aFrames, uint8_t aNumFrames, bool aEncrypt)
+{
+    Lane lanes[kMaxFrames];
+    uint8_t blocks[2 * kMaxFrames][AesBatch::kBlockSize];
+    uint8_t plainText[AesBatch::kBlockSize];
+    uint32_t steps = 0;
+
+    for (uint8_t i = 0; i < aNumFrames; i++)
+    {
+        InitLane(lanes[i], aFrames[i]);
+
+        if (lanes[i].mSteps > steps)
+        {
+            steps = lanes[i].mSteps;
+        }
+    }
+
+    for (uint32_t step = 0; step < steps; step++)
+    {
+        uint8_t count = 0;
+
+        for (uint8_t i = 0; i < aNumFrames; i++)
+        {
+            Lane &lane = lanes[i];
+            uint32_t headerBlocks = lane.mHeaderBlocks;
+
+            lane.mMacSlot = kNoSlot;
+            lane.mCounterSlot = kNoSlot;
+
+            if (step >= lane.mSteps)
+            {
+                continue;
+            }
+
+            if (step > headerBlocks)
+            {
+                CryptPayloadBlock(lane, step - headerBlocks - 1, aEncrypt, plainText);
+            }
+
+            if (lane.mTagLength > 0)
+            {
+                uint8_t *block = blocks[count];
+
+                memcpy(block, lane.mMac, AesBatch::kBlockSize);
+
+                if (step > headerBlocks)
+                {
+                    for (uint8_t j = 0; j < AesBatch::kBlockSize; j++)
+                    {
+                        block[j] ^= plainText[j];
+                    }
+                }
+                else if (step > 0)
+                {
+                    AddHeaderBlock(lane, step - 1, block);
+                }
+
+                lane.mMacSlot = count++;
+            }
+
+            if (step + 1 >= headerBlocks)
+            {
+                uint32_t counter = step + 1 - headerBlocks;
+
+                if (counter >= 1 && counter <= lane.mPayloadBlocks)
+                {
+                    SetCounter(lane, counter, blocks[count]);
+                    lane.mCounterSlot = count++;
+                }
+                else if (counter == lane.mPayloadBlocks + 1 && lane.mTagLength > 0)
+                {
+                    SetCounter(lane, 0, blocks[count]);
+                    lane.mCounterSlot = count++;
+                }
+            }
+        }
+
+        mAes.Encrypt(blocks[0], blocks[0], count);
+
+        for (uint8_t i = 0; i < aNumFrames; i++)
+        {
+            Lane &lane = lanes[i];
+
+            if (lane.mMacSlot != kNoSlot)
+            {
+                memcpy(lane.mMac, blocks[lane.mMacSlot], AesBatch::kBlockSize);
+            }
+
+            if (lane.mCounterSlot != kNoSlot)
+            {
+                // the key stream of the tag is the last one computed
+                memcpy(step + 1 - lane.mHeaderBlocks <= lane.mPayloadBlocks ? lane.mPad : lane.mTagPad,
+                       blocks[lane.mCounterSlot], AesBatch::kBlockSize);
+            }
+        }
+    }
+
+    for (uint8_t i = 0; i < aNumFrames; i++)
+    {
+        uint8_t *tag = static_cast<uint8_t *>(aFrames[i].mTag);
+
+        for (uint8_t j = 0; j < lanes[i].mTagLength; j++)
+        {
+            tag[j] = lanes[i].mMac[j] ^ lanes[i].mTagPad[j];
+        }
+    }
+}
+
+void AesCcmBatch::Process(const Frame *aFrames, uint16_t aNumFrames, bool aEncrypt)
+{
+    while (aNumFrames > 0)
+    {
+        uint8_t numFrames = static_cast<uint8_t>((aNumFrames < kMaxFrames) ?
+                                                 aNumFrames : static_cast<uint16_t>(kMaxFrames));
+
+        ProcessGroup(aFrames, numFrames, aEncrypt);
+        aFrames += numFrames;
+        aNumFrames -= numFrames;
+    }
+}
+
+}  // namespace Crypto
+}  // namespace Thread
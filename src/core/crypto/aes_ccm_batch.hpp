@@ -0,0 +1,160 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for performing AES-CCM computations on several frames at once.
+ */
+
+#ifndef AES_CCM_BATCH_HPP_
+#define AES_CCM_BATCH_HPP_
+
+#include <openthread-types.h>
+#include <crypto/aes_batch.hpp>
+
+namespace Thread {
+namespace Crypto {
+
+/**
+ * @addtogroup core-security
+ *
+ * @{
+ *
+ */
+
+/**
+ * This class implements AES-CCM computation on several frames sharing a key.
+ *
+ * The frames advance together, one block of each frame's CBC-MAC and one block of its key stream per step, and every
+ * step encrypts all those blocks in one call to AesBatch.  The results are the same as those of AesCcm.
+ *
+ */
+class AesCcmBatch
+{
+public:
+    enum
+    {
+        kMaxFrames = 4,  ///< Frames advancing together (larger batches are processed in groups of this size).
+    };
+
+    /**
+     * This structure describes one frame.
+     *
+     */
+    struct Frame
+    {
+        const void *mNonce;          ///< A pointer to the nonce.
+        uint8_t     mNonceLength;    ///< Length of the nonce in bytes.
+        const void *mHeader;         ///< A pointer to the header, which is authenticated but not encrypted.
+        uint32_t    mHeaderLength;   ///< Length of the header in bytes.
+        void       *mPlainText;      ///< A pointer to the plaintext.
+        void       *mCipherText;     ///< A pointer to the ciphertext, which may be the same as the plaintext.
+        uint32_t    mPayloadLength;  ///< Length of the payload in bytes.
+        void       *mTag;            ///< A pointer to the tag, written on both encrypt and decrypt.
+        uint8_t     mTagLength;      ///< Length of the tag in bytes, rounded down to even and at most 16.
+    };
+
+    /**
+     * This method sets the key and selects the fastest AES implementation available.
+     *
+     * @param[in]  aKey        A pointer to the key.
+     * @param[in]  aKeyLength  Length of the key in bytes.
+     *
+     * @retval kThreadError_None         Successfully set the key.
+     * @retval kThreadError_InvalidArgs  The key is not an AES-128 key.
+     *
+     */
+    ThreadError SetKey(const uint8_t *aKey, uint16_t aKeyLength);
+
+    /**
+     * This method sets the key and selects the given AES implementation.
+     *
+     * @param[in]  aKey        A pointer to the key.
+     * @param[in]  aKeyLength  Length of the key in bytes.
+     * @param[in]  aBackend    The AES implementation, which must be supported.
+     *
+     * @retval kThreadError_None         Successfully set the key.
+     * @retval kThreadError_InvalidArgs  The key is not an AES-128 key.
+     *
+     */
+    ThreadError SetKey(const uint8_t *aKey, uint16_t aKeyLength, AesBatch::Backend aBackend);
+
+    /**
+     * This method encrypts, or decrypts, frames and generates their tags.
+     *
+     * On decrypt, the caller compares the generated tags with the received ones, as with AesCcm::Finalize().
+     *
+     * @param[in]  aFrames     A pointer to the frames.
+     * @param[in]  aNumFrames  The number of frames.
+     * @param[in]  aEncrypt    TRUE on encrypt and FALSE on decrypt.
+     *
+     */
+    void Process(const Frame *aFrames, uint16_t aNumFrames, bool aEncrypt);
+
+private:
+    struct Lane
+    {
+        const Frame *mFrame;
+        uint8_t      mMac[AesBatch::kBlockSize];
+        uint8_t      mPad[AesBatch::kBlockSize];
+        uint8_t      mTagPad[AesBatch::kBlockSize];
+        uint8_t      mCounter[AesBatch::kBlockSize];
+        uint8_t      mPrefix[6];
+        uint8_t      mPrefixLength;
+        uint8_t      mNonceLength;
+        uint8_t      mTagLength;
+        uint8_t      mMacSlot;
+        uint8_t      mCounterSlot;
+        uint32_t     mHeaderBlocks;
+        uint32_t     mPayloadBlocks;
+        uint32_t     mSteps;
+    };
+
+    enum
+    {
+        kNoSlot = 0xff,
+    };
+
+    static void InitLane(Lane &aLane, const Frame &aFrame);
+    static void AddHeaderBlock(const Lane &aLane, uint32_t aIndex, uint8_t *aBlock);
+    static void CryptPayloadBlock(const Lane &aLane, uint32_t aIndex, bool aEncrypt, uint8_t *aPlainText);
+    static void SetCounter(const Lane &aLane, uint32_t aCounter, uint8_t *aBlock);
+    void ProcessGroup(const Frame *aFrames, uint8_t aNumFrames, bool aEncrypt);
+
+    AesBatch mAes;
+};
+
+/**
+ * @}
+ *
+ */
+
+}  // namespace Crypto
+}  // namespace Thread
+
+#endif  // AES_CCM_BATCH_HPP_
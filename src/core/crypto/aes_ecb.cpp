@@ -38,13 +38,33 @@ namespace Crypto {
 
 void AesEcb::SetKey(const uint8_t *aKey, uint16_t aKeyLength)
 {
-    mbedtls_aes_init(&mContext);
-    mbedtls_aes_setkey_enc(&mContext, aKey, aKeyLength);
+#if OPENTHREAD_CONFIG_AES_OPTIMIZED
+    mUseBatch = (aKeyLength == 8 * AesBatch::kKeySize);
+
+    if (mUseBatch)
+    {
+        mBatch.SetKey(aKey);
+    }
+    else
+#endif
+    {
+        mbedtls_aes_init(&mContext);
+        mbedtls_aes_setkey_enc(&mContext, aKey, aKeyLength);
+    }
 }
 
 void AesEcb::Encrypt(const uint8_t aInput[kBlockSize], uint8_t aOutput[kBlockSize])
 {
-    mbedtls_aes_crypt_ecb(&mContext, MBEDTLS_AES_ENCRYPT, aInput, aOutput);
+#if OPENTHREAD_CONFIG_AES_OPTIMIZED
+    if (mUseBatch)
+    {
+        mBatch.Encrypt(aInput, aOutput, 1);
+    }
+    else
+#endif
+    {
+        mbedtls_aes_crypt_ecb(&mContext, MBEDTLS_AES_ENCRYPT, aInput, aOutput);
+    }
 }
 
 }  // namespace Crypto
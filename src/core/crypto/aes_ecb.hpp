@@ -34,8 +34,13 @@
 #ifndef AES_ECB_HPP_
 #define AES_ECB_HPP_
 
+#include <openthread-core-config.h>
 #include <mbedtls/aes.h>
 
+#if OPENTHREAD_CONFIG_AES_OPTIMIZED
+#include <crypto/aes_batch.hpp>
+#endif
+
 namespace Thread {
 namespace Crypto {
 
@@ -77,7 +82,16 @@ public:
     void Encrypt(const uint8_t aInput[kBlockSize], uint8_t aOutput[kBlockSize]);
 
 private:
+#if OPENTHREAD_CONFIG_AES_OPTIMIZED
+    union
+    {
+        mbedtls_aes_context mContext;
+        AesBatch mBatch;  ///< Used for AES-128 keys.
+    };
+    bool mUseBatch;
+#else
     mbedtls_aes_context mContext;
+#endif
 };
 
 /**
@@ -45,6 +45,7 @@
 #include <common/debug.hpp>
 #include <common/encoding.hpp>
 #include <common/logging.hpp>
+#include <common/perf_counters.hpp>
 #include <crypto/aes_ccm.hpp>
 #include <crypto/sha256.hpp>
 #include <mac/mac.hpp>
@@ -88,20 +89,41 @@ void Mac::StartCsmaBackoff(void)
         backoffExponent = kMaxBE;
     }
 
+#if OPENTHREAD_ENABLE_PERF_COUNTERS
+
+    if (mState == kStateTransmitData && mCsmaAttempts == 0 && mTransmitAttempts == 0)
+    {
+        mTxStartTime = Timer::GetNow();
+    }
+
+#endif
+
+#if OPENTHREAD_ENABLE_PLATFORM_USEC_TIMER
+    // Wait a random number of unit backoff periods in [0, 2^BE - 1] (IEEE 802.15.4-2006, 7.5.1.4).
+    backoff = (otPlatRandomGet() % (1UL << backoffExponent)) * kUnitBackoffPeriod * kPhyUsPerSymbol;
+#else
     backoff = kMinBackoff + (kUnitBackoffPeriod * kPhyUsPerSymbol * (1 << backoffExponent)) / 1000;
     backoff = otPlatRandomGet() % backoff;
+#endif
 
     mBackoffTimer.Start(backoff);
 }
 
 Mac::Mac(ThreadNetif &aThreadNetif):
     mMacTimer(aThreadNetif.GetIp6().mTimerScheduler, &Mac::HandleMacTimer, this),
+#if OPENTHREAD_ENABLE_PLATFORM_USEC_TIMER
+    mBackoffTimer(aThreadNetif.GetIp6().mTimerMicroScheduler, &Mac::HandleBeginTransmit, this),
+    mAckTimer(aThreadNetif.GetIp6().mTimerMicroScheduler, &Mac::HandleMacTimer, this),
+#else
     mBackoffTimer(aThreadNetif.GetIp6().mTimerScheduler, &Mac::HandleBeginTransmit, this),
+    mAckTimer(aThreadNetif.GetIp6().mTimerScheduler, &Mac::HandleMacTimer, this),
+#endif
     mReceiveTimer(aThreadNetif.GetIp6().mTimerScheduler, &Mac::HandleReceiveTimer, this),
+    mCslTimer(aThreadNetif.GetIp6().mTimerScheduler, &Mac::HandleCslTimer, this),
     mKeyManager(aThreadNetif.GetKeyManager()),
     mMle(aThreadNetif.GetMle()),
     mNetif(aThreadNetif),
-    mEnergyScanSampleRssiTask(aThreadNetif.GetIp6().mTaskletScheduler, &Mac::HandleEnergyScanSampleRssi, this),
+    mEnergyScanSampleRssiTimer(aThreadNetif.GetIp6().mTimerScheduler, &Mac::HandleEnergyScanSampleRssi, this),
     mWhitelist(),
     mBlacklist()
 {
@@ -112,6 +134,14 @@ Mac::Mac(ThreadNetif &aThreadNetif):
     mTransmitAttempts = 0;
     mTransmitBeacon = false;
 
+#if OPENTHREAD_ENABLE_PERF_COUNTERS
+    mTxStartTime = 0;
+#endif
+
+    mCslPeriod = 0;
+    mCslSampleTime = 0;
+    mCslSampling = false;
+
     mPendingScanRequest = kScanTypeNone;
     mScanChannel = kPhyMinChannel;
     mScanChannels = 0xff;
@@ -120,8 +150,11 @@ Mac::Mac(ThreadNetif &aThreadNetif):
     mActiveScanHandler = NULL;
     mEnergyScanHandler = NULL;
     mEnergyScanCurrentMaxRssi = kInvalidRssiValue;
+    mEnergyScanRssiSum = 0;
+    mEnergyScanSampleCount = 0;
 
     mSendHead = NULL;
+    mPreparedSender = NULL;
     mSendTail = NULL;
     mReceiveHead = NULL;
     mReceiveTail = NULL;
@@ -235,8 +268,11 @@ void Mac::StartEnergyScan(void)
     if (!(otPlatRadioGetCaps(mNetif.GetInstance()) & kRadioCapsEnergyScan))
     {
         mEnergyScanCurrentMaxRssi = kInvalidRssiValue;
+        mEnergyScanRssiSum = 0;
+        mEnergyScanSampleCount = 0;
+        memset(mEnergyScanRssiHistogram, 0, sizeof(mEnergyScanRssiHistogram));
         mMacTimer.Start(mScanDuration);
-        mEnergyScanSampleRssiTask.Post();
+        mEnergyScanSampleRssiTimer.Start(OPENTHREAD_CONFIG_ENERGY_SCAN_SAMPLE_INTERVAL);
         NextOperation();
     }
     else
@@ -259,14 +295,67 @@ extern "C" void otPlatRadioEnergyScanDone(otInstance *aInstance, int8_t aEnergyS
 
 void Mac::EnergyScanDone(int8_t aEnergyScanMaxRssi)
 {
-    // Trigger a energy scan handler callback if necessary
-    if (aEnergyScanMaxRssi != kInvalidRssiValue)
+    otEnergyScanResult result;
+
+    result.mChannel = mScanChannel;
+    result.mMaxRssi = aEnergyScanMaxRssi;
+    result.mAverageRssi = aEnergyScanMaxRssi;
+    result.mPercentileRssi = aEnergyScanMaxRssi;
+    result.mSampleCount = 0;
+
+    EnergyScanChannelDone(result);
+}
+
+void Mac::EnergyScanSampleDone(void)
+{
+    otEnergyScanResult result;
+    uint32_t rank;
+    uint32_t count = 0;
+    uint8_t bin = 0;
+
+    mEnergyScanSampleRssiTimer.Stop();
+
+    result.mChannel = mScanChannel;
+    result.mMaxRssi = mEnergyScanCurrentMaxRssi;
+    result.mAverageRssi = mEnergyScanCurrentMaxRssi;
+    result.mPercentileRssi = mEnergyScanCurrentMaxRssi;
+    result.mSampleCount = mEnergyScanSampleCount;
+
+    if (mEnergyScanSampleCount > 0)
     {
-        otEnergyScanResult result;
+        result.mAverageRssi = static_cast<int8_t>(mEnergyScanRssiSum / static_cast<int32_t>(mEnergyScanSampleCount));
+
+        // report the upper edge of the histogram bin holding the sample of the requested rank
+        rank = mEnergyScanSampleCount;
+        rank = (rank * OPENTHREAD_CONFIG_ENERGY_SCAN_RSSI_PERCENTILE + 99) / 100;
+
+        for (bin = 0; bin < kEnergyScanRssiBins - 1; bin++)
+        {
+            count += mEnergyScanRssiHistogram[bin];
+
+            if (count >= rank)
+            {
+                break;
+            }
+        }
 
-        result.mChannel = mScanChannel;
-        result.mMaxRssi = aEnergyScanMaxRssi;
-        mEnergyScanHandler(mScanContext, &result);
+        // the last bin also holds every sample above its range, so its upper edge is the maximum
+        if (bin < kEnergyScanRssiBins - 1 &&
+            kEnergyScanRssiMin + (bin + 1) * kEnergyScanRssiBinWidth - 1 < mEnergyScanCurrentMaxRssi)
+        {
+            result.mPercentileRssi = static_cast<int8_t>(kEnergyScanRssiMin + (bin + 1) * kEnergyScanRssiBinWidth - 1);
+        }
+    }
+
+    EnergyScanChannelDone(result);
+}
+
+void Mac::EnergyScanChannelDone(otEnergyScanResult &aResult)
+{
+    // Trigger a energy scan handler callback if necessary
+    if (aResult.mMaxRssi != kInvalidRssiValue)
+    {
+        mEnergyScanHandler(mScanContext, &aResult);
     }
 
     // Update to the next scan channel
@@ -301,6 +390,7 @@ void Mac::HandleEnergyScanSampleRssi(void *aContext)
 void Mac::HandleEnergyScanSampleRssi(void)
 {
     int8_t rssi;
+    uint8_t bin;
 
     VerifyOrExit(mState == kStateEnergyScan, ;);
 
@@ -312,9 +402,23 @@ void Mac::HandleEnergyScanSampleRssi(void)
         {
             mEnergyScanCurrentMaxRssi = rssi;
         }
+
+        if (mEnergyScanSampleCount < 0xffff)
+        {
+            bin = static_cast<uint8_t>((rssi - kEnergyScanRssiMin) / kEnergyScanRssiBinWidth);
+
+            if (bin >= kEnergyScanRssiBins)
+            {
+                bin = kEnergyScanRssiBins - 1;
+            }
+
+            mEnergyScanRssiHistogram[bin]++;
+            mEnergyScanRssiSum += rssi;
+            mEnergyScanSampleCount++;
+        }
     }
 
-    mEnergyScanSampleRssiTask.Post();
+    mEnergyScanSampleRssiTimer.Start(OPENTHREAD_CONFIG_ENERGY_SCAN_SAMPLE_INTERVAL);
 
 exit:
     return;
@@ -353,6 +457,77 @@ void Mac::SetRxOnWhenIdle(bool aRxOnWhenIdle)
     }
 }
 
+void Mac::SetCslPeriod(uint16_t aPeriod)
+{
+    // keep the sample grid already announced to the parent
+    VerifyOrExit(aPeriod != mCslPeriod, ;);
+
+    mCslPeriod = aPeriod;
+    mCslSampling = false;
+    mCslTimer.Stop();
+
+    if (mCslPeriod != 0)
+    {
+        mCslSampleTime = Timer::GetNow() + mCslPeriod + OPENTHREAD_CONFIG_CSL_RECEIVE_WINDOW / 2;
+        mCslTimer.Start(mCslPeriod);
+    }
+
+    if (mState == kStateIdle)
+    {
+        NextOperation();
+    }
+
+exit:
+    return;
+}
+
+uint16_t Mac::GetCslPhase(void) const
+{
+    int32_t phase = static_cast<int32_t>(mCslSampleTime - Timer::GetNow());
+
+    while (phase < 0)
+    {
+        phase += mCslPeriod;
+    }
+
+    return static_cast<uint16_t>(phase);
+}
+
+void Mac::HandleCslTimer(void *aContext)
+{
+    static_cast<Mac *>(aContext)->HandleCslTimer();
+}
+
+void Mac::HandleCslTimer(void)
+{
+    uint32_t now = Timer::GetNow();
+
+    if (!mCslSampling)
+    {
+        // the window opens half of its length ahead of the announced sample, tolerating drift in both directions
+        mCslSampling = true;
+        mCslTimer.Start(OPENTHREAD_CONFIG_CSL_RECEIVE_WINDOW);
+    }
+    else
+    {
+        mCslSampling = false;
+
+        // stay on the sample grid announced to the parent, even if the window was extended
+        do
+        {
+            mCslSampleTime += mCslPeriod;
+        }
+        while (static_cast<int32_t>(mCslSampleTime - OPENTHREAD_CONFIG_CSL_RECEIVE_WINDOW / 2 - now) <= 0);
+
+        mCslTimer.Start(mCslSampleTime - OPENTHREAD_CONFIG_CSL_RECEIVE_WINDOW / 2 - now);
+    }
+
+    if (mState == kStateIdle)
+    {
+        NextOperation();
+    }
+}
+
 const ExtAddress *Mac::GetExtAddress(void) const
 {
     return &mExtAddress;
@@ -523,7 +698,8 @@ void Mac::NextOperation(void)
         break;
 
     default:
-        if (mRxOnWhenIdle || mReceiveTimer.IsRunning() || otPlatRadioGetPromiscuous(mNetif.GetInstance()))
+        if (mRxOnWhenIdle || mReceiveTimer.IsRunning() || mCslSampling ||
+            otPlatRadioGetPromiscuous(mNetif.GetInstance()))
         {
             otPlatRadioReceive(mNetif.GetInstance(), mChannel);
         }
@@ -712,32 +888,52 @@ exit:
 
 void Mac::HandleBeginTransmit(void)
 {
-    Frame &sendFrame(*static_cast<Frame *>(otPlatRadioGetTransmitBuffer(mNetif.GetInstance())));
+    Frame *sendFrame = static_cast<Frame *>(otPlatRadioGetTransmitBuffer(mNetif.GetInstance()));
     ThreadError error = kThreadError_None;
+    bool secured = false;
 
     if (mCsmaAttempts == 0 && mTransmitAttempts == 0)
     {
-        sendFrame.SetPower(mMaxTransmitPower);
+        if (mState == kStateTransmitData && mPreparedSender != NULL)
+        {
+            // The frame prepared while the previous one was in flight sits in the standby buffer.
+            assert(mPreparedSender == mSendHead);
+            mPreparedSender = NULL;
+            otPlatRadioSwapTransmitBuffers(mNetif.GetInstance());
+            sendFrame = static_cast<Frame *>(otPlatRadioGetTransmitBuffer(mNetif.GetInstance()));
+        }
+
+        sendFrame->SetPower(mMaxTransmitPower);
 
         switch (mState)
         {
         case kStateActiveScan:
             otPlatRadioSetPanId(mNetif.GetInstance(), kPanIdBroadcast);
-            sendFrame.SetChannel(mScanChannel);
-            SendBeaconRequest(sendFrame);
-            sendFrame.SetSequence(0);
+            sendFrame->SetChannel(mScanChannel);
+            SendBeaconRequest(*sendFrame);
+            sendFrame->SetSequence(0);
             break;
 
         case kStateTransmitBeacon:
-            sendFrame.SetChannel(mChannel);
-            SendBeacon(sendFrame);
-            sendFrame.SetSequence(mBeaconSequence++);
+            sendFrame->SetChannel(mChannel);
+            SendBeacon(*sendFrame);
+            sendFrame->SetSequence(mBeaconSequence++);
             break;
 
         case kStateTransmitData:
-            sendFrame.SetChannel(mChannel);
-            SuccessOrExit(error = mSendHead->HandleFrameRequest(sendFrame));
-            sendFrame.SetSequence(mDataSequence);
+            sendFrame->SetChannel(mChannel);
+            error = mSendHead->HandleFrameRequest(*sendFrame);
+
+            if (error == kThreadError_Already)
+            {
+                // The sender kept the prepared frame, which is already secured with sequence number mDataSequence.
+                error = kThreadError_None;
+                secured = true;
+                break;
+            }
+
+            SuccessOrExit(error);
+            sendFrame->SetSequence(mDataSequence);
             break;
 
         default:
@@ -746,31 +942,40 @@ void Mac::HandleBeginTransmit(void)
         }
 
         // Security Processing
-        ProcessTransmitSecurity(sendFrame);
+        if (!secured)
+        {
+            ProcessTransmitSecurity(*sendFrame);
+        }
 
-        if (sendFrame.GetPower() > mMaxTransmitPower)
+        if (sendFrame->GetPower() > mMaxTransmitPower)
         {
-            sendFrame.SetPower(mMaxTransmitPower);
+            sendFrame->SetPower(mMaxTransmitPower);
         }
     }
 
-    error = otPlatRadioReceive(mNetif.GetInstance(), sendFrame.GetChannel());
+    error = otPlatRadioReceive(mNetif.GetInstance(), sendFrame->GetChannel());
     assert(error == kThreadError_None);
     error = otPlatRadioTransmit(mNetif.GetInstance());
     assert(error == kThreadError_None);
 
-    if (sendFrame.GetAckRequest() && !(otPlatRadioGetCaps(mNetif.GetInstance()) & kRadioCapsAckTimeout))
+    if (sendFrame->GetAckRequest() && !(otPlatRadioGetCaps(mNetif.GetInstance()) & kRadioCapsAckTimeout))
     {
-        mMacTimer.Start(kAckTimeout);
+#if OPENTHREAD_ENABLE_PLATFORM_USEC_TIMER
+        mAckTimer.Start(kAckTimeout * 1000u);
+#else
+        mAckTimer.Start(kAckTimeout);
+#endif
         otLogDebgMac("ack timer start");
     }
 
     if (mPcapCallback)
     {
-        sendFrame.mDidTX = true;
-        mPcapCallback(&sendFrame, mPcapCallbackContext);
+        sendFrame->mDidTX = true;
+        mPcapCallback(sendFrame, mPcapCallbackContext);
     }
 
+    PrepareNextFrame();
+
 exit:
 
     if (error != kThreadError_None)
@@ -779,6 +984,33 @@ exit:
     }
 }
 
+void Mac::PrepareNextFrame(void)
+{
+    Frame *nextFrame;
+
+    VerifyOrExit(mState == kStateTransmitData && mSendHead != NULL && mPreparedSender == NULL &&
+                 (otPlatRadioGetCaps(mNetif.GetInstance()) & kRadioCapsTransmitPipeline) != 0, ;);
+    VerifyOrExit((nextFrame = static_cast<Frame *>(otPlatRadioGetNextTransmitBuffer(mNetif.GetInstance()))) != NULL, ;);
+
+    nextFrame->SetPower(mMaxTransmitPower);
+    nextFrame->SetChannel(mChannel);
+
+    SuccessOrExit(mSendHead->HandleNextFrameRequest(*nextFrame));
+
+    nextFrame->SetSequence(mDataSequence + 1);
+    ProcessTransmitSecurity(*nextFrame);
+
+    if (nextFrame->GetPower() > mMaxTransmitPower)
+    {
+        nextFrame->SetPower(mMaxTransmitPower);
+    }
+
+    mPreparedSender = mSendHead;
+
+exit:
+    return;
+}
+
 extern "C" void otPlatRadioTransmitDone(otInstance *aInstance, bool aRxPending, ThreadError aError)
 {
     otLogFuncEntryMsg("%!otError!, aRxPending=%u", aError, aRxPending ? 1 : 0);
@@ -788,7 +1020,7 @@ extern "C" void otPlatRadioTransmitDone(otInstance *aInstance, bool aRxPending,
 
 void Mac::TransmitDoneTask(bool aRxPending, ThreadError aError)
 {
-    mMacTimer.Stop();
+    mAckTimer.Stop();
 
     mCounters.mTxTotal++;
 
@@ -860,7 +1092,7 @@ void Mac::HandleMacTimer(void)
         break;
 
     case kStateEnergyScan:
-        EnergyScanDone(mEnergyScanCurrentMaxRssi);
+        EnergyScanSampleDone();
         break;
 
     case kStateTransmitData:
@@ -963,6 +1195,17 @@ void Mac::SentFrame(ThreadError aError)
             mCounters.mTxData++;
         }
 
+#if OPENTHREAD_ENABLE_PERF_COUNTERS
+        otPerfRecordLatency(mNetif.GetIp6().mPerfCounters, mMacTxLatency, mTxStartTime);
+        otPerfCount(mNetif.GetIp6().mPerfCounters, mMacTxFrames);
+
+        if (aError != kThreadError_None)
+        {
+            otPerfCount(mNetif.GetIp6().mPerfCounters, mMacTxFailures);
+        }
+
+#endif
+
         sender = mSendHead;
         mSendHead = mSendHead->mNext;
 
@@ -1144,6 +1387,8 @@ void Mac::ReceiveDoneTask(Frame *aFrame, ThreadError aError)
         mPcapCallback(aFrame, mPcapCallbackContext);
     }
 
+    SuccessOrExit(error = aFrame->ParseHeader());
+
     aFrame->GetSrcAddr(srcaddr);
     neighbor = mMle.GetNeighbor(srcaddr);
 
@@ -1246,6 +1491,12 @@ void Mac::ReceiveDoneTask(Frame *aFrame, ThreadError aError)
         if (dstaddr.mLength != 0)
         {
             mReceiveTimer.Stop();
+
+            // keep sampling while the parent indicates more frames
+            if (mCslSampling && aFrame->GetFramePending())
+            {
+                mCslTimer.Start(OPENTHREAD_CONFIG_CSL_RECEIVE_WINDOW);
+            }
         }
 
         switch (aFrame->GetType())
@@ -72,7 +72,7 @@ enum
     kMaxFrameRetries      = 3,                     ///< macMaxFrameRetries (IEEE 802.15.4-2006)
     kUnitBackoffPeriod    = 20,                    ///< Number of symbols (IEEE 802.15.4-2006)
 
-    kMinBackoff           = 1,                     ///< Minimum backoff (milliseconds).
+    kMinBackoff           = 1,                     ///< Minimum backoff without microsecond timer (milliseconds).
     kMaxFrameAttempts     = kMaxFrameRetries + 1,  ///< Number of transmission attempts.
 
     kAckTimeout           = 16,                    ///< Timeout for waiting on an ACK (milliseconds).
@@ -161,6 +161,30 @@ public:
      */
     Sender(FrameRequestHandler aFrameRequestHandler, SentFrameHandler aSentFrameHandler, void *aContext) {
         mFrameRequestHandler = aFrameRequestHandler;
+        mNextFrameRequestHandler = NULL;
+        mSentFrameHandler = aSentFrameHandler;
+        mContext = aContext;
+        mNext = NULL;
+    }
+
+    /**
+     * This constructor creates a MAC sender client that can prepare its next frame ahead of time.
+     *
+     * On radios that report kRadioCapsTransmitPipeline, @p aNextFrameRequestHandler is called while the sender's
+     * current frame is in flight.  It forms the frame the sender expects to send next, which the MAC then secures in
+     * the standby transmit buffer.  When the MAC next calls @p aFrameRequestHandler with that buffer, the sender
+     * returns kThreadError_Already if the prepared frame is still the right one, or forms a new frame otherwise.
+     *
+     * @param[in]  aFrameRequestHandler      A pointer to a function that is called when about to send a MAC frame.
+     * @param[in]  aNextFrameRequestHandler  A pointer to a function that is called to prepare the next MAC frame.
+     * @param[in]  aSentFrameHandler         A pointer to a function that is called when done sending the frame.
+     * @param[in]  aContext                  A pointer to arbitrary context information.
+     *
+     */
+    Sender(FrameRequestHandler aFrameRequestHandler, FrameRequestHandler aNextFrameRequestHandler,
+           SentFrameHandler aSentFrameHandler, void *aContext) {
+        mFrameRequestHandler = aFrameRequestHandler;
+        mNextFrameRequestHandler = aNextFrameRequestHandler;
         mSentFrameHandler = aSentFrameHandler;
         mContext = aContext;
         mNext = NULL;
@@ -168,9 +192,13 @@ public:
 
 private:
     ThreadError HandleFrameRequest(Frame &frame) { return mFrameRequestHandler(mContext, frame); }
+    ThreadError HandleNextFrameRequest(Frame &frame) {
+        return (mNextFrameRequestHandler != NULL) ? mNextFrameRequestHandler(mContext, frame) : kThreadError_NotImplemented;
+    }
     void HandleSentFrame(Frame &frame, ThreadError error) { mSentFrameHandler(mContext, frame, error); }
 
     FrameRequestHandler mFrameRequestHandler;
+    FrameRequestHandler mNextFrameRequestHandler;
     SentFrameHandler mSentFrameHandler;
     void *mContext;
     Sender *mNext;
@@ -259,6 +287,36 @@ public:
      */
     void SetRxOnWhenIdle(bool aRxOnWhenIdle);
 
+    /**
+     * This method returns the coordinated sampled listening period.
+     *
+     * @returns The sample period in milliseconds, or zero if sampled listening is disabled.
+     *
+     */
+    uint16_t GetCslPeriod(void) const { return mCslPeriod; }
+
+    /**
+     * This method sets the coordinated sampled listening period.
+     *
+     * While rx-on-when-idle is disabled, the receiver is turned on for OPENTHREAD_CONFIG_CSL_RECEIVE_WINDOW
+     * milliseconds around a sample every @p aPeriod milliseconds.  MLE only sets a non-zero period while attached as a
+     * sleepy child.  Setting the current period again keeps the current sample times.
+     *
+     * @param[in]  aPeriod  The sample period in milliseconds, or zero to disable sampled listening.
+     *
+     */
+    void SetCslPeriod(uint16_t aPeriod);
+
+    /**
+     * This method returns the time until the next coordinated sampled listening sample.
+     *
+     * The receive window opens half of OPENTHREAD_CONFIG_CSL_RECEIVE_WINDOW ahead of the sample.
+     *
+     * @returns The time in milliseconds until the next sample.
+     *
+     */
+    uint16_t GetCslPhase(void) const;
+
     /**
      * This method registers a new MAC receiver client.
      *
@@ -558,9 +616,17 @@ private:
         kInvalidRssiValue = 127
     };
 
+    enum
+    {
+        kEnergyScanRssiBins     = 32,  ///< Number of bins in the sampled RSSI histogram.
+        kEnergyScanRssiBinWidth = 4,   ///< Width of a sampled RSSI histogram bin (dB).
+        kEnergyScanRssiMin      = -128,
+    };
+
     void GenerateNonce(const ExtAddress &aAddress, uint32_t aFrameCounter, uint8_t aSecurityLevel, uint8_t *aNonce);
     void NextOperation(void);
     void ProcessTransmitSecurity(Frame &aFrame);
+    void PrepareNextFrame(void);
     ThreadError ProcessReceiveSecurity(Frame &aFrame, const Address &aSrcAddr, Neighbor *aNeighbor);
     void ScheduleNextTransmission(void);
     void SentFrame(ThreadError aError);
@@ -568,6 +634,8 @@ private:
     void SendBeacon(Frame &aFrame);
     void StartBackoff(void);
     void StartEnergyScan(void);
+    void EnergyScanSampleDone(void);
+    void EnergyScanChannelDone(otEnergyScanResult &aResult);
     ThreadError HandleMacCommand(Frame &aFrame);
 
     static void HandleMacTimer(void *aContext);
@@ -578,13 +646,22 @@ private:
     void HandleReceiveTimer(void);
     static void HandleEnergyScanSampleRssi(void *aContext);
     void HandleEnergyScanSampleRssi(void);
+    static void HandleCslTimer(void *aContext);
+    void HandleCslTimer(void);
 
     void StartCsmaBackoff(void);
     ThreadError Scan(ScanType aType, uint32_t aScanChannels, uint16_t aScanDuration, void *aContext);
 
     Timer mMacTimer;
+#if OPENTHREAD_ENABLE_PLATFORM_USEC_TIMER
+    TimerMicro mBackoffTimer;
+    TimerMicro mAckTimer;
+#else
     Timer mBackoffTimer;
+    Timer mAckTimer;
+#endif
     Timer mReceiveTimer;
+    Timer mCslTimer;
 
     KeyManager &mKeyManager;
     Mle::MleRouter &mMle;
@@ -600,6 +677,7 @@ private:
     otExtendedPanId mExtendedPanId;
 
     Sender *mSendHead, *mSendTail;
+    Sender *mPreparedSender;
     Receiver *mReceiveHead, *mReceiveTail;
 
     enum
@@ -619,6 +697,14 @@ private:
     uint8_t mTransmitAttempts;
     bool mTransmitBeacon;
 
+#if OPENTHREAD_ENABLE_PERF_COUNTERS
+    uint32_t mTxStartTime;
+#endif
+
+    uint16_t mCslPeriod;
+    uint32_t mCslSampleTime;
+    bool mCslSampling;
+
     ScanType mPendingScanRequest;
     uint8_t mScanChannel;
     uint32_t mScanChannels;
@@ -630,7 +716,10 @@ private:
         EnergyScanHandler mEnergyScanHandler;
     };
     int8_t mEnergyScanCurrentMaxRssi;
-    Tasklet mEnergyScanSampleRssiTask;
+    int32_t mEnergyScanRssiSum;
+    uint16_t mEnergyScanSampleCount;
+    uint16_t mEnergyScanRssiHistogram[kEnergyScanRssiBins];
+    Timer mEnergyScanSampleRssiTimer;
 
     LinkQualityInfo mNoiseFloor;
 
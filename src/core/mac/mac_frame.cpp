@@ -47,102 +47,174 @@ void ExtAddress::Set(const Ip6::Address &aIpAddress)
 
 ThreadError Frame::InitMacHeader(uint16_t aFcf, uint8_t aSecurityControl)
 {
-    uint8_t *bytes = GetPsdu();
-    uint8_t length = 0;
+    ThreadError error = kThreadError_None;
 
     // Frame Control Field
-    bytes[0] = aFcf & 0xff;
-    bytes[1] = aFcf >> 8;
-    length += kFcfSize;
+    mPsdu[0] = aFcf & 0xff;
+    mPsdu[1] = aFcf >> 8;
+
+    VerifyOrExit(UpdateHeaderInfo(&aSecurityControl) == kThreadError_None, error = kThreadError_InvalidArgs);
+
+    SetPsduLength(mHeaderInfo.mPayload + mHeaderInfo.mFooterLength);
+
+exit:
+    return error;
+}
+
+ThreadError Frame::ParseHeader(void)
+{
+    ThreadError error = kThreadError_None;
+
+    VerifyOrExit(GetPsduLength() >= kFcfSize + kDsnSize + kFcsSize, error = kThreadError_Parse);
+
+    SuccessOrExit(error = UpdateHeaderInfo(NULL));
+
+    VerifyOrExit(mHeaderInfo.mPayload + mHeaderInfo.mFooterLength <= GetPsduLength(), error = kThreadError_Parse);
+
+exit:
+    return error;
+}
 
-    // Sequence Number
-    length += kDsnSize;
+ThreadError Frame::UpdateHeaderInfo(const uint8_t *aSecurityControl)
+{
+    ThreadError error = kThreadError_None;
+    uint16_t fcf = static_cast<uint16_t>((mPsdu[1] << 8) | mPsdu[0]);
+    uint8_t cur = kFcfSize + kDsnSize;
+    uint8_t footerLength = kFcsSize;
+    uint8_t securityControl;
 
-    // Destinatino PAN + Address
-    switch (aFcf & Frame::kFcfDstAddrMask)
+    memset(&mHeaderInfo, 0, sizeof(mHeaderInfo));
+
+    // Destination PAN + Address
+    switch (fcf & Frame::kFcfDstAddrMask)
     {
     case Frame::kFcfDstAddrNone:
         break;
 
     case Frame::kFcfDstAddrShort:
-        length += sizeof(PanId) + sizeof(ShortAddress);
+        mHeaderInfo.mDstPanId = cur;
+        mHeaderInfo.mDstAddr = cur + sizeof(PanId);
+        cur += sizeof(PanId) + sizeof(ShortAddress);
         break;
 
     case Frame::kFcfDstAddrExt:
-        length += sizeof(PanId) + sizeof(ExtAddress);
+        mHeaderInfo.mDstPanId = cur;
+        mHeaderInfo.mDstAddr = cur + sizeof(PanId);
+        cur += sizeof(PanId) + sizeof(ExtAddress);
         break;
 
     default:
-        assert(false);
+        ExitNow(error = kThreadError_Parse);
     }
 
     // Source PAN + Address
-    switch (aFcf & Frame::kFcfSrcAddrMask)
+    mHeaderInfo.mSrcPanId = mHeaderInfo.mDstPanId;
+
+    switch (fcf & Frame::kFcfSrcAddrMask)
     {
     case Frame::kFcfSrcAddrNone:
         break;
 
     case Frame::kFcfSrcAddrShort:
-        if ((aFcf & Frame::kFcfPanidCompression) == 0)
+        if ((fcf & Frame::kFcfPanidCompression) == 0)
         {
-            length += sizeof(PanId);
+            mHeaderInfo.mSrcPanId = cur;
+            cur += sizeof(PanId);
         }
 
-        length += sizeof(ShortAddress);
+        mHeaderInfo.mSrcAddr = cur;
+        cur += sizeof(ShortAddress);
         break;
 
     case Frame::kFcfSrcAddrExt:
-        if ((aFcf & Frame::kFcfPanidCompression) == 0)
+        if ((fcf & Frame::kFcfPanidCompression) == 0)
         {
-            length += sizeof(PanId);
+            mHeaderInfo.mSrcPanId = cur;
+            cur += sizeof(PanId);
         }
 
-        length += sizeof(ExtAddress);
+        mHeaderInfo.mSrcAddr = cur;
+        cur += sizeof(ExtAddress);
         break;
 
     default:
-        assert(false);
+        ExitNow(error = kThreadError_Parse);
     }
 
-    // Security Header
-    if (aFcf & Frame::kFcfSecurityEnabled)
+    // Security Control + Frame Counter + Key Identifier
+    if ((fcf & Frame::kFcfSecurityEnabled) != 0)
     {
-        bytes[length] = aSecurityControl;
+        if (aSecurityControl != NULL)
+        {
+            mPsdu[cur] = *aSecurityControl;
+        }
+        else
+        {
+            VerifyOrExit(cur < GetPsduLength(), error = kThreadError_Parse);
+        }
 
-        if (aSecurityControl & kSecLevelMask)
+        mHeaderInfo.mSecurityHeader = cur;
+        securityControl = mPsdu[cur];
+
+        if (securityControl & kSecLevelMask)
         {
-            length += kSecurityControlSize + kFrameCounterSize;
+            cur += kSecurityControlSize + kFrameCounterSize;
         }
 
-        switch (aSecurityControl & kKeyIdModeMask)
+        switch (securityControl & kKeyIdModeMask)
         {
         case kKeyIdMode0:
-            length += kKeySourceSizeMode0;
+            cur += kKeySourceSizeMode0;
             break;
 
         case kKeyIdMode1:
-            length += kKeySourceSizeMode1 + kKeyIndexSize;
+            cur += kKeySourceSizeMode1 + kKeyIndexSize;
             break;
 
         case kKeyIdMode2:
-            length += kKeySourceSizeMode2 + kKeyIndexSize;
+            cur += kKeySourceSizeMode2 + kKeyIndexSize;
             break;
 
         case kKeyIdMode3:
-            length += kKeySourceSizeMode3 + kKeyIndexSize;
+            cur += kKeySourceSizeMode3 + kKeyIndexSize;
+            break;
+        }
+
+        switch (securityControl & kSecLevelMask)
+        {
+        case kSecNone:
+        case kSecEnc:
+            footerLength += kMic0Size;
+            break;
+
+        case kSecMic32:
+        case kSecEncMic32:
+            footerLength += kMic32Size;
+            break;
+
+        case kSecMic64:
+        case kSecEncMic64:
+            footerLength += kMic64Size;
+            break;
+
+        case kSecMic128:
+        case kSecEncMic128:
+            footerLength += kMic128Size;
             break;
         }
     }
 
     // Command ID
-    if ((aFcf & kFcfFrameTypeMask) == kFcfFrameMacCmd)
+    if ((fcf & kFcfFrameTypeMask) == kFcfFrameMacCmd)
     {
-        length += kCommandIdSize;
+        cur += kCommandIdSize;
     }
 
-    SetPsduLength(length + GetFooterLength());
+    mHeaderInfo.mPayload = cur;
+    mHeaderInfo.mFooterLength = footerLength;
 
-    return kThreadError_None;
+exit:
+    return error;
 }
 
 uint8_t Frame::GetType(void)
@@ -213,18 +285,7 @@ void Frame::SetSequence(uint8_t aSequence)
 
 uint8_t *Frame::FindDstPanId(void)
 {
-    uint8_t *cur = GetPsdu();
-    uint16_t fcf = static_cast<uint16_t>((GetPsdu()[1] << 8) | GetPsdu()[0]);
-
-    VerifyOrExit((fcf & Frame::kFcfDstAddrMask) != Frame::kFcfDstAddrNone, cur = NULL);
-
-    // Frame Control Field
-    cur += kFcfSize;
-    // Sequence Number
-    cur += kDsnSize;
-
-exit:
-    return cur;
+    return (mHeaderInfo.mDstPanId != 0) ? GetPsdu() + mHeaderInfo.mDstPanId : NULL;
 }
 
 ThreadError Frame::GetDstPanId(PanId &aPanId)
@@ -255,26 +316,14 @@ ThreadError Frame::SetDstPanId(PanId aPanId)
 
 uint8_t *Frame::FindDstAddr(void)
 {
-    uint8_t *cur = GetPsdu();
-
-    // Frame Control Field
-    cur += kFcfSize;
-    // Sequence Number
-    cur += kDsnSize;
-    // Destination PAN
-    cur += sizeof(PanId);
-
-    return cur;
+    return (mHeaderInfo.mDstAddr != 0) ? GetPsdu() + mHeaderInfo.mDstAddr : NULL;
 }
 
 ThreadError Frame::GetDstAddr(Address &aAddress)
 {
-    ThreadError error = kThreadError_None;
-    uint8_t *buf;
+    uint8_t *buf = FindDstAddr();
     uint16_t fcf = static_cast<uint16_t>((GetPsdu()[1] << 8) | GetPsdu()[0]);
 
-    VerifyOrExit(buf = FindDstAddr(), error = kThreadError_Parse);
-
     switch (fcf & Frame::kFcfDstAddrMask)
     {
     case Frame::kFcfDstAddrShort:
@@ -297,8 +346,7 @@ ThreadError Frame::GetDstAddr(Address &aAddress)
         break;
     }
 
-exit:
-    return error;
+    return kThreadError_None;
 }
 
 ThreadError Frame::SetDstAddr(ShortAddress aShortAddress)
@@ -337,34 +385,7 @@ ThreadError Frame::SetDstAddr(const ExtAddress &aExtAddress)
 
 uint8_t *Frame::FindSrcPanId(void)
 {
-    uint8_t *cur = GetPsdu();
-    uint16_t fcf = static_cast<uint16_t>((GetPsdu()[1] << 8) | GetPsdu()[0]);
-
-    VerifyOrExit((fcf & Frame::kFcfDstAddrMask) != Frame::kFcfDstAddrNone ||
-                 (fcf & Frame::kFcfSrcAddrMask) != Frame::kFcfSrcAddrNone, cur = NULL);
-
-    // Frame Control Field
-    cur += kFcfSize;
-    // Sequence Number
-    cur += kDsnSize;
-
-    if ((fcf & Frame::kFcfPanidCompression) == 0)
-    {
-        // Destination PAN + Address
-        switch (fcf & Frame::kFcfDstAddrMask)
-        {
-        case Frame::kFcfDstAddrShort:
-            cur += sizeof(PanId) + sizeof(ShortAddress);
-            break;
-
-        case Frame::kFcfDstAddrExt:
-            cur += sizeof(PanId) + sizeof(ExtAddress);
-            break;
-        }
-    }
-
-exit:
-    return cur;
+    return (mHeaderInfo.mSrcPanId != 0) ? GetPsdu() + mHeaderInfo.mSrcPanId : NULL;
 }
 
 ThreadError Frame::GetSrcPanId(PanId &aPanId)
@@ -396,43 +417,14 @@ exit:
 
 uint8_t *Frame::FindSrcAddr(void)
 {
-    uint8_t *cur = GetPsdu();
-    uint16_t fcf = static_cast<uint16_t>((GetPsdu()[1] << 8) | GetPsdu()[0]);
-
-    // Frame Control Field
-    cur += kFcfSize;
-    // Sequence Number
-    cur += kDsnSize;
-
-    // Destination PAN + Address
-    switch (fcf & Frame::kFcfDstAddrMask)
-    {
-    case Frame::kFcfDstAddrShort:
-        cur += sizeof(PanId) + sizeof(ShortAddress);
-        break;
-
-    case Frame::kFcfDstAddrExt:
-        cur += sizeof(PanId) + sizeof(ExtAddress);
-        break;
-    }
-
-    // Source PAN
-    if ((fcf & Frame::kFcfPanidCompression) == 0)
-    {
-        cur += sizeof(PanId);
-    }
-
-    return cur;
+    return (mHeaderInfo.mSrcAddr != 0) ? GetPsdu() + mHeaderInfo.mSrcAddr : NULL;
 }
 
 ThreadError Frame::GetSrcAddr(Address &address)
 {
-    ThreadError error = kThreadError_None;
-    uint8_t *buf;
+    uint8_t *buf = FindSrcAddr();
     uint16_t fcf = static_cast<uint16_t>((GetPsdu()[1] << 8) | GetPsdu()[0]);
 
-    VerifyOrExit((buf = FindSrcAddr()) != NULL, error = kThreadError_Parse);
-
     switch (fcf & Frame::kFcfSrcAddrMask)
     {
     case Frame::kFcfSrcAddrShort:
@@ -455,8 +447,7 @@ ThreadError Frame::GetSrcAddr(Address &address)
         break;
     }
 
-exit:
-    return error;
+    return kThreadError_None;
 }
 
 ThreadError Frame::SetSrcAddr(ShortAddress aShortAddress)
@@ -495,52 +486,7 @@ ThreadError Frame::SetSrcAddr(const ExtAddress &aExtAddress)
 
 uint8_t *Frame::FindSecurityHeader(void)
 {
-    uint8_t *cur = GetPsdu();
-    uint16_t fcf = static_cast<uint16_t>((GetPsdu()[1] << 8) | GetPsdu()[0]);
-
-    VerifyOrExit((fcf & Frame::kFcfSecurityEnabled) != 0, cur = NULL);
-
-    // Frame Control Field
-    cur += kFcfSize;
-    // Sequence Number
-    cur += kDsnSize;
-
-    // Destination PAN + Address
-    switch (fcf & Frame::kFcfDstAddrMask)
-    {
-    case Frame::kFcfDstAddrShort:
-        cur += sizeof(PanId) + sizeof(ShortAddress);
-        break;
-
-    case Frame::kFcfDstAddrExt:
-        cur += sizeof(PanId) + sizeof(ExtAddress);
-        break;
-    }
-
-    // Source PAN + Address
-    switch (fcf & Frame::kFcfSrcAddrMask)
-    {
-    case Frame::kFcfSrcAddrShort:
-        if ((fcf & Frame::kFcfPanidCompression) == 0)
-        {
-            cur += sizeof(PanId);
-        }
-
-        cur += sizeof(ShortAddress);
-        break;
-
-    case Frame::kFcfSrcAddrExt:
-        if ((fcf & Frame::kFcfPanidCompression) == 0)
-        {
-            cur += sizeof(PanId);
-        }
-
-        cur += sizeof(ExtAddress);
-        break;
-    }
-
-exit:
-    return cur;
+    return (mHeaderInfo.mSecurityHeader != 0) ? GetPsdu() + mHeaderInfo.mSecurityHeader : NULL;
 }
 
 ThreadError Frame::GetSecurityLevel(uint8_t &aSecurityLevel)
@@ -732,44 +678,12 @@ ThreadError Frame::SetLength(uint8_t aLength)
 
 uint8_t Frame::GetHeaderLength(void)
 {
-    return static_cast<uint8_t>(GetPayload() - GetPsdu());
+    return mHeaderInfo.mPayload;
 }
 
 uint8_t Frame::GetFooterLength(void)
 {
-    uint8_t footerLength = 0;
-    uint8_t *cur;
-
-    VerifyOrExit((cur = FindSecurityHeader()) != NULL, ;);
-
-    switch (cur[0] & kSecLevelMask)
-    {
-    case kSecNone:
-    case kSecEnc:
-        footerLength += kMic0Size;
-        break;
-
-    case kSecMic32:
-    case kSecEncMic32:
-        footerLength += kMic32Size;
-        break;
-
-    case kSecMic64:
-    case kSecEncMic64:
-        footerLength += kMic64Size;
-        break;
-
-    case kSecMic128:
-    case kSecEncMic128:
-        footerLength += kMic128Size;
-        break;
-    }
-
-exit:
-    // Frame Check Sequence
-    footerLength += kFcsSize;
-
-    return footerLength;
+    return mHeaderInfo.mFooterLength;
 }
 
 uint8_t Frame::GetMaxPayloadLength(void)
@@ -795,99 +709,7 @@ uint8_t *Frame::GetHeader(void)
 
 uint8_t *Frame::GetPayload(void)
 {
-    uint8_t *cur = GetPsdu();
-    uint16_t fcf = static_cast<uint16_t>((GetPsdu()[1] << 8) | GetPsdu()[0]);
-    uint8_t securityControl;
-
-    // Frame Control
-    cur += kFcfSize;
-    // Sequence Number
-    cur += kDsnSize;
-
-    // Destination PAN + Address
-    switch (fcf & Frame::kFcfDstAddrMask)
-    {
-    case Frame::kFcfDstAddrNone:
-        break;
-
-    case Frame::kFcfDstAddrShort:
-        cur += sizeof(PanId) + sizeof(ShortAddress);
-        break;
-
-    case Frame::kFcfDstAddrExt:
-        cur += sizeof(PanId) + sizeof(ExtAddress);
-        break;
-
-    default:
-        ExitNow(cur = NULL);
-    }
-
-    // Source PAN + Address
-    switch (fcf & Frame::kFcfSrcAddrMask)
-    {
-    case Frame::kFcfSrcAddrNone:
-        break;
-
-    case Frame::kFcfSrcAddrShort:
-        if ((fcf & Frame::kFcfPanidCompression) == 0)
-        {
-            cur += sizeof(PanId);
-        }
-
-        cur += sizeof(ShortAddress);
-        break;
-
-    case Frame::kFcfSrcAddrExt:
-        if ((fcf & Frame::kFcfPanidCompression) == 0)
-        {
-            cur += sizeof(PanId);
-        }
-
-        cur += sizeof(ExtAddress);
-        break;
-
-    default:
-        ExitNow(cur = NULL);
-    }
-
-    // Security Control + Frame Counter + Key Identifier
-    if ((fcf & Frame::kFcfSecurityEnabled) != 0)
-    {
-        securityControl = *cur;
-
-        if (securityControl & kSecLevelMask)
-        {
-            cur += kSecurityControlSize + kFrameCounterSize;
-        }
-
-        switch (securityControl & kKeyIdModeMask)
-        {
-        case kKeyIdMode0:
-            cur += kKeySourceSizeMode0;
-            break;
-
-        case kKeyIdMode1:
-            cur += kKeySourceSizeMode1 + kKeyIndexSize;
-            break;
-
-        case kKeyIdMode2:
-            cur += kKeySourceSizeMode2 + kKeyIndexSize;
-            break;
-
-        case kKeyIdMode3:
-            cur += kKeySourceSizeMode3 + kKeyIndexSize;
-            break;
-        }
-    }
-
-    // Command ID
-    if ((fcf & kFcfFrameTypeMask) == kFcfFrameMacCmd)
-    {
-        cur += kCommandIdSize;
-    }
-
-exit:
-    return cur;
+    return GetPsdu() + mHeaderInfo.mPayload;
 }
 
 uint8_t *Frame::GetFooter(void)
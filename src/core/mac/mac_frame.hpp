@@ -250,6 +250,18 @@ public:
      */
     ThreadError InitMacHeader(uint16_t aFcf, uint8_t aSecCtl);
 
+    /**
+     * This method parses the MAC header of a received frame.
+     *
+     * The header is walked once and the location of every addressing, security and payload field is recorded.  All
+     * other accessors read from this record, so this method (or InitMacHeader()) must be called before them.
+     *
+     * @retval kThreadError_None   Successfully parsed the MAC header.
+     * @retval kThreadError_Parse  The header uses a reserved addressing mode or does not fit in the PSDU length.
+     *
+     */
+    ThreadError ParseHeader(void);
+
     /**
      * This method returns the IEEE 802.15.4 Frame Type.
      *
@@ -693,6 +705,7 @@ private:
     uint8_t *FindSrcPanId(void);
     uint8_t *FindSrcAddr(void);
     uint8_t *FindSecurityHeader(void);
+    ThreadError UpdateHeaderInfo(const uint8_t *aSecurityControl);
     static uint8_t GetKeySourceLength(uint8_t aKeyIdMode);
 };
 
@@ -43,7 +43,6 @@
 #include <string.h>
 
 #include <coap/coap_header.hpp>
-#include <common/crc16.hpp>
 #include <common/encoding.hpp>
 #include <common/logging.hpp>
 #include <meshcop/commissioner.hpp>
@@ -63,6 +62,8 @@ Commissioner::Commissioner(ThreadNetif &aThreadNetif):
     mAnnounceBegin(aThreadNetif),
     mEnergyScan(aThreadNetif),
     mPanIdQuery(aThreadNetif),
+    mJoinerTimer(aThreadNetif.GetIp6().mTimerScheduler, HandleJoinerTimer, this),
+    mSteeringDataTask(aThreadNetif.GetIp6().mTaskletScheduler, HandleSteeringDataChanged, this),
     mTimer(aThreadNetif.GetIp6().mTimerScheduler, HandleTimer, this),
     mTransmitTask(aThreadNetif.GetIp6().mTaskletScheduler, &Commissioner::HandleUdpTransmit, this),
     mSendKek(false),
@@ -72,7 +73,6 @@ Commissioner::Commissioner(ThreadNetif &aThreadNetif):
     mCoapClient(aThreadNetif.GetCoapClient()),
     mNetif(aThreadNetif)
 {
-    memset(mJoiners, 0, sizeof(mJoiners));
     mCoapServer.AddResource(mRelayReceive);
     mCoapServer.AddResource(mDatasetChanged);
 }
@@ -128,39 +128,8 @@ ThreadError Commissioner::SendCommissionerSet(void)
     dataset.mSessionId = mSessionId;
     dataset.mIsSessionIdSet = true;
 
-    // compute bloom filter
-    steeringData.Init();
-    steeringData.Clear();
-
-    for (size_t i = 0; i < sizeof(mJoiners) / sizeof(mJoiners[0]); i++)
-    {
-        Crc16 ccitt(Crc16::kCcitt);
-        Crc16 ansi(Crc16::kAnsi);
-
-        if (!mJoiners[i].mValid)
-        {
-            continue;
-        }
-
-        if (mJoiners[i].mAny)
-        {
-            steeringData.SetLength(1);
-            steeringData.Set();
-            break;
-        }
-
-        for (size_t j = 0; j < sizeof(mJoiners[i].mExtAddress.m8); j++)
-        {
-            uint8_t byte = mJoiners[i].mExtAddress.m8[j];
-            ccitt.Update(byte);
-            ansi.Update(byte);
-        }
-
-        steeringData.SetBit(ccitt.Get() % steeringData.GetNumBits());
-        steeringData.SetBit(ansi.Get() % steeringData.GetNumBits());
-    }
-
-    // set bloom filter
+    // bloom filter
+    mJoiners.GetSteeringData(steeringData);
     memcpy(dataset.mSteeringData.m8, steeringData.GetValue(), steeringData.GetLength());
     dataset.mSteeringData.mLength = steeringData.GetLength();
     dataset.mIsSteeringDataSet = true;
@@ -176,88 +145,85 @@ void Commissioner::ClearJoiners(void)
 {
     otLogFuncEntry();
 
-    for (size_t i = 0; i < sizeof(mJoiners) / sizeof(mJoiners[0]); i++)
-    {
-        mJoiners[i].mValid = false;
-    }
+    mJoiners.Clear();
+    mJoinerTimer.Stop();
 
-    SendCommissionerSet();
+    // sessions of removed joiners must not be resumed
+    mNetif.GetDtls().ClearSessionCache();
+    mSteeringDataTask.Post();
     otLogFuncExit();
 }
 
 ThreadError Commissioner::AddJoiner(const Mac::ExtAddress *aExtAddress, const char *aPSKd)
 {
-    ThreadError error = kThreadError_NoBufs;
+    ThreadError error;
+    uint32_t now = Timer::GetNow();
 
     otLogFuncEntryMsg("%llX, %s", (aExtAddress ? HostSwap64(*reinterpret_cast<const uint64_t *>(aExtAddress)) : 0), aPSKd);
-    VerifyOrExit(strlen(aPSKd) <= Dtls::kPskMaxLength, error = kThreadError_InvalidArgs);
-    RemoveJoiner(aExtAddress);
+    SuccessOrExit(error = mJoiners.Add(aExtAddress, aPSKd,
+                                       now + Timer::SecToMsec(OPENTHREAD_CONFIG_JOINER_ENTRY_TIMEOUT)));
 
-    for (size_t i = 0; i < sizeof(mJoiners) / sizeof(mJoiners[0]); i++)
+    if (OPENTHREAD_CONFIG_JOINER_ENTRY_TIMEOUT > 0 && !mJoinerTimer.IsRunning())
     {
-        if (mJoiners[i].mValid)
-        {
-            continue;
-        }
+        mJoinerTimer.StartAt(now, Timer::SecToMsec(OPENTHREAD_CONFIG_JOINER_ENTRY_TIMEOUT));
+    }
 
-        if (aExtAddress != NULL)
-        {
-            mJoiners[i].mExtAddress = *aExtAddress;
-            mJoiners[i].mAny = false;
-        }
-        else
-        {
-            mJoiners[i].mAny = true;
-        }
+    mSteeringDataTask.Post();
 
-        strncpy(mJoiners[i].mPsk, aPSKd, sizeof(mJoiners[i].mPsk));
-        mJoiners[i].mValid = true;
+exit:
+    otLogFuncExitErr(error);
+    return error;
+}
 
-        SendCommissionerSet();
+ThreadError Commissioner::RemoveJoiner(const Mac::ExtAddress *aExtAddress)
+{
+    ThreadError error;
 
-        ExitNow(error = kThreadError_None);
-    }
+    otLogFuncEntryMsg("%llX", (aExtAddress ? HostSwap64(*reinterpret_cast<const uint64_t *>(aExtAddress)) : 0));
+
+    SuccessOrExit(error = mJoiners.Remove(aExtAddress));
+    mNetif.GetDtls().ClearSessionCache();
+    mSteeringDataTask.Post();
 
 exit:
     otLogFuncExitErr(error);
     return error;
 }
 
-ThreadError Commissioner::RemoveJoiner(const Mac::ExtAddress *aExtAddress)
+void Commissioner::HandleJoinerTimer(void *aContext)
 {
-    ThreadError error = kThreadError_NotFound;
+    static_cast<Commissioner *>(aContext)->HandleJoinerTimer();
+}
 
-    otLogFuncEntryMsg("%llX", (aExtAddress ? HostSwap64(*reinterpret_cast<const uint64_t *>(aExtAddress)) : 0));
+void Commissioner::HandleJoinerTimer(void)
+{
+    uint32_t now = Timer::GetNow();
+    JoinerTable::Joiner *joiner;
 
-    for (size_t i = 0; i < sizeof(mJoiners) / sizeof(mJoiners[0]); i++)
+    // joiners expire in the order they were added, so only the head of the expiry list is checked
+    while ((joiner = mJoiners.GetNextExpiring()) != NULL)
     {
-        if (!mJoiners[i].mValid)
-        {
-            continue;
-        }
-
-        if (aExtAddress != NULL)
-        {
-            if (memcmp(&mJoiners[i].mExtAddress, &aExtAddress, sizeof(mJoiners[i].mExtAddress)))
-            {
-                continue;
-            }
-        }
-        else if (!mJoiners[i].mAny)
+        if (static_cast<int32_t>(joiner->GetExpiration() - now) > 0)
         {
-            continue;
+            mJoinerTimer.StartAt(now, joiner->GetExpiration() - now);
+            break;
         }
 
-        mJoiners[i].mValid = false;
-
-        SendCommissionerSet();
-
-        ExitNow(error = kThreadError_None);
+        otLogInfoMeshCoP("joiner %llX expired", HostSwap64(*reinterpret_cast<const uint64_t *>(&joiner->GetExtAddress())));
+        mJoiners.Remove(*joiner);
+        mNetif.GetDtls().ClearSessionCache();
+        mSteeringDataTask.Post();
     }
+}
 
-exit:
-    otLogFuncExitErr(error);
-    return error;
+void Commissioner::HandleSteeringDataChanged(void *aContext)
+{
+    static_cast<Commissioner *>(aContext)->HandleSteeringDataChanged();
+}
+
+void Commissioner::HandleSteeringDataChanged(void)
+{
+    SendCommissionerSet();
 }
 
 ThreadError Commissioner::SetProvisioningUrl(const char *aProvisioningUrl)
@@ -668,26 +634,20 @@ void Commissioner::HandleRelayReceive(Coap::Header &aHeader, Message &aMessage,
 
     if (!mNetif.GetDtls().IsStarted())
     {
+        JoinerTable::Joiner *joiner;
+
+        mJoinerIid[0] ^= 0x2;
+        joiner = mJoiners.FindMatching(*reinterpret_cast<const Mac::ExtAddress *>(mJoinerIid));
         mJoinerIid[0] ^= 0x2;
 
-        for (size_t i = 0; i < sizeof(mJoiners) / sizeof(mJoiners[0]); i++)
+        if (joiner != NULL)
         {
-            if (!mJoiners[i].mValid)
-            {
-                continue;
-            }
-
-            if (mJoiners[i].mAny || !memcmp(&mJoiners[i].mExtAddress, mJoinerIid, sizeof(mJoiners[i].mExtAddress)))
-            {
-                SuccessOrExit(error = mNetif.GetDtls().SetPsk(reinterpret_cast<const uint8_t *>(mJoiners[i].mPsk),
-                                                              static_cast<uint8_t>(strlen(mJoiners[i].mPsk))));
-                SuccessOrExit(error = mNetif.GetDtls().Start(false, HandleDtlsReceive, HandleDtlsSend, this));
-                otLogInfoMeshCoP("found joiner, starting new session");
-                break;
-            }
+            SuccessOrExit(error = mNetif.GetDtls().SetPsk(reinterpret_cast<const uint8_t *>(joiner->GetPsk()),
+                                                          static_cast<uint8_t>(strlen(joiner->GetPsk()))));
+            SuccessOrExit(error = mNetif.GetDtls().Start(false, HandleDtlsReceive, HandleDtlsSend, this));
+            joiner->SetState(JoinerTable::kStateConnecting);
+            otLogInfoMeshCoP("found joiner, starting new session");
         }
-
-        mJoinerIid[0] ^= 0x2;
     }
 
     VerifyOrExit(mNetif.GetDtls().IsStarted() && memcmp(mJoinerIid, joinerIid.GetIid(), sizeof(mJoinerIid)) == 0,);
@@ -929,6 +889,20 @@ void Commissioner::ReceiveJoinerFinalize(uint8_t *buf, uint16_t length)
 
     otDumpCertMeshCoP("[THCI] direction=recv | type=JOIN_FIN.req |", buf + header.GetLength(), length - header.GetLength());
 
+    if (state == StateTlv::kAccept)
+    {
+        JoinerTable::Joiner *joiner;
+
+        mJoinerIid[0] ^= 0x2;
+        joiner = mJoiners.FindMatching(*reinterpret_cast<const Mac::ExtAddress *>(mJoinerIid));
+        mJoinerIid[0] ^= 0x2;
+
+        if (joiner != NULL)
+        {
+            joiner->SetState(JoinerTable::kStateJoined);
+        }
+    }
+
     SendJoinFinalizeResponse(header, state);
 
 exit:
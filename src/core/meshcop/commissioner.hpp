@@ -43,6 +43,7 @@
 #include <meshcop/announce_begin_client.hpp>
 #include <meshcop/dtls.hpp>
 #include <meshcop/energy_scan_client.hpp>
+#include <meshcop/joiner_table.hpp>
 #include <meshcop/panid_query_client.hpp>
 #include <net/udp6.hpp>
 #include <thread/mle.hpp>
@@ -92,8 +93,9 @@ public:
      * @param[in]  aExtAddress      A pointer to the Joiner's extended address or NULL for any Joiner.
      * @param[in]  aPSKd            A pointer to the PSKd
      *
-     * @retval kThreadError_None    Successfully added the Joiner.
-     * @retval kThreadError_NoBufs  No buffers available to add the Joiner.
+     * @retval kThreadError_None         Successfully added the Joiner.
+     * @retval kThreadError_InvalidArgs  @p aPSKd is too long.
+     * @retval kThreadError_NoBufs       No buffers available to add the Joiner.
      *
      */
     ThreadError AddJoiner(const Mac::ExtAddress *aExtAddress, const char *aPSKd);
@@ -189,6 +191,12 @@ private:
     static void HandleTimer(void *aContext);
     void HandleTimer(void);
 
+    static void HandleJoinerTimer(void *aContext);
+    void HandleJoinerTimer(void);
+
+    static void HandleSteeringDataChanged(void *aContext);
+    void HandleSteeringDataChanged(void);
+
     static void HandleMgmtCommissionerSetResponse(void *aContext, otCoapHeader *aHeader,
                                                   otMessage aMessage, ThreadError aResult);
     void HandleMgmtCommissisonerSetResponse(Coap::Header *aHeader, Message *aMessage, ThreadError aResult);
@@ -229,14 +237,9 @@ private:
 
     uint8_t mState;
 
-    struct Joiner
-    {
-        Mac::ExtAddress mExtAddress;
-        char mPsk[Dtls::kPskMaxLength + 1];
-        bool mValid : 1;
-        bool mAny : 1;
-    };
-    Joiner mJoiners[OPENTHREAD_CONFIG_MAX_JOINER_ENTRIES];
+    JoinerTable mJoiners;
+    Timer mJoinerTimer;
+    Tasklet mSteeringDataTask;
 
     union
     {
@@ -43,6 +43,7 @@
 #include <thread/thread_netif.hpp>
 
 #include <mbedtls/debug.h>
+#include <mbedtls/ssl_internal.h>
 
 #ifdef WINDOWS_LOGGING
 #include "dtls.tmh"
@@ -51,13 +52,156 @@
 namespace Thread {
 namespace MeshCoP {
 
+DtlsSessionCache::DtlsSessionCache(void)
+{
+    Clear();
+}
+
+void DtlsSessionCache::Clear(void)
+{
+#if OPENTHREAD_CONFIG_DTLS_SESSION_CACHE_SIZE > 0
+    memset(mEntries, 0, sizeof(mEntries));
+#endif
+}
+
+ThreadError DtlsSessionCache::Save(const mbedtls_ssl_session &aSession, const uint8_t *aPskHash)
+{
+    ThreadError error = kThreadError_None;
+    uint32_t now = Timer::GetNow();
+    Entry *entry;
+
+    VerifyOrExit(aSession.id_len != 0 && aSession.id_len <= sizeof(entry->mId), error = kThreadError_NotFound);
+    VerifyOrExit(Find(aPskHash, aSession.id, aSession.id_len) == NULL, ;);
+    VerifyOrExit((entry = GetFreeEntry(now)) != NULL, error = kThreadError_NoBufs);
+
+    entry->mCreated = now;
+    entry->mCiphersuite = static_cast<uint16_t>(aSession.ciphersuite);
+    entry->mCompression = static_cast<uint8_t>(aSession.compression);
+    entry->mIdLength = static_cast<uint8_t>(aSession.id_len);
+    memcpy(entry->mId, aSession.id, aSession.id_len);
+    memcpy(entry->mMaster, aSession.master, sizeof(entry->mMaster));
+    memcpy(entry->mPskHash, aPskHash, sizeof(entry->mPskHash));
+
+exit:
+    return error;
+}
+
+ThreadError DtlsSessionCache::Restore(mbedtls_ssl_session &aSession, const uint8_t *aPskHash)
+{
+    ThreadError error = kThreadError_None;
+    Entry *entry;
+
+    VerifyOrExit((entry = Find(aPskHash, aSession.id, aSession.id_len)) != NULL, error = kThreadError_NotFound);
+    VerifyOrExit(entry->mCiphersuite == aSession.ciphersuite && entry->mCompression == aSession.compression,
+                 error = kThreadError_NotFound);
+
+    CopyTo(*entry, aSession);
+
+exit:
+    return error;
+}
+
+ThreadError DtlsSessionCache::RestoreLatest(mbedtls_ssl_session &aSession, const uint8_t *aPskHash)
+{
+    ThreadError error = kThreadError_None;
+    Entry *entry;
+
+    VerifyOrExit((entry = Find(aPskHash, NULL, 0)) != NULL, error = kThreadError_NotFound);
+
+    CopyTo(*entry, aSession);
+
+exit:
+    return error;
+}
+
+DtlsSessionCache::Entry *DtlsSessionCache::Find(const uint8_t *aPskHash, const uint8_t *aId, size_t aIdLength)
+{
+    Entry *rval = NULL;
+
+#if OPENTHREAD_CONFIG_DTLS_SESSION_CACHE_SIZE > 0
+    uint32_t now = Timer::GetNow();
+
+    for (int i = 0; i < kNumEntries; i++)
+    {
+        Entry &entry = mEntries[i];
+
+        if (entry.mIdLength == 0 || now - entry.mCreated >= kLifetime ||
+            memcmp(entry.mPskHash, aPskHash, sizeof(entry.mPskHash)) != 0)
+        {
+            continue;
+        }
+
+        if (aId == NULL)
+        {
+            // the most recent session
+            if (rval == NULL || now - entry.mCreated < now - rval->mCreated)
+            {
+                rval = &entry;
+            }
+        }
+        else if (entry.mIdLength == aIdLength && memcmp(entry.mId, aId, aIdLength) == 0)
+        {
+            ExitNow(rval = &entry);
+        }
+    }
+
+exit:
+#else
+    (void)aPskHash;
+    (void)aId;
+    (void)aIdLength;
+#endif
+    return rval;
+}
+
+DtlsSessionCache::Entry *DtlsSessionCache::GetFreeEntry(uint32_t aNow)
+{
+    Entry *rval = NULL;
+
+#if OPENTHREAD_CONFIG_DTLS_SESSION_CACHE_SIZE > 0
+
+    // an unused or expired entry, otherwise the oldest one
+    for (int i = 0; i < kNumEntries; i++)
+    {
+        Entry &entry = mEntries[i];
+
+        if (entry.mIdLength == 0 || aNow - entry.mCreated >= kLifetime)
+        {
+            ExitNow(rval = &entry);
+        }
+
+        if (rval == NULL || aNow - entry.mCreated > aNow - rval->mCreated)
+        {
+            rval = &entry;
+        }
+    }
+
+exit:
+#else
+    (void)aNow;
+#endif
+    return rval;
+}
+
+void DtlsSessionCache::CopyTo(const Entry &aEntry, mbedtls_ssl_session &aSession)
+{
+    aSession.ciphersuite = aEntry.mCiphersuite;
+    aSession.compression = aEntry.mCompression;
+    aSession.id_len = aEntry.mIdLength;
+    memcpy(aSession.id, aEntry.mId, aEntry.mIdLength);
+    memcpy(aSession.master, aEntry.mMaster, sizeof(aEntry.mMaster));
+}
+
 Dtls::Dtls(ThreadNetif &aNetif):
+    mPskLength(0),
+    mSessionResumed(false),
     mStarted(false),
     mTimer(aNetif.GetIp6().mTimerScheduler, &Dtls::HandleTimer, this),
     mTimerIntermediate(0),
     mTimerSet(false),
     mNetif(aNetif)
 {
+    memset(mPskHash, 0, sizeof(mPskHash));
     mProvisioningUrl.Init();
 }
 
@@ -79,6 +223,7 @@ ThreadError Dtls::Start(bool aClient, ReceiveHandler aReceiveHandler, SendHandle
     mContext = aContext;
     mClient = aClient;
     mReceiveMessage = NULL;
+    mSessionResumed = false;
 
     mbedtls_ssl_init(&mSsl);
     mbedtls_ssl_config_init(&mConf);
@@ -111,6 +256,7 @@ ThreadError Dtls::Start(bool aClient, ReceiveHandler aReceiveHandler, SendHandle
         VerifyOrExit(rval == 0, ;);
 
         mbedtls_ssl_conf_dtls_cookies(&mConf, mbedtls_ssl_cookie_write, mbedtls_ssl_cookie_check, &mCookieCtx);
+        mbedtls_ssl_conf_session_cache(&mConf, this, HandleMbedtlsGetCache, HandleMbedtlsSetCache);
     }
 
     rval = mbedtls_ssl_setup(&mSsl, &mConf);
@@ -122,6 +268,22 @@ ThreadError Dtls::Start(bool aClient, ReceiveHandler aReceiveHandler, SendHandle
     rval = mbedtls_ssl_set_hs_ecjpake_password(&mSsl, mPsk, mPskLength);
     VerifyOrExit(rval == 0, ;);
 
+    if (mClient)
+    {
+        // offer the last session established with this PSK for resumption
+        mbedtls_ssl_session session;
+
+        mbedtls_ssl_session_init(&session);
+
+        if (mSessionCache.RestoreLatest(session, mPskHash) == kThreadError_None)
+        {
+            rval = mbedtls_ssl_set_session(&mSsl, &session);
+        }
+
+        mbedtls_ssl_session_free(&session);
+        VerifyOrExit(rval == 0, ;);
+    }
+
     mStarted = true;
     Process();
 
@@ -156,12 +318,20 @@ bool Dtls::IsStarted(void)
 ThreadError Dtls::SetPsk(const uint8_t *aPsk, uint8_t aPskLength)
 {
     ThreadError error = kThreadError_None;
+    uint8_t hash[Crypto::Sha256::kHashSize];
+    Crypto::Sha256 sha256;
 
     VerifyOrExit(aPskLength <= sizeof(mPsk), error = kThreadError_InvalidArgs);
 
     memcpy(mPsk, aPsk, aPskLength);
     mPskLength = aPskLength;
 
+    // cached sessions are bound to the PSK they were established with
+    sha256.Start();
+    sha256.Update(aPsk, aPskLength);
+    sha256.Finish(hash);
+    memcpy(mPskHash, hash, sizeof(mPskHash));
+
 exit:
     return error;
 }
@@ -330,6 +500,27 @@ int Dtls::HandleMbedtlsExportKeys(const unsigned char *aMasterSecret, const unsi
     return 0;
 }
 
+int Dtls::HandleMbedtlsGetCache(void *aContext, mbedtls_ssl_session *aSession)
+{
+    return static_cast<Dtls *>(aContext)->HandleMbedtlsGetCache(aSession);
+}
+
+int Dtls::HandleMbedtlsGetCache(mbedtls_ssl_session *aSession)
+{
+    return (mSessionCache.Restore(*aSession, mPskHash) == kThreadError_None) ? 0 : -1;
+}
+
+int Dtls::HandleMbedtlsSetCache(void *aContext, const mbedtls_ssl_session *aSession)
+{
+    return static_cast<Dtls *>(aContext)->HandleMbedtlsSetCache(aSession);
+}
+
+int Dtls::HandleMbedtlsSetCache(const mbedtls_ssl_session *aSession)
+{
+    mSessionCache.Save(*aSession, mPskHash);
+    return 0;
+}
+
 void Dtls::HandleTimer(void *aContext)
 {
     static_cast<Dtls *>(aContext)->HandleTimer();
@@ -351,6 +542,20 @@ void Dtls::Process(void)
         if (mSsl.state != MBEDTLS_SSL_HANDSHAKE_OVER)
         {
             rval = mbedtls_ssl_handshake(&mSsl);
+
+            // the resume flag is final once the Server Hello has been processed
+            if (mSsl.handshake != NULL && mSsl.handshake->resume && mSsl.state > MBEDTLS_SSL_SERVER_HELLO &&
+                !mSessionResumed)
+            {
+                otLogInfoMeshCoP("DTLS session resumed");
+                mSessionResumed = true;
+            }
+
+            if (mClient && mSsl.state == MBEDTLS_SSL_HANDSHAKE_OVER)
+            {
+                // the server caches its sessions through HandleMbedtlsSetCache()
+                mSessionCache.Save(*mSsl.session, mPskHash);
+            }
         }
         else
         {
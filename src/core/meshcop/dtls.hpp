@@ -34,6 +34,7 @@
 #ifndef DTLS_HPP_
 #define DTLS_HPP_
 
+#include <openthread-core-config.h>
 #include <openthread-types.h>
 #include <common/message.hpp>
 #include <common/timer.hpp>
@@ -53,6 +54,96 @@ class ThreadNetif;
 
 namespace MeshCoP {
 
+/**
+ * This class implements a bounded cache of DTLS sessions for session ID based resumption.
+ *
+ * A resumed session skips the EC J-PAKE key exchange and the second flight of the handshake.  Each session is bound
+ * to the PSK it was established with and expires after OPENTHREAD_CONFIG_DTLS_SESSION_CACHE_LIFETIME seconds.
+ *
+ */
+class DtlsSessionCache
+{
+public:
+    enum
+    {
+        kPskHashLength = 8,  ///< Length of the PSK digest that binds a session to its PSK.
+    };
+
+    /**
+     * This constructor initializes the object.
+     *
+     */
+    DtlsSessionCache(void);
+
+    /**
+     * This method removes all sessions from the cache.
+     *
+     */
+    void Clear(void);
+
+    /**
+     * This method adds a session to the cache, replacing an expired or the oldest session if the cache is full.
+     *
+     * @param[in]  aSession  A reference to the established session.
+     * @param[in]  aPskHash  A pointer to the digest of the PSK the session was established with.
+     *
+     * @retval kThreadError_None      Successfully added the session, or the session was already cached.
+     * @retval kThreadError_NotFound  The session has no session ID and cannot be resumed.
+     *
+     */
+    ThreadError Save(const mbedtls_ssl_session &aSession, const uint8_t *aPskHash);
+
+    /**
+     * This method restores the session with the session ID of @p aSession.
+     *
+     * @param[inout]  aSession  A reference to the session, whose session ID is looked up.
+     * @param[in]     aPskHash  A pointer to the digest of the current PSK.
+     *
+     * @retval kThreadError_None      Successfully restored the session.
+     * @retval kThreadError_NotFound  No session with this session ID and PSK is cached.
+     *
+     */
+    ThreadError Restore(mbedtls_ssl_session &aSession, const uint8_t *aPskHash);
+
+    /**
+     * This method restores the most recent session established with the current PSK.
+     *
+     * @param[out]  aSession  A reference to the session.
+     * @param[in]   aPskHash  A pointer to the digest of the current PSK.
+     *
+     * @retval kThreadError_None      Successfully restored the session.
+     * @retval kThreadError_NotFound  No session with this PSK is cached.
+     *
+     */
+    ThreadError RestoreLatest(mbedtls_ssl_session &aSession, const uint8_t *aPskHash);
+
+private:
+    enum
+    {
+        kNumEntries = OPENTHREAD_CONFIG_DTLS_SESSION_CACHE_SIZE,
+        kLifetime   = OPENTHREAD_CONFIG_DTLS_SESSION_CACHE_LIFETIME * 1000u,  ///< Lifetime in milliseconds.
+    };
+
+    struct Entry
+    {
+        uint32_t mCreated;
+        uint16_t mCiphersuite;
+        uint8_t  mCompression;
+        uint8_t  mIdLength;      ///< Zero if the entry is unused.
+        uint8_t  mId[32];
+        uint8_t  mMaster[48];
+        uint8_t  mPskHash[kPskHashLength];
+    };
+
+    Entry *Find(const uint8_t *aPskHash, const uint8_t *aId, size_t aIdLength);
+    Entry *GetFreeEntry(uint32_t aNow);
+    static void CopyTo(const Entry &aEntry, mbedtls_ssl_session &aSession);
+
+#if OPENTHREAD_CONFIG_DTLS_SESSION_CACHE_SIZE > 0
+    Entry mEntries[kNumEntries];
+#endif
+};
+
 class Dtls
 {
 public:
@@ -135,6 +226,20 @@ public:
      */
     ThreadError SetPsk(const uint8_t *aPsk, uint8_t aPskLength);
 
+    /**
+     * This method removes all cached sessions, so that no session established before can be resumed.
+     *
+     */
+    void ClearSessionCache(void) { mSessionCache.Clear(); }
+
+    /**
+     * This method indicates whether or not the current session was resumed from the session cache.
+     *
+     * @returns TRUE if the session was resumed, FALSE if it was established with a full handshake.
+     *
+     */
+    bool IsSessionResumed(void) const { return mSessionResumed; }
+
     /**
      * This method sets the Client ID used for generating the Hello Cookie.
      *
@@ -207,6 +312,12 @@ private:
     int HandleMbedtlsExportKeys(const unsigned char *aMasterSecret, const unsigned char *aKeyBlock,
                                 size_t aMacLength, size_t aKeyLength, size_t aIvLength);
 
+    static int HandleMbedtlsGetCache(void *aContext, mbedtls_ssl_session *aSession);
+    int HandleMbedtlsGetCache(mbedtls_ssl_session *aSession);
+
+    static int HandleMbedtlsSetCache(void *aContext, const mbedtls_ssl_session *aSession);
+    int HandleMbedtlsSetCache(const mbedtls_ssl_session *aSession);
+
     static void HandleTimer(void *aContext);
     void HandleTimer(void);
 
@@ -215,6 +326,10 @@ private:
 
     uint8_t mPsk[kPskMaxLength];
     uint8_t mPskLength;
+    uint8_t mPskHash[DtlsSessionCache::kPskHashLength];
+
+    DtlsSessionCache mSessionCache;
+    bool mSessionResumed;
 
     mbedtls_entropy_context mEntropy;
     mbedtls_ctr_drbg_context mCtrDrbg;
@@ -0,0 +1,295 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the Commissioner's table of Joiners.
+ */
+
+#include <string.h>
+
+#include <common/code_utils.hpp>
+#include <common/crc16.hpp>
+#include <meshcop/joiner_table.hpp>
+
+namespace Thread {
+namespace MeshCoP {
+
+JoinerTable::JoinerTable(void)
+{
+    Clear();
+}
+
+void JoinerTable::Clear(void)
+{
+    memset(mJoiners, 0, sizeof(mJoiners));
+    memset(mBuckets, 0xff, sizeof(mBuckets));
+    memset(mBitCounts, 0, sizeof(mBitCounts));
+
+    for (uint16_t i = 0; i < kNumJoiners; i++)
+    {
+        mJoiners[i].mNext = i + 1;
+    }
+
+    mJoiners[kNumJoiners - 1].mNext = kInvalidIndex;
+    mFree = 0;
+    mAnyJoiner = kInvalidIndex;
+    mExpiryHead = kInvalidIndex;
+    mExpiryTail = kInvalidIndex;
+    mNumJoiners = 0;
+}
+
+ThreadError JoinerTable::Add(const Mac::ExtAddress *aExtAddress, const char *aPsk, uint32_t aExpiration)
+{
+    ThreadError error = kThreadError_None;
+    Joiner *joiner;
+
+    VerifyOrExit(strlen(aPsk) <= Dtls::kPskMaxLength, error = kThreadError_InvalidArgs);
+
+    if ((joiner = Find(aExtAddress)) != NULL)
+    {
+        RemoveFromExpiryList(*joiner);
+    }
+    else
+    {
+        VerifyOrExit(mFree != kInvalidIndex, error = kThreadError_NoBufs);
+
+        joiner = &mJoiners[mFree];
+        mFree = joiner->mNext;
+
+        if (aExtAddress != NULL)
+        {
+            uint16_t &bucket = GetBucket(*aExtAddress);
+
+            joiner->mExtAddress = *aExtAddress;
+            joiner->mAny = false;
+            joiner->mNext = bucket;
+            bucket = GetIndex(*joiner);
+            UpdateSteeringData(*aExtAddress, true);
+        }
+        else
+        {
+            joiner->mAny = true;
+            mAnyJoiner = GetIndex(*joiner);
+        }
+
+        mNumJoiners++;
+    }
+
+    strncpy(joiner->mPsk, aPsk, sizeof(joiner->mPsk));
+    joiner->mExpiration = aExpiration;
+    joiner->mState = kStatePending;
+    AddToExpiryList(*joiner);
+
+exit:
+    return error;
+}
+
+ThreadError JoinerTable::Remove(const Mac::ExtAddress *aExtAddress)
+{
+    ThreadError error = kThreadError_None;
+    Joiner *joiner;
+
+    VerifyOrExit((joiner = Find(aExtAddress)) != NULL, error = kThreadError_NotFound);
+    Remove(*joiner);
+
+exit:
+    return error;
+}
+
+void JoinerTable::Remove(Joiner &aJoiner)
+{
+    uint16_t index = GetIndex(aJoiner);
+
+    if (aJoiner.mAny)
+    {
+        mAnyJoiner = kInvalidIndex;
+    }
+    else
+    {
+        uint16_t *cur = &GetBucket(aJoiner.mExtAddress);
+
+        while (*cur != index)
+        {
+            cur = &mJoiners[*cur].mNext;
+        }
+
+        *cur = aJoiner.mNext;
+        UpdateSteeringData(aJoiner.mExtAddress, false);
+    }
+
+    RemoveFromExpiryList(aJoiner);
+    aJoiner.mNext = mFree;
+    mFree = index;
+    mNumJoiners--;
+}
+
+JoinerTable::Joiner *JoinerTable::Find(const Mac::ExtAddress *aExtAddress)
+{
+    Joiner *rval = NULL;
+
+    if (aExtAddress == NULL)
+    {
+        VerifyOrExit(mAnyJoiner != kInvalidIndex, ;);
+        ExitNow(rval = &mJoiners[mAnyJoiner]);
+    }
+
+    for (uint16_t i = GetBucket(*aExtAddress); i != kInvalidIndex; i = mJoiners[i].mNext)
+    {
+        if (memcmp(&mJoiners[i].mExtAddress, aExtAddress, sizeof(mJoiners[i].mExtAddress)) == 0)
+        {
+            ExitNow(rval = &mJoiners[i]);
+        }
+    }
+
+exit:
+    return rval;
+}
+
+JoinerTable::Joiner *JoinerTable::FindMatching(const Mac::ExtAddress &aExtAddress)
+{
+    Joiner *rval;
+
+    if ((rval = Find(&aExtAddress)) == NULL)
+    {
+        rval = Find(NULL);
+    }
+
+    return rval;
+}
+
+JoinerTable::Joiner *JoinerTable::GetNextExpiring(void)
+{
+    return (mExpiryHead != kInvalidIndex) ? &mJoiners[mExpiryHead] : NULL;
+}
+
+void JoinerTable::GetSteeringData(SteeringDataTlv &aSteeringData) const
+{
+    aSteeringData.Init();
+
+    if (mAnyJoiner != kInvalidIndex)
+    {
+        aSteeringData.SetLength(1);
+        aSteeringData.Set();
+        ExitNow();
+    }
+
+    for (uint8_t i = 0; i < aSteeringData.GetNumBits(); i++)
+    {
+        if (mBitCounts[i] != 0)
+        {
+            aSteeringData.SetBit(i);
+        }
+    }
+
+exit:
+    return;
+}
+
+uint16_t &JoinerTable::GetBucket(const Mac::ExtAddress &aExtAddress)
+{
+    Crc16 ccitt(Crc16::kCcitt);
+
+    for (size_t i = 0; i < sizeof(aExtAddress.m8); i++)
+    {
+        ccitt.Update(aExtAddress.m8[i]);
+    }
+
+    return mBuckets[ccitt.Get() % kNumBuckets];
+}
+
+void JoinerTable::UpdateSteeringData(const Mac::ExtAddress &aExtAddress, bool aAdd)
+{
+    Crc16 ccitt(Crc16::kCcitt);
+    Crc16 ansi(Crc16::kAnsi);
+    uint16_t bits[2];
+
+    for (size_t i = 0; i < sizeof(aExtAddress.m8); i++)
+    {
+        ccitt.Update(aExtAddress.m8[i]);
+        ansi.Update(aExtAddress.m8[i]);
+    }
+
+    bits[0] = ccitt.Get() % kNumBits;
+    bits[1] = ansi.Get() % kNumBits;
+
+    for (size_t i = 0; i < sizeof(bits) / sizeof(bits[0]); i++)
+    {
+        if (aAdd)
+        {
+            mBitCounts[bits[i]]++;
+        }
+        else
+        {
+            mBitCounts[bits[i]]--;
+        }
+    }
+}
+
+void JoinerTable::AddToExpiryList(Joiner &aJoiner)
+{
+    uint16_t index = GetIndex(aJoiner);
+
+    aJoiner.mExpiryPrev = mExpiryTail;
+    aJoiner.mExpiryNext = kInvalidIndex;
+
+    if (mExpiryTail != kInvalidIndex)
+    {
+        mJoiners[mExpiryTail].mExpiryNext = index;
+    }
+    else
+    {
+        mExpiryHead = index;
+    }
+
+    mExpiryTail = index;
+}
+
+void JoinerTable::RemoveFromExpiryList(Joiner &aJoiner)
+{
+    if (aJoiner.mExpiryPrev != kInvalidIndex)
+    {
+        mJoiners[aJoiner.mExpiryPrev].mExpiryNext = aJoiner.mExpiryNext;
+    }
+    else
+    {
+        mExpiryHead = aJoiner.mExpiryNext;
+    }
+
+    if (aJoiner.mExpiryNext != kInvalidIndex)
+    {
+        mJoiners[aJoiner.mExpiryNext].mExpiryPrev = aJoiner.mExpiryPrev;
+    }
+    else
+    {
+        mExpiryTail = aJoiner.mExpiryPrev;
+    }
+}
+
+}  // namespace MeshCoP
+}  // namespace Thread
@@ -0,0 +1,262 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the Commissioner's table of Joiners.
+ */
+
+#ifndef JOINER_TABLE_HPP_
+#define JOINER_TABLE_HPP_
+
+#include <openthread-core-config.h>
+#include <openthread-types.h>
+#include <mac/mac_frame.hpp>
+#include <meshcop/dtls.hpp>
+#include <thread/meshcop_tlvs.hpp>
+
+namespace Thread {
+namespace MeshCoP {
+
+/**
+ * This class implements the Commissioner's table of Joiners.
+ *
+ * Joiners are allocated from a pool of OPENTHREAD_CONFIG_MAX_JOINER_ENTRIES entries and hashed by Joiner ID, so that
+ * looking up a Joiner does not depend on the number of Joiners.  The steering data Bloom filter is kept as a counting
+ * Bloom filter, which is updated as each Joiner is added or removed.  Joiners expire in the order they were added,
+ * so the next Joiner to expire is always at the head of a list.
+ *
+ */
+class JoinerTable
+{
+public:
+    /**
+     * Joiner states.
+     *
+     */
+    enum State
+    {
+        kStatePending    = 0,  ///< Waiting for the Joiner to connect.
+        kStateConnecting = 1,  ///< A DTLS session with the Joiner is in progress.
+        kStateJoined     = 2,  ///< The Joiner was accepted in a JOIN_FIN.rsp.
+    };
+
+    /**
+     * This class represents a Joiner entry.
+     *
+     */
+    class Joiner
+    {
+        friend class JoinerTable;
+
+    public:
+        /**
+         * This method indicates whether or not the entry accepts any Joiner.
+         *
+         * @retval TRUE   If the entry accepts any Joiner.
+         * @retval FALSE  If the entry only accepts the Joiner with its Joiner ID.
+         *
+         */
+        bool IsAny(void) const { return mAny; }
+
+        /**
+         * This method returns the Joiner ID.
+         *
+         * @returns A reference to the Joiner ID.
+         *
+         */
+        const Mac::ExtAddress &GetExtAddress(void) const { return mExtAddress; }
+
+        /**
+         * This method returns the Joiner's PSKd.
+         *
+         * @returns A pointer to the NULL-terminated PSKd.
+         *
+         */
+        const char *GetPsk(void) const { return mPsk; }
+
+        /**
+         * This method returns the time at which the entry expires.
+         *
+         * @returns The expiration time in milliseconds.
+         *
+         */
+        uint32_t GetExpiration(void) const { return mExpiration; }
+
+        /**
+         * This method returns the state of the Joiner.
+         *
+         * @returns The state of the Joiner.
+         *
+         */
+        State GetState(void) const { return static_cast<State>(mState); }
+
+        /**
+         * This method sets the state of the Joiner.
+         *
+         * @param[in]  aState  The state of the Joiner.
+         *
+         */
+        void SetState(State aState) { mState = static_cast<uint8_t>(aState); }
+
+    private:
+        Mac::ExtAddress mExtAddress;
+        char mPsk[Dtls::kPskMaxLength + 1];
+        uint32_t mExpiration;
+        uint16_t mNext;          ///< The next entry in the hash bucket or in the free list.
+        uint16_t mExpiryPrev;
+        uint16_t mExpiryNext;
+        uint8_t mState;
+        bool mAny;
+    };
+
+    /**
+     * This constructor initializes the object.
+     *
+     */
+    JoinerTable(void);
+
+    /**
+     * This method removes all Joiners.
+     *
+     */
+    void Clear(void);
+
+    /**
+     * This method adds a Joiner, or updates the PSKd and expiration time of a Joiner already in the table.
+     *
+     * @param[in]  aExtAddress   A pointer to the Joiner ID or NULL for any Joiner.
+     * @param[in]  aPsk          A pointer to the NULL-terminated PSKd.
+     * @param[in]  aExpiration   The time at which the Joiner expires.
+     *
+     * @retval kThreadError_None         Successfully added the Joiner.
+     * @retval kThreadError_InvalidArgs  @p aPsk is too long.
+     * @retval kThreadError_NoBufs       The table is full.
+     *
+     */
+    ThreadError Add(const Mac::ExtAddress *aExtAddress, const char *aPsk, uint32_t aExpiration);
+
+    /**
+     * This method removes a Joiner.
+     *
+     * @param[in]  aExtAddress  A pointer to the Joiner ID or NULL for any Joiner.
+     *
+     * @retval kThreadError_None      Successfully removed the Joiner.
+     * @retval kThreadError_NotFound  The Joiner is not in the table.
+     *
+     */
+    ThreadError Remove(const Mac::ExtAddress *aExtAddress);
+
+    /**
+     * This method removes a Joiner.
+     *
+     * @param[in]  aJoiner  A reference to the Joiner entry.
+     *
+     */
+    void Remove(Joiner &aJoiner);
+
+    /**
+     * This method finds the entry of a Joiner.
+     *
+     * @param[in]  aExtAddress  A pointer to the Joiner ID or NULL for any Joiner.
+     *
+     * @returns A pointer to the entry or NULL if the Joiner is not in the table.
+     *
+     */
+    Joiner *Find(const Mac::ExtAddress *aExtAddress);
+
+    /**
+     * This method finds the entry that accepts a Joiner, preferring the entry for its Joiner ID over an entry for
+     * any Joiner.
+     *
+     * @param[in]  aExtAddress  A reference to the Joiner ID.
+     *
+     * @returns A pointer to the entry or NULL if no entry accepts the Joiner.
+     *
+     */
+    Joiner *FindMatching(const Mac::ExtAddress &aExtAddress);
+
+    /**
+     * This method returns the entry that expires next.
+     *
+     * @returns A pointer to the entry that expires next or NULL if the table is empty.
+     *
+     */
+    Joiner *GetNextExpiring(void);
+
+    /**
+     * This method returns the number of Joiners in the table.
+     *
+     * @returns The number of Joiners in the table.
+     *
+     */
+    uint16_t GetNumJoiners(void) const { return mNumJoiners; }
+
+    /**
+     * This method writes the steering data for the Joiners in the table.
+     *
+     * @param[out]  aSteeringData  A reference to the Steering Data TLV.
+     *
+     */
+    void GetSteeringData(SteeringDataTlv &aSteeringData) const;
+
+private:
+    enum
+    {
+        kNumJoiners   = OPENTHREAD_CONFIG_MAX_JOINER_ENTRIES,
+        kNumBuckets   = OPENTHREAD_CONFIG_MAX_JOINER_ENTRIES,
+        kNumBits      = OT_STEERING_DATA_MAX_LENGTH * 8,
+        kInvalidIndex = 0xffff,
+    };
+
+#if OPENTHREAD_CONFIG_MAX_JOINER_ENTRIES < 256
+    typedef uint8_t BitCount;
+#else
+    typedef uint16_t BitCount;
+#endif
+
+    uint16_t GetIndex(const Joiner &aJoiner) const { return static_cast<uint16_t>(&aJoiner - mJoiners); }
+    uint16_t &GetBucket(const Mac::ExtAddress &aExtAddress);
+    void UpdateSteeringData(const Mac::ExtAddress &aExtAddress, bool aAdd);
+    void AddToExpiryList(Joiner &aJoiner);
+    void RemoveFromExpiryList(Joiner &aJoiner);
+
+    Joiner mJoiners[kNumJoiners];
+    uint16_t mBuckets[kNumBuckets];
+    BitCount mBitCounts[kNumBits];
+    uint16_t mFree;
+    uint16_t mAnyJoiner;
+    uint16_t mExpiryHead;
+    uint16_t mExpiryTail;
+    uint16_t mNumJoiners;
+};
+
+}  // namespace MeshCoP
+}  // namespace Thread
+
+#endif  // JOINER_TABLE_HPP_
@@ -44,6 +44,7 @@
 #include <net/ip6_routes.hpp>
 #include <net/netif.hpp>
 #include <net/udp6.hpp>
+#include <platform/random.h>
 #include <thread/mle.hpp>
 #include <openthread-instance.h>
 
@@ -55,18 +56,26 @@ Ip6::Ip6(void):
     mIcmp(*this),
     mUdp(*this),
     mMpl(*this),
+    mTimerScheduler(*this),
+#if OPENTHREAD_ENABLE_PLATFORM_USEC_TIMER
+    mTimerMicroScheduler(*this),
+#endif
     mForwardingEnabled(false),
     mSendQueueTask(mTaskletScheduler, HandleSendQueue, this),
     mReceiveIp6DatagramCallback(NULL),
     mReceiveIp6DatagramCallbackContext(NULL),
     mIsReceiveIp6FilterEnabled(false),
-    mNetifListHead(NULL)
+    mNetifListHead(NULL),
+    mReassemblyTimer(mTimerScheduler, &Ip6::HandleReassemblyTimer, this),
+    mFragmentIdentification(otPlatRandomGet())
 {
+    memset(mReassemblyEntries, 0, sizeof(mReassemblyEntries));
 }
 
-Message *Ip6::NewMessage(uint16_t reserved)
+Message *Ip6::NewMessage(uint16_t reserved, uint8_t aPriority)
 {
-    return mMessagePool.New(Message::kTypeIp6, sizeof(Header) + sizeof(HopByHopHeader) + sizeof(OptionMpl) + reserved);
+    return mMessagePool.New(Message::kTypeIp6, sizeof(Header) + sizeof(HopByHopHeader) + sizeof(OptionMpl) + reserved,
+                            aPriority);
 }
 
 void Ip6::SetForwardingEnabled(bool aEnable)
@@ -380,6 +389,8 @@ exit:
 
     if (error == kThreadError_None)
     {
+        otPerfStampMessage(message);
+        otPerfCount(mPerfCounters, mIp6TxDatagrams);
         message.SetInterfaceId(messageInfo.mInterfaceId);
         EnqueueDatagram(message);
     }
@@ -387,6 +398,82 @@ exit:
     return error;
 }
 
+ThreadError Ip6::FragmentDatagram(Message &message, uint16_t unfragmentableLength, IpProto ipproto)
+{
+    ThreadError error = kThreadError_None;
+    Header header;
+    FragmentHeader fragmentHeader;
+    Message *fragment = NULL;
+    uint16_t maxLength = (kLinkMtu - unfragmentableLength - sizeof(fragmentHeader)) & ~7;
+    uint16_t offset = unfragmentableLength;
+    uint16_t nextHeaderOffset = Header::GetNextHeaderOffset();
+    uint16_t length;
+    uint8_t nextHeader = kProtoFragment;
+    ExtensionHeader extensionHeader;
+
+    message.Read(0, sizeof(header), &header);
+
+    // the Next Header field of the last header in the Unfragmentable Part will refer to the Fragment header
+    for (uint16_t headerOffset = sizeof(header); headerOffset < unfragmentableLength;
+         headerOffset += (extensionHeader.GetLength() + 1) * 8)
+    {
+        message.Read(headerOffset, sizeof(extensionHeader), &extensionHeader);
+        nextHeaderOffset = headerOffset;
+    }
+
+    fragmentHeader.Init();
+    fragmentHeader.SetNextHeader(ipproto);
+    fragmentHeader.SetIdentification(mFragmentIdentification++);
+
+    while (offset < message.GetLength())
+    {
+        length = message.GetLength() - offset;
+
+        if (length > maxLength)
+        {
+            length = maxLength;
+            fragmentHeader.SetMoreFlag();
+        }
+        else
+        {
+            fragmentHeader.ClearMoreFlag();
+        }
+
+        fragmentHeader.SetOffset((offset - unfragmentableLength) / 8);
+        header.SetPayloadLength(unfragmentableLength - sizeof(header) + sizeof(fragmentHeader) + length);
+
+        VerifyOrExit((fragment = mMessagePool.New(Message::kTypeIp6, 0, message.GetPriority())) != NULL,
+                     error = kThreadError_NoBufs);
+        SuccessOrExit(error = fragment->SetLength(unfragmentableLength + sizeof(fragmentHeader) + length));
+#if OPENTHREAD_ENABLE_PERF_COUNTERS
+        fragment->SetTimestamp(message.GetTimestamp());
+#endif
+
+        // the Fragment header follows the Unfragmentable Part
+        message.CopyTo(0, 0, unfragmentableLength, *fragment);
+        fragment->Write(0, sizeof(header), &header);
+        fragment->Write(nextHeaderOffset, sizeof(nextHeader), &nextHeader);
+
+        fragment->Write(unfragmentableLength, sizeof(fragmentHeader), &fragmentHeader);
+        message.CopyTo(offset, unfragmentableLength + sizeof(fragmentHeader), length, *fragment);
+
+        fragment->SetInterfaceId(message.GetInterfaceId());
+        EnqueueDatagram(*fragment);
+        fragment = NULL;
+
+        offset += length;
+    }
+
+exit:
+
+    if (fragment != NULL)
+    {
+        fragment->Free();
+    }
+
+    return error;
+}
+
 void Ip6::HandleSendQueue(void *aContext)
 {
     static_cast<Ip6 *>(aContext)->HandleSendQueue();
@@ -461,32 +548,299 @@ exit:
     return error;
 }
 
-ThreadError Ip6::HandleFragment(Message &message)
+ThreadError Ip6::HandleFragment(Message &message, Netif *netif, const void *linkMessageInfo, bool fromLocalHost,
+                               Header &header, uint16_t nextHeaderOffset, bool forward, bool &receive)
 {
     ThreadError error = kThreadError_None;
     FragmentHeader fragmentHeader;
+    Message *datagram = NULL;
 
     message.Read(message.GetOffset(), sizeof(fragmentHeader), &fragmentHeader);
 
-    VerifyOrExit(fragmentHeader.GetOffset() == 0 && fragmentHeader.IsMoreFlagSet() == false,
-                 error = kThreadError_Drop);
+    if (fragmentHeader.GetOffset() == 0 && fragmentHeader.IsMoreFlagSet() == false)
+    {
+        // atomic fragment
+        message.MoveOffset(sizeof(fragmentHeader));
+        ExitNow();
+    }
+
+    // only unicast datagrams destined to this node are reassembled, and never from nested fragments
+    VerifyOrExit(!forward && !header.GetDestination().IsMulticast() &&
+                 fragmentHeader.GetNextHeader() != kProtoFragment, error = kThreadError_Drop);
+
+    SuccessOrExit(error = ReassembleFragment(message, header, fragmentHeader, nextHeaderOffset, datagram));
+
+    // the fragment is consumed, the datagram it completes is received over the same link
+    receive = false;
+
+    if (datagram != NULL)
+    {
+        HandleDatagram(*datagram, netif, message.GetInterfaceId(), linkMessageInfo, fromLocalHost);
+    }
+
+exit:
+    return error;
+}
+
+ThreadError Ip6::ReassembleFragment(Message &message, Header &header, FragmentHeader &fragmentHeader,
+                                    uint16_t nextHeaderOffset, Message *&reassembled)
+{
+    ThreadError error = kThreadError_None;
+    ReassemblyEntry *entry = NULL;
+    Message *datagram;
+    Header datagramHeader;
+    uint16_t unfragmentableLength = message.GetOffset();
+    uint16_t fragmentOffset = unfragmentableLength + sizeof(fragmentHeader);
+    uint16_t start = fragmentHeader.GetOffset() * 8;
+    uint16_t end;
+    uint16_t length;
+    uint16_t dataLength;
+    uint16_t growth;
+    uint8_t nextHeader;
+
+    VerifyOrExit(message.GetLength() > fragmentOffset, error = kThreadError_Drop);
+    length = message.GetLength() - fragmentOffset;
+    end = start + length;
+
+    // every fragment except the last one carries a multiple of 8 bytes
+    VerifyOrExit(!fragmentHeader.IsMoreFlagSet() || (length & 7) == 0, error = kThreadError_Drop);
+    VerifyOrExit(unfragmentableLength + end <= kMaxDatagramLength, error = kThreadError_Drop);
+
+    VerifyOrExit((entry = GetReassemblyEntry(header, fragmentHeader.GetIdentification())) != NULL,
+                 error = kThreadError_NoBufs);
+
+    if (fragmentHeader.IsMoreFlagSet())
+    {
+        VerifyOrExit(entry->mLength == 0 || end < entry->mLength, error = kThreadError_Drop);
+    }
+    else
+    {
+        // the last fragment sets the total length, which must cover every fragment received so far
+        VerifyOrExit(entry->mLength == 0, error = kThreadError_Drop);
+        VerifyOrExit(entry->mRangeCount == 0 || entry->mRanges[entry->mRangeCount - 1].mEnd <= end,
+                     error = kThreadError_Drop);
+        entry->mLength = end;
+    }
+
+    // overlapping fragments discard the whole datagram (RFC 5722)
+    SuccessOrExit(error = AddReassemblyRange(*entry, start, end));
+
+    datagram = entry->mMessage;
+    dataLength = datagram->GetLength() - entry->mUnfragmentableLength;
+    growth = (end > dataLength) ? end - dataLength : 0;
+
+    if (start == 0)
+    {
+        growth += unfragmentableLength;
+    }
+
+    VerifyOrExit(GetReassemblyBufferLength() + growth <= OPENTHREAD_CONFIG_IP6_REASSEMBLY_BUFFER_SIZE,
+                 error = kThreadError_NoBufs);
+
+    if (end > dataLength)
+    {
+        SuccessOrExit(error = datagram->SetLength(entry->mUnfragmentableLength + end));
+    }
+
+    message.CopyTo(fragmentOffset, entry->mUnfragmentableLength + start, length, *datagram);
+
+    if (start == 0)
+    {
+        // the first fragment provides the Unfragmentable Part, whose last Next Header now refers to the payload
+        SuccessOrExit(error = datagram->Prepend(NULL, unfragmentableLength));
+        message.CopyTo(0, 0, unfragmentableLength, *datagram);
+        nextHeader = static_cast<uint8_t>(fragmentHeader.GetNextHeader());
+        datagram->Write(nextHeaderOffset, sizeof(nextHeader), &nextHeader);
+        entry->mUnfragmentableLength = unfragmentableLength;
+    }
+
+    if (entry->mLength != 0 && entry->mRangeCount == 1 &&
+        entry->mRanges[0].mStart == 0 && entry->mRanges[0].mEnd == entry->mLength)
+    {
+        VerifyOrExit(datagram->GetLength() <= kMaxDatagramLength, error = kThreadError_Drop);
+
+        datagram->Read(0, sizeof(datagramHeader), &datagramHeader);
+        datagramHeader.SetPayloadLength(datagram->GetLength() - sizeof(datagramHeader));
+        datagram->Write(0, sizeof(datagramHeader), &datagramHeader);
+
+        entry->mMessage = NULL;
+        reassembled = datagram;
+    }
+
+exit:
+
+    if (error != kThreadError_None && entry != NULL)
+    {
+        FreeReassemblyEntry(*entry);
+    }
 
-    message.MoveOffset(sizeof(fragmentHeader));
+    return error;
+}
+
+Ip6::ReassemblyEntry *Ip6::GetReassemblyEntry(Header &header, uint32_t identification)
+{
+    ReassemblyEntry *entry = NULL;
+    Message *message;
+
+    for (ReassemblyEntry *cur = &mReassemblyEntries[0];
+         cur < &mReassemblyEntries[OPENTHREAD_CONFIG_IP6_REASSEMBLY_DATAGRAMS]; cur++)
+    {
+        if (cur->mMessage != NULL && cur->mIdentification == identification &&
+            cur->mSource == header.GetSource() && cur->mDestination == header.GetDestination())
+        {
+            ExitNow(entry = cur);
+        }
+    }
+
+    // use a free entry or evict the datagram closest to its timeout
+    for (ReassemblyEntry *cur = &mReassemblyEntries[0];
+         cur < &mReassemblyEntries[OPENTHREAD_CONFIG_IP6_REASSEMBLY_DATAGRAMS]; cur++)
+    {
+        if (entry == NULL || cur->mMessage == NULL ||
+            (entry->mMessage != NULL && cur->mTimeout < entry->mTimeout))
+        {
+            entry = cur;
+        }
+    }
+
+    if (entry->mMessage != NULL)
+    {
+        otLogInfoIp6("evicting reassembly of datagram %x", entry->mIdentification);
+        FreeReassemblyEntry(*entry);
+    }
+
+    VerifyOrExit((message = mMessagePool.New(Message::kTypeIp6, sizeof(Header))) != NULL, entry = NULL);
+
+    memset(entry, 0, sizeof(*entry));
+    entry->mMessage = message;
+    entry->mSource = header.GetSource();
+    entry->mDestination = header.GetDestination();
+    entry->mIdentification = identification;
+    entry->mTimeout = OPENTHREAD_CONFIG_IP6_REASSEMBLY_TIMEOUT;
+
+    if (!mReassemblyTimer.IsRunning())
+    {
+        mReassemblyTimer.Start(Timer::SecToMsec(1));
+    }
+
+exit:
+    return entry;
+}
+
+ThreadError Ip6::AddReassemblyRange(ReassemblyEntry &entry, uint16_t start, uint16_t end)
+{
+    ThreadError error = kThreadError_None;
+    ReassemblyEntry::Range *ranges = entry.mRanges;
+    uint8_t index = 0;
+
+    while (index < entry.mRangeCount && ranges[index].mEnd < start)
+    {
+        index++;
+    }
+
+    if (index < entry.mRangeCount && ranges[index].mEnd == start)
+    {
+        // extend the preceding range, merging with the following one if the gap is now filled
+        VerifyOrExit(index + 1 == entry.mRangeCount || ranges[index + 1].mStart >= end, error = kThreadError_Drop);
+        ranges[index].mEnd = end;
+
+        if (index + 1 < entry.mRangeCount && ranges[index + 1].mStart == end)
+        {
+            ranges[index].mEnd = ranges[index + 1].mEnd;
+            memmove(&ranges[index + 1], &ranges[index + 2],
+                    (entry.mRangeCount - index - 2) * sizeof(ReassemblyEntry::Range));
+            entry.mRangeCount--;
+        }
+    }
+    else if (index < entry.mRangeCount && ranges[index].mStart <= end)
+    {
+        // extend the following range
+        VerifyOrExit(ranges[index].mStart == end, error = kThreadError_Drop);
+        ranges[index].mStart = start;
+    }
+    else
+    {
+        VerifyOrExit(entry.mRangeCount < kReassemblyRanges, error = kThreadError_NoBufs);
+        memmove(&ranges[index + 1], &ranges[index], (entry.mRangeCount - index) * sizeof(ReassemblyEntry::Range));
+        ranges[index].mStart = start;
+        ranges[index].mEnd = end;
+        entry.mRangeCount++;
+    }
 
 exit:
     return error;
 }
 
-ThreadError Ip6::HandleExtensionHeaders(Message &message, Header &header, uint8_t &nextHeader, bool forward,
-                                        bool receive)
+uint16_t Ip6::GetReassemblyBufferLength(void) const
+{
+    uint16_t length = 0;
+
+    for (int i = 0; i < OPENTHREAD_CONFIG_IP6_REASSEMBLY_DATAGRAMS; i++)
+    {
+        if (mReassemblyEntries[i].mMessage != NULL)
+        {
+            length += mReassemblyEntries[i].mMessage->GetLength();
+        }
+    }
+
+    return length;
+}
+
+void Ip6::FreeReassemblyEntry(ReassemblyEntry &entry)
+{
+    entry.mMessage->Free();
+    entry.mMessage = NULL;
+}
+
+void Ip6::HandleReassemblyTimer(void *aContext)
+{
+    static_cast<Ip6 *>(aContext)->HandleReassemblyTimer();
+}
+
+void Ip6::HandleReassemblyTimer(void)
+{
+    bool running = false;
+
+    for (int i = 0; i < OPENTHREAD_CONFIG_IP6_REASSEMBLY_DATAGRAMS; i++)
+    {
+        ReassemblyEntry &entry = mReassemblyEntries[i];
+
+        if (entry.mMessage == NULL)
+        {
+            continue;
+        }
+
+        if (--entry.mTimeout == 0)
+        {
+            otLogInfoIp6("reassembly of datagram %x timed out", entry.mIdentification);
+            FreeReassemblyEntry(entry);
+        }
+        else
+        {
+            running = true;
+        }
+    }
+
+    if (running)
+    {
+        mReassemblyTimer.Start(Timer::SecToMsec(1));
+    }
+}
+
+ThreadError Ip6::HandleExtensionHeaders(Message &message, Netif *netif, const void *linkMessageInfo,
+                                        bool fromLocalHost, Header &header, uint8_t &nextHeader, bool forward,
+                                        bool &receive)
 {
     ThreadError error = kThreadError_None;
     ExtensionHeader extensionHeader;
+    uint16_t headerOffset;
+    uint16_t nextHeaderOffset = Header::GetNextHeaderOffset();
 
     while (receive == true || nextHeader == kProtoHopOpts)
     {
         VerifyOrExit(message.GetOffset() <= message.GetLength(), error = kThreadError_Drop);
 
+        headerOffset = message.GetOffset();
         message.Read(message.GetOffset(), sizeof(extensionHeader), &extensionHeader);
 
         switch (nextHeader)
@@ -496,7 +850,8 @@ ThreadError Ip6::HandleExtensionHeaders(Message &message, Header &header, uint8_
             break;
 
         case kProtoFragment:
-            SuccessOrExit(error = HandleFragment(message));
+            SuccessOrExit(error = HandleFragment(message, netif, linkMessageInfo, fromLocalHost, header,
+                                                 nextHeaderOffset, forward, receive));
             break;
 
         case kProtoDstOpts:
@@ -513,6 +868,7 @@ ThreadError Ip6::HandleExtensionHeaders(Message &message, Header &header, uint8_
         }
 
         nextHeader = static_cast<uint8_t>(extensionHeader.GetNextHeader());
+        nextHeaderOffset = headerOffset;
     }
 
 exit:
@@ -668,7 +1024,8 @@ ThreadError Ip6::HandleDatagram(Message &message, Netif *netif, int8_t interface
 
     // process IPv6 Extension Headers
     nextHeader = static_cast<uint8_t>(header.GetNextHeader());
-    SuccessOrExit(error = HandleExtensionHeaders(message, header, nextHeader, forward, receive));
+    SuccessOrExit(error = HandleExtensionHeaders(message, netif, linkMessageInfo, fromLocalHost, header, nextHeader,
+                                                 forward, receive));
 
     if (!mForwardingEnabled && netif != NULL)
     {
@@ -678,6 +1035,8 @@ ThreadError Ip6::HandleDatagram(Message &message, Netif *netif, int8_t interface
     // process IPv6 Payload
     if (receive)
     {
+        otPerfCount(mPerfCounters, mIp6RxDatagrams);
+
         if (fromLocalHost == false)
         {
             ProcessReceiveCallback(message, messageInfo, nextHeader);
@@ -690,6 +1049,9 @@ ThreadError Ip6::HandleDatagram(Message &message, Netif *netif, int8_t interface
     {
         if (netif != NULL)
         {
+            // relayed datagrams yield buffers to locally originated traffic
+            SuccessOrExit(error = message.SetPriority(Message::kPriorityLow));
+            otPerfCount(mPerfCounters, mIp6ForwardedDatagrams);
             header.SetHopLimit(header.GetHopLimit() - 1);
         }
 
@@ -698,6 +1060,12 @@ ThreadError Ip6::HandleDatagram(Message &message, Netif *netif, int8_t interface
             // send time exceeded
             ExitNow(error = kThreadError_Drop);
         }
+        else if (netif == NULL && message.GetLength() > kLinkMtu && !header.GetDestination().IsMulticast())
+        {
+            // the fragments are forwarded once they pass through the send queue
+            SuccessOrExit(error = FragmentDatagram(message, message.GetOffset(), static_cast<IpProto>(nextHeader)));
+            forward = false;
+        }
         else
         {
             hopLimit = header.GetHopLimit();
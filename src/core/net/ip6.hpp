@@ -39,6 +39,8 @@
 #include <openthread-types.h>
 #include <common/encoding.hpp>
 #include <common/message.hpp>
+#include <common/perf_counters.hpp>
+#include <common/timer.hpp>
 #include <net/icmp6.hpp>
 #include <net/ip6_address.hpp>
 #include <net/ip6_headers.hpp>
@@ -53,6 +55,8 @@ using Thread::Encoding::BigEndian::HostSwap32;
 
 namespace Thread {
 
+void TestIp6FragmentExtensionHeaders(void);
+
 /**
  * @namespace Thread::Ip6
  *
@@ -95,22 +99,26 @@ namespace Ip6 {
  */
 class Ip6
 {
+    friend void Thread::TestIp6FragmentExtensionHeaders(void);
+
 public:
     enum
     {
         kDefaultHopLimit = 64,
         kMaxDatagramLength = 1500,
+        kLinkMtu           = 1280,  ///< Datagrams sent by this node are fragmented above this length.
     };
 
     /**
      * This method allocates a new message buffer from the buffer pool.
      *
      * @param[in]  aReserved  The number of header bytes to reserve following the IPv6 header.
+     * @param[in]  aPriority  The priority class of the message.
      *
      * @returns A pointer to the message or NULL if insufficient message buffers are available.
      *
      */
-    Message *NewMessage(uint16_t aReserved);
+    Message *NewMessage(uint16_t aReserved, uint8_t aPriority = Message::kPriorityNormal);
 
     /**
      * This constructor initializes the object.
@@ -337,15 +345,24 @@ public:
     MessagePool mMessagePool;
     TaskletScheduler mTaskletScheduler;
     TimerScheduler mTimerScheduler;
+#if OPENTHREAD_ENABLE_PLATFORM_USEC_TIMER
+    TimerMicroScheduler mTimerMicroScheduler;
+#endif
+#if OPENTHREAD_ENABLE_PERF_COUNTERS
+    PerfCounters mPerfCounters;
+#endif
 
 private:
     static void HandleSendQueue(void *aContext);
     void HandleSendQueue(void);
 
     ThreadError ProcessReceiveCallback(const Message &aMessage, const MessageInfo &aMessageInfo, uint8_t aIpProto);
-    ThreadError HandleExtensionHeaders(Message &message, Header &header, uint8_t &nextHeader, bool forward,
-                                       bool receive);
-    ThreadError HandleFragment(Message &message);
+    ThreadError HandleExtensionHeaders(Message &message, Netif *netif, const void *linkMessageInfo,
+                                       bool fromLocalHost, Header &header, uint8_t &nextHeader, bool forward,
+                                       bool &receive);
+    ThreadError HandleFragment(Message &message, Netif *netif, const void *linkMessageInfo, bool fromLocalHost,
+                               Header &header, uint16_t nextHeaderOffset, bool forward, bool &receive);
+    ThreadError FragmentDatagram(Message &message, uint16_t unfragmentableLength, IpProto ipproto);
     ThreadError AddMplOption(Message &message, Header &header, IpProto nextHeader, uint16_t payloadLength);
     ThreadError InsertMplOption(Message &message, Header &header);
     ThreadError RemoveMplOption(Message &aMessage);
@@ -363,6 +380,48 @@ private:
     bool mIsReceiveIp6FilterEnabled;
 
     Netif *mNetifListHead;
+
+    enum
+    {
+        kReassemblyRanges  = 8,  ///< Maximum number of disjoint byte ranges tracked per datagram.
+    };
+
+    /**
+     * This structure holds the state of a datagram reassembled from IPv6 Fragment headers.
+     *
+     */
+    struct ReassemblyEntry
+    {
+        struct Range
+        {
+            uint16_t mStart;
+            uint16_t mEnd;
+        };
+
+        Message  *mMessage;                       ///< The datagram being reassembled, NULL if the entry is free.
+        Address   mSource;
+        Address   mDestination;
+        uint32_t  mIdentification;
+        uint16_t  mLength;                        ///< Fragmentable Part length, zero until the last fragment.
+        uint16_t  mUnfragmentableLength;          ///< Unfragmentable Part length, zero until the first fragment.
+        uint8_t   mTimeout;                       ///< Seconds remaining before the datagram is discarded.
+        uint8_t   mRangeCount;
+        Range     mRanges[kReassemblyRanges];     ///< Received byte ranges, sorted and non-adjacent.
+    };
+
+    ThreadError ReassembleFragment(Message &message, Header &header, FragmentHeader &fragmentHeader,
+                                   uint16_t nextHeaderOffset, Message *&reassembled);
+    ReassemblyEntry *GetReassemblyEntry(Header &header, uint32_t identification);
+    ThreadError AddReassemblyRange(ReassemblyEntry &entry, uint16_t start, uint16_t end);
+    uint16_t GetReassemblyBufferLength(void) const;
+    void FreeReassemblyEntry(ReassemblyEntry &entry);
+
+    static void HandleReassemblyTimer(void *aContext);
+    void HandleReassemblyTimer(void);
+
+    ReassemblyEntry mReassemblyEntries[OPENTHREAD_CONFIG_IP6_REASSEMBLY_DATAGRAMS];
+    Timer mReassemblyTimer;
+    uint32_t mFragmentIdentification;
 };
 
 static inline Ip6 *Ip6FromTaskletScheduler(TaskletScheduler *aTaskletScheduler)
@@ -370,11 +429,6 @@ static inline Ip6 *Ip6FromTaskletScheduler(TaskletScheduler *aTaskletScheduler)
     return (Ip6 *)CONTAINING_RECORD(aTaskletScheduler, Ip6, mTaskletScheduler);
 }
 
-static inline Ip6 *Ip6FromTimerScheduler(TimerScheduler *aTimerScheduler)
-{
-    return (Ip6 *)CONTAINING_RECORD(aTimerScheduler, Ip6, mTimerScheduler);
-}
-
 /**
  * @}
  *
@@ -44,6 +44,7 @@
 #include <net/socket.hpp>
 
 using Thread::Encoding::BigEndian::HostSwap16;
+using Thread::Encoding::BigEndian::HostSwap32;
 
 namespace Thread {
 
@@ -235,6 +236,14 @@ public:
      */
     static uint8_t GetPayloadLengthOffset() { return offsetof(HeaderPoD, mPayloadLength); }
 
+    /**
+     * This static method returns the byte offset of the IPv6 Next Header field.
+     *
+     * @returns The byte offset of the IPv6 Next Header field.
+     *
+     */
+    static uint8_t GetNextHeaderOffset() { return offsetof(HeaderPoD, mNextHeader); }
+
     /**
      * This static method returns the byte offset of the IPv6 Hop Limit field.
      *
@@ -465,7 +474,7 @@ public:
      * This method initializes the IPv6 Fragment header.
      *
      */
-    void Init() { mReserved = 0; mIdentification = 0; }
+    void Init() { mReserved = 0; mOffsetMore = 0; mIdentification = 0; }
 
     /**
      * This method returns the IPv6 Next Header value.
@@ -522,6 +531,22 @@ public:
      */
     void SetMoreFlag() { mOffsetMore = HostSwap16(HostSwap16(mOffsetMore) | kMoreFlag); }
 
+    /**
+     * This method returns the Identification value.
+     *
+     * @returns The Identification value.
+     *
+     */
+    uint32_t GetIdentification() const { return HostSwap32(mIdentification); }
+
+    /**
+     * This method sets the Identification value.
+     *
+     * @param[in]  aIdentification  The Identification value.
+     *
+     */
+    void SetIdentification(uint32_t aIdentification) { mIdentification = HostSwap32(aIdentification); }
+
 private:
     uint8_t mNextHeader;
     uint8_t mReserved;
@@ -167,6 +167,7 @@ void Mpl::AddBufferedMessage(Message &aMessage, uint16_t aSeedId, uint8_t aSeque
     uint8_t hopLimit;
 
     VerifyOrExit((messageCopy = aMessage.Clone()) != NULL, error = kThreadError_NoBufs);
+    SuccessOrExit(error = messageCopy->SetPriority(Message::kPriorityLow));
 
     if (!aIsOutbound)
     {
@@ -45,6 +45,31 @@
 namespace Thread {
 namespace Ip6 {
 
+/**
+ * This function folds an IPv6 address into an 8-bit hash used to index the address hash tables.
+ *
+ */
+static uint8_t HashAddress(const Address &aAddress)
+{
+    uint16_t hash = 0;
+
+    for (size_t i = 0; i < sizeof(aAddress.mFields.m16) / sizeof(aAddress.mFields.m16[0]); i++)
+    {
+        hash ^= aAddress.mFields.m16[i];
+    }
+
+    return static_cast<uint8_t>(hash ^ (hash >> 8));
+}
+
+/**
+ * This function returns the bit of the multicast filter for a hash, using other hash bits than the table index.
+ *
+ */
+static uint32_t GetMulticastFilterBit(uint8_t aHash)
+{
+    return static_cast<uint32_t>(1) << (aHash >> 3);
+}
+
 Netif::Netif(Ip6 &aIp6, int8_t aInterfaceId):
     mIp6(aIp6),
     mStateChangedTask(aIp6.mTaskletScheduler, &Netif::HandleStateChangedTask, this)
@@ -58,6 +83,9 @@ Netif::Netif(Ip6 &aIp6, int8_t aInterfaceId):
     mMaskExtUnicastAddresses = 0;
 
     mStateChangedFlags = 0;
+
+    UpdateUnicastHash();
+    UpdateMulticastHash();
 }
 
 ThreadError Netif::RegisterCallback(NetifCallback &aCallback)
@@ -136,11 +164,30 @@ bool Netif::IsMulticastSubscribed(const Address &aAddress) const
         ExitNow(rval = mAllRoutersSubscribed);
     }
 
-    for (NetifMulticastAddress *cur = mMulticastAddresses; cur; cur = cur->mNext)
+    if (mMulticastHashValid)
+    {
+        uint8_t hash = HashAddress(aAddress);
+
+        // fast negative check before probing the table
+        VerifyOrExit((mMulticastFilter & GetMulticastFilterBit(hash)) != 0, ;);
+
+        for (uint8_t index = hash & (kAddressHashSize - 1); mMulticastHash[index] != NULL;
+             index = (index + 1) & (kAddressHashSize - 1))
+        {
+            if (mMulticastHash[index]->GetAddress() == aAddress)
+            {
+                ExitNow(rval = true);
+            }
+        }
+    }
+    else
     {
-        if (memcmp(&cur->mAddress, &aAddress, sizeof(cur->mAddress)) == 0)
+        for (NetifMulticastAddress *cur = mMulticastAddresses; cur; cur = cur->mNext)
         {
-            ExitNow(rval = true);
+            if (memcmp(&cur->mAddress, &aAddress, sizeof(cur->mAddress)) == 0)
+            {
+                ExitNow(rval = true);
+            }
         }
     }
 
@@ -148,6 +195,34 @@ exit:
     return rval;
 }
 
+void Netif::UpdateMulticastHash(void)
+{
+    uint8_t count = 0;
+    uint8_t hash;
+    uint8_t index;
+
+    memset(mMulticastHash, 0, sizeof(mMulticastHash));
+    mMulticastFilter = 0;
+    mMulticastHashValid = true;
+
+    for (const NetifMulticastAddress *cur = mMulticastAddresses; cur; cur = cur->GetNext())
+    {
+        // keep one slot empty to terminate probing
+        VerifyOrExit(++count < kAddressHashSize, mMulticastHashValid = false);
+
+        hash = HashAddress(cur->GetAddress());
+
+        for (index = hash & (kAddressHashSize - 1); mMulticastHash[index] != NULL;
+             index = (index + 1) & (kAddressHashSize - 1));
+
+        mMulticastHash[index] = cur;
+        mMulticastFilter |= GetMulticastFilterBit(hash);
+    }
+
+exit:
+    return;
+}
+
 void Netif::SubscribeAllRoutersMulticast()
 {
     mAllRoutersSubscribed = true;
@@ -174,6 +249,7 @@ ThreadError Netif::SubscribeMulticast(NetifMulticastAddress &aAddress)
     mMulticastAddresses = &aAddress;
 
 exit:
+    UpdateMulticastHash();
     return error;
 }
 
@@ -201,6 +277,7 @@ ThreadError Netif::UnsubscribeMulticast(const NetifMulticastAddress &aAddress)
     ExitNow(error = kThreadError_Error);
 
 exit:
+    UpdateMulticastHash();
     return error;
 }
 
@@ -227,6 +304,8 @@ ThreadError Netif::AddUnicastAddress(NetifUnicastAddress &aAddress)
     SetStateChangedFlags(OT_IP6_ADDRESS_ADDED);
 
 exit:
+    // also rehash when already added, callers may have updated the address before adding it again
+    UpdateUnicastHash();
     return error;
 }
 
@@ -257,6 +336,7 @@ exit:
 
     if (error != kThreadError_NotFound)
     {
+        UpdateUnicastHash();
         SetStateChangedFlags(OT_IP6_ADDRESS_REMOVED);
     }
 
@@ -302,6 +382,7 @@ ThreadError Netif::AddExternalUnicastAddress(const NetifUnicastAddress &aAddress
 
     mUnicastAddresses = &mExtUnicastAddresses[index];
 
+    UpdateUnicastHash();
     SetStateChangedFlags(OT_IP6_ADDRESS_ADDED);
 
 exit:
@@ -340,6 +421,7 @@ ThreadError Netif::RemoveExternalUnicastAddress(const Address &aAddress)
     {
         mMaskExtUnicastAddresses &= ~(1 << aAddressIndexToRemove);
 
+        UpdateUnicastHash();
         SetStateChangedFlags(OT_IP6_ADDRESS_REMOVED);
     }
     else
@@ -356,11 +438,25 @@ bool Netif::IsUnicastAddress(const Address &aAddress) const
 {
     bool rval = false;
 
-    for (const NetifUnicastAddress *cur = mUnicastAddresses; cur; cur = cur->GetNext())
+    if (mUnicastHashValid)
     {
-        if (cur->GetAddress() == aAddress)
+        for (uint8_t index = HashAddress(aAddress) & (kAddressHashSize - 1); mUnicastHash[index] != NULL;
+             index = (index + 1) & (kAddressHashSize - 1))
         {
-            ExitNow(rval = true);
+            if (mUnicastHash[index]->GetAddress() == aAddress)
+            {
+                ExitNow(rval = true);
+            }
+        }
+    }
+    else
+    {
+        for (const NetifUnicastAddress *cur = mUnicastAddresses; cur; cur = cur->GetNext())
+        {
+            if (cur->GetAddress() == aAddress)
+            {
+                ExitNow(rval = true);
+            }
         }
     }
 
@@ -368,6 +464,29 @@ exit:
     return rval;
 }
 
+void Netif::UpdateUnicastHash(void)
+{
+    uint8_t count = 0;
+    uint8_t index;
+
+    memset(mUnicastHash, 0, sizeof(mUnicastHash));
+    mUnicastHashValid = true;
+
+    for (const NetifUnicastAddress *cur = mUnicastAddresses; cur; cur = cur->GetNext())
+    {
+        // keep one slot empty to terminate probing
+        VerifyOrExit(++count < kAddressHashSize, mUnicastHashValid = false);
+
+        for (index = HashAddress(cur->GetAddress()) & (kAddressHashSize - 1); mUnicastHash[index] != NULL;
+             index = (index + 1) & (kAddressHashSize - 1));
+
+        mUnicastHash[index] = cur;
+    }
+
+exit:
+    return;
+}
+
 
 bool Netif::IsStateChangedCallbackPending(void)
 {
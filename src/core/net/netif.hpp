@@ -447,12 +447,25 @@ protected:
     Ip6 &mIp6;
 
 private:
+    enum
+    {
+        kAddressHashSize = OPENTHREAD_CONFIG_NETIF_ADDRESS_HASH_SIZE,
+    };
+
     static void HandleStateChangedTask(void *aContext);
     void HandleStateChangedTask(void);
 
+    void UpdateUnicastHash(void);
+    void UpdateMulticastHash(void);
+
     NetifCallback *mCallbacks;
     NetifUnicastAddress *mUnicastAddresses;
     NetifMulticastAddress *mMulticastAddresses;
+    const NetifUnicastAddress *mUnicastHash[kAddressHashSize];
+    const NetifMulticastAddress *mMulticastHash[kAddressHashSize];
+    uint32_t mMulticastFilter;
+    bool mUnicastHashValid;
+    bool mMulticastHashValid;
     int8_t mInterfaceId;
     bool mAllRoutersSubscribed;
     Tasklet mStateChangedTask;
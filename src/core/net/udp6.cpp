@@ -48,9 +48,9 @@ UdpSocket::UdpSocket(Udp &aUdp)
     mTransport = &aUdp;
 }
 
-Message *UdpSocket::NewMessage(uint16_t aReserved)
+Message *UdpSocket::NewMessage(uint16_t aReserved, uint8_t aPriority)
 {
-    return static_cast<Udp *>(mTransport)->NewMessage(aReserved);
+    return static_cast<Udp *>(mTransport)->NewMessage(aReserved, aPriority);
 }
 
 ThreadError UdpSocket::Open(otUdpReceive aHandler, void *aContext)
@@ -175,13 +175,14 @@ uint16_t Udp::GetEphemeralPort(void)
     return rval;
 }
 
-Message *Udp::NewMessage(uint16_t aReserved)
+Message *Udp::NewMessage(uint16_t aReserved, uint8_t aPriority)
 {
-    return mIp6.NewMessage(sizeof(UdpHeader) + aReserved);
+    return mIp6.NewMessage(sizeof(UdpHeader) + aReserved, aPriority);
 }
 
 ThreadError Udp::SendDatagram(Message &aMessage, MessageInfo &aMessageInfo, IpProto aIpProto)
 {
+    otPerfCount(mIp6.mPerfCounters, mUdpTxDatagrams);
     return mIp6.SendDatagram(aMessage, aMessageInfo, aIpProto);
 }
 
@@ -208,6 +209,8 @@ ThreadError Udp::HandleMessage(Message &aMessage, MessageInfo &aMessageInfo)
     aMessageInfo.mPeerPort = udpHeader.GetSourcePort();
     aMessageInfo.mSockPort = udpHeader.GetDestinationPort();
 
+    otPerfCount(mIp6.mPerfCounters, mUdpRxDatagrams);
+
     // find socket
     for (UdpSocket *socket = mSockets; socket; socket = socket->GetNext())
     {
@@ -244,6 +247,7 @@ ThreadError Udp::HandleMessage(Message &aMessage, MessageInfo &aMessageInfo)
             }
         }
 
+        otPerfRecordLatency(mIp6.mPerfCounters, mReceiveLatency, aMessage.GetTimestamp());
         socket->HandleUdpReceive(aMessage, aMessageInfo);
     }
 
@@ -73,11 +73,12 @@ public:
      * This method returns a new UDP message with sufficient header space reserved.
      *
      * @param[in]  aReserved  The number of header bytes to reserve after the UDP header.
+     * @param[in]  aPriority  The priority class of the message.
      *
      * @returns A pointer to the message or NULL if no buffers are available.
      *
      */
-    Message *NewMessage(uint16_t aReserved);
+    Message *NewMessage(uint16_t aReserved, uint8_t aPriority = Message::kPriorityNormal);
 
     /**
      * This method opens the UDP socket.
@@ -196,11 +197,12 @@ public:
      * This method returns a new UDP message with sufficient header space reserved.
      *
      * @param[in]  aReserved  The number of header bytes to reserve after the UDP header.
+     * @param[in]  aPriority  The priority class of the message.
      *
      * @returns A pointer to the message or NULL if no buffers are available.
      *
      */
-    Message *NewMessage(uint16_t aReserved);
+    Message *NewMessage(uint16_t aReserved, uint8_t aPriority = Message::kPriorityNormal);
 
     /**
      * This method sends an IPv6 datagram.
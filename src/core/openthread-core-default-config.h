@@ -55,6 +55,36 @@
 #define OPENTHREAD_CONFIG_MESSAGE_BUFFER_SIZE                   128
 #endif  // OPENTHREAD_CONFIG_MESSAGE_BUFFER_SIZE
 
+/**
+ * @def OPENTHREAD_CONFIG_MESSAGE_BUFFERS_RESERVED_NETWORK
+ *
+ * The number of message buffers that only network control messages (MLE and MAC data polls) may use.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_MESSAGE_BUFFERS_RESERVED_NETWORK
+#define OPENTHREAD_CONFIG_MESSAGE_BUFFERS_RESERVED_NETWORK      4
+#endif  // OPENTHREAD_CONFIG_MESSAGE_BUFFERS_RESERVED_NETWORK
+
+/**
+ * @def OPENTHREAD_CONFIG_MESSAGE_BUFFERS_MAX_LOW
+ *
+ * The maximum number of message buffers held by low priority messages (relayed datagrams and MPL retransmissions).
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_MESSAGE_BUFFERS_MAX_LOW
+#define OPENTHREAD_CONFIG_MESSAGE_BUFFERS_MAX_LOW               (OPENTHREAD_CONFIG_NUM_MESSAGE_BUFFERS * 2 / 5)
+#endif  // OPENTHREAD_CONFIG_MESSAGE_BUFFERS_MAX_LOW
+
+/**
+ * @def OPENTHREAD_CONFIG_MESSAGE_BUFFERS_MAX_HIGH
+ *
+ * The maximum number of message buffers held by high priority messages (CoAP, including retransmission copies).
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_MESSAGE_BUFFERS_MAX_HIGH
+#define OPENTHREAD_CONFIG_MESSAGE_BUFFERS_MAX_HIGH              (OPENTHREAD_CONFIG_NUM_MESSAGE_BUFFERS * 3 / 5)
+#endif  // OPENTHREAD_CONFIG_MESSAGE_BUFFERS_MAX_HIGH
+
 /**
  * @def OPENTHREAD_CONFIG_DEFAULT_CHANNEL
  *
@@ -85,6 +115,52 @@
 #define OPENTHREAD_CONFIG_ATTACH_DATA_POLL_PERIOD               100
 #endif  // OPENTHREAD_CONFIG_ATTACH_DATA_POLL_PERIOD
 
+/**
+ * @def OPENTHREAD_CONFIG_FAST_DATA_POLL_PERIOD
+ *
+ * The Data Poll period in milliseconds used by a sleepy end device right after it sends a message or its parent
+ * indicates a pending frame.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_FAST_DATA_POLL_PERIOD
+#define OPENTHREAD_CONFIG_FAST_DATA_POLL_PERIOD                 100
+#endif  // OPENTHREAD_CONFIG_FAST_DATA_POLL_PERIOD
+
+/**
+ * @def OPENTHREAD_CONFIG_FAST_DATA_POLLS
+ *
+ * The number of Data Polls sent at the fast Data Poll period before the period backs off exponentially towards the
+ * regular Data Poll period.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_FAST_DATA_POLLS
+#define OPENTHREAD_CONFIG_FAST_DATA_POLLS                       4
+#endif  // OPENTHREAD_CONFIG_FAST_DATA_POLLS
+
+/**
+ * @def OPENTHREAD_CONFIG_CSL_RECEIVE_WINDOW
+ *
+ * The time in milliseconds a sleepy end device using coordinated sampled listening keeps its receiver on at each
+ * sample.  The window is centered on the sample time announced to the parent, which starts transmitting to such a
+ * child no later than a quarter of this window after the sample.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_CSL_RECEIVE_WINDOW
+#define OPENTHREAD_CONFIG_CSL_RECEIVE_WINDOW                    10
+#endif  // OPENTHREAD_CONFIG_CSL_RECEIVE_WINDOW
+
+/**
+ * @def OPENTHREAD_CONFIG_CSL_RESYNC_INTERVAL
+ *
+ * The maximum time in seconds between two Child Update Requests of a sleepy end device using coordinated sampled
+ * listening, each of which resynchronizes the sample times tracked by its parent.  The clocks of the child and the
+ * parent may drift apart by at most a quarter of OPENTHREAD_CONFIG_CSL_RECEIVE_WINDOW within this interval.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_CSL_RESYNC_INTERVAL
+#define OPENTHREAD_CONFIG_CSL_RESYNC_INTERVAL                   30
+#endif  // OPENTHREAD_CONFIG_CSL_RESYNC_INTERVAL
+
 /**
  * @def OPENTHREAD_CONFIG_ADDRESS_CACHE_ENTRIES
  *
@@ -125,6 +201,17 @@
 #define OPENTHREAD_CONFIG_MAX_EXT_IP_ADDRS                      4
 #endif  // OPENTHREAD_CONFIG_MAX_EXT_IP_ADDRS
 
+/**
+ * @def OPENTHREAD_CONFIG_NETIF_ADDRESS_HASH_SIZE
+ *
+ * The number of slots in the per-interface unicast address and multicast subscription hash tables (must be a power
+ * of two).  An interface holding more addresses than slots falls back to a linear search.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_NETIF_ADDRESS_HASH_SIZE
+#define OPENTHREAD_CONFIG_NETIF_ADDRESS_HASH_SIZE               16
+#endif  // OPENTHREAD_CONFIG_NETIF_ADDRESS_HASH_SIZE
+
 /**
  * @def OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_TIMEOUT
  *
@@ -135,6 +222,47 @@
 #define OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_TIMEOUT            5
 #endif  // OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_TIMEOUT
 
+/**
+ * @def OPENTHREAD_CONFIG_IP6_REASSEMBLY_DATAGRAMS
+ *
+ * The maximum number of IPv6 datagrams reassembled from IPv6 Fragment headers at the same time.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_IP6_REASSEMBLY_DATAGRAMS
+#define OPENTHREAD_CONFIG_IP6_REASSEMBLY_DATAGRAMS              2
+#endif  // OPENTHREAD_CONFIG_IP6_REASSEMBLY_DATAGRAMS
+
+/**
+ * @def OPENTHREAD_CONFIG_IP6_REASSEMBLY_BUFFER_SIZE
+ *
+ * The maximum number of bytes held by all IPv6 datagrams under reassembly.  A fragment that would exceed this budget
+ * causes its datagram to be discarded.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_IP6_REASSEMBLY_BUFFER_SIZE
+#define OPENTHREAD_CONFIG_IP6_REASSEMBLY_BUFFER_SIZE            2560
+#endif  // OPENTHREAD_CONFIG_IP6_REASSEMBLY_BUFFER_SIZE
+
+/**
+ * @def OPENTHREAD_CONFIG_IP6_REASSEMBLY_TIMEOUT
+ *
+ * The IPv6 fragment reassembly timeout in seconds.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_IP6_REASSEMBLY_TIMEOUT
+#define OPENTHREAD_CONFIG_IP6_REASSEMBLY_TIMEOUT                10
+#endif  // OPENTHREAD_CONFIG_IP6_REASSEMBLY_TIMEOUT
+
+/**
+ * @def OPENTHREAD_CONFIG_MESH_FORWARD_RING_SIZE
+ *
+ * The number of mesh-header frames a router can hold for relaying without allocating a message.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_MESH_FORWARD_RING_SIZE
+#define OPENTHREAD_CONFIG_MESH_FORWARD_RING_SIZE                4
+#endif  // OPENTHREAD_CONFIG_MESH_FORWARD_RING_SIZE
+
 /**
  * @def OPENTHREAD_CONFIG_MPL_SEED_SET_ENTRIES
  *
@@ -175,16 +303,91 @@
 #define OPENTHREAD_CONFIG_MAX_ENERGY_RESULTS                    64
 #endif  // OPENTHREAD_CONFIG_MAX_ENERGY_RESULTS
 
+/**
+ * @def OPENTHREAD_CONFIG_ENERGY_SCAN_SAMPLE_INTERVAL
+ *
+ * The interval in milliseconds between RSSI samples when the radio does not perform Energy Scans itself.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_ENERGY_SCAN_SAMPLE_INTERVAL
+#define OPENTHREAD_CONFIG_ENERGY_SCAN_SAMPLE_INTERVAL           1
+#endif  // OPENTHREAD_CONFIG_ENERGY_SCAN_SAMPLE_INTERVAL
+
+/**
+ * @def OPENTHREAD_CONFIG_ENERGY_SCAN_RSSI_PERCENTILE
+ *
+ * The percentile of sampled RSSI values reported in an Energy Scan result.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_ENERGY_SCAN_RSSI_PERCENTILE
+#define OPENTHREAD_CONFIG_ENERGY_SCAN_RSSI_PERCENTILE           90
+#endif  // OPENTHREAD_CONFIG_ENERGY_SCAN_RSSI_PERCENTILE
+
 /**
  * @def OPENTHREAD_CONFIG_MAX_JOINER_ENTRIES
  *
- * The maximum number of Joiner entries maintained by the Commissioner.
+ * The maximum number of Joiner entries maintained by the Commissioner.  Joiners are looked up by hash, so this may
+ * be raised to hundreds of entries.
  *
  */
 #ifndef OPENTHREAD_CONFIG_MAX_JOINER_ENTRIES
 #define OPENTHREAD_CONFIG_MAX_JOINER_ENTRIES                    2
 #endif  // OPENTHREAD_CONFIG_MAX_JOINER_ENTRIES
 
+/**
+ * @def OPENTHREAD_CONFIG_JOINER_ENTRY_TIMEOUT
+ *
+ * The time in seconds after which the Commissioner removes a Joiner entry.  Set to 0 to keep entries until they are
+ * removed.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_JOINER_ENTRY_TIMEOUT
+#define OPENTHREAD_CONFIG_JOINER_ENTRY_TIMEOUT                  0
+#endif  // OPENTHREAD_CONFIG_JOINER_ENTRY_TIMEOUT
+
+/**
+ * @def OPENTHREAD_CONFIG_DTLS_SESSION_CACHE_SIZE
+ *
+ * The maximum number of DTLS sessions cached for resumption.  Set to 0 to disable session resumption.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_DTLS_SESSION_CACHE_SIZE
+#define OPENTHREAD_CONFIG_DTLS_SESSION_CACHE_SIZE               2
+#endif  // OPENTHREAD_CONFIG_DTLS_SESSION_CACHE_SIZE
+
+/**
+ * @def OPENTHREAD_CONFIG_DTLS_SESSION_CACHE_LIFETIME
+ *
+ * The time in seconds a cached DTLS session may be resumed after its full handshake.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_DTLS_SESSION_CACHE_LIFETIME
+#define OPENTHREAD_CONFIG_DTLS_SESSION_CACHE_LIFETIME           600
+#endif  // OPENTHREAD_CONFIG_DTLS_SESSION_CACHE_LIFETIME
+
+/**
+ * @def OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_LOG_SIZE
+ *
+ * The size in bytes of the log of recent Network Data changes, from which routers send deltas to neighbors that are a
+ * few versions behind.  Set to 0 to always send the full Network Data.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_LOG_SIZE
+#define OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_LOG_SIZE           128
+#endif  // OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_LOG_SIZE
+
+/**
+ * @def OPENTHREAD_CONFIG_AES_OPTIMIZED
+ *
+ * Define as 1 to compute the AES-128 blocks of MAC and MLE frame security with the AES instructions of the processor
+ * (AES-NI or the ARMv8 Cryptography Extensions) or a constant-time bitsliced implementation, instead of mbedtls.
+ * This mostly benefits simulations and hosts; each AES-CCM computation then takes about 700 bytes of stack.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_AES_OPTIMIZED
+#define OPENTHREAD_CONFIG_AES_OPTIMIZED                         0
+#endif  // OPENTHREAD_CONFIG_AES_OPTIMIZED
+
 /**
  * @def OPENTHREAD_CONFIG_MAX_STATECHANGE_HANDLERS
  *
@@ -237,6 +440,79 @@
 #define OPENTHREAD_CONFIG_COAP_MAX_RETRANSMIT                   4
 #endif  // OPENTHREAD_CONFIG_COAP_MAX_RETRANSMIT
 
+/**
+ * @def OPENTHREAD_CONFIG_COAP_NSTART
+ *
+ * Initial number of outstanding Confirmable requests to a single destination (RFC7252 default value is 1).
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_COAP_NSTART
+#define OPENTHREAD_CONFIG_COAP_NSTART                           1
+#endif  // OPENTHREAD_CONFIG_COAP_NSTART
+
+/**
+ * @def OPENTHREAD_CONFIG_COAP_MAX_CONGESTION_WINDOW
+ *
+ * Maximum number of outstanding Confirmable requests to a single destination once exchanges complete without
+ * retransmissions.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_COAP_MAX_CONGESTION_WINDOW
+#define OPENTHREAD_CONFIG_COAP_MAX_CONGESTION_WINDOW            4
+#endif  // OPENTHREAD_CONFIG_COAP_MAX_CONGESTION_WINDOW
+
+/**
+ * @def OPENTHREAD_CONFIG_COAP_CLIENT_MAX_PEERS
+ *
+ * The number of destinations for which the CoAP client keeps RTT estimates and congestion state.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_COAP_CLIENT_MAX_PEERS
+#define OPENTHREAD_CONFIG_COAP_CLIENT_MAX_PEERS                 4
+#endif  // OPENTHREAD_CONFIG_COAP_CLIENT_MAX_PEERS
+
+/**
+ * @def OPENTHREAD_CONFIG_COAP_CLIENT_REQUEST_INDEX_SIZE
+ *
+ * Number of pending CoAP client requests indexed by Message ID and token.  The number of pending requests is only
+ * bounded by the message buffers; responses to requests beyond the index are matched by searching the pending list.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_COAP_CLIENT_REQUEST_INDEX_SIZE
+#define OPENTHREAD_CONFIG_COAP_CLIENT_REQUEST_INDEX_SIZE        16
+#endif  // OPENTHREAD_CONFIG_COAP_CLIENT_REQUEST_INDEX_SIZE
+
+/**
+ * @def OPENTHREAD_CONFIG_COAP_SERVER_MAX_CACHED_RESPONSES
+ *
+ * Maximum number of responses the CoAP server keeps for answering retransmitted Confirmable requests.  Set to 0 to
+ * disable the cache.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_COAP_SERVER_MAX_CACHED_RESPONSES
+#define OPENTHREAD_CONFIG_COAP_SERVER_MAX_CACHED_RESPONSES      6
+#endif  // OPENTHREAD_CONFIG_COAP_SERVER_MAX_CACHED_RESPONSES
+
+/**
+ * @def OPENTHREAD_CONFIG_COAP_SERVER_MAX_BLOCK1_TRANSFERS
+ *
+ * Maximum number of Block1 (request payload) transfers the CoAP server receives concurrently.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_COAP_SERVER_MAX_BLOCK1_TRANSFERS
+#define OPENTHREAD_CONFIG_COAP_SERVER_MAX_BLOCK1_TRANSFERS      2
+#endif  // OPENTHREAD_CONFIG_COAP_SERVER_MAX_BLOCK1_TRANSFERS
+
+/**
+ * @def OPENTHREAD_CONFIG_COAP_BLOCK_SIZE
+ *
+ * The preferred block size exponent (SZX) for CoAP block-wise transfers, the block size is 2^(SZX + 4) bytes.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_COAP_BLOCK_SIZE
+#define OPENTHREAD_CONFIG_COAP_BLOCK_SIZE                       kCoapBlockSize64
+#endif  // OPENTHREAD_CONFIG_COAP_BLOCK_SIZE
+
 /**
  * @def OPENTHREAD_CONFIG_JOIN_BEACON_VERSION
  *
@@ -270,6 +546,27 @@
 #define OPENTHREAD_CONFIG_LOG_LEVEL                             OPENTHREAD_LOG_LEVEL_CRIT
 #endif  // OPENTHREAD_CONFIG_LOG_LEVEL
 
+/**
+ * @def OPENTHREAD_CONFIG_LOG_BINARY
+ *
+ * Define as 1 to store logs as compact binary records for offline decoding instead of formatting them with
+ * otPlatLog(). The platform drains the records with otLogBinaryRead().
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_LOG_BINARY
+#define OPENTHREAD_CONFIG_LOG_BINARY                            0
+#endif  // OPENTHREAD_CONFIG_LOG_BINARY
+
+/**
+ * @def OPENTHREAD_CONFIG_LOG_BINARY_BUFFER_SIZE
+ *
+ * The size of the binary log buffer in bytes, a power of two no larger than 32768.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_LOG_BINARY_BUFFER_SIZE
+#define OPENTHREAD_CONFIG_LOG_BINARY_BUFFER_SIZE                1024
+#endif  // OPENTHREAD_CONFIG_LOG_BINARY_BUFFER_SIZE
+
 /**
  * @def OPENTHREAD_CONFIG_LOG_API
  *
@@ -890,6 +890,38 @@ const otMacCounters *otGetMacCounters(otInstance *aInstance)
     return &aInstance->mThreadNetif.GetMac().GetCounters();
 }
 
+const otDataPollCounters *otGetDataPollCounters(otInstance *aInstance)
+{
+    return &aInstance->mThreadNetif.GetMeshForwarder().GetDataPollCounters();
+}
+
+const otSendQueueCounters *otGetSendQueueCounters(otInstance *aInstance)
+{
+    return &aInstance->mThreadNetif.GetMeshForwarder().GetSendQueueCounters();
+}
+
+const otBufferCounters *otGetBufferCounters(otInstance *aInstance)
+{
+    return &aInstance->mIp6.mMessagePool.GetBufferCounters();
+}
+
+const otCoapResponseCacheCounters *otGetCoapResponseCacheCounters(otInstance *aInstance)
+{
+    return &aInstance->mThreadNetif.GetCoapServer().GetResponsesQueueCounters();
+}
+
+#if OPENTHREAD_ENABLE_PERF_COUNTERS
+const otPerfCounters *otGetPerfCounters(otInstance *aInstance)
+{
+    return &aInstance->mIp6.mPerfCounters.GetCounters();
+}
+
+void otResetPerfCounters(otInstance *aInstance)
+{
+    aInstance->mIp6.mPerfCounters.Reset();
+}
+#endif  // OPENTHREAD_ENABLE_PERF_COUNTERS
+
 bool otIsIp6AddressEqual(const otIp6Address *a, const otIp6Address *b)
 {
     return *static_cast<const Ip6::Address *>(a) == *static_cast<const Ip6::Address *>(b);
@@ -996,6 +1028,21 @@ void otSetPollPeriod(otInstance *aInstance, uint32_t aPollPeriod)
     aInstance->mThreadNetif.GetMeshForwarder().SetAssignPollPeriod(aPollPeriod);
 }
 
+uint32_t otGetEffectivePollPeriod(otInstance *aInstance)
+{
+    return aInstance->mThreadNetif.GetMeshForwarder().GetEffectivePollPeriod();
+}
+
+uint16_t otGetCslPeriod(otInstance *aInstance)
+{
+    return aInstance->mThreadNetif.GetMle().GetCslPeriod();
+}
+
+void otSetCslPeriod(otInstance *aInstance, uint16_t aCslPeriod)
+{
+    aInstance->mThreadNetif.GetMle().SetCslPeriod(aCslPeriod);
+}
+
 ThreadError otSetPreferredRouterId(otInstance *aInstance, uint8_t aRouterId)
 {
     return aInstance->mThreadNetif.GetMle().SetPreferredRouterId(aRouterId);
@@ -1274,6 +1321,9 @@ ThreadError otSendIp6Datagram(otInstance *aInstance, otMessage aMessage)
 
     otLogFuncEntry();
 
+    otPerfStampMessage(*static_cast<Message *>(aMessage));
+    otPerfCount(aInstance->mIp6.mPerfCounters, mIp6TxDatagrams);
+
     error = aInstance->mIp6.HandleDatagram(*static_cast<Message *>(aMessage), NULL,
                                            aInstance->mThreadNetif.GetInterfaceId(), NULL, true);
 
@@ -1323,6 +1373,18 @@ ThreadError otSetMessageLength(otMessage aMessage, uint16_t aLength)
     return message->SetLength(aLength);
 }
 
+otMessagePriority otGetMessagePriority(otMessage aMessage)
+{
+    Message *message = static_cast<Message *>(aMessage);
+    return static_cast<otMessagePriority>(message->GetPriority());
+}
+
+ThreadError otSetMessagePriority(otMessage aMessage, otMessagePriority aPriority)
+{
+    Message *message = static_cast<Message *>(aMessage);
+    return message->SetPriority(static_cast<uint8_t>(aPriority));
+}
+
 uint16_t otGetMessageOffset(otMessage aMessage)
 {
     Message *message = static_cast<Message *>(aMessage);
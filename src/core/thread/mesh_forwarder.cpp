@@ -38,6 +38,7 @@
 #include <common/logging.hpp>
 #include <common/encoding.hpp>
 #include <common/message.hpp>
+#include <common/perf_counters.hpp>
 #include <net/ip6.hpp>
 #include <net/ip6_filter.hpp>
 #include <net/udp6.hpp>
@@ -58,10 +59,12 @@ namespace Thread {
 
 MeshForwarder::MeshForwarder(ThreadNetif &aThreadNetif):
     mMacReceiver(&MeshForwarder::HandleReceivedFrame, this),
-    mMacSender(&MeshForwarder::HandleFrameRequest, &MeshForwarder::HandleSentFrame, this),
+    mMacSender(&MeshForwarder::HandleFrameRequest, &MeshForwarder::HandleNextFrameRequest,
+               &MeshForwarder::HandleSentFrame, this),
     mDiscoverTimer(aThreadNetif.GetIp6().mTimerScheduler, &MeshForwarder::HandleDiscoverTimer, this),
     mPollTimer(aThreadNetif.GetIp6().mTimerScheduler, &MeshForwarder::HandlePollTimer, this),
     mReassemblyTimer(aThreadNetif.GetIp6().mTimerScheduler, &MeshForwarder::HandleReassemblyTimer, this),
+    mCslTimer(aThreadNetif.GetIp6().mTimerScheduler, &MeshForwarder::HandleCslTimer, this),
     mScheduleTransmissionTask(aThreadNetif.GetIp6().mTaskletScheduler, ScheduleTransmissionTask, this),
     mNetif(aThreadNetif),
     mAddressResolver(aThreadNetif.GetAddressResolver()),
@@ -73,11 +76,27 @@ MeshForwarder::MeshForwarder(ThreadNetif &aThreadNetif):
     mFragTag = static_cast<uint16_t>(otPlatRandomGet());
     mPollPeriod = 0;
     mAssignPollPeriod = 0;
+    mPollBackoffPeriod = 0;
+    mFastPollsRemaining = 0;
+    memset(&mDataPollCounters, 0, sizeof(mDataPollCounters));
+    memset(&mSendQueueCounters, 0, sizeof(mSendQueueCounters));
     mSendMessage = NULL;
     mSendBusy = false;
     mEnabled = false;
+    mEvictEnabled = true;
 
     mMessageNextOffset = 0;
+    mPreparedMessage = NULL;
+    mPreparedOffset = 0;
+    mPreparedNextOffset = 0;
+    mPreparedMacSource.mLength = 0;
+    mPreparedMacDest.mLength = 0;
+    mPreparedMeshSource = Mac::kShortAddrInvalid;
+    mPreparedMeshDest = Mac::kShortAddrInvalid;
+    mPreparedAddMeshHeader = false;
+    mForwardRingHead = 0;
+    mForwardRingCount = 0;
+    mSendForwardFrame = false;
     mMacSource.mLength = 0;
     mMacDest.mLength = 0;
     mMeshSource = Mac::kShortAddrInvalid;
@@ -87,6 +106,8 @@ MeshForwarder::MeshForwarder(ThreadNetif &aThreadNetif):
     mMac.EnableSrcMatch(true);
     mSrcMatchEnabled = true;
 
+    aThreadNetif.GetIp6().mMessagePool.SetEvictHandler(&MeshForwarder::HandleEvictMessage, this);
+
     mMac.RegisterReceiver(mMacReceiver);
 }
 
@@ -132,6 +153,7 @@ ThreadError MeshForwarder::Stop()
         message->Free();
     }
 
+    mForwardRingCount = 0;
     mEnabled = false;
     mSendMessage = NULL;
     mMac.SetRxOnWhenIdle(false);
@@ -168,6 +190,7 @@ void MeshForwarder::HandleResolved(const Ip6::Address &aEid, ThreadError aError)
             }
             else
             {
+                mSendQueueCounters.mDropped[cur->GetPriority()]++;
                 cur->Free();
             }
         }
@@ -192,6 +215,12 @@ void MeshForwarder::ScheduleTransmissionTask()
 
     VerifyOrExit(mSendBusy == false, error = kThreadError_Busy);
 
+    if (mForwardRingCount > 0)
+    {
+        mMac.SendFrameRequest(mMacSender);
+        ExitNow();
+    }
+
     children = mMle.GetChildren(&numChildren);
 
     for (int i = 0; i < numChildren; i++)
@@ -408,10 +437,107 @@ ThreadError MeshForwarder::SendMessage(Message &aMessage)
     SuccessOrExit(error = mSendQueue.Enqueue(aMessage));
     mScheduleTransmissionTask.Post();
 
+    if (aMessage.IsChildPending())
+    {
+        ScheduleCslTransmissions();
+    }
+
+    if (aMessage.GetType() != Message::kTypeMacDataPoll && mPollTimer.IsRunning())
+    {
+        // poll quickly for a while, since a response from the peer is likely to follow
+        StartFastPolls(mDataPollCounters.mTrafficTriggers);
+
+        if (static_cast<int32_t>(mPollTimer.Gett0() + mPollTimer.Getdt() - Timer::GetNow()) > kFastPollPeriod)
+        {
+            mPollTimer.Start(GetEffectivePollPeriod());
+        }
+    }
+
 exit:
     return error;
 }
 
+void MeshForwarder::ScheduleCslTransmissions(void)
+{
+    uint32_t now = Timer::GetNow();
+    uint32_t delay;
+    uint32_t nextDelay = 0;
+    bool pending = false;
+    uint8_t numChildren;
+    Child *children;
+
+    mCslTimer.Stop();
+
+    // only a router or leader with attached children transmits at their samples
+    VerifyOrExit(mMle.GetDeviceState() == Mle::kDeviceStateRouter ||
+                 mMle.GetDeviceState() == Mle::kDeviceStateLeader, ;);
+
+    children = mMle.GetChildren(&numChildren);
+
+    for (uint8_t i = 0; i < numChildren; i++)
+    {
+        Child &child = children[i];
+
+        if (child.mState != Neighbor::kStateValid || child.mCslPeriod == 0 ||
+            (child.mMode & Mle::ModeTlv::kModeRxOnWhenIdle) != 0 ||
+            child.mQueuedIndirectMessageCnt == 0 || child.mDataRequest)
+        {
+            continue;
+        }
+
+        delay = GetCslSampleDelay(child, now);
+
+        if (delay == 0)
+        {
+            // the child is listening, serve it like a child that just sent a Data Poll
+            child.mDataRequest = true;
+            child.mCslTransmit = true;
+            mScheduleTransmissionTask.Post();
+        }
+        else if (!pending || delay < nextDelay)
+        {
+            nextDelay = delay;
+            pending = true;
+        }
+    }
+
+    if (pending)
+    {
+        mCslTimer.Start(nextDelay);
+    }
+
+exit:
+    return;
+}
+
+uint32_t MeshForwarder::GetCslSampleDelay(const Child &aChild, uint32_t aNow) const
+{
+    int32_t elapsed = static_cast<int32_t>(aNow - aChild.mCslSampleTime);
+    uint32_t offset;
+    uint32_t delay;
+
+    if (elapsed < 0)
+    {
+        ExitNow(delay = static_cast<uint32_t>(-elapsed));
+    }
+
+    offset = static_cast<uint32_t>(elapsed) % aChild.mCslPeriod;
+    delay = (offset < kCslTransmitMargin) ? 0 : aChild.mCslPeriod - offset;
+
+exit:
+    return delay;
+}
+
+void MeshForwarder::HandleCslTimer(void *aContext)
+{
+    static_cast<MeshForwarder *>(aContext)->HandleCslTimer();
+}
+
+void MeshForwarder::HandleCslTimer(void)
+{
+    ScheduleCslTransmissions();
+}
+
 void MeshForwarder::MoveToResolving(const Ip6::Address &aDestination)
 {
     Message *cur, *next;
@@ -436,12 +562,75 @@ void MeshForwarder::MoveToResolving(const Ip6::Address &aDestination)
     }
 }
 
+Message *MeshForwarder::HandleEvictMessage(void *aContext, uint8_t aPriority)
+{
+    return static_cast<MeshForwarder *>(aContext)->HandleEvictMessage(aPriority);
+}
+
+Message *MeshForwarder::HandleEvictMessage(uint8_t aPriority)
+{
+    MessageQueue *queues[] = {&mReassemblyList, &mResolvingQueue, &mSendQueue};
+    MessageQueue *evictQueue = NULL;
+    Message *evictMessage = NULL;
+
+    VerifyOrExit(mEvictEnabled, ;);
+
+    // responses cached for duplicate requests are given up before any message waiting to be sent
+    VerifyOrExit((evictMessage = mNetif.GetCoapServer().EvictCachedResponse(aPriority)) == NULL, ;);
+
+    // evict the most recently queued message of the lowest priority class, skipping messages that are being
+    // transmitted or still owed to sleepy children
+    for (size_t i = 0; i < sizeof(queues) / sizeof(queues[0]); i++)
+    {
+        for (Message *message = queues[i]->GetHead(); message; message = message->GetNext())
+        {
+            if (message->GetPriority() >= aPriority || message == mSendMessage || message == mPreparedMessage ||
+                message->IsChildPending())
+            {
+                continue;
+            }
+
+            if (evictMessage == NULL || message->GetPriority() <= evictMessage->GetPriority())
+            {
+                evictQueue = queues[i];
+                evictMessage = message;
+            }
+        }
+    }
+
+    VerifyOrExit(evictMessage != NULL, ;);
+    evictQueue->Dequeue(*evictMessage);
+
+    if (evictQueue != &mReassemblyList)
+    {
+        mSendQueueCounters.mDropped[evictMessage->GetPriority()]++;
+    }
+
+exit:
+    return evictMessage;
+}
+
+const otSendQueueCounters &MeshForwarder::GetSendQueueCounters(void)
+{
+    memset(mSendQueueCounters.mQueued, 0, sizeof(mSendQueueCounters.mQueued));
+
+    for (Message *message = mSendQueue.GetHead(); message; message = message->GetNext())
+    {
+        mSendQueueCounters.mQueued[message->GetPriority()]++;
+    }
+
+    return mSendQueueCounters;
+}
+
 Message *MeshForwarder::GetDirectTransmission()
 {
     Message *curMessage, *nextMessage;
     ThreadError error = kThreadError_None;
     Ip6::Address ip6Dst;
 
+    // resolving a route may allocate messages, which must not evict the messages being walked
+    mEvictEnabled = false;
+
     for (curMessage = mSendQueue.GetHead(); curMessage; curMessage = nextMessage)
     {
         nextMessage = curMessage->GetNext();
@@ -477,6 +666,7 @@ Message *MeshForwarder::GetDirectTransmission()
 
         case kThreadError_Drop:
         case kThreadError_NoBufs:
+            mSendQueueCounters.mDropped[curMessage->GetPriority()]++;
             mSendQueue.Dequeue(*curMessage);
             curMessage->Free();
             continue;
@@ -488,6 +678,7 @@ Message *MeshForwarder::GetDirectTransmission()
     }
 
 exit:
+    mEvictEnabled = true;
     return curMessage;
 }
 
@@ -732,6 +923,8 @@ void MeshForwarder::SetRxOnWhenIdle(bool aRxOnWhenIdle)
     }
     else
     {
+        mFastPollsRemaining = 0;
+        mPollBackoffPeriod = mPollPeriod;
         mPollTimer.Start(mPollPeriod);
     }
 }
@@ -764,6 +957,8 @@ void MeshForwarder::SetPollPeriod(uint32_t aPeriod)
             mPollPeriod = aPeriod;
         }
 
+        mFastPollsRemaining = 0;
+        mPollBackoffPeriod = mPollPeriod;
         mPollTimer.Start(mPollPeriod);
     }
 }
@@ -773,6 +968,32 @@ uint32_t MeshForwarder::GetPollPeriod()
     return mPollPeriod;
 }
 
+uint32_t MeshForwarder::GetEffectivePollPeriod(void) const
+{
+    uint32_t period = mPollPeriod;
+
+    if (mFastPollsRemaining > 0)
+    {
+        if (period > kFastPollPeriod)
+        {
+            period = kFastPollPeriod;
+        }
+    }
+    else if (period > mPollBackoffPeriod)
+    {
+        period = mPollBackoffPeriod;
+    }
+
+    return period;
+}
+
+void MeshForwarder::StartFastPolls(uint32_t &aTriggerCounter)
+{
+    aTriggerCounter++;
+    mFastPollsRemaining = kFastPolls;
+    mPollBackoffPeriod = kFastPollPeriod;
+}
+
 void MeshForwarder::HandlePollTimer(void *aContext)
 {
     static_cast<MeshForwarder *>(aContext)->HandlePollTimer();
@@ -782,13 +1003,26 @@ void MeshForwarder::HandlePollTimer()
 {
     Message *message;
 
-    if ((message = mNetif.GetIp6().mMessagePool.New(Message::kTypeMacDataPoll, 0)) != NULL)
+    if ((message = mNetif.GetIp6().mMessagePool.New(Message::kTypeMacDataPoll, 0, Message::kPriorityNetwork)) != NULL)
     {
         SendMessage(*message);
         otLogInfoMac("Sent poll");
+        mDataPollCounters.mTxPolls++;
     }
 
-    mPollTimer.Start(mPollPeriod);
+    if (mFastPollsRemaining > 0)
+    {
+        mFastPollsRemaining--;
+        mDataPollCounters.mTxFastPolls++;
+    }
+    else if (mPollBackoffPeriod < mPollPeriod)
+    {
+        // no traffic since the fast polls, back off exponentially towards the regular period
+        mPollBackoffPeriod = (mPollBackoffPeriod > mPollPeriod / 2) ? mPollPeriod : mPollBackoffPeriod * 2;
+        mDataPollCounters.mTxBackoffPolls++;
+    }
+
+    mPollTimer.Start(GetEffectivePollPeriod());
 }
 
 ThreadError MeshForwarder::GetMacSourceAddress(const Ip6::Address &aIp6Addr, Mac::Address &aMacAddr)
@@ -847,10 +1081,42 @@ ThreadError MeshForwarder::HandleFrameRequest(Mac::Frame &aFrame)
     ThreadError error = kThreadError_None;
     Mac::Address macDest;
     Child *child = NULL;
+    bool prepared;
 
-    VerifyOrExit(mSendMessage != NULL, error = kThreadError_Abort);
+    if (mForwardRingCount > 0)
+    {
+        mPreparedMessage = NULL;
+        mSendBusy = true;
+        mSendForwardFrame = true;
+        SendForwardFrame(aFrame);
+        ExitNow();
+    }
+
+    VerifyOrExit(mSendMessage != NULL, mPreparedMessage = NULL; error = kThreadError_Abort);
     mSendBusy = true;
 
+    if (mPreparedMessage != NULL)
+    {
+        // aFrame holds the fragment formed by HandleNextFrameRequest(); keep it if nothing changed since.
+        prepared = IsPreparedFrameCurrent();
+        mPreparedMessage = NULL;
+
+        if (prepared)
+        {
+            mMessageNextOffset = mPreparedNextOffset;
+            ExitNow(error = kThreadError_Already);
+        }
+    }
+
+#if OPENTHREAD_ENABLE_PERF_COUNTERS
+
+    if (mSendMessage->GetOffset() == 0 && mSendMessage->GetType() != Message::kTypeMacDataPoll)
+    {
+        otPerfRecordLatency(mNetif.GetIp6().mPerfCounters, mSendQueueLatency, mSendMessage->GetTimestamp());
+    }
+
+#endif
+
     switch (mSendMessage->GetType())
     {
     case Message::kTypeIp6:
@@ -904,6 +1170,91 @@ exit:
     return error;
 }
 
+ThreadError MeshForwarder::HandleNextFrameRequest(void *aContext, Mac::Frame &aFrame)
+{
+    return static_cast<MeshForwarder *>(aContext)->HandleNextFrameRequest(aFrame);
+}
+
+ThreadError MeshForwarder::HandleNextFrameRequest(Mac::Frame &aFrame)
+{
+    ThreadError error = kThreadError_None;
+    uint16_t offset;
+    uint16_t nextOffset;
+
+    // Only the next fragment of a direct IPv6 datagram is known before the current one completes.
+    VerifyOrExit(!mSendForwardFrame && mForwardRingCount == 0 &&
+                 mSendMessage != NULL && mSendMessage->GetType() == Message::kTypeIp6 &&
+                 mSendMessage->GetSubType() != Message::kSubTypeMleAnnounce &&
+                 mSendMessage->GetSubType() != Message::kSubTypeMleDiscoverRequest &&
+                 mSendMessage->GetDirectTransmission() && !mSendMessage->IsChildPending() &&
+                 mMessageNextOffset < mSendMessage->GetLength(), error = kThreadError_NotFound);
+
+    offset = mSendMessage->GetOffset();
+    nextOffset = mMessageNextOffset;
+
+    mSendMessage->SetOffset(nextOffset);
+    SendFragment(*mSendMessage, aFrame);
+
+    // The frame is secured once formed, so remember the addressing it was formed with.
+    mPreparedMessage = mSendMessage;
+    mPreparedOffset = nextOffset;
+    mPreparedNextOffset = mMessageNextOffset;
+    mPreparedMacSource = mMacSource;
+    mPreparedMacDest = mMacDest;
+    mPreparedMeshSource = mMeshSource;
+    mPreparedMeshDest = mMeshDest;
+    mPreparedAddMeshHeader = mAddMeshHeader;
+
+    mSendMessage->SetOffset(offset);
+    mMessageNextOffset = nextOffset;
+
+exit:
+    return error;
+}
+
+bool MeshForwarder::IsPreparedFrameCurrent(void) const
+{
+    bool rval = false;
+
+    VerifyOrExit(mSendMessage == mPreparedMessage && mSendMessage->GetOffset() == mPreparedOffset &&
+                 mSendMessage->GetDirectTransmission() && !mSendMessage->IsChildPending(), ;);
+
+    // The route is looked up again before each fragment, so it may have changed while the frame was waiting.
+    VerifyOrExit(mMacSource.mLength == mPreparedMacSource.mLength && mMacDest.mLength == mPreparedMacDest.mLength, ;);
+
+    if (mMacSource.mLength == sizeof(Mac::ShortAddress))
+    {
+        VerifyOrExit(mMacSource.mShortAddress == mPreparedMacSource.mShortAddress, ;);
+    }
+    else
+    {
+        VerifyOrExit(memcmp(&mMacSource.mExtAddress, &mPreparedMacSource.mExtAddress,
+                            sizeof(mMacSource.mExtAddress)) == 0, ;);
+    }
+
+    if (mMacDest.mLength == sizeof(Mac::ShortAddress))
+    {
+        VerifyOrExit(mMacDest.mShortAddress == mPreparedMacDest.mShortAddress, ;);
+    }
+    else
+    {
+        VerifyOrExit(memcmp(&mMacDest.mExtAddress, &mPreparedMacDest.mExtAddress,
+                            sizeof(mMacDest.mExtAddress)) == 0, ;);
+    }
+
+    VerifyOrExit(mAddMeshHeader == mPreparedAddMeshHeader, ;);
+
+    if (mAddMeshHeader)
+    {
+        VerifyOrExit(mMeshSource == mPreparedMeshSource && mMeshDest == mPreparedMeshDest, ;);
+    }
+
+    rval = true;
+
+exit:
+    return rval;
+}
+
 ThreadError MeshForwarder::SendPoll(Message &aMessage, Mac::Frame &aFrame)
 {
     Mac::Address macSource;
@@ -984,6 +1335,27 @@ ThreadError MeshForwarder::SendMesh(Message &aMessage, Mac::Frame &aFrame)
     return kThreadError_None;
 }
 
+void MeshForwarder::SendForwardFrame(Mac::Frame &aFrame)
+{
+    const ForwardFrame &forwardFrame = mForwardRing[mForwardRingHead];
+    uint16_t fcf;
+
+    // initialize MAC header
+    fcf = Mac::Frame::kFcfFrameData | Mac::Frame::kFcfPanidCompression | Mac::Frame::kFcfFrameVersion2006 |
+          Mac::Frame::kFcfDstAddrShort | Mac::Frame::kFcfSrcAddrShort |
+          Mac::Frame::kFcfAckRequest | Mac::Frame::kFcfSecurityEnabled;
+
+    aFrame.InitMacHeader(fcf, Mac::Frame::kKeyIdMode1 | Mac::Frame::kSecEncMic32);
+    aFrame.SetDstPanId(mMac.GetPanId());
+    aFrame.SetDstAddr(forwardFrame.mNextHop);
+    aFrame.SetSrcAddr(mMac.GetShortAddress());
+
+    // write payload
+    assert(forwardFrame.mLength <= aFrame.GetMaxPayloadLength());
+    memcpy(aFrame.GetPayload(), forwardFrame.mPayload, forwardFrame.mLength);
+    aFrame.SetPayloadLength(forwardFrame.mLength);
+}
+
 ThreadError MeshForwarder::SendFragment(Message &aMessage, Mac::Frame &aFrame)
 {
     Mac::Address meshDest, meshSource;
@@ -1191,45 +1563,45 @@ void MeshForwarder::HandleSentFrame(Mac::Frame &aFrame, ThreadError aError)
     Neighbor *neighbor;
 
     mSendBusy = false;
-    VerifyOrExit(mSendMessage != NULL, ;);
-
-    mSendMessage->SetOffset(mMessageNextOffset);
-
-    aFrame.GetDstAddr(macDest);
 
-    if ((neighbor = mMle.GetNeighbor(macDest)) != NULL)
+    if (mSendForwardFrame)
     {
-        switch (aError)
+        mSendForwardFrame = false;
+        UpdateNeighborOnSentFrame(aFrame, aError);
+
+        if (mForwardRingCount > 0)
         {
-        case kThreadError_None:
-            neighbor->mLinkFailures = 0;
-            break;
+            mForwardRingHead = (mForwardRingHead + 1) % kForwardRingSize;
+            mForwardRingCount--;
+        }
 
-        case kThreadError_ChannelAccessFailure:
-            break;
+        mScheduleTransmissionTask.Post();
+        ExitNow();
+    }
 
-        case kThreadError_NoAck:
-            neighbor->mLinkFailures++;
+    VerifyOrExit(mSendMessage != NULL, ;);
 
-            if (mMle.IsActiveRouter(neighbor->mValid.mRloc16))
-            {
-                if (neighbor->mLinkFailures >= Mle::kFailedRouterTransmissions)
-                {
-                    mMle.RemoveNeighbor(*neighbor);
-                }
-            }
+    mSendMessage->SetOffset(mMessageNextOffset);
 
-            break;
+    aFrame.GetDstAddr(macDest);
+    UpdateNeighborOnSentFrame(aFrame, aError);
 
-        default:
-            assert(false);
-            break;
-        }
+#if OPENTHREAD_ENABLE_PERF_COUNTERS
+
+    if (mMessageNextOffset >= mSendMessage->GetLength() && mSendMessage->GetType() != Message::kTypeMacDataPoll)
+    {
+        otPerfRecordLatency(mNetif.GetIp6().mPerfCounters, mSendLatency, mSendMessage->GetTimestamp());
+        otPerfCount(mNetif.GetIp6().mPerfCounters, mMeshTxMessages);
     }
 
+#endif
+
     if ((child = mMle.GetChild(macDest)) != NULL)
     {
-        child->mDataRequest = false;
+        // a child keeps its sample open after a frame that indicates more to follow, but polls again after a
+        // frame that answered its Data Poll
+        child->mCslTransmit = (child->mCslTransmit && aError == kThreadError_None && aFrame.GetFramePending());
+        child->mDataRequest = child->mCslTransmit;
 
         if (mMessageNextOffset < mSendMessage->GetLength())
         {
@@ -1292,12 +1664,57 @@ void MeshForwarder::HandleSentFrame(Mac::Frame &aFrame, ThreadError aError)
         mSendMessage = NULL;
     }
 
+    if (child != NULL && child->mCslPeriod != 0)
+    {
+        ScheduleCslTransmissions();
+    }
+
     mScheduleTransmissionTask.Post();
 
 exit:
     {}
 }
 
+void MeshForwarder::UpdateNeighborOnSentFrame(Mac::Frame &aFrame, ThreadError aError)
+{
+    Mac::Address macDest;
+    Neighbor *neighbor;
+
+    aFrame.GetDstAddr(macDest);
+
+    VerifyOrExit((neighbor = mMle.GetNeighbor(macDest)) != NULL, ;);
+
+    switch (aError)
+    {
+    case kThreadError_None:
+        neighbor->mLinkFailures = 0;
+        break;
+
+    case kThreadError_ChannelAccessFailure:
+        break;
+
+    case kThreadError_NoAck:
+        neighbor->mLinkFailures++;
+
+        if (mMle.IsActiveRouter(neighbor->mValid.mRloc16))
+        {
+            if (neighbor->mLinkFailures >= Mle::kFailedRouterTransmissions)
+            {
+                mMle.RemoveNeighbor(*neighbor);
+            }
+        }
+
+        break;
+
+    default:
+        assert(false);
+        break;
+    }
+
+exit:
+    return;
+}
+
 void MeshForwarder::SetDiscoverParameters(uint32_t aScanChannels, uint16_t aScanDuration)
 {
     mScanChannels = (aScanChannels == 0) ? static_cast<uint32_t>(Mac::kScanChannelsAll) : aScanChannels;
@@ -1413,7 +1830,8 @@ void MeshForwarder::HandleReceivedFrame(Mac::Frame &aFrame, ThreadError aError)
     if (mPollTimer.IsRunning() && aFrame.GetFramePending())
     {
         // add delay to avoid packet loss due to possible switch senarios between transmit/receive status
-        mPollTimer.Start(OPENTHREAD_CONFIG_ATTACH_DATA_POLL_PERIOD);
+        StartFastPolls(mDataPollCounters.mFramePendingTriggers);
+        mPollTimer.Start(GetEffectivePollPeriod());
     }
 
     switch (aFrame.GetType())
@@ -1492,9 +1910,15 @@ void MeshForwarder::HandleMesh(uint8_t *aFrame, uint8_t aFrameLength, const Thre
         SuccessOrExit(error = CheckReachability(aFrame, aFrameLength, meshSource, meshDest));
 
         meshHeader->SetHopsLeft(meshHeader->GetHopsLeft() - 1);
+        otPerfCount(mNetif.GetIp6().mPerfCounters, mMeshForwardedFrames);
 
-        VerifyOrExit((message = mNetif.GetIp6().mMessagePool.New(Message::kType6lowpan, 0)) != NULL,
-                     error = kThreadError_NoBufs);
+        if (ForwardMesh(aFrame, aFrameLength, meshDest.mShortAddress) == kThreadError_None)
+        {
+            ExitNow();
+        }
+
+        VerifyOrExit((message = mNetif.GetIp6().mMessagePool.New(Message::kType6lowpan, 0, Message::kPriorityLow)) !=
+                     NULL, error = kThreadError_NoBufs);
         SuccessOrExit(error = message->SetLength(aFrameLength));
         message->Write(0, aFrameLength, aFrame);
         message->SetLinkSecurityEnabled(aMessageInfo.mLinkSecurity);
@@ -1516,6 +1940,58 @@ exit:
     }
 }
 
+ThreadError MeshForwarder::ForwardMesh(uint8_t *aFrame, uint8_t aFrameLength, uint16_t aMeshDest)
+{
+    ThreadError error = kThreadError_None;
+    ForwardFrame *forwardFrame;
+    Neighbor *neighbor;
+    uint16_t nextHop;
+
+    // Queued transmissions go first so that fragments of a datagram are not reordered.
+    VerifyOrExit(mForwardRingCount < kForwardRingSize && !HasDirectTransmission(), error = kThreadError_Busy);
+
+    // Frames for a sleepy child wait in the send queue for its data request.
+    neighbor = mMle.GetNeighbor(aMeshDest);
+    VerifyOrExit(neighbor == NULL || (neighbor->mMode & Mle::ModeTlv::kModeRxOnWhenIdle) != 0,
+                 error = kThreadError_InvalidState);
+
+    if ((nextHop = mMle.GetNextHop(aMeshDest)) != Mac::kShortAddrInvalid)
+    {
+        neighbor = mMle.GetNeighbor(nextHop);
+    }
+
+    VerifyOrExit(neighbor != NULL, error = kThreadError_NoRoute);
+
+    forwardFrame = &mForwardRing[(mForwardRingHead + mForwardRingCount) % kForwardRingSize];
+    forwardFrame->mNextHop = neighbor->mValid.mRloc16;
+    forwardFrame->mLength = aFrameLength;
+    memcpy(forwardFrame->mPayload, aFrame, aFrameLength);
+    mForwardRingCount++;
+
+    if (!mSendBusy)
+    {
+        mMac.SendFrameRequest(mMacSender);
+    }
+
+exit:
+    return error;
+}
+
+bool MeshForwarder::HasDirectTransmission(void)
+{
+    Message *message;
+
+    for (message = mSendQueue.GetHead(); message != NULL; message = message->GetNext())
+    {
+        if (message->GetDirectTransmission())
+        {
+            break;
+        }
+    }
+
+    return message != NULL;
+}
+
 ThreadError MeshForwarder::CheckReachability(uint8_t *aFrame, uint8_t aFrameLength,
                                              const Mac::Address &aMeshSource, const Mac::Address &aMeshDest)
 {
@@ -1710,6 +2186,7 @@ exit:
 
 ThreadError MeshForwarder::HandleDatagram(Message &aMessage, const ThreadMessageInfo &aMessageInfo)
 {
+    otPerfCount(mNetif.GetIp6().mPerfCounters, mMeshRxMessages);
     return mNetif.GetIp6().HandleDatagram(aMessage, &mNetif, mNetif.GetInterfaceId(), &aMessageInfo, false);
 }
 
@@ -1735,6 +2212,7 @@ void MeshForwarder::HandleDataRequest(const Mac::Address &aMacSource, const Thre
     if (child->mQueuedIndirectMessageCnt > 0)
     {
         child->mDataRequest = true;
+        child->mCslTransmit = false;
     }
 
     mScheduleTransmissionTask.Post();
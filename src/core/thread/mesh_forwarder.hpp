@@ -69,6 +69,8 @@ struct ThreadMessageInfo;
  */
 class MeshForwarder
 {
+    friend void TestMeshForwarderPreparedFrame(void);
+
 public:
     /**
      * This constructor initializes the object.
@@ -162,6 +164,42 @@ public:
      */
     uint32_t GetPollPeriod(void);
 
+    /**
+     * This method gets the period until the next Data Poll.
+     *
+     * The effective period drops to the fast Data Poll period after the device sends a message or its parent
+     * indicates a pending frame, and then backs off exponentially towards the regular Data Poll period.
+     *
+     * @returns  The effective Data Poll period in milliseconds.
+     *
+     */
+    uint32_t GetEffectivePollPeriod(void) const;
+
+    /**
+     * This method returns the Data Poll counters.
+     *
+     * @returns A reference to the Data Poll counters.
+     *
+     */
+    const otDataPollCounters &GetDataPollCounters(void) const { return mDataPollCounters; }
+
+    /**
+     * This method returns the per-priority send queue counters.
+     *
+     * @returns A reference to the send queue counters.
+     *
+     */
+    const otSendQueueCounters &GetSendQueueCounters(void);
+
+    /**
+     * This method schedules queued indirect frames for sleepy children using coordinated sampled listening.
+     *
+     * A child with a CSL period is served at its next sample time, without waiting for a Data Poll.  This method
+     * must be called when the CSL schedule of a child changes.
+     *
+     */
+    void ScheduleCslTransmissions(void);
+
     /**
      * This method sets the scan parameters for MLE Discovery Request messages.
      *
@@ -175,6 +213,21 @@ private:
     enum
     {
         kStateUpdatePeriod = 1000,  ///< State update period in milliseconds.
+        kForwardRingSize   = OPENTHREAD_CONFIG_MESH_FORWARD_RING_SIZE,
+        kFastPollPeriod    = OPENTHREAD_CONFIG_FAST_DATA_POLL_PERIOD,
+        kFastPolls         = OPENTHREAD_CONFIG_FAST_DATA_POLLS,
+        kCslTransmitMargin = OPENTHREAD_CONFIG_CSL_RECEIVE_WINDOW / 4,  ///< Latest start after a CSL sample (ms).
+    };
+
+    /**
+     * This structure holds a mesh-header frame waiting to be relayed to its next hop.
+     *
+     */
+    struct ForwardFrame
+    {
+        uint16_t mNextHop;                     ///< RLOC16 of the next hop.
+        uint8_t  mLength;                      ///< Length of the mesh-header frame.
+        uint8_t  mPayload[Mac::Frame::kMTU];   ///< The mesh-header frame.
     };
 
     ThreadError CheckReachability(uint8_t *aFrame, uint8_t aFrameLength,
@@ -192,8 +245,14 @@ private:
                         const ThreadMessageInfo &aMessageInfo);
     void HandleDataRequest(const Mac::Address &aMacSource, const ThreadMessageInfo &aMessageInfo);
     void MoveToResolving(const Ip6::Address &aDestination);
+    static Message *HandleEvictMessage(void *aContext, uint8_t aPriority);
+    Message *HandleEvictMessage(uint8_t aPriority);
     ThreadError SendPoll(Message &aMessage, Mac::Frame &aFrame);
     ThreadError SendMesh(Message &aMessage, Mac::Frame &aFrame);
+    ThreadError ForwardMesh(uint8_t *aFrame, uint8_t aFrameLength, uint16_t aMeshDest);
+    bool HasDirectTransmission(void);
+    void SendForwardFrame(Mac::Frame &aFrame);
+    void UpdateNeighborOnSentFrame(Mac::Frame &aFrame, ThreadError aError);
     ThreadError SendFragment(Message &aMessage, Mac::Frame &aFrame);
     void UpdateFramePending(void);
     ThreadError UpdateIp6Route(Message &aMessage);
@@ -205,6 +264,9 @@ private:
 
     static ThreadError HandleFrameRequest(void *aContext, Mac::Frame &aFrame);
     ThreadError HandleFrameRequest(Mac::Frame &aFrame);
+    static ThreadError HandleNextFrameRequest(void *aContext, Mac::Frame &aFrame);
+    ThreadError HandleNextFrameRequest(Mac::Frame &aFrame);
+    bool IsPreparedFrameCurrent(void) const;
 
     static void HandleSentFrame(void *aContext, Mac::Frame &aFrame, ThreadError aError);
     void HandleSentFrame(Mac::Frame &aFrame, ThreadError aError);
@@ -215,6 +277,10 @@ private:
     void HandleReassemblyTimer(void);
     static void HandlePollTimer(void *aContext);
     void HandlePollTimer(void);
+    void StartFastPolls(uint32_t &aTriggerCounter);
+    static void HandleCslTimer(void *aContext);
+    void HandleCslTimer(void);
+    uint32_t GetCslSampleDelay(const Child &aChild, uint32_t aNow) const;
 
     static void ScheduleTransmissionTask(void *aContext);
     void ScheduleTransmissionTask(void);
@@ -228,15 +294,33 @@ private:
     Timer mDiscoverTimer;
     Timer mPollTimer;
     Timer mReassemblyTimer;
+    Timer mCslTimer;
 
     MessageQueue mSendQueue;
     MessageQueue mReassemblyList;
     MessageQueue mResolvingQueue;
     uint16_t mFragTag;
     uint16_t mMessageNextOffset;
+    Message *mPreparedMessage;
+    ForwardFrame mForwardRing[kForwardRingSize];
+    uint8_t mForwardRingHead;
+    uint8_t mForwardRingCount;
+    bool mSendForwardFrame;
+    uint16_t mPreparedOffset;
+    uint16_t mPreparedNextOffset;
+    Mac::Address mPreparedMacSource;
+    Mac::Address mPreparedMacDest;
+    uint16_t mPreparedMeshSource;
+    uint16_t mPreparedMeshDest;
+    bool mPreparedAddMeshHeader;
     uint32_t mPollPeriod;
     uint32_t mAssignPollPeriod;  ///< only for certification test
+    uint32_t mPollBackoffPeriod;
+    uint8_t mFastPollsRemaining;
+    otDataPollCounters mDataPollCounters;
+    otSendQueueCounters mSendQueueCounters;
     Message *mSendMessage;
+    bool mEvictEnabled;
 
     Mac::Address mMacSource;
     Mac::Address mMacDest;
@@ -38,6 +38,7 @@
 #include <common/debug.hpp>
 #include <common/logging.hpp>
 #include <common/encoding.hpp>
+#include <common/perf_counters.hpp>
 #include <crypto/aes_ccm.hpp>
 #include <mac/mac_frame.hpp>
 #include <net/netif.hpp>
@@ -84,6 +85,7 @@ Mle::Mle(ThreadNetif &aThreadNetif) :
     mParentLinkQuality1 = 0;
     mRetrieveNewNetworkData = false;
     mTimeout = kMleEndDeviceTimeout;
+    mCslPeriod = 0;
 
     memset(&mLeaderData, 0, sizeof(mLeaderData));
     memset(&mParent, 0, sizeof(mParent));
@@ -271,7 +273,7 @@ ThreadError Mle::Discover(uint32_t aScanChannels, uint16_t aScanDuration, uint16
     mDiscoverContext = aContext;
     mMesh.SetDiscoverParameters(aScanChannels, aScanDuration);
 
-    VerifyOrExit((message = mSocket.NewMessage(0)) != NULL, ;);
+    VerifyOrExit((message = mSocket.NewMessage(0, Message::kPriorityNetwork)) != NULL, ;);
     message->SetLinkSecurityEnabled(false);
     message->SetSubType(Message::kSubTypeMleDiscoverRequest);
     message->SetPanId(aPanId);
@@ -392,6 +394,7 @@ ThreadError Mle::SetStateDetached(void)
     mParentRequestState = kParentIdle;
     mParentRequestTimer.Stop();
     mMesh.SetRxOnWhenIdle(true);
+    UpdateCslSampling();
     mMleRouter.HandleDetachStart();
     mNetif.GetIp6().SetForwardingEnabled(false);
     mNetif.GetIp6().mMpl.SetTimerExpirations(0);
@@ -402,6 +405,8 @@ ThreadError Mle::SetStateDetached(void)
 
 ThreadError Mle::SetStateChild(uint16_t aRloc16)
 {
+    bool sampling = (mMac.GetCslPeriod() != 0);
+
     if (mDeviceState != kDeviceStateChild)
     {
         mNetif.SetStateChangedFlags(OT_NET_ROLE);
@@ -415,10 +420,13 @@ ThreadError Mle::SetStateChild(uint16_t aRloc16)
     SetRloc16(aRloc16);
     mDeviceState = kDeviceStateChild;
     mParentRequestState = kParentIdle;
+    UpdateCslSampling();
+    StartChildKeepAlive();
 
-    if ((mDeviceMode & ModeTlv::kModeRxOnWhenIdle) != 0)
+    if (!sampling && mMac.GetCslPeriod() != 0)
     {
-        mParentRequestTimer.Start(Timer::SecToMsec(mTimeout / kMaxChildKeepAliveAttempts));
+        // sampling starts with the attachment, announce its schedule to the parent
+        mSendChildUpdateRequest.Post();
     }
 
     if ((mDeviceMode & ModeTlv::kModeFFD) != 0)
@@ -457,14 +465,66 @@ ThreadError Mle::SetTimeout(uint32_t aTimeout)
     if (mDeviceState == kDeviceStateChild)
     {
         SendChildUpdateRequest();
+        StartChildKeepAlive();
+    }
+
+    return kThreadError_None;
+}
+
+uint16_t Mle::GetCslPeriod(void) const
+{
+    return mCslPeriod;
+}
+
+void Mle::SetCslPeriod(uint16_t aPeriod)
+{
+    VerifyOrExit(aPeriod != mCslPeriod, ;);
+
+    mCslPeriod = aPeriod;
+    UpdateCslSampling();
+
+    if (mDeviceState == kDeviceStateChild && (mDeviceMode & ModeTlv::kModeRxOnWhenIdle) == 0)
+    {
+        SendChildUpdateRequest();
+        StartChildKeepAlive();
+    }
+
+exit:
+    return;
+}
+
+void Mle::UpdateCslSampling(void)
+{
+    // only an attached sleepy child samples, the parent it announced its schedule to is the only sender using it
+    if (mDeviceState == kDeviceStateChild && (mDeviceMode & ModeTlv::kModeRxOnWhenIdle) == 0)
+    {
+        mMac.SetCslPeriod(mCslPeriod);
+    }
+    else
+    {
+        mMac.SetCslPeriod(0);
+    }
+}
+
+void Mle::StartChildKeepAlive(void)
+{
+    uint32_t period = Timer::SecToMsec(mTimeout / kMaxChildKeepAliveAttempts);
 
-        if ((mDeviceMode & ModeTlv::kModeRxOnWhenIdle) != 0)
+    if ((mDeviceMode & ModeTlv::kModeRxOnWhenIdle) == 0)
+    {
+        // a sampling child resends its schedule before the clocks of both ends drift out of the receive window
+        VerifyOrExit(mMac.GetCslPeriod() != 0, ;);
+
+        if (period > Timer::SecToMsec(OPENTHREAD_CONFIG_CSL_RESYNC_INTERVAL))
         {
-            mParentRequestTimer.Start(Timer::SecToMsec(mTimeout / kMaxChildKeepAliveAttempts));
+            period = Timer::SecToMsec(OPENTHREAD_CONFIG_CSL_RESYNC_INTERVAL);
         }
     }
 
-    return kThreadError_None;
+    mParentRequestTimer.Start(period);
+
+exit:
+    return;
 }
 
 uint8_t Mle::GetDeviceMode(void) const
@@ -525,10 +585,16 @@ const uint8_t *Mle::GetMeshLocalPrefix(void) const
 
 ThreadError Mle::SetMeshLocalPrefix(const uint8_t *aMeshLocalPrefix)
 {
+    bool subscribed;
+
     // We must remove the old address before adding the new one.
     mNetif.RemoveUnicastAddress(mMeshLocal64);
     mNetif.RemoveUnicastAddress(mMeshLocal16);
 
+    // The all Thread nodes multicast addresses are derived from the prefix, unsubscribe them while they change.
+    subscribed = (mNetif.UnsubscribeMulticast(mLinkLocalAllThreadNodes) == kThreadError_None);
+    mNetif.UnsubscribeMulticast(mRealmLocalAllThreadNodes);
+
     memcpy(mMeshLocal64.GetAddress().mFields.m8, aMeshLocalPrefix, 8);
     memcpy(mMeshLocal16.GetAddress().mFields.m8, mMeshLocal64.GetAddress().mFields.m8, 8);
 
@@ -538,6 +604,12 @@ ThreadError Mle::SetMeshLocalPrefix(const uint8_t *aMeshLocalPrefix)
     mRealmLocalAllThreadNodes.GetAddress().mFields.m8[3] = 64;
     memcpy(mRealmLocalAllThreadNodes.GetAddress().mFields.m8 + 4, mMeshLocal64.GetAddress().mFields.m8, 8);
 
+    if (subscribed)
+    {
+        mNetif.SubscribeMulticast(mLinkLocalAllThreadNodes);
+        mNetif.SubscribeMulticast(mRealmLocalAllThreadNodes);
+    }
+
     // Add the address back into the table.
     mNetif.AddUnicastAddress(mMeshLocal64);
 
@@ -834,6 +906,23 @@ ThreadError Mle::AppendTimeout(Message &aMessage, uint32_t aTimeout)
     return aMessage.Append(&tlv, sizeof(tlv));
 }
 
+ThreadError Mle::AppendCslSchedule(Message &aMessage)
+{
+    ThreadError error = kThreadError_None;
+    CslScheduleTlv tlv;
+
+    VerifyOrExit(mMac.GetCslPeriod() != 0 && (mDeviceMode & ModeTlv::kModeRxOnWhenIdle) == 0, ;);
+
+    tlv.Init();
+    tlv.SetPeriod(mMac.GetCslPeriod());
+    tlv.SetPhase(mMac.GetCslPhase());
+
+    error = aMessage.Append(&tlv, sizeof(tlv));
+
+exit:
+    return error;
+}
+
 ThreadError Mle::AppendChallenge(Message &aMessage, const uint8_t *aChallenge, uint8_t aChallengeLength)
 {
     ThreadError error;
@@ -923,6 +1012,22 @@ exit:
     return error;
 }
 
+ThreadError Mle::AppendNetworkDataDelta(Message &aMessage, uint8_t aVersion)
+{
+    ThreadError error;
+    NetworkDataDeltaTlv tlv;
+    uint8_t length = sizeof(tlv) - sizeof(Tlv);
+
+    tlv.Init();
+    SuccessOrExit(error = mNetworkData.GetDelta(aVersion, tlv.GetDelta(), length));
+    tlv.SetLength(length);
+
+    SuccessOrExit(error = aMessage.Append(&tlv, sizeof(Tlv) + tlv.GetLength()));
+
+exit:
+    return error;
+}
+
 ThreadError Mle::AppendTlvRequest(Message &aMessage, const uint8_t *aTlvs, uint8_t aTlvsLength)
 {
     ThreadError error;
@@ -1084,6 +1189,11 @@ void Mle::HandleNetifStateChanged(uint32_t aFlags)
 
     if ((aFlags & OT_THREAD_NETDATA_UPDATED) != 0)
     {
+        if (mDeviceMode & ModeTlv::kModeFullNetworkData)
+        {
+            mNetworkData.UpdateDeltaLog();
+        }
+
         if (mDeviceMode & ModeTlv::kModeFFD)
         {
             mMleRouter.HandleNetworkDataUpdateRouter();
@@ -1109,10 +1219,10 @@ void Mle::HandleParentRequestTimer(void)
     case kParentIdle:
         if (mParent.mState == Neighbor::kStateValid)
         {
-            if (mDeviceMode & ModeTlv::kModeRxOnWhenIdle)
+            if ((mDeviceMode & ModeTlv::kModeRxOnWhenIdle) || mMac.GetCslPeriod() != 0)
             {
                 SendChildUpdateRequest();
-                mParentRequestTimer.Start(Timer::SecToMsec(mTimeout / kMaxChildKeepAliveAttempts));
+                StartChildKeepAlive();
             }
         }
         else
@@ -1221,7 +1331,7 @@ ThreadError Mle::SendParentRequest(void)
         mParentRequest.mChallenge[i] = static_cast<uint8_t>(otPlatRandomGet());
     }
 
-    VerifyOrExit((message = mSocket.NewMessage(0)) != NULL, ;);
+    VerifyOrExit((message = mSocket.NewMessage(0, Message::kPriorityNetwork)) != NULL, ;);
     message->SetLinkSecurityEnabled(false);
     SuccessOrExit(error = AppendHeader(*message, Header::kCommandParentRequest));
     SuccessOrExit(error = AppendMode(*message, mDeviceMode));
@@ -1288,7 +1398,7 @@ ThreadError Mle::SendChildIdRequest(void)
     Message *message;
     Ip6::Address destination;
 
-    VerifyOrExit((message = mSocket.NewMessage(0)) != NULL, ;);
+    VerifyOrExit((message = mSocket.NewMessage(0, Message::kPriorityNetwork)) != NULL, ;);
     message->SetLinkSecurityEnabled(false);
     SuccessOrExit(error = AppendHeader(*message, Header::kCommandChildIdRequest));
     SuccessOrExit(error = AppendResponse(*message, mChildIdRequest.mChallenge, mChildIdRequest.mChallengeLength));
@@ -1333,13 +1443,35 @@ ThreadError Mle::SendDataRequest(const Ip6::Address &aDestination, const uint8_t
 {
     ThreadError error = kThreadError_None;
     Message *message;
+    bool requestDelta = false;
+#if OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_LOG_SIZE > 0
+    uint8_t tlvs[4];
+
+    // with the full Network Data of the partition, ask for a delta from the current version
+    if (!mRetrieveNewNetworkData && (mDeviceMode & ModeTlv::kModeFullNetworkData) &&
+        memchr(aTlvs, Tlv::kNetworkData, aTlvsLength) != NULL && aTlvsLength < sizeof(tlvs))
+    {
+        memcpy(tlvs, aTlvs, aTlvsLength);
+        tlvs[aTlvsLength++] = Tlv::kNetworkDataDelta;
+        aTlvs = tlvs;
+        requestDelta = true;
+    }
 
-    VerifyOrExit((message = mSocket.NewMessage(0)) != NULL, ;);
+#endif
+
+    VerifyOrExit((message = mSocket.NewMessage(0, Message::kPriorityNetwork)) != NULL, ;);
     message->SetLinkSecurityEnabled(false);
     SuccessOrExit(error = AppendHeader(*message, Header::kCommandDataRequest));
     SuccessOrExit(error = AppendTlvRequest(*message, aTlvs, aTlvsLength));
+
+    if (requestDelta)
+    {
+        SuccessOrExit(error = AppendLeaderData(*message));
+    }
+
     SuccessOrExit(error = AppendActiveTimestamp(*message));
     SuccessOrExit(error = AppendPendingTimestamp(*message));
+    SuccessOrExit(error = AppendCslSchedule(*message));
 
     SuccessOrExit(error = SendMessage(*message, aDestination));
 
@@ -1380,7 +1512,7 @@ ThreadError Mle::SendChildUpdateRequest(void)
     Ip6::Address destination;
     Message *message;
 
-    VerifyOrExit((message = mSocket.NewMessage(0)) != NULL, ;);
+    VerifyOrExit((message = mSocket.NewMessage(0, Message::kPriorityNetwork)) != NULL, ;);
     message->SetLinkSecurityEnabled(false);
     SuccessOrExit(error = AppendHeader(*message, Header::kCommandChildUpdateRequest));
     SuccessOrExit(error = AppendMode(*message, mDeviceMode));
@@ -1406,6 +1538,7 @@ ThreadError Mle::SendChildUpdateRequest(void)
         SuccessOrExit(error = AppendSourceAddress(*message));
         SuccessOrExit(error = AppendLeaderData(*message));
         SuccessOrExit(error = AppendTimeout(*message, mTimeout));
+        SuccessOrExit(error = AppendCslSchedule(*message));
         break;
 
     case kDeviceStateDisabled:
@@ -1447,7 +1580,7 @@ ThreadError Mle::SendAnnounce(uint8_t aChannel, bool aOrphanAnnounce)
     Ip6::Address destination;
     Message *message;
 
-    VerifyOrExit((message = mSocket.NewMessage(0)) != NULL, ;);
+    VerifyOrExit((message = mSocket.NewMessage(0, Message::kPriorityNetwork)) != NULL, ;);
     message->SetSubType(Message::kSubTypeMleAnnounce);
     message->SetChannel(aChannel);
     SuccessOrExit(error = AppendHeader(*message, Header::kCommandAnnounce));
@@ -1591,6 +1724,7 @@ ThreadError Mle::SendMessage(Message &aMessage, const Ip6::Address &aDestination
     messageInfo.mHopLimit = 255;
 
     SuccessOrExit(error = mSocket.SendTo(aMessage, messageInfo));
+    otPerfCount(mNetif.GetIp6().mPerfCounters, mMleTxMessages);
 
 exit:
     return error;
@@ -1625,6 +1759,7 @@ void Mle::HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessageIn
     VerifyOrExit(header.IsValid(),);
 
     assert(aMessageInfo.mLinkInfo != NULL);
+    otPerfCount(mNetif.GetIp6().mPerfCounters, mMleRxMessages);
 
     if (header.GetSecuritySuite() == Header::kNoSecurity)
     {
@@ -1921,6 +2056,7 @@ ThreadError Mle::HandleDataResponse(const Message &aMessage, const Ip6::MessageI
     NetworkDataTlv networkData;
     ActiveTimestampTlv activeTimestamp;
     PendingTimestampTlv pendingTimestamp;
+    uint16_t networkDataDeltaOffset = 0;
     uint16_t activeDatasetOffset = 0;
     uint16_t pendingDatasetOffset = 0;
     bool dataRequest = false;
@@ -1949,9 +2085,15 @@ ThreadError Mle::HandleDataResponse(const Message &aMessage, const Ip6::MessageI
         VerifyOrExit(static_cast<int8_t>(leaderData.GetDataVersion() - mNetworkData.GetVersion()) > 0, ;);
     }
 
-    // Network Data
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kNetworkData, sizeof(networkData), networkData));
-    VerifyOrExit(networkData.IsValid(), error = kThreadError_Parse);
+    // Network Data, or a delta from the current version
+    if (Tlv::GetTlv(aMessage, Tlv::kNetworkData, sizeof(networkData), networkData) == kThreadError_None)
+    {
+        VerifyOrExit(networkData.IsValid(), error = kThreadError_Parse);
+    }
+    else
+    {
+        SuccessOrExit(error = Tlv::GetOffset(aMessage, Tlv::kNetworkDataDelta, networkDataDeltaOffset));
+    }
 
     // Active Timestamp
     if (Tlv::GetTlv(aMessage, Tlv::kActiveTimestamp, sizeof(activeTimestamp), activeTimestamp) == kThreadError_None)
@@ -1996,9 +2138,21 @@ ThreadError Mle::HandleDataResponse(const Message &aMessage, const Ip6::MessageI
     }
 
     // Network Data
-    mNetworkData.SetNetworkData(leaderData.GetDataVersion(), leaderData.GetStableDataVersion(),
-                                (mDeviceMode & ModeTlv::kModeFullNetworkData) == 0,
-                                networkData.GetNetworkData(), networkData.GetLength());
+    if (networkDataDeltaOffset > 0)
+    {
+        if (HandleNetworkDataDelta(aMessage, networkDataDeltaOffset, leaderData) != kThreadError_None)
+        {
+            otLogInfoMle("Failed to apply Network Data delta, requesting full Network Data");
+            mRetrieveNewNetworkData = true;
+            ExitNow(dataRequest = true);
+        }
+    }
+    else
+    {
+        mNetworkData.SetNetworkData(leaderData.GetDataVersion(), leaderData.GetStableDataVersion(),
+                                    (mDeviceMode & ModeTlv::kModeFullNetworkData) == 0,
+                                    networkData.GetNetworkData(), networkData.GetLength());
+    }
 
     // Active Dataset
     if (activeTimestamp.GetLength() > 0)
@@ -2057,6 +2211,23 @@ exit:
     return error;
 }
 
+ThreadError Mle::HandleNetworkDataDelta(const Message &aMessage, uint16_t aOffset, const LeaderDataTlv &aLeaderData)
+{
+    ThreadError error;
+    NetworkDataDeltaTlv networkDataDelta;
+
+    VerifyOrExit(mDeviceMode & ModeTlv::kModeFullNetworkData, error = kThreadError_Drop);
+
+    aMessage.Read(aOffset, sizeof(networkDataDelta), &networkDataDelta);
+    VerifyOrExit(networkDataDelta.IsValid(), error = kThreadError_Parse);
+
+    error = mNetworkData.ApplyDelta(aLeaderData.GetDataVersion(), aLeaderData.GetStableDataVersion(),
+                                    networkDataDelta.GetDelta(), networkDataDelta.GetLength());
+
+exit:
+    return error;
+}
+
 bool Mle::IsBetterParent(uint16_t aRloc16, uint8_t aLinkQuality, ConnectivityTlv &aConnectivityTlv) const
 {
     bool rval = false;
@@ -2339,6 +2510,7 @@ ThreadError Mle::HandleChildIdResponse(const Message &aMessage, const Ip6::Messa
             (numRouters < mMleRouter.GetRouterUpgradeThreshold()))
         {
             mRouterSelectionJitterTimeout = (otPlatRandomGet() % mRouterSelectionJitter) + 1;
+            mMleRouter.ScheduleStateUpdate();
         }
     }
 
@@ -2599,7 +2771,7 @@ ThreadError Mle::SendDiscoveryResponse(const Ip6::Address &aDestination, uint16_
     uint8_t *cur;
     uint8_t length;
 
-    VerifyOrExit((message = mSocket.NewMessage(0)) != NULL, ;);
+    VerifyOrExit((message = mSocket.NewMessage(0, Message::kPriorityNetwork)) != NULL, ;);
     message->SetLinkSecurityEnabled(false);
     message->SetSubType(Message::kSubTypeMleDiscoverResponse);
     message->SetPanId(aPanId);
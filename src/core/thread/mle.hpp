@@ -578,6 +578,26 @@ public:
      */
     ThreadError SetTimeout(uint32_t aTimeout);
 
+    /**
+     * This method returns the coordinated sampled listening period used while operating as a sleepy child.
+     *
+     * @returns The sample period in milliseconds, or zero if sampled listening is disabled.
+     *
+     */
+    uint16_t GetCslPeriod(void) const;
+
+    /**
+     * This method sets the coordinated sampled listening period used while operating as a sleepy child.
+     *
+     * The period only takes effect while this device is attached as a sleepy child.  The parent learns the period
+     * and phase from a CSL Schedule TLV, resynchronized on every Child Update Request and Data Request, and transmits
+     * queued frames at the child's sample times instead of waiting for a Data Poll.
+     *
+     * @param[in]  aPeriod  The sample period in milliseconds, or zero to disable sampled listening.
+     *
+     */
+    void SetCslPeriod(uint16_t aPeriod);
+
     /**
      * This method returns the RLOC16 assigned to the Thread interface.
      *
@@ -796,6 +816,17 @@ protected:
      */
     ThreadError AppendTimeout(Message &aMessage, uint32_t aTimeout);
 
+    /**
+     * This method appends a CSL Schedule TLV to a message if this device samples as an attached sleepy child.
+     *
+     * @param[in]  aMessage  A reference to the message.
+     *
+     * @retval kThreadError_None    Successfully appended the CSL Schedule TLV or sampled listening is not used.
+     * @retval kThreadError_NoBufs  Insufficient buffers available to append the CSL Schedule TLV.
+     *
+     */
+    ThreadError AppendCslSchedule(Message &aMessage);
+
     /**
      * This method appends a Challenge TLV to a message.
      *
@@ -868,6 +899,19 @@ protected:
      */
     ThreadError AppendNetworkData(Message &aMessage, bool aStableOnly);
 
+    /**
+     * This method appends a Network Data Delta TLV to the message.
+     *
+     * @param[in]  aMessage  A reference to the message.
+     * @param[in]  aVersion  The Network Data version of the receiver.
+     *
+     * @retval kThreadError_None      Successfully appended the Network Data Delta TLV.
+     * @retval kThreadError_NotFound  No delta from @p aVersion is available, nothing was appended.
+     * @retval kThreadError_NoBufs    Insufficient buffers available to append the Network Data Delta TLV.
+     *
+     */
+    ThreadError AppendNetworkDataDelta(Message &aMessage, uint8_t aVersion);
+
     /**
      * This method appends a TLV Request TLV to a message.
      *
@@ -1112,7 +1156,7 @@ protected:
      * @returns A pointer to the message or NULL if no buffers are available.
      *
      */
-    Message *NewMessage(void) { return mSocket.NewMessage(0); };
+    Message *NewMessage(void) { return mSocket.NewMessage(0, Message::kPriorityNetwork); };
 
     /**
      * This method sets the Leader's Partition ID, Weighting, and Router ID values.
@@ -1178,6 +1222,8 @@ private:
     void HandleNetifStateChanged(uint32_t aFlags);
     static void HandleParentRequestTimer(void *aContext);
     void HandleParentRequestTimer(void);
+    void StartChildKeepAlive(void);
+    void UpdateCslSampling(void);
     static void HandleUdpReceive(void *aContext, otMessage aMessage, const otMessageInfo *aMessageInfo);
     void HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
     static void HandleSendChildUpdateRequest(void *aContext);
@@ -1187,6 +1233,7 @@ private:
     ThreadError HandleChildIdResponse(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
     ThreadError HandleChildUpdateResponse(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
     ThreadError HandleDataResponse(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
+    ThreadError HandleNetworkDataDelta(const Message &aMessage, uint16_t aOffset, const LeaderDataTlv &aLeaderData);
     ThreadError HandleParentResponse(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo,
                                      uint32_t aKeySequence);
     ThreadError HandleAnnounce(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
@@ -1222,6 +1269,7 @@ private:
 
     Ip6::UdpSocket mSocket;
     uint32_t mTimeout;
+    uint16_t mCslPeriod;
 
     Tasklet mSendChildUpdateRequest;
 
@@ -59,6 +59,7 @@ MleRouter::MleRouter(ThreadNetif &aThreadNetif):
     mAdvertiseTimer(aThreadNetif.GetIp6().mTimerScheduler, &MleRouter::HandleAdvertiseTimer, NULL, this),
     mStateUpdateTimer(aThreadNetif.GetIp6().mTimerScheduler, &MleRouter::HandleStateUpdateTimer, this),
     mDelayedResponseTimer(aThreadNetif.GetIp6().mTimerScheduler, &MleRouter::HandleDelayedResponseTimer, this),
+    mNeighborExpiryTimer(aThreadNetif.GetIp6().mTimerScheduler, &MleRouter::HandleNeighborExpiryTimer, this),
     mAddressSolicit(OPENTHREAD_URI_ADDRESS_SOLICIT, &MleRouter::HandleAddressSolicit, this),
     mAddressRelease(OPENTHREAD_URI_ADDRESS_RELEASE, &MleRouter::HandleAddressRelease, this),
     mCoapServer(aThreadNetif.GetCoapServer()),
@@ -69,6 +70,8 @@ MleRouter::MleRouter(ThreadNetif &aThreadNetif):
     mRouterIdSequence = 0;
     memset(mChildren, 0, sizeof(mChildren));
     memset(mRouters, 0, sizeof(mRouters));
+    memset(mNeighborExpiryPosition, kNumNeighborExpiryIds, sizeof(mNeighborExpiryPosition));
+    mNeighborExpiryCount = 0;
 
     mNetworkIdTimeout = kNetworkIdTimeout;
     mRouterUpgradeThreshold = kRouterUpgradeThreshold;
@@ -173,9 +176,15 @@ ThreadError MleRouter::ReleaseRouterId(uint8_t aRouterId)
     mRouters[aRouterId].mReclaimDelay = true;
     mRouters[aRouterId].mState = Neighbor::kStateInvalid;
     mRouters[aRouterId].mNextHop = kInvalidRouterId;
+    mRouters[aRouterId].mAltNextHop = kInvalidRouterId;
 
     for (uint8_t i = 0; i <= kMaxRouterId; i++)
     {
+        if (mRouters[i].mAltNextHop == aRouterId)
+        {
+            mRouters[i].mAltNextHop = kInvalidRouterId;
+        }
+
         if (mRouters[i].mNextHop == aRouterId)
         {
             mRouters[i].mNextHop = kInvalidRouterId;
@@ -186,6 +195,7 @@ ThreadError MleRouter::ReleaseRouterId(uint8_t aRouterId)
     mRouterIdSequence++;
     mRouterIdSequenceLastUpdated = Timer::GetNow();
     mAddressResolver.Remove(aRouterId);
+    ScheduleStateUpdate();
     mNetworkData.RemoveBorderRouter(GetRloc16(aRouterId));
     ResetAdvertiseInterval();
     return kThreadError_None;
@@ -210,6 +220,7 @@ ThreadError MleRouter::BecomeRouter(ThreadStatusTlv::Status aStatus)
         mRouters[i].mReclaimDelay = false;
         mRouters[i].mState = Neighbor::kStateInvalid;
         mRouters[i].mNextHop = kInvalidRouterId;
+        mRouters[i].mAltNextHop = kInvalidRouterId;
     }
 
     mAdvertiseTimer.Stop();
@@ -250,6 +261,7 @@ ThreadError MleRouter::BecomeLeader(void)
         mRouters[i].mReclaimDelay = false;
         mRouters[i].mState = Neighbor::kStateInvalid;
         mRouters[i].mNextHop = kInvalidRouterId;
+        mRouters[i].mAltNextHop = kInvalidRouterId;
     }
 
     mAdvertiseTimer.Stop();
@@ -309,6 +321,7 @@ ThreadError MleRouter::HandleDetachStart(void)
 
     StopLeader();
     mStateUpdateTimer.Stop();
+    mNeighborExpiryTimer.Stop();
 
     return error;
 }
@@ -319,6 +332,7 @@ ThreadError MleRouter::HandleChildStart(otMleAttachFilter aFilter)
 
     StopLeader();
     mStateUpdateTimer.Start(kStateUpdatePeriod);
+    StartNeighborExpiryTimer();
 
     switch (aFilter)
     {
@@ -362,6 +376,7 @@ ThreadError MleRouter::SetStateRouter(uint16_t aRloc16)
     mRouters[mRouterId].mNextHop = mRouterId;
     mNetworkData.Stop();
     mStateUpdateTimer.Start(kStateUpdatePeriod);
+    StartNeighborExpiryTimer();
     mNetif.GetIp6().SetForwardingEnabled(true);
     mNetif.GetIp6().mMpl.SetTimerExpirations(kMplRouterDataMessageTimerExpirations);
 
@@ -386,6 +401,7 @@ ThreadError MleRouter::SetStateLeader(uint16_t aRloc16)
     mRouters[mRouterId].mLastHeard = Timer::GetNow();
 
     mNetworkData.Start();
+    StartNeighborExpiryTimer();
     mNetif.GetActiveDataset().StartLeader();
     mNetif.GetPendingDataset().StartLeader();
     mCoapServer.AddResource(mAddressSolicit);
@@ -405,6 +421,7 @@ uint8_t MleRouter::GetNetworkIdTimeout(void) const
 void MleRouter::SetNetworkIdTimeout(uint8_t aTimeout)
 {
     mNetworkIdTimeout = aTimeout;
+    ScheduleStateUpdate();
 }
 
 uint8_t MleRouter::GetRouterUpgradeThreshold(void) const
@@ -552,6 +569,7 @@ ThreadError MleRouter::SendLinkRequest(Neighbor *aNeighbor)
         }
 
         mChallengeTimeout = (((2 * kMaxResponseDelay) + kStateUpdatePeriod - 1) / kStateUpdatePeriod);
+        ScheduleStateUpdate();
 
         SuccessOrExit(error = AppendChallenge(*message, mChallenge, sizeof(mChallenge)));
         destination.mFields.m8[0] = 0xff;
@@ -956,6 +974,15 @@ ThreadError MleRouter::HandleLinkAccept(const Message &aMessage, const Ip6::Mess
     neighbor->mState = Neighbor::kStateValid;
     neighbor->mKeySequence = aKeySequence;
 
+    if (routerId != mRouterId)
+    {
+        ScheduleRouterExpiry(routerId);
+    }
+    else
+    {
+        ScheduleChildExpiry(*static_cast<Child *>(neighbor));
+    }
+
     if (aRequest)
     {
         // Challenge
@@ -1128,6 +1155,7 @@ ThreadError MleRouter::ProcessRouteTlv(const RouteTlv &aRoute)
         if (old && !mRouters[i].mAllocated)
         {
             mRouters[i].mNextHop = kInvalidRouterId;
+            mRouters[i].mAltNextHop = kInvalidRouterId;
             mAddressResolver.Remove(i);
         }
     }
@@ -1350,6 +1378,7 @@ ThreadError MleRouter::HandleAdvertisement(const Message &aMessage, const Ip6::M
             (GetActiveRouterCount() < mRouterUpgradeThreshold))
         {
             mRouterSelectionJitterTimeout = (otPlatRandomGet() % mRouterSelectionJitter) + 1;
+            ScheduleStateUpdate();
             ExitNow();
         }
 
@@ -1430,6 +1459,7 @@ ThreadError MleRouter::HandleAdvertisement(const Message &aMessage, const Ip6::M
             HasOneNeighborwithComparableConnectivity(route, routerId))
         {
             mRouterSelectionJitterTimeout = (otPlatRandomGet() % mRouterSelectionJitter) + 1;
+            ScheduleStateUpdate();
         }
 
     // fall through
@@ -1470,111 +1500,54 @@ exit:
 
 void MleRouter::UpdateRoutes(const RouteTlv &aRoute, uint8_t aRouterId)
 {
-    uint8_t curCost;
-    uint8_t newCost;
-    uint8_t oldNextHop;
+    uint8_t routeCount = 0;
     uint8_t cost;
-    uint8_t lqi;
-    bool update;
 
-    // update routes
-    do
+    // apply the link quality reported by the neighbor first, so every entry below is costed over the current link
+    if (IsRouterIdValid(mRouterId) && mRouters[mRouterId].mAllocated && aRoute.IsRouterIdSet(mRouterId))
     {
-        update = false;
-
-        for (uint8_t i = 0, routeCount = 0; i <= kMaxRouterId; i++)
+        for (uint8_t i = 0; i < mRouterId; i++)
         {
-            if (aRoute.IsRouterIdSet(i) == false)
-            {
-                continue;
-            }
-
-            if (mRouters[i].mAllocated == false)
+            if (aRoute.IsRouterIdSet(i))
             {
                 routeCount++;
-                continue;
             }
+        }
 
-            if (i == mRouterId)
-            {
-                lqi = aRoute.GetLinkQualityIn(routeCount);
+        mRouters[aRouterId].mLinkQualityOut = aRoute.GetLinkQualityIn(routeCount);
+    }
 
-                if (mRouters[aRouterId].mLinkQualityOut != lqi)
-                {
-                    mRouters[aRouterId].mLinkQualityOut = lqi;
-                    update = true;
-                }
+    // update routes
+    routeCount = 0;
+
+    for (uint8_t i = 0; i <= kMaxRouterId; i++)
+    {
+        if (aRoute.IsRouterIdSet(i) == false)
+        {
+            continue;
+        }
+
+        if (mRouters[i].mAllocated && i != mRouterId)
+        {
+            if (i == aRouterId)
+            {
+                cost = 0;
             }
             else
             {
-                oldNextHop = mRouters[i].mNextHop;
+                cost = aRoute.GetRouteCost(routeCount);
 
-                if (i == aRouterId)
+                if (cost == 0)
                 {
-                    cost = 0;
+                    cost = kMaxRouteCost;
                 }
-                else
-                {
-                    cost = aRoute.GetRouteCost(routeCount);
-
-                    if (cost == 0)
-                    {
-                        cost = kMaxRouteCost;
-                    }
-                }
-
-                if (!IsRouterIdValid(mRouters[i].mNextHop) || mRouters[i].mNextHop == aRouterId)
-                {
-                    // route has no nexthop or nexthop is neighbor
-                    newCost = cost + GetLinkCost(aRouterId);
-
-                    if (i == aRouterId)
-                    {
-                        if (!IsRouterIdValid(mRouters[i].mNextHop))
-                        {
-                            ResetAdvertiseInterval();
-                        }
-
-                        mRouters[i].mNextHop = aRouterId;
-                        mRouters[i].mCost = 0;
-                    }
-                    else if (newCost <= kMaxRouteCost)
-                    {
-                        if (!IsRouterIdValid(mRouters[i].mNextHop))
-                        {
-                            ResetAdvertiseInterval();
-                        }
-
-                        mRouters[i].mNextHop = aRouterId;
-                        mRouters[i].mCost = cost;
-                    }
-                    else if (IsRouterIdValid(mRouters[i].mNextHop))
-                    {
-                        ResetAdvertiseInterval();
-                        mRouters[i].mNextHop = kInvalidRouterId;
-                        mRouters[i].mCost = 0;
-                        mRouters[i].mLastHeard = Timer::GetNow();
-                    }
-                }
-                else
-                {
-                    curCost = mRouters[i].mCost + GetLinkCost(mRouters[i].mNextHop);
-                    newCost = cost + GetLinkCost(aRouterId);
-
-                    if (newCost < curCost || (newCost == curCost && i == aRouterId))
-                    {
-                        mRouters[i].mNextHop = aRouterId;
-                        mRouters[i].mCost = cost;
-                    }
-                }
-
-                update |= mRouters[i].mNextHop != oldNextHop;
             }
 
-            routeCount++;
+            UpdateRoute(i, aRouterId, cost);
         }
+
+        routeCount++;
     }
-    while (update);
 
 #if 1
 
@@ -1593,6 +1566,134 @@ void MleRouter::UpdateRoutes(const RouteTlv &aRoute, uint8_t aRouterId)
 #endif
 }
 
+void MleRouter::UpdateRoute(uint8_t aDestId, uint8_t aRouterId, uint8_t aCost)
+{
+    Router &router = mRouters[aDestId];
+    uint8_t oldNextHop = router.mNextHop;
+    uint8_t oldCost = router.mCost;
+    uint8_t newCost = aCost + GetLinkCost(aRouterId);
+    uint8_t curCost;
+
+    if (!IsRouterIdValid(router.mNextHop) || router.mNextHop == aRouterId)
+    {
+        // route has no nexthop or nexthop is neighbor
+        if (aDestId == aRouterId)
+        {
+            if (!IsRouterIdValid(router.mNextHop))
+            {
+                ResetAdvertiseInterval();
+            }
+
+            router.mNextHop = aRouterId;
+            router.mCost = 0;
+        }
+        else if (newCost <= kMaxRouteCost)
+        {
+            if (!IsRouterIdValid(router.mNextHop))
+            {
+                ResetAdvertiseInterval();
+            }
+
+            router.mNextHop = aRouterId;
+            router.mCost = aCost;
+        }
+        else if (IsRouterIdValid(router.mNextHop) && !PromoteAltRoute(aDestId))
+        {
+            ResetAdvertiseInterval();
+            router.mNextHop = kInvalidRouterId;
+            router.mCost = 0;
+            router.mLastHeard = Timer::GetNow();
+        }
+    }
+    else
+    {
+        curCost = router.mCost + GetLinkCost(router.mNextHop);
+
+        if (newCost < curCost || (newCost == curCost && aDestId == aRouterId))
+        {
+            router.mNextHop = aRouterId;
+            router.mCost = aCost;
+        }
+    }
+
+    // maintain the alternate, which must advertise a cost lower than ours to guarantee it does not route back via us
+    if (router.mNextHop == aRouterId)
+    {
+        if (IsRouterIdValid(oldNextHop) && oldNextHop != aRouterId && oldCost < newCost)
+        {
+            router.mAltNextHop = oldNextHop;
+            router.mAltCost = oldCost;
+        }
+        else if (router.mAltNextHop == aRouterId)
+        {
+            router.mAltNextHop = kInvalidRouterId;
+        }
+    }
+    else
+    {
+        curCost = IsRouterIdValid(router.mNextHop) ? router.mCost + GetLinkCost(router.mNextHop) : kMaxRouteCost;
+
+        if (newCost < kMaxRouteCost && aCost < curCost &&
+            (router.mAltNextHop == aRouterId || newCost <= GetAltRouteCost(aDestId)))
+        {
+            router.mAltNextHop = aRouterId;
+            router.mAltCost = aCost;
+        }
+        else if (router.mAltNextHop == aRouterId)
+        {
+            router.mAltNextHop = kInvalidRouterId;
+        }
+    }
+
+    if (IsRouterIdValid(router.mAltNextHop) && router.mAltCost >= router.mCost + GetLinkCost(router.mNextHop))
+    {
+        // the primary route improved, the alternate might now route back via us
+        router.mAltNextHop = kInvalidRouterId;
+    }
+}
+
+uint8_t MleRouter::GetAltRouteCost(uint8_t aDestId)
+{
+    uint8_t altNextHop = mRouters[aDestId].mAltNextHop;
+    uint8_t rval = kMaxRouteCost;
+
+    VerifyOrExit(IsRouterIdValid(altNextHop) && altNextHop != mRouters[aDestId].mNextHop, ;);
+    rval = mRouters[aDestId].mAltCost + GetLinkCost(altNextHop);
+
+exit:
+    return rval;
+}
+
+bool MleRouter::PromoteAltRoute(uint8_t aDestId)
+{
+    Router &router = mRouters[aDestId];
+    bool rval = false;
+
+    VerifyOrExit(GetAltRouteCost(aDestId) < kMaxRouteCost, ;);
+
+    otLogDebgMle("route %x: failover %x -> %x", GetRloc16(aDestId), GetRloc16(router.mNextHop),
+                 GetRloc16(router.mAltNextHop));
+
+    router.mNextHop = router.mAltNextHop;
+    router.mCost = router.mAltCost;
+    router.mAltNextHop = kInvalidRouterId;
+    rval = true;
+
+exit:
+    return rval;
+}
+
+void MleRouter::FailoverRoutes(uint8_t aRouterId)
+{
+    for (uint8_t i = 0; i <= kMaxRouterId; i++)
+    {
+        if (mRouters[i].mAllocated && mRouters[i].mNextHop == aRouterId)
+        {
+            PromoteAltRoute(i);
+        }
+    }
+}
+
 ThreadError MleRouter::HandleParentRequest(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo)
 {
     ThreadError error = kThreadError_None;
@@ -1662,6 +1763,7 @@ ThreadError MleRouter::HandleParentRequest(const Message &aMessage, const Ip6::M
 
     child->mLastHeard = Timer::GetNow();
     child->mTimeout = Timer::SecToMsec(2 * kParentRequestChildTimeout);
+    ScheduleChildExpiry(*child);
     SuccessOrExit(error = SendParentResponse(child, challenge, !scanMask.IsEndDeviceFlagSet()));
 
 exit:
@@ -1739,36 +1841,10 @@ void MleRouter::HandleStateUpdateTimer(void)
         break;
     }
 
-    // update children state
-    for (int i = 0; i < mMaxChildrenAllowed; i++)
-    {
-        if (mChildren[i].mState == Neighbor::kStateInvalid)
-        {
-            continue;
-        }
-
-        if ((Timer::GetNow() - mChildren[i].mLastHeard) >= Timer::SecToMsec(mChildren[i].mTimeout))
-        {
-            RemoveNeighbor(mChildren[i]);
-        }
-    }
-
-    // update router state
-    for (uint8_t i = 0; i <= kMaxRouterId; i++)
+    // update router id state
+    if (GetDeviceState() == kDeviceStateLeader)
     {
-        if (mRouters[i].mState == Neighbor::kStateValid)
-        {
-            if ((Timer::GetNow() - mRouters[i].mLastHeard) >= Timer::SecToMsec(kMaxNeighborAge))
-            {
-                mRouters[i].mState = Neighbor::kStateInvalid;
-                mRouters[i].mLinkInfo.Clear();
-                mRouters[i].mNextHop = kInvalidRouterId;
-                mRouters[i].mLinkQualityOut = 0;
-                mRouters[i].mLastHeard = Timer::GetNow();
-            }
-        }
-
-        if (GetDeviceState() == kDeviceStateLeader)
+        for (uint8_t i = 0; i <= kMaxRouterId; i++)
         {
             if (mRouters[i].mAllocated)
             {
@@ -1789,12 +1865,289 @@ void MleRouter::HandleStateUpdateTimer(void)
         }
     }
 
-    mStateUpdateTimer.Start(kStateUpdatePeriod);
+    ScheduleStateUpdate();
 
 exit:
     {}
 }
 
+void MleRouter::ScheduleStateUpdate(void)
+{
+    uint32_t now = Timer::GetNow();
+    uint32_t delay;
+
+    VerifyOrExit(GetDeviceState() != kDeviceStateDisabled, ;);
+
+    if (mChallengeTimeout > 0 || mRouterSelectionJitterTimeout > 0 || GetDeviceState() == kDeviceStateDetached)
+    {
+        // count down in whole periods
+        delay = kStateUpdatePeriod;
+    }
+    else if (GetDeviceState() == kDeviceStateLeader)
+    {
+        delay = GetTimeRemaining(mRouterIdSequenceLastUpdated, Timer::SecToMsec(kRouterIdSequencePeriod), now);
+
+        for (uint8_t i = 0; i <= kMaxRouterId; i++)
+        {
+            if (mRouters[i].mAllocated && !IsRouterIdValid(mRouters[i].mNextHop))
+            {
+                uint32_t remaining = GetTimeRemaining(mRouters[i].mLastHeard,
+                                                      Timer::SecToMsec(kMaxLeaderToRouterTimeout), now);
+                delay = (remaining < delay) ? remaining : delay;
+            }
+            else if (!mRouters[i].mAllocated && mRouters[i].mReclaimDelay)
+            {
+                uint32_t remaining = GetTimeRemaining(mRouters[i].mLastHeard,
+                                                      Timer::SecToMsec(kMaxLeaderToRouterTimeout + kRouterIdReuseDelay),
+                                                      now);
+                delay = (remaining < delay) ? remaining : delay;
+            }
+        }
+    }
+    else
+    {
+        delay = GetTimeRemaining(mRouterIdSequenceLastUpdated, Timer::SecToMsec(mNetworkIdTimeout), now);
+    }
+
+    // conditions that remain true are checked again no sooner than one period later
+    if (delay < kStateUpdatePeriod)
+    {
+        delay = kStateUpdatePeriod;
+    }
+
+    // an earlier wakeup only re-evaluates the state, so never postpone one that is already pending
+    if (!mStateUpdateTimer.IsRunning() ||
+        static_cast<int32_t>(mStateUpdateTimer.Gett0() + mStateUpdateTimer.Getdt() - now) > static_cast<int32_t>(delay))
+    {
+        mStateUpdateTimer.Start(delay);
+    }
+
+exit:
+    return;
+}
+
+uint32_t MleRouter::GetTimeRemaining(uint32_t aStartTime, uint32_t aPeriod, uint32_t aNow)
+{
+    uint32_t elapsed = aNow - aStartTime;
+    return (elapsed < aPeriod) ? (aPeriod - elapsed) : 0;
+}
+
+void MleRouter::ScheduleChildExpiry(const Child &aChild)
+{
+    ScheduleNeighborExpiry(static_cast<uint8_t>(&aChild - mChildren));
+}
+
+void MleRouter::ScheduleRouterExpiry(uint8_t aRouterId)
+{
+    ScheduleNeighborExpiry(kNeighborExpiryRouterBase + aRouterId);
+}
+
+void MleRouter::ScheduleNeighborExpiry(uint8_t aId)
+{
+    uint32_t now = Timer::GetNow();
+    uint32_t delay;
+    uint8_t position = mNeighborExpiryPosition[aId];
+
+    if (!GetNeighborExpiryDelay(aId, now, delay))
+    {
+        if (position < mNeighborExpiryCount)
+        {
+            RemoveNeighborExpiry(position);
+        }
+
+        ExitNow();
+    }
+
+    if (position >= mNeighborExpiryCount)
+    {
+        position = mNeighborExpiryCount++;
+        mNeighborExpiryHeap[position] = aId;
+        mNeighborExpiryPosition[aId] = position;
+    }
+
+    mNeighborExpiryDeadline[aId] = now + delay;
+    SiftNeighborExpiry(position);
+
+exit:
+    StartNeighborExpiryTimer();
+}
+
+bool MleRouter::GetNeighborExpiryDelay(uint8_t aId, uint32_t aNow, uint32_t &aDelay)
+{
+    bool rval = false;
+    Neighbor *neighbor;
+    uint32_t timeout;
+
+    if (aId < kNeighborExpiryRouterBase)
+    {
+        neighbor = &mChildren[aId];
+        VerifyOrExit(neighbor->mState != Neighbor::kStateInvalid, ;);
+        timeout = Timer::SecToMsec(mChildren[aId].mTimeout);
+    }
+    else
+    {
+        neighbor = &mRouters[aId - kNeighborExpiryRouterBase];
+        VerifyOrExit(neighbor->mState == Neighbor::kStateValid, ;);
+        timeout = Timer::SecToMsec(kMaxNeighborAge);
+    }
+
+    aDelay = GetTimeRemaining(neighbor->mLastHeard, timeout, aNow);
+
+    if (aDelay > kMaxNeighborExpiryDelay)
+    {
+        aDelay = kMaxNeighborExpiryDelay;
+    }
+
+    rval = true;
+
+exit:
+    return rval;
+}
+
+void MleRouter::ExpireNeighbor(uint8_t aId)
+{
+    if (aId < kNeighborExpiryRouterBase)
+    {
+        RemoveNeighbor(mChildren[aId]);
+    }
+    else
+    {
+        uint8_t routerId = aId - kNeighborExpiryRouterBase;
+        Router &router = mRouters[routerId];
+
+        router.mState = Neighbor::kStateInvalid;
+        router.mLinkInfo.Clear();
+        FailoverRoutes(routerId);
+
+        if (router.mNextHop == routerId)
+        {
+            router.mNextHop = kInvalidRouterId;
+        }
+
+        router.mLinkQualityOut = 0;
+        router.mLastHeard = Timer::GetNow();
+
+        if (GetDeviceState() == kDeviceStateLeader)
+        {
+            // the router id may now be released
+            ScheduleStateUpdate();
+        }
+    }
+}
+
+void MleRouter::RemoveNeighborExpiry(uint8_t aPosition)
+{
+    uint8_t last = --mNeighborExpiryCount;
+
+    mNeighborExpiryPosition[mNeighborExpiryHeap[aPosition]] = kNumNeighborExpiryIds;
+
+    if (aPosition != last)
+    {
+        mNeighborExpiryHeap[aPosition] = mNeighborExpiryHeap[last];
+        mNeighborExpiryPosition[mNeighborExpiryHeap[aPosition]] = aPosition;
+        SiftNeighborExpiry(aPosition);
+    }
+}
+
+void MleRouter::SiftNeighborExpiry(uint8_t aPosition)
+{
+    uint8_t parent;
+    uint8_t child;
+
+    // an entry whose deadline moved earlier rises towards the root
+    while (aPosition > 0 && IsNeighborExpiryBefore(aPosition, parent = (aPosition - 1) / 2))
+    {
+        SwapNeighborExpiry(aPosition, parent);
+        aPosition = parent;
+    }
+
+    // an entry whose deadline moved later sinks towards the leaves
+    while ((child = 2 * aPosition + 1) < mNeighborExpiryCount)
+    {
+        if (child + 1 < mNeighborExpiryCount && IsNeighborExpiryBefore(child + 1, child))
+        {
+            child++;
+        }
+
+        if (!IsNeighborExpiryBefore(child, aPosition))
+        {
+            break;
+        }
+
+        SwapNeighborExpiry(aPosition, child);
+        aPosition = child;
+    }
+}
+
+void MleRouter::SwapNeighborExpiry(uint8_t aPositionA, uint8_t aPositionB)
+{
+    uint8_t id = mNeighborExpiryHeap[aPositionA];
+
+    mNeighborExpiryHeap[aPositionA] = mNeighborExpiryHeap[aPositionB];
+    mNeighborExpiryHeap[aPositionB] = id;
+    mNeighborExpiryPosition[mNeighborExpiryHeap[aPositionA]] = aPositionA;
+    mNeighborExpiryPosition[mNeighborExpiryHeap[aPositionB]] = aPositionB;
+}
+
+bool MleRouter::IsNeighborExpiryBefore(uint8_t aPositionA, uint8_t aPositionB) const
+{
+    return static_cast<int32_t>(mNeighborExpiryDeadline[mNeighborExpiryHeap[aPositionA]] -
+                                mNeighborExpiryDeadline[mNeighborExpiryHeap[aPositionB]]) < 0;
+}
+
+void MleRouter::StartNeighborExpiryTimer(void)
+{
+    int32_t delay;
+
+    if (mNeighborExpiryCount == 0 || GetDeviceState() == kDeviceStateDisabled)
+    {
+        mNeighborExpiryTimer.Stop();
+        ExitNow();
+    }
+
+    delay = static_cast<int32_t>(mNeighborExpiryDeadline[mNeighborExpiryHeap[0]] - Timer::GetNow());
+    mNeighborExpiryTimer.Start((delay > 0) ? static_cast<uint32_t>(delay) : 0);
+
+exit:
+    return;
+}
+
+void MleRouter::HandleNeighborExpiryTimer(void *aContext)
+{
+    static_cast<MleRouter *>(aContext)->HandleNeighborExpiryTimer();
+}
+
+void MleRouter::HandleNeighborExpiryTimer(void)
+{
+    uint32_t now = Timer::GetNow();
+    uint32_t delay;
+    uint8_t id;
+
+    // deadlines are not moved when a neighbor is heard, so an entry that comes due is checked again here
+    while (mNeighborExpiryCount > 0 &&
+           static_cast<int32_t>(mNeighborExpiryDeadline[mNeighborExpiryHeap[0]] - now) <= 0)
+    {
+        id = mNeighborExpiryHeap[0];
+
+        if (!GetNeighborExpiryDelay(id, now, delay))
+        {
+            RemoveNeighborExpiry(0);
+        }
+        else if (delay == 0)
+        {
+            RemoveNeighborExpiry(0);
+            ExpireNeighbor(id);
+        }
+        else
+        {
+            mNeighborExpiryDeadline[id] = now + delay;
+            SiftNeighborExpiry(0);
+        }
+    }
+
+    StartNeighborExpiryTimer();
+}
+
 void MleRouter::HandleDelayedResponseTimer(void *aContext)
 {
     static_cast<MleRouter *>(aContext)->HandleDelayedResponseTimer();
@@ -1943,6 +2296,23 @@ exit:
     return kThreadError_None;
 }
 
+void MleRouter::UpdateChildCslSchedule(const Message &aMessage, Child &aChild)
+{
+    CslScheduleTlv csl;
+
+    aChild.mCslPeriod = 0;
+
+    if (Tlv::GetTlv(aMessage, Tlv::kCslSchedule, sizeof(csl), csl) == kThreadError_None && csl.IsValid())
+    {
+        // the phase was measured when the child sent the message, anchoring the sample grid on its reception again
+        // discards the drift between both clocks since the previous exchange
+        aChild.mCslPeriod = csl.GetPeriod();
+        aChild.mCslSampleTime = Timer::GetNow() + csl.GetPhase();
+    }
+
+    mMesh.ScheduleCslTransmissions();
+}
+
 ThreadError MleRouter::UpdateChildAddresses(const AddressRegistrationTlv &aTlv, Child &aChild)
 {
     const AddressRegistrationEntry *entry;
@@ -2076,6 +2446,7 @@ ThreadError MleRouter::HandleChildIdRequest(const Message &aMessage, const Ip6::
     child->mMode = mode.GetMode();
     child->mLinkInfo.AddRss(mMac.GetNoiseFloor(), threadMessageInfo->mRss);
     child->mTimeout = timeout.GetTimeout();
+    ScheduleChildExpiry(*child);
 
     if (mode.GetMode() & ModeTlv::kModeFullNetworkData)
     {
@@ -2087,6 +2458,7 @@ ThreadError MleRouter::HandleChildIdRequest(const Message &aMessage, const Ip6::
     }
 
     UpdateChildAddresses(address, *child);
+    UpdateChildCslSchedule(aMessage, *child);
 
     memset(child->mRequestTlvs, Tlv::kInvalid, sizeof(child->mRequestTlvs));
     memcpy(child->mRequestTlvs, tlvRequest.GetTlvs(), tlvRequest.GetLength());
@@ -2221,8 +2593,11 @@ ThreadError MleRouter::HandleChildUpdateRequest(const Message &aMessage, const I
         tlvs[tlvslength++] = Tlv::kTimeout;
     }
 
+    UpdateChildCslSchedule(aMessage, *child);
+
     child->mLastHeard = Timer::GetNow();
     child->mAddSrcMatchEntryShort = true;
+    ScheduleChildExpiry(*child);
 
     SendChildUpdateResponse(child, aMessageInfo, tlvs, tlvslength, &challenge);
 
@@ -2234,8 +2609,12 @@ ThreadError MleRouter::HandleDataRequest(const Message &aMessage, const Ip6::Mes
 {
     ThreadError error = kThreadError_None;
     TlvRequestTlv tlvRequest;
+    LeaderDataTlv leaderData;
+    const LeaderDataTlv *requesterData = NULL;
     ActiveTimestampTlv activeTimestamp;
     PendingTimestampTlv pendingTimestamp;
+    Mac::ExtAddress macAddr;
+    Child *child;
     uint8_t tlvs[4];
     uint8_t numTlvs;
 
@@ -2245,6 +2624,14 @@ ThreadError MleRouter::HandleDataRequest(const Message &aMessage, const Ip6::Mes
     SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kTlvRequest, sizeof(tlvRequest), tlvRequest));
     VerifyOrExit(tlvRequest.IsValid() && tlvRequest.GetLength() <= sizeof(tlvs), error = kThreadError_Parse);
 
+    // Leader Data, sent along with a request for a Network Data delta
+    if (memchr(tlvRequest.GetTlvs(), Tlv::kNetworkDataDelta, tlvRequest.GetLength()) != NULL &&
+        Tlv::GetTlv(aMessage, Tlv::kLeaderData, sizeof(leaderData), leaderData) == kThreadError_None &&
+        leaderData.IsValid() && leaderData.GetPartitionId() == mLeaderData.GetPartitionId())
+    {
+        requesterData = &leaderData;
+    }
+
     // Active Timestamp
     activeTimestamp.SetLength(0);
 
@@ -2261,6 +2648,14 @@ ThreadError MleRouter::HandleDataRequest(const Message &aMessage, const Ip6::Mes
         VerifyOrExit(pendingTimestamp.IsValid(), error = kThreadError_Parse);
     }
 
+    // every exchange with a sampling child resynchronizes its schedule
+    macAddr.Set(aMessageInfo.GetPeerAddr());
+
+    if ((child = FindChild(macAddr)) != NULL && child->mState == Neighbor::kStateValid)
+    {
+        UpdateChildCslSchedule(aMessage, *child);
+    }
+
     memset(tlvs, Tlv::kInvalid, sizeof(tlvs));
     memcpy(tlvs, tlvRequest.GetTlvs(), tlvRequest.GetLength());
     numTlvs = tlvRequest.GetLength();
@@ -2279,7 +2674,7 @@ ThreadError MleRouter::HandleDataRequest(const Message &aMessage, const Ip6::Mes
         tlvs[numTlvs++] = Tlv::kPendingDataset;
     }
 
-    SendDataResponse(aMessageInfo.GetPeerAddr(), tlvs, numTlvs);
+    SendDataResponse(aMessageInfo.GetPeerAddr(), tlvs, numTlvs, requesterData);
 
 exit:
     return error;
@@ -2296,7 +2691,7 @@ ThreadError MleRouter::HandleNetworkDataUpdateRouter(void)
     destination.mFields.m16[0] = HostSwap16(0xff02);
     destination.mFields.m16[7] = HostSwap16(0x0001);
 
-    SendDataResponse(destination, tlvs, sizeof(tlvs));
+    SendDataResponse(destination, tlvs, sizeof(tlvs), NULL);
 
 exit:
     return kThreadError_None;
@@ -2449,7 +2844,8 @@ exit:
     return kThreadError_None;
 }
 
-ThreadError MleRouter::SendDataResponse(const Ip6::Address &aDestination, const uint8_t *aTlvs, uint8_t aTlvsLength)
+ThreadError MleRouter::SendDataResponse(const Ip6::Address &aDestination, const uint8_t *aTlvs, uint8_t aTlvsLength,
+                                        const LeaderDataTlv *aLeaderData)
 {
     ThreadError error = kThreadError_None;
     Message *message;
@@ -2471,6 +2867,13 @@ ThreadError MleRouter::SendDataResponse(const Ip6::Address &aDestination, const
         case Tlv::kNetworkData:
             neighbor = mMleRouter.GetNeighbor(aDestination);
             stableOnly = neighbor != NULL ? (neighbor->mMode & ModeTlv::kModeFullNetworkData) == 0 : false;
+
+            if (aLeaderData != NULL && !stableOnly &&
+                AppendNetworkDataDelta(*message, aLeaderData->GetDataVersion()) == kThreadError_None)
+            {
+                break;
+            }
+
             SuccessOrExit(error = AppendNetworkData(*message, stableOnly));
             break;
 
@@ -2612,6 +3015,12 @@ ThreadError MleRouter::RemoveNeighbor(Neighbor &aNeighbor)
 
     aNeighbor.mState = Neighbor::kStateInvalid;
 
+    if (&aNeighbor >= &mRouters[0] && &aNeighbor <= &mRouters[kMaxRouterId])
+    {
+        // switch routes over the failed link to their alternates without waiting for the next advertisement
+        FailoverRoutes(static_cast<uint8_t>(static_cast<Router *>(&aNeighbor) - mRouters));
+    }
+
     return kThreadError_None;
 }
 
@@ -2819,8 +3228,15 @@ uint16_t MleRouter::GetNextHop(uint16_t aDestination) const
     if (IsRouterIdValid(routerId))
     {
         nextHopRouterId = mRouters[routerId].mNextHop;
-        VerifyOrExit(IsRouterIdValid(nextHopRouterId) && mRouters[nextHopRouterId].mState != Neighbor::kStateInvalid, ;);
-        nextHopRloc16 = GetRloc16(mRouters[nextHopRouterId].mNextHop);
+
+        if (IsRouterIdValid(nextHopRouterId) && mRouters[nextHopRouterId].mState != Neighbor::kStateInvalid)
+        {
+            ExitNow(nextHopRloc16 = GetRloc16(mRouters[nextHopRouterId].mNextHop));
+        }
+
+        nextHopRouterId = mRouters[routerId].mAltNextHop;
+        VerifyOrExit(IsRouterIdValid(nextHopRouterId) && mRouters[nextHopRouterId].mState == Neighbor::kStateValid, ;);
+        nextHopRloc16 = GetRloc16(nextHopRouterId);
     }
 
 exit:
@@ -2895,14 +3311,14 @@ void MleRouter::HandleMacDataRequest(const Child &aChild)
     {
         if (aChild.mNetworkDataVersion != mNetworkData.GetVersion())
         {
-            SendDataResponse(destination, tlvs, sizeof(tlvs));
+            SendDataResponse(destination, tlvs, sizeof(tlvs), NULL);
         }
     }
     else
     {
         if (aChild.mNetworkDataVersion != mNetworkData.GetStableVersion())
         {
-            SendDataResponse(destination, tlvs, sizeof(tlvs));
+            SendDataResponse(destination, tlvs, sizeof(tlvs), NULL);
         }
     }
 
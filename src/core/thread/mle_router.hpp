@@ -50,6 +50,15 @@
 #include <thread/topology.hpp>
 
 namespace Thread {
+
+void TestMleRouterUpdateRoutes(void);
+void TestMleRouterFailover(void);
+
+namespace Benchmark {
+class Timing;
+uint32_t UpdateMleRoutes(Timing &aTiming, uint32_t aIterations);
+}  // namespace Benchmark
+
 namespace Mle {
 
 class MeshForwarder;
@@ -174,6 +183,9 @@ private:
  */
 class MleRouter: public Mle
 {
+    friend void Thread::TestMleRouterUpdateRoutes(void);
+    friend void Thread::TestMleRouterFailover(void);
+    friend uint32_t Thread::Benchmark::UpdateMleRoutes(Benchmark::Timing &aTiming, uint32_t aIterations);
     friend class Mle;
 
 public:
@@ -301,6 +313,8 @@ public:
     /**
      * This method returns the next hop towards an RLOC16 destination.
      *
+     * When the link to the primary next hop is no longer valid, the precomputed alternate next hop is returned.
+     *
      * @param[in]  aDestination  The RLOC16 of the destination.
      *
      * @returns A RLOC16 of the next hop if a route is known, kInvalidRloc16 otherwise.
@@ -637,7 +651,10 @@ public:
 private:
     enum
     {
-        kStateUpdatePeriod = 1000u,  ///< State update period in milliseconds.
+        kStateUpdatePeriod        = 1000u,                            ///< State update period in milliseconds.
+        kNeighborExpiryRouterBase = kMaxChildren,                     ///< Expiry id of router 0, children come first.
+        kNumNeighborExpiryIds     = kMaxChildren + kMaxRouterId + 1,  ///< Number of child and router expiry ids.
+        kMaxNeighborExpiryDelay   = 86400000u,                        ///< Longest expiry timer period in milliseconds.
     };
 
     ThreadError AppendConnectivity(Message &aMessage);
@@ -679,13 +696,19 @@ private:
     ThreadError SendChildIdResponse(Child *aChild);
     ThreadError SendChildUpdateResponse(Child *aChild, const Ip6::MessageInfo &aMessageInfo,
                                         const uint8_t *aTlvs, uint8_t aTlvsLength,  const ChallengeTlv *challenge);
-    ThreadError SendDataResponse(const Ip6::Address &aDestination, const uint8_t *aTlvs, uint8_t aTlvsLength);
+    ThreadError SendDataResponse(const Ip6::Address &aDestination, const uint8_t *aTlvs, uint8_t aTlvsLength,
+                                 const LeaderDataTlv *aLeaderData);
 
     ThreadError SetStateRouter(uint16_t aRloc16);
     ThreadError SetStateLeader(uint16_t aRloc16);
     void StopLeader(void);
     ThreadError UpdateChildAddresses(const AddressRegistrationTlv &aTlv, Child &aChild);
+    void UpdateChildCslSchedule(const Message &aMessage, Child &aChild);
     void UpdateRoutes(const RouteTlv &aTlv, uint8_t aRouterId);
+    void UpdateRoute(uint8_t aDestId, uint8_t aRouterId, uint8_t aCost);
+    uint8_t GetAltRouteCost(uint8_t aDestId);
+    bool PromoteAltRoute(uint8_t aDestId);
+    void FailoverRoutes(uint8_t aRouterId);
 
     static void HandleAddressSolicitResponse(void *aContext, otCoapHeader *aHeader, otMessage aMessage,
                                              ThreadError result);
@@ -716,6 +739,21 @@ private:
     bool HandleAdvertiseTimer(void);
     static void HandleStateUpdateTimer(void *aContext);
     void HandleStateUpdateTimer(void);
+    void ScheduleStateUpdate(void);
+    static uint32_t GetTimeRemaining(uint32_t aStartTime, uint32_t aPeriod, uint32_t aNow);
+
+    void ScheduleChildExpiry(const Child &aChild);
+    void ScheduleRouterExpiry(uint8_t aRouterId);
+    void ScheduleNeighborExpiry(uint8_t aId);
+    bool GetNeighborExpiryDelay(uint8_t aId, uint32_t aNow, uint32_t &aDelay);
+    void ExpireNeighbor(uint8_t aId);
+    void RemoveNeighborExpiry(uint8_t aPosition);
+    void SiftNeighborExpiry(uint8_t aPosition);
+    void SwapNeighborExpiry(uint8_t aPositionA, uint8_t aPositionB);
+    bool IsNeighborExpiryBefore(uint8_t aPositionA, uint8_t aPositionB) const;
+    void StartNeighborExpiryTimer(void);
+    static void HandleNeighborExpiryTimer(void *aContext);
+    void HandleNeighborExpiryTimer(void);
     static void HandleDelayedResponseTimer(void *aContext);
     void HandleDelayedResponseTimer(void);
 
@@ -726,6 +764,12 @@ private:
     TrickleTimer mAdvertiseTimer;
     Timer mStateUpdateTimer;
     Timer mDelayedResponseTimer;
+    Timer mNeighborExpiryTimer;
+
+    uint32_t mNeighborExpiryDeadline[kNumNeighborExpiryIds];  ///< Expiry time of each id, valid while queued.
+    uint8_t mNeighborExpiryPosition[kNumNeighborExpiryIds];   ///< Heap position of each id, or kNumNeighborExpiryIds.
+    uint8_t mNeighborExpiryHeap[kNumNeighborExpiryIds];       ///< Binary min-heap of ids ordered by deadline.
+    uint8_t mNeighborExpiryCount;
 
     Coap::Resource mAddressSolicit;
     Coap::Resource mAddressRelease;
@@ -101,6 +101,8 @@ public:
         kActiveDataset       = 24,   ///< Active Operational Dataset TLV
         kPendingDataset      = 25,   ///< Pending Operational Dataset TLV
         kDiscovery           = 26,   ///< Thread Discovery TLV
+        kCslSchedule         = 27,   ///< CSL Schedule TLV (not assigned by the Thread specification)
+        kNetworkDataDelta    = 28,   ///< Network Data Delta TLV (not assigned by the Thread specification)
         kInvalid             = 255,
     };
 
@@ -851,6 +853,49 @@ private:
     uint8_t mNetworkData[255];
 } OT_TOOL_PACKED_END;
 
+/**
+ * This class implements Network Data Delta TLV generation and parsing.
+ *
+ * A router sends this TLV in place of the Network Data TLV when the receiver asked for it and the delta from the
+ * receiver's Network Data version is smaller than the Network Data.
+ *
+ * The Thread specification defines no Network Data delta, so type 28 is taken from the unassigned space and only this
+ * implementation understands it.  A device asks for the delta by listing type 28 next to the Network Data TLV in its
+ * TLV Request, and a router that does not understand it skips the unknown type and sends the full Network Data.  The
+ * type must move if the specification assigns 28.
+ *
+ */
+OT_TOOL_PACKED_BEGIN
+class NetworkDataDeltaTlv: public Tlv
+{
+public:
+    /**
+     * This method initializes the TLV.
+     *
+     */
+    void Init(void) { SetType(kNetworkDataDelta); SetLength(sizeof(*this) - sizeof(Tlv)); }
+
+    /**
+     * This method indicates whether or not the TLV appears to be well-formed.
+     *
+     * @retval TRUE   If the TLV appears to be well-formed.
+     * @retval FALSE  If the TLV does not appear to be well-formed.
+     *
+     */
+    bool IsValid(void) const { return GetLength() < sizeof(*this) - sizeof(Tlv); }
+
+    /**
+     * This method returns a pointer to the delta.
+     *
+     * @returns A pointer to the delta.
+     *
+     */
+    uint8_t *GetDelta(void) { return mDelta; }
+
+private:
+    uint8_t mDelta[255];
+} OT_TOOL_PACKED_END;
+
 /**
  * This class implements Source Address TLV generation and parsing.
  *
@@ -1611,6 +1656,70 @@ public:
     bool IsValid(void) const { return GetLength() == sizeof(*this) - sizeof(Tlv); }
 } OT_TOOL_PACKED_END;
 
+/**
+ * This class implements CSL Schedule TLV generation and parsing.
+ *
+ * The Thread specification assigns no MLE TLV for coordinated sampled listening, so type 27 is taken from the
+ * unassigned space and only this implementation understands it.  A parent that does not skips it as an unknown TLV
+ * and keeps serving the child through its Data Polls.  The type must move if the specification assigns 27.
+ *
+ */
+OT_TOOL_PACKED_BEGIN
+class CslScheduleTlv: public Tlv
+{
+public:
+    /**
+     * This method initializes the TLV.
+     *
+     */
+    void Init(void) { SetType(kCslSchedule); SetLength(sizeof(*this) - sizeof(Tlv)); }
+
+    /**
+     * This method indicates whether or not the TLV appears to be well-formed.
+     *
+     * @retval TRUE   If the TLV appears to be well-formed.
+     * @retval FALSE  If the TLV does not appear to be well-formed.
+     *
+     */
+    bool IsValid(void) const { return GetLength() == sizeof(*this) - sizeof(Tlv) && GetPeriod() != 0; }
+
+    /**
+     * This method returns the sample period in milliseconds.
+     *
+     * @returns The sample period in milliseconds.
+     *
+     */
+    uint16_t GetPeriod(void) const { return HostSwap16(mPeriod); }
+
+    /**
+     * This method sets the sample period in milliseconds.
+     *
+     * @param[in]  aPeriod  The sample period in milliseconds.
+     *
+     */
+    void SetPeriod(uint16_t aPeriod) { mPeriod = HostSwap16(aPeriod); }
+
+    /**
+     * This method returns the time in milliseconds from the sending of this TLV to the next sample.
+     *
+     * @returns The time in milliseconds to the next sample.
+     *
+     */
+    uint16_t GetPhase(void) const { return HostSwap16(mPhase); }
+
+    /**
+     * This method sets the time in milliseconds from the sending of this TLV to the next sample.
+     *
+     * @param[in]  aPhase  The time in milliseconds to the next sample.
+     *
+     */
+    void SetPhase(uint16_t aPhase) { mPhase = HostSwap16(aPhase); }
+
+private:
+    uint16_t mPeriod;
+    uint16_t mPhase;
+} OT_TOOL_PACKED_END;
+
 /**
  * @}
  *
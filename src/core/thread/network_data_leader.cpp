@@ -34,6 +34,7 @@
 #define WPP_NAME "network_data_leader.tmh"
 
 #include <coap/coap_header.hpp>
+#include <common/crc16.hpp>
 #include <common/debug.hpp>
 #include <common/logging.hpp>
 #include <common/code_utils.hpp>
@@ -77,6 +78,7 @@ void Leader::Reset(void)
     mLength = 0;
     mContextUsed = 0;
     mContextIdReuseDelay = kContextIdReuseDelay;
+    ClearDeltaLog();
     mNetif.SetStateChangedFlags(OT_THREAD_NETDATA_UPDATED);
 }
 
@@ -449,6 +451,189 @@ void Leader::SetNetworkData(uint8_t aVersion, uint8_t aStableVersion, bool aStab
     mNetif.SetStateChangedFlags(OT_THREAD_NETDATA_UPDATED);
 }
 
+void Leader::ClearDeltaLog(void)
+{
+#if OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_LOG_SIZE > 0
+    mDeltaBaseValid = false;
+    mDeltaLogLength = 0;
+#endif
+}
+
+uint8_t Leader::GetDeltaRecordLength(uint16_t aOffset) const
+{
+#if OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_LOG_SIZE > 0
+    const DeltaRecord *record = reinterpret_cast<const DeltaRecord *>(mDeltaLog + aOffset);
+    return static_cast<uint8_t>(sizeof(DeltaRecord) + record->mInsertLength);
+#else
+    (void)aOffset;
+    return 0;
+#endif
+}
+
+uint16_t Leader::ComputeChecksum(const uint8_t *aTlvs, uint8_t aLength)
+{
+    Crc16 ccitt(Crc16::kCcitt);
+
+    for (uint8_t i = 0; i < aLength; i++)
+    {
+        ccitt.Update(aTlvs[i]);
+    }
+
+    return ccitt.Get();
+}
+
+void Leader::UpdateDeltaLog(void)
+{
+#if OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_LOG_SIZE > 0
+    DeltaRecord record;
+    uint8_t prefix = 0;
+    uint8_t suffix = 0;
+    uint16_t recordLength;
+
+    VerifyOrExit(mDeltaBaseValid, ;);
+
+    if (mDeltaBaseVersion == mVersion)
+    {
+        VerifyOrExit(mDeltaBaseLength != mLength || memcmp(mDeltaBase, mTlvs, mLength) != 0, ;);
+
+        // the data changed without a new version, deltas from older versions no longer apply
+        mDeltaLogLength = 0;
+        ExitNow();
+    }
+
+    if (static_cast<int8_t>(mVersion - mDeltaBaseVersion) < 0)
+    {
+        mDeltaLogLength = 0;
+        ExitNow();
+    }
+
+    // the change is logged as a single replacement of the bytes between the common prefix and the common suffix
+    while (prefix < mDeltaBaseLength && prefix < mLength && mDeltaBase[prefix] == mTlvs[prefix])
+    {
+        prefix++;
+    }
+
+    while (suffix < mDeltaBaseLength - prefix && suffix < mLength - prefix &&
+           mDeltaBase[mDeltaBaseLength - 1 - suffix] == mTlvs[mLength - 1 - suffix])
+    {
+        suffix++;
+    }
+
+    record.mFromVersion = mDeltaBaseVersion;
+    record.mToVersion = mVersion;
+    record.mOffset = prefix;
+    record.mRemoveLength = mDeltaBaseLength - prefix - suffix;
+    record.mInsertLength = mLength - prefix - suffix;
+    recordLength = sizeof(record) + record.mInsertLength;
+
+    if (recordLength > kDeltaLogSize)
+    {
+        mDeltaLogLength = 0;
+        ExitNow();
+    }
+
+    // evict the oldest changes
+    while (mDeltaLogLength + recordLength > kDeltaLogSize)
+    {
+        uint8_t length = GetDeltaRecordLength(0);
+
+        mDeltaLogLength -= length;
+        memmove(mDeltaLog, mDeltaLog + length, mDeltaLogLength);
+    }
+
+    memcpy(mDeltaLog + mDeltaLogLength, &record, sizeof(record));
+    memcpy(mDeltaLog + mDeltaLogLength + sizeof(record), mTlvs + prefix, record.mInsertLength);
+    mDeltaLogLength += recordLength;
+
+exit:
+    memcpy(mDeltaBase, mTlvs, mLength);
+    mDeltaBaseLength = mLength;
+    mDeltaBaseVersion = mVersion;
+    mDeltaBaseValid = true;
+#endif
+}
+
+ThreadError Leader::GetDelta(uint8_t aVersion, uint8_t *aDelta, uint8_t &aDeltaLength)
+{
+    ThreadError error = kThreadError_NotFound;
+
+#if OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_LOG_SIZE > 0
+    uint16_t offset = 0;
+    uint16_t length;
+    uint16_t checksum;
+
+    UpdateDeltaLog();
+
+    while (offset < mDeltaLogLength &&
+           reinterpret_cast<const DeltaRecord *>(mDeltaLog + offset)->mFromVersion != aVersion)
+    {
+        offset += GetDeltaRecordLength(offset);
+    }
+
+    VerifyOrExit(offset < mDeltaLogLength, ;);
+
+    length = kDeltaHeaderLength + mDeltaLogLength - offset;
+    VerifyOrExit(length <= aDeltaLength && length < mLength, ;);
+
+    checksum = ComputeChecksum(mTlvs, mLength);
+    aDelta[0] = mLength;
+    aDelta[1] = static_cast<uint8_t>(checksum >> 8);
+    aDelta[2] = static_cast<uint8_t>(checksum);
+    memcpy(aDelta + kDeltaHeaderLength, mDeltaLog + offset, mDeltaLogLength - offset);
+    aDeltaLength = static_cast<uint8_t>(length);
+    error = kThreadError_None;
+
+exit:
+#else
+    (void)aVersion;
+    (void)aDelta;
+    (void)aDeltaLength;
+#endif
+    return error;
+}
+
+ThreadError Leader::ApplyDelta(uint8_t aVersion, uint8_t aStableVersion, const uint8_t *aDelta, uint8_t aDeltaLength)
+{
+    ThreadError error = kThreadError_None;
+    uint8_t tlvs[kMaxSize];
+    uint8_t length = mLength;
+    uint8_t version = mVersion;
+    uint16_t offset = kDeltaHeaderLength;
+    DeltaRecord record;
+
+    VerifyOrExit(aDeltaLength > kDeltaHeaderLength, error = kThreadError_Parse);
+    memcpy(tlvs, mTlvs, mLength);
+
+    while (offset < aDeltaLength)
+    {
+        VerifyOrExit(offset + sizeof(record) <= aDeltaLength, error = kThreadError_Parse);
+        memcpy(&record, aDelta + offset, sizeof(record));
+        offset += sizeof(record);
+
+        VerifyOrExit(record.mFromVersion == version, error = kThreadError_NotFound);
+        VerifyOrExit(offset + record.mInsertLength <= aDeltaLength &&
+                     record.mOffset + record.mRemoveLength <= length &&
+                     length - record.mRemoveLength + record.mInsertLength <= kMaxSize,
+                     error = kThreadError_Parse);
+
+        memmove(tlvs + record.mOffset + record.mInsertLength, tlvs + record.mOffset + record.mRemoveLength,
+                length - record.mOffset - record.mRemoveLength);
+        memcpy(tlvs + record.mOffset, aDelta + offset, record.mInsertLength);
+        length = static_cast<uint8_t>(length - record.mRemoveLength + record.mInsertLength);
+        version = record.mToVersion;
+        offset += record.mInsertLength;
+    }
+
+    VerifyOrExit(version == aVersion && length == aDelta[0] &&
+                 ComputeChecksum(tlvs, length) == ((static_cast<uint16_t>(aDelta[1]) << 8) | aDelta[2]),
+                 error = kThreadError_Failed);
+
+    SetNetworkData(aVersion, aStableVersion, false, tlvs, length);
+
+exit:
+    return error;
+}
+
 void Leader::RemoveBorderRouter(uint16_t aRloc16)
 {
     bool rlocIn = false;
@@ -934,6 +1119,8 @@ ThreadError Leader::RegisterNetworkData(uint16_t aRloc16, uint8_t *aTlvs, uint8_
     bool rlocIn = false;
     bool rlocStable = false;
     bool stableUpdated = false;
+    uint8_t oldTlvs[kMaxSize];
+    uint8_t oldLength = mLength;
 
     RlocLookup(aRloc16, rlocIn, rlocStable, mTlvs, mLength);
 
@@ -945,9 +1132,13 @@ ThreadError Leader::RegisterNetworkData(uint16_t aRloc16, uint8_t *aTlvs, uint8_
             stableUpdated = true;
         }
 
+        memcpy(oldTlvs, mTlvs, mLength);
         SuccessOrExit(error = RemoveRloc(aRloc16));
         SuccessOrExit(error = AddNetworkData(aTlvs, aTlvsLength));
 
+        // a server re-registering the data it already registered does not create a new version
+        VerifyOrExit(mLength != oldLength || memcmp(mTlvs, oldTlvs, mLength) != 0, ;);
+
         mVersion++;
 
         if (stableUpdated)
@@ -34,6 +34,7 @@
 #ifndef NETWORK_DATA_LEADER_HPP_
 #define NETWORK_DATA_LEADER_HPP_
 
+#include <openthread-core-config.h>
 #include <openthread-std-types.h>
 #include <coap/coap_server.hpp>
 #include <common/timer.hpp>
@@ -199,6 +200,46 @@ public:
     void SetNetworkData(uint8_t aVersion, uint8_t aStableVersion, bool aStableOnly, const uint8_t *aData,
                         uint8_t aDataLength);
 
+    /**
+     * This method records the changes to the Network Data since the last call in the delta log.
+     *
+     */
+    void UpdateDeltaLog(void);
+
+    /**
+     * This method provides the delta that transforms version @p aVersion of the Network Data into the current version.
+     *
+     * The delta starts with the length and the CRC16-CCITT of the resulting Network Data, followed by one record per
+     * logged change: the old and new version, the offset and length of the replaced bytes, and the inserted bytes.
+     *
+     * @param[in]     aVersion      The Network Data version of the receiver.
+     * @param[out]    aDelta        A pointer to the delta buffer.
+     * @param[inout]  aDeltaLength  On entry, size of the delta buffer pointed to by @p aDelta.
+     *                              On exit, the length of the delta.
+     *
+     * @retval kThreadError_None      Successfully provided the delta.
+     * @retval kThreadError_NotFound  The log does not reach back to @p aVersion or the delta is not smaller than the
+     *                                Network Data.
+     *
+     */
+    ThreadError GetDelta(uint8_t aVersion, uint8_t *aDelta, uint8_t &aDeltaLength);
+
+    /**
+     * This method is used by non-Leader devices to apply a delta received from a router to the full Network Data.
+     *
+     * @param[in]  aVersion        The Version value.
+     * @param[in]  aStableVersion  The Stable Version value.
+     * @param[in]  aDelta          A pointer to the delta.
+     * @param[in]  aDeltaLength    The length of the delta in bytes.
+     *
+     * @retval kThreadError_None      Successfully applied the delta.
+     * @retval kThreadError_Parse     The delta is malformed.
+     * @retval kThreadError_NotFound  The delta does not start at the current version.
+     * @retval kThreadError_Failed    The result does not match the Network Data the delta was generated from.
+     *
+     */
+    ThreadError ApplyDelta(uint8_t aVersion, uint8_t aStableVersion, const uint8_t *aDelta, uint8_t aDeltaLength);
+
     /**
      * This method removes Network Data associated with a given RLOC16.
      *
@@ -293,12 +334,27 @@ private:
     void SendCommissioningSetResponse(const Coap::Header &aRequestHeader, const Ip6::MessageInfo &aMessageInfo,
                                       MeshCoP::StateTlv::State aState);
 
+    struct DeltaRecord
+    {
+        uint8_t mFromVersion;
+        uint8_t mToVersion;
+        uint8_t mOffset;
+        uint8_t mRemoveLength;
+        uint8_t mInsertLength;
+    };
+
+    void ClearDeltaLog(void);
+    uint8_t GetDeltaRecordLength(uint16_t aOffset) const;
+    static uint16_t ComputeChecksum(const uint8_t *aTlvs, uint8_t aLength);
+
     /**
      * Thread Specification Constants
      *
      */
     enum
     {
+        kDeltaHeaderLength   = 3,             ///< Length and checksum of the resulting Network Data.
+        kDeltaLogSize        = OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_LOG_SIZE,
         kMinContextId        = 1,             ///< Minimum Context ID (0 is used for Mesh Local)
         kNumContextIds       = 15,            ///< Maximum Context ID
         kContextIdReuseDelay = 48 * 60 * 60,  ///< CONTEXT_ID_REUSE_DELAY (seconds)
@@ -313,6 +369,15 @@ private:
     uint8_t         mStableVersion;
     uint8_t         mVersion;
 
+#if OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_LOG_SIZE > 0
+    uint8_t         mDeltaBase[kMaxSize];  ///< The Network Data the last logged change leads to.
+    uint8_t         mDeltaBaseLength;
+    uint8_t         mDeltaBaseVersion;
+    bool            mDeltaBaseValid;
+    uint8_t         mDeltaLog[kDeltaLogSize];
+    uint16_t        mDeltaLogLength;
+#endif
+
     Coap::Resource mCommissioningDataGet;
     Coap::Resource mCommissioningDataSet;
 
@@ -114,6 +114,9 @@ public:
     uint16_t     mQueuedIndirectMessageCnt;            ///< Count of queued messages
     bool         mAddSrcMatchEntryShort;               ///< Indicates whether or not to force add short address
     bool         mAddSrcMatchEntryPending;             ///< Indicates whether or not pending to add
+    uint16_t     mCslPeriod;                           ///< CSL sample period in milliseconds, zero if not used
+    uint32_t     mCslSampleTime;                       ///< Time of a CSL sample of the child
+    bool         mCslTransmit;                         ///< Indicates whether or not the child listens at a CSL sample
 };
 
 /**
@@ -124,6 +127,8 @@ class Router : public Neighbor
 {
 public:
     uint8_t mNextHop;             ///< The next hop towards this router
+    uint8_t mAltNextHop;          ///< The alternate (loop-free) next hop towards this router
+    uint8_t mAltCost;             ///< The cost to this router advertised by the alternate next hop
     uint8_t mLinkQualityOut : 2;  ///< The link quality out for this router
     uint8_t mCost : 4;            ///< The cost to this router
     bool    mAllocated : 1;       ///< Indicates whether or not this entry is allocated
@@ -189,6 +189,11 @@ const NcpBase::GetPropertyHandlerEntry NcpBase::mGetPropertyHandlerTable[] =
     { SPINEL_PROP_CNTR_TX_SPINEL_TOTAL, &NcpBase::GetPropertyHandler_NCP_CNTR },
     { SPINEL_PROP_CNTR_RX_SPINEL_TOTAL, &NcpBase::GetPropertyHandler_NCP_CNTR },
     { SPINEL_PROP_CNTR_RX_SPINEL_ERR, &NcpBase::GetPropertyHandler_NCP_CNTR },
+    { SPINEL_PROP_CNTR_MSG_BUFFERS, &NcpBase::GetPropertyHandler_MSG_BUFFER_CNTR },
+#if OPENTHREAD_ENABLE_PERF_COUNTERS
+    { SPINEL_PROP_CNTR_PERF_EVENTS, &NcpBase::GetPropertyHandler_PERF_EVENTS_CNTR },
+    { SPINEL_PROP_CNTR_PERF_LATENCY, &NcpBase::GetPropertyHandler_PERF_LATENCY_CNTR },
+#endif
 };
 
 const NcpBase::SetPropertyHandlerEntry NcpBase::mSetPropertyHandlerTable[] =
@@ -664,9 +669,12 @@ void NcpBase::HandleEnergyScanResult(otEnergyScanResult *aResult)
             SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
             SPINEL_CMD_PROP_VALUE_INSERTED,
             SPINEL_PROP_MAC_ENERGY_SCAN_RESULT,
-            "Cc",
+            "CcccS",
             aResult->mChannel,
-            aResult->mMaxRssi
+            aResult->mMaxRssi,
+            aResult->mAverageRssi,
+            aResult->mPercentileRssi,
+            aResult->mSampleCount
         );
     }
     else
@@ -2542,6 +2550,123 @@ bail:
     return errorCode;
 }
 
+ThreadError NcpBase::GetPropertyHandler_MSG_BUFFER_CNTR(uint8_t header, spinel_prop_key_t key)
+{
+    ThreadError errorCode = kThreadError_None;
+    const otBufferCounters *counters = otGetBufferCounters(mInstance);
+
+    SuccessOrExit(errorCode = OutboundFrameBegin());
+    SuccessOrExit(errorCode = OutboundFrameFeedPacked("CiiS", header, SPINEL_CMD_PROP_VALUE_IS, key,
+                                                      counters->mFreeBuffers));
+
+    for (uint8_t i = 0; i < OT_NUM_MESSAGE_PRIORITIES; i++)
+    {
+        SuccessOrExit(
+            errorCode = OutboundFrameFeedPacked(
+                "T("
+                    SPINEL_DATATYPE_UINT16_S        // In use
+                    SPINEL_DATATYPE_UINT16_S        // High water
+                    SPINEL_DATATYPE_UINT32_S        // Evicted
+                    SPINEL_DATATYPE_UINT32_S        // Failed
+                ")",
+                counters->mInUse[i],
+                counters->mHighWater[i],
+                counters->mEvicted[i],
+                counters->mFailed[i]
+        ));
+    }
+
+    SuccessOrExit(errorCode = OutboundFrameSend());
+
+exit:
+    return errorCode;
+}
+
+#if OPENTHREAD_ENABLE_PERF_COUNTERS
+
+ThreadError NcpBase::GetPropertyHandler_PERF_EVENTS_CNTR(uint8_t header, spinel_prop_key_t key)
+{
+    ThreadError errorCode = kThreadError_None;
+    const otPerfCounters *counters = otGetPerfCounters(mInstance);
+    const uint32_t events[] =
+    {
+        counters->mMacTxFrames,
+        counters->mMacTxFailures,
+        counters->mMeshTxMessages,
+        counters->mMeshRxMessages,
+        counters->mMeshForwardedFrames,
+        counters->mIp6TxDatagrams,
+        counters->mIp6RxDatagrams,
+        counters->mIp6ForwardedDatagrams,
+        counters->mUdpTxDatagrams,
+        counters->mUdpRxDatagrams,
+        counters->mCoapRequests,
+        counters->mCoapRetransmissions,
+        counters->mCoapResponses,
+        counters->mCoapTimeouts,
+        counters->mMleTxMessages,
+        counters->mMleRxMessages,
+    };
+
+    SuccessOrExit(errorCode = OutboundFrameBegin());
+    SuccessOrExit(errorCode = OutboundFrameFeedPacked("Cii", header, SPINEL_CMD_PROP_VALUE_IS, key));
+
+    for (uint8_t i = 0; i < sizeof(events) / sizeof(events[0]); i++)
+    {
+        SuccessOrExit(errorCode = OutboundFrameFeedPacked(SPINEL_DATATYPE_UINT32_S, events[i]));
+    }
+
+    SuccessOrExit(errorCode = OutboundFrameSend());
+
+exit:
+    return errorCode;
+}
+
+ThreadError NcpBase::GetPropertyHandler_PERF_LATENCY_CNTR(uint8_t header, spinel_prop_key_t key)
+{
+    ThreadError errorCode = kThreadError_None;
+    const otPerfCounters *counters = otGetPerfCounters(mInstance);
+    const otPerfHistogram *histograms[] =
+    {
+        &counters->mMacTxLatency,
+        &counters->mSendQueueLatency,
+        &counters->mSendLatency,
+        &counters->mReceiveLatency,
+        &counters->mCoapResponseLatency,
+    };
+
+    SuccessOrExit(errorCode = OutboundFrameBegin());
+    SuccessOrExit(errorCode = OutboundFrameFeedPacked("Cii", header, SPINEL_CMD_PROP_VALUE_IS, key));
+
+    for (uint8_t i = 0; i < sizeof(histograms) / sizeof(histograms[0]); i++)
+    {
+        const uint32_t *buckets = histograms[i]->mBuckets;
+
+        // The bucket array is the last member of the struct, so its entries are packed without a length.
+        SuccessOrExit(
+            errorCode = OutboundFrameFeedPacked(
+                "T("
+                    SPINEL_DATATYPE_UINT32_S        // Count
+                    SPINEL_DATATYPE_UINT32_S        // Sum
+                    SPINEL_DATATYPE_UINT32_S        // Max
+                    "LLLLLLLLLLLLLLLL"              // Buckets
+                ")",
+                histograms[i]->mCount,
+                histograms[i]->mSum,
+                histograms[i]->mMax,
+                buckets[0], buckets[1], buckets[2], buckets[3], buckets[4], buckets[5], buckets[6], buckets[7],
+                buckets[8], buckets[9], buckets[10], buckets[11], buckets[12], buckets[13], buckets[14], buckets[15]
+        ));
+    }
+
+    SuccessOrExit(errorCode = OutboundFrameSend());
+
+exit:
+    return errorCode;
+}
+
+#endif  // OPENTHREAD_ENABLE_PERF_COUNTERS
+
 ThreadError NcpBase::GetPropertyHandler_MAC_WHITELIST(uint8_t header, spinel_prop_key_t key)
 {
     otMacWhitelistEntry entry;
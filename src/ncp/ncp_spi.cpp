@@ -41,6 +41,7 @@
 
 #define SPI_RESET_FLAG          0x80
 #define SPI_CRC_FLAG            0x40
+#define SPI_AGGREGATE_FLAG      0x20
 #define SPI_PATTERN_VALUE       0x02
 #define SPI_PATTERN_MASK        0x03
 
@@ -86,6 +87,17 @@ static uint16_t spi_header_get_data_len(const uint8_t *header)
     return ( header[3] + static_cast<uint16_t>(header[4] << 8) );
 }
 
+static void spi_frame_set_len(uint8_t *frame, uint16_t len)
+{
+    frame[0] = ((len >> 0) & 0xFF);
+    frame[1] = ((len >> 8) & 0xFF);
+}
+
+static uint16_t spi_frame_get_len(const uint8_t *frame)
+{
+    return ( frame[0] + static_cast<uint16_t>(frame[1] << 8) );
+}
+
 NcpSpi::NcpSpi(otInstance *aInstance):
     NcpBase(aInstance),
     mHandleRxFrameTask(aInstance->mIp6.mTaskletScheduler, &NcpSpi::HandleRxFrame, this),
@@ -97,13 +109,19 @@ NcpSpi::NcpSpi(otInstance *aInstance):
 
     mSending = false;
     mHandlingSendDone = false;
-    mHandlingRxFrame = false;
+    mHostAggregation = false;
+    mHostAcceptLen = 0;
+
+    memset(mRxFrameReady, 0, sizeof(mRxFrameReady));
+    mRxFrameIndex = 0;
+    mRxHandleIndex = 0;
 
     mTxFrameBuffer.SetCallbacks(NULL, TxFrameBufferHasData, this);
 
+    // The aggregate flag on a frame without data advertises that we can parse aggregated frames from the host.
     spi_header_set_flag_byte(mSendFrame, SPI_RESET_FLAG|SPI_PATTERN_VALUE);
-    spi_header_set_flag_byte(mEmptySendFrame, SPI_RESET_FLAG|SPI_PATTERN_VALUE);
-    spi_header_set_accept_len(mSendFrame, sizeof(mReceiveFrame) - kSpiHeaderLength);
+    spi_header_set_flag_byte(mEmptySendFrame, SPI_RESET_FLAG|SPI_AGGREGATE_FLAG|SPI_PATTERN_VALUE);
+    spi_header_set_accept_len(mSendFrame, sizeof(mReceiveFrame[0]) - kSpiHeaderLength);
     otPlatSpiSlaveEnable(&NcpSpi::SpiTransactionComplete, (void*)this);
 
     // We signal an interrupt on this first transaction to
@@ -152,6 +170,7 @@ NcpSpi::SpiTransactionComplete(
     uint16_t rx_accept_len(0);
     uint16_t tx_data_len(0);
     uint16_t tx_accept_len(0);
+    uint8_t rx_flag_byte(0);
 
     // TODO: Check `PATTERN` bits of `HDR` and ignore frame if not set.
     //       Holding off on implementing this so as to not cause immediate
@@ -170,14 +189,27 @@ NcpSpi::SpiTransactionComplete(
         {
             rx_data_len = spi_header_get_data_len(aMOSIBuf);
             tx_accept_len = spi_header_get_accept_len(aMOSIBuf);
+            rx_flag_byte = spi_header_get_flag_byte(aMOSIBuf);
+
+            if ((rx_flag_byte & SPI_PATTERN_MASK) == SPI_PATTERN_VALUE)
+            {
+                mHostAggregation = ((rx_flag_byte & SPI_AGGREGATE_FLAG) != 0);
+
+                if (tx_accept_len > 0)
+                {
+                    mHostAcceptLen = tx_accept_len;
+                }
+            }
         }
 
-        if ( !mHandlingRxFrame
+        if ( (aMOSIBuf == mReceiveFrame[mRxFrameIndex])
           && (rx_data_len > 0)
           && (rx_data_len <= (aTransactionLength - kSpiHeaderLength))
           && (rx_data_len <= rx_accept_len)
         ) {
-            mHandlingRxFrame = true;
+            // Hand the frame over and receive the next one into the other buffer.
+            mRxFrameReady[mRxFrameIndex] = true;
+            mRxFrameIndex = (mRxFrameIndex + 1) % kRxFrameCount;
             mHandleRxFrameTask.Post();
         }
 
@@ -197,8 +229,8 @@ NcpSpi::SpiTransactionComplete(
       && (aMISOBufLen >= 1)
     ) {
         // Clear the reset flag.
-        spi_header_set_flag_byte(mSendFrame, SPI_PATTERN_VALUE);
-        spi_header_set_flag_byte(mEmptySendFrame, SPI_PATTERN_VALUE);
+        spi_header_set_flag_byte(mSendFrame, spi_header_get_flag_byte(mSendFrame) & ~SPI_RESET_FLAG);
+        spi_header_set_flag_byte(mEmptySendFrame, SPI_AGGREGATE_FLAG|SPI_PATTERN_VALUE);
     }
 
     if (mSending && !mHandlingSendDone)
@@ -212,7 +244,7 @@ NcpSpi::SpiTransactionComplete(
         aMISOBufLen = kSpiHeaderLength;
     }
 
-    if (mHandlingRxFrame)
+    if (mRxFrameReady[mRxFrameIndex])
     {
         aMOSIBuf = mEmptyReceiveFrame;
         aMOSIBufLen = kSpiHeaderLength;
@@ -220,9 +252,9 @@ NcpSpi::SpiTransactionComplete(
     }
     else
     {
-        aMOSIBuf = mReceiveFrame;
-        aMOSIBufLen = sizeof(mReceiveFrame);
-        spi_header_set_accept_len(aMISOBuf, sizeof(mReceiveFrame) - kSpiHeaderLength);
+        aMOSIBuf = mReceiveFrame[mRxFrameIndex];
+        aMOSIBufLen = sizeof(mReceiveFrame[0]);
+        spi_header_set_accept_len(aMISOBuf, sizeof(mReceiveFrame[0]) - kSpiHeaderLength);
     }
 
     otPlatSpiSlavePrepareTransaction(
@@ -270,25 +302,63 @@ void NcpSpi::TxFrameBufferHasData(void)
 ThreadError NcpSpi::PrepareNextSpiSendFrame(void)
 {
     ThreadError errorCode = kThreadError_None;
+    uint8_t flagByte = spi_header_get_flag_byte(mSendFrame) & SPI_RESET_FLAG;
+    uint16_t prefixLength = 0;
+    uint16_t maxDataLength = sizeof(mSendFrame) - kSpiHeaderLength;
+    uint16_t dataLength = 0;
     uint16_t frameLength;
     uint16_t readLength;
 
     VerifyOrExit(!mTxFrameBuffer.IsEmpty(), ;);
 
-    SuccessOrExit(errorCode = mTxFrameBuffer.OutFrameBegin());
+    if (mHostAggregation)
+    {
+        // Pack as many length-prefixed frames as the host was last willing to receive.
+        flagByte |= SPI_AGGREGATE_FLAG;
+        prefixLength = kSpiFrameLengthSize;
+
+        if (mHostAcceptLen > 0 && mHostAcceptLen < maxDataLength)
+        {
+            maxDataLength = mHostAcceptLen;
+        }
+    }
+
+    do
+    {
+        SuccessOrExit(errorCode = mTxFrameBuffer.OutFrameBegin());
+
+        frameLength = mTxFrameBuffer.OutFrameGetLength();
+
+        if (dataLength > 0 && dataLength + prefixLength + frameLength > maxDataLength)
+        {
+            break;
+        }
+
+        VerifyOrExit(dataLength + prefixLength + frameLength <= kSpiBufferSize - kSpiHeaderLength,
+                     errorCode = kThreadError_NoBufs);
+
+        if (prefixLength > 0)
+        {
+            spi_frame_set_len(mSendFrame + kSpiHeaderLength + dataLength, frameLength);
+        }
 
-    frameLength = mTxFrameBuffer.OutFrameGetLength();
-    VerifyOrExit(frameLength <= sizeof(mSendFrame) - kSpiHeaderLength, errorCode = kThreadError_NoBufs);
+        readLength = mTxFrameBuffer.OutFrameRead(frameLength, mSendFrame + kSpiHeaderLength + dataLength + prefixLength);
+        VerifyOrExit(readLength == frameLength, errorCode = kThreadError_Failed);
 
-    spi_header_set_data_len(mSendFrame, frameLength);
+        dataLength += prefixLength + frameLength;
+
+        // Remove the frame from tx buffer, it is now held in `mSendFrame`.
+        mTxFrameBuffer.OutFrameRemove();
+    }
+    while (prefixLength > 0 && !mTxFrameBuffer.IsEmpty());
+
+    spi_header_set_flag_byte(mSendFrame, flagByte | SPI_PATTERN_VALUE);
+    spi_header_set_data_len(mSendFrame, dataLength);
 
     // Half-duplex to avoid race condition.
     spi_header_set_accept_len(mSendFrame, 0);
 
-    readLength = mTxFrameBuffer.OutFrameRead(frameLength, mSendFrame + kSpiHeaderLength);
-    VerifyOrExit(readLength == frameLength, errorCode = kThreadError_Failed);
-
-    mSendFrameLen = frameLength + kSpiHeaderLength;
+    mSendFrameLen = dataLength + kSpiHeaderLength;
 
     mSending = true;
 
@@ -313,9 +383,7 @@ ThreadError NcpSpi::PrepareNextSpiSendFrame(void)
         mSending = false;
     }
 
-    // Remove the frame from tx buffer and inform the base
-    // class that space is now available for a new frame.
-    mTxFrameBuffer.OutFrameRemove();
+    // Inform the base class that space is now available for a new frame.
     super_t::HandleSpaceAvailableInTxBuffer();
 
 exit:
@@ -348,9 +416,44 @@ void NcpSpi::HandleRxFrame(void *aContext)
 
 void NcpSpi::HandleRxFrame(void)
 {
-    uint16_t rx_data_len( spi_header_get_data_len(mReceiveFrame) );
-    super_t::HandleReceive(mReceiveFrame + kSpiHeaderLength, rx_data_len);
-    mHandlingRxFrame = false;
+    while (mRxFrameReady[mRxHandleIndex])
+    {
+        const uint8_t *frame = mReceiveFrame[mRxHandleIndex];
+        uint16_t rx_data_len( spi_header_get_data_len(frame) );
+
+        if (spi_header_get_flag_byte(frame) & SPI_AGGREGATE_FLAG)
+        {
+            HandleAggregatedRxFrame(frame + kSpiHeaderLength, rx_data_len);
+        }
+        else
+        {
+            super_t::HandleReceive(frame + kSpiHeaderLength, rx_data_len);
+        }
+
+        mRxFrameReady[mRxHandleIndex] = false;
+        mRxHandleIndex = (mRxHandleIndex + 1) % kRxFrameCount;
+    }
+}
+
+void NcpSpi::HandleAggregatedRxFrame(const uint8_t *aBuf, uint16_t aBufLength)
+{
+    uint16_t frameLength;
+
+    while (aBufLength >= kSpiFrameLengthSize)
+    {
+        frameLength = spi_frame_get_len(aBuf);
+        aBuf += kSpiFrameLengthSize;
+        aBufLength -= kSpiFrameLengthSize;
+
+        VerifyOrExit(frameLength <= aBufLength, ;);
+
+        super_t::HandleReceive(aBuf, frameLength);
+        aBuf += frameLength;
+        aBufLength -= frameLength;
+    }
+
+exit:
+    return;
 }
 
 }  // namespace Thread
@@ -64,6 +64,8 @@ private:
         kSpiBufferSize   = 1500, // Spi buffer size (should be large enough to fit a max length frame + spi header).
         kTxBufferSize    = 512,  // Tx Buffer size (used by mTxFrameBuffer).
         kSpiHeaderLength = 5,    // Size of spi header.
+        kSpiFrameLengthSize = 2, // Size of the length prefix of each frame in an aggregated spi payload.
+        kRxFrameCount    = 2,    // Number of receive buffers (allows accepting a frame while handling the previous one).
     };
 
     uint16_t OutboundFrameSize(void);
@@ -94,17 +96,22 @@ private:
     void TxFrameBufferHasData(void);
 
     ThreadError PrepareNextSpiSendFrame(void);
+    void HandleAggregatedRxFrame(const uint8_t *aBuf, uint16_t aBufLength);
 
     bool mSending;
-    bool mHandlingRxFrame;
     bool mHandlingSendDone;
+    bool mHostAggregation;
+    uint16_t mHostAcceptLen;
 
     Tasklet mHandleRxFrameTask;
     Tasklet mPrepareTxFrameTask;
 
     uint8_t mSendFrame[kSpiBufferSize];
     uint16_t mSendFrameLen;
-    uint8_t mReceiveFrame[kSpiBufferSize];
+    uint8_t mReceiveFrame[kRxFrameCount][kSpiBufferSize];
+    bool mRxFrameReady[kRxFrameCount];
+    uint8_t mRxFrameIndex;
+    uint8_t mRxHandleIndex;
 
     uint8_t mEmptySendFrame[kSpiHeaderLength];
     uint8_t mEmptyReceiveFrame[kSpiHeaderLength];
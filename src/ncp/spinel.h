@@ -359,7 +359,7 @@ typedef enum
     SPINEL_PROP_MAC_15_4_PANID         = SPINEL_PROP_MAC__BEGIN + 6, ///< [S]
     SPINEL_PROP_MAC_RAW_STREAM_ENABLED = SPINEL_PROP_MAC__BEGIN + 7, ///< [C]
     SPINEL_PROP_MAC_PROMISCUOUS_MODE   = SPINEL_PROP_MAC__BEGIN + 8, ///< [C]
-    SPINEL_PROP_MAC_ENERGY_SCAN_RESULT = SPINEL_PROP_MAC__BEGIN + 9, ///< chan,maxRssi [Cc]
+    SPINEL_PROP_MAC_ENERGY_SCAN_RESULT = SPINEL_PROP_MAC__BEGIN + 9, ///< chan,maxRssi,avgRssi,pctRssi,samples [CcccS]
     SPINEL_PROP_MAC__END               = 0x40,
 
     SPINEL_PROP_MAC_EXT__BEGIN         = 0x1300,
@@ -764,6 +764,18 @@ typedef enum
     /** Format: `L` (Read-only) */
     SPINEL_PROP_CNTR_RX_SPINEL_ERR     = SPINEL_PROP_CNTR__BEGIN + 302,
 
+    /// The message buffer usage: free buffers, then in use, high water, evicted and failed per priority class.
+    /** Format: `SA(T(SSLL))` (Read-only) */
+    SPINEL_PROP_CNTR_MSG_BUFFERS       = SPINEL_PROP_CNTR__BEGIN + 400,
+
+    /// The stack event counters, in the order of the fields of otPerfCounters.
+    /** Format: `A(L)` (Read-only) */
+    SPINEL_PROP_CNTR_PERF_EVENTS       = SPINEL_PROP_CNTR__BEGIN + 401,
+
+    /// The stack latency histograms: count, sum and maximum in milliseconds, then the bucket counts.
+    /** Format: `A(T(LLLA(L)))` (Read-only) */
+    SPINEL_PROP_CNTR_PERF_LATENCY      = SPINEL_PROP_CNTR__BEGIN + 402,
+
     SPINEL_PROP_CNTR__END       = 2048,
 
     SPINEL_PROP_NEST__BEGIN         = 15296,
@@ -0,0 +1,193 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <openthread.h>
+#include <crypto/aes_ccm.hpp>
+#include <crypto/aes_ccm_batch.hpp>
+
+#include "benchmark.hpp"
+
+namespace Thread {
+namespace Benchmark {
+
+enum
+{
+    kKeyLength     = 16,
+    kNonceLength   = 13,
+    kHeaderLength  = 21,   ///< A MAC header with a short destination, an extended source and key ID mode 1.
+    kPayloadLength = 80,
+    kTagLength     = 4,
+};
+
+/**
+ * This function encrypts or decrypts a MAC frame, the way Mac::ProcessTransmitSecurity() and
+ * Mac::ProcessReceiveSecurity() do.
+ *
+ */
+static uint32_t ProcessFrames(Timing &aTiming, uint32_t aIterations, bool aEncrypt)
+{
+    Crypto::AesCcm aesCcm;
+    uint8_t key[kKeyLength];
+    uint8_t nonce[kNonceLength];
+    uint8_t header[kHeaderLength];
+    uint8_t payload[kPayloadLength];
+    uint8_t tag[kTagLength];
+    uint8_t tagLength;
+    uint32_t rval = 0;
+
+    FillRandom(key, sizeof(key), 0x4b657920);
+    FillRandom(nonce, sizeof(nonce), 0x4e6f6e63);
+    FillRandom(header, sizeof(header), 0x48647220);
+    FillRandom(payload, sizeof(payload), 0x50796c64);
+    aesCcm.SetKey(key, sizeof(key));
+
+    aTiming.Start();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        // the frame counter, which follows the extended address in the nonce, changes with every frame
+        nonce[8] = static_cast<uint8_t>(i);
+
+        aesCcm.Init(sizeof(header), sizeof(payload), sizeof(tag), nonce, sizeof(nonce));
+        aesCcm.Header(header, sizeof(header));
+        aesCcm.Payload(payload, payload, sizeof(payload), aEncrypt);
+        aesCcm.Finalize(tag, &tagLength);
+        rval += tag[0] + tagLength;
+    }
+
+    aTiming.Stop();
+
+    return rval + payload[0];
+}
+
+static uint32_t Encrypt(Timing &aTiming, uint32_t aIterations)
+{
+    return ProcessFrames(aTiming, aIterations, true);
+}
+
+static uint32_t Decrypt(Timing &aTiming, uint32_t aIterations)
+{
+    return ProcessFrames(aTiming, aIterations, false);
+}
+
+/**
+ * This function encrypts or decrypts the same MAC frames with AesCcmBatch, @p aBatchSize frames per call.  An
+ * iteration is one frame, so that the results compare with those of ProcessFrames().
+ *
+ */
+static uint32_t ProcessFramesBatch(Timing &aTiming, uint32_t aIterations, Crypto::AesBatch::Backend aBackend,
+                                   uint8_t aBatchSize, bool aEncrypt)
+{
+    Crypto::AesCcmBatch aesCcmBatch;
+    Crypto::AesCcmBatch::Frame frames[Crypto::AesCcmBatch::kMaxFrames];
+    uint8_t key[kKeyLength];
+    uint8_t nonces[Crypto::AesCcmBatch::kMaxFrames][kNonceLength];
+    uint8_t header[kHeaderLength];
+    uint8_t payloads[Crypto::AesCcmBatch::kMaxFrames][kPayloadLength];
+    uint8_t tags[Crypto::AesCcmBatch::kMaxFrames][kTagLength];
+    uint32_t rval = 0;
+
+    FillRandom(key, sizeof(key), 0x4b657920);
+    FillRandom(header, sizeof(header), 0x48647220);
+    aesCcmBatch.SetKey(key, sizeof(key), aBackend);
+
+    for (uint8_t i = 0; i < aBatchSize; i++)
+    {
+        FillRandom(nonces[i], sizeof(nonces[i]), 0x4e6f6e63);
+        FillRandom(payloads[i], sizeof(payloads[i]), 0x50796c64);
+
+        frames[i].mNonce = nonces[i];
+        frames[i].mNonceLength = sizeof(nonces[i]);
+        frames[i].mHeader = header;
+        frames[i].mHeaderLength = sizeof(header);
+        frames[i].mPlainText = payloads[i];
+        frames[i].mCipherText = payloads[i];
+        frames[i].mPayloadLength = sizeof(payloads[i]);
+        frames[i].mTag = tags[i];
+        frames[i].mTagLength = sizeof(tags[i]);
+    }
+
+    aTiming.Start();
+
+    for (uint32_t i = 0; i < aIterations; i += aBatchSize)
+    {
+        for (uint8_t j = 0; j < aBatchSize; j++)
+        {
+            nonces[j][8] = static_cast<uint8_t>(i + j);
+        }
+
+        aesCcmBatch.Process(frames, aBatchSize, aEncrypt);
+
+        for (uint8_t j = 0; j < aBatchSize; j++)
+        {
+            rval += tags[j][0] + sizeof(tags[j]);
+        }
+    }
+
+    aTiming.Stop();
+
+    return rval + payloads[0][0];
+}
+
+static uint32_t EncryptBatch1Bitsliced(Timing &aTiming, uint32_t aIterations)
+{
+    return ProcessFramesBatch(aTiming, aIterations, Crypto::AesBatch::kBackendBitsliced, 1, true);
+}
+
+static uint32_t EncryptBatch4Bitsliced(Timing &aTiming, uint32_t aIterations)
+{
+    return ProcessFramesBatch(aTiming, aIterations, Crypto::AesBatch::kBackendBitsliced, 4, true);
+}
+
+static uint32_t EncryptBatch1(Timing &aTiming, uint32_t aIterations)
+{
+    return ProcessFramesBatch(aTiming, aIterations, Crypto::AesBatch::GetBestBackend(), 1, true);
+}
+
+static uint32_t EncryptBatch4(Timing &aTiming, uint32_t aIterations)
+{
+    return ProcessFramesBatch(aTiming, aIterations, Crypto::AesBatch::GetBestBackend(), 4, true);
+}
+
+static uint32_t DecryptBatch4(Timing &aTiming, uint32_t aIterations)
+{
+    return ProcessFramesBatch(aTiming, aIterations, Crypto::AesBatch::GetBestBackend(), 4, false);
+}
+
+static Case sEncrypt("aes-ccm/encrypt-mac-frame", Encrypt, 50000);
+static Case sDecrypt("aes-ccm/decrypt-mac-frame", Decrypt, 50000);
+
+// the bitsliced implementation is what processors without AES instructions get
+static Case sEncryptBatch1Bitsliced("aes-ccm/encrypt-mac-frame-batch1-bitsliced", EncryptBatch1Bitsliced, 50000);
+static Case sEncryptBatch4Bitsliced("aes-ccm/encrypt-mac-frame-batch4-bitsliced", EncryptBatch4Bitsliced, 50000);
+static Case sEncryptBatch1("aes-ccm/encrypt-mac-frame-batch1", EncryptBatch1, 50000);
+static Case sEncryptBatch4("aes-ccm/encrypt-mac-frame-batch4", EncryptBatch4, 50000);
+static Case sDecryptBatch4("aes-ccm/decrypt-mac-frame-batch4", DecryptBatch4, 50000);
+
+}  // namespace Benchmark
+}  // namespace Thread
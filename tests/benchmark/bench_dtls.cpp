@@ -0,0 +1,224 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <openthread.h>
+#include <common/message.hpp>
+#include <meshcop/dtls.hpp>
+#include <thread/thread_netif.hpp>
+
+#include <mbedtls/memory_buffer_alloc.h>
+
+#include "benchmark.hpp"
+
+namespace Thread {
+namespace Benchmark {
+
+enum
+{
+    kHeapSize = 64 * 1024,  ///< Room for the mbedTLS state of both ends of the session.
+};
+
+static const uint8_t sPskd[] = "J01NME";
+static const uint8_t sClientId[] = {0x12, 0x34, 0x56, 0x78, 0x9a, 0xbc, 0xde, 0xf0};
+
+static unsigned char sHeap[kHeapSize];
+
+static Ip6::Ip6 sClientIp6;
+static Ip6::Ip6 sServerIp6;
+static ThreadNetif sClientNetif(sClientIp6);
+static ThreadNetif sServerNetif(sServerIp6);
+
+static MessageQueue sToClient;
+static MessageQueue sToServer;
+
+static ThreadError Enqueue(MessagePool &aPool, MessageQueue &aQueue, const uint8_t *aBuf, uint16_t aLength)
+{
+    ThreadError error = kThreadError_NoBufs;
+    Message *message = aPool.New(Message::kTypeIp6, 0);
+
+    if (message != NULL && (error = message->Append(aBuf, aLength)) == kThreadError_None)
+    {
+        error = aQueue.Enqueue(*message);
+    }
+
+    if (error != kThreadError_None && message != NULL)
+    {
+        message->Free();
+    }
+
+    return error;
+}
+
+static ThreadError HandleClientSend(void *aContext, const uint8_t *aBuf, uint16_t aLength)
+{
+    (void)aContext;
+    return Enqueue(sServerIp6.mMessagePool, sToServer, aBuf, aLength);
+}
+
+static ThreadError HandleServerSend(void *aContext, const uint8_t *aBuf, uint16_t aLength)
+{
+    (void)aContext;
+    return Enqueue(sClientIp6.mMessagePool, sToClient, aBuf, aLength);
+}
+
+static void HandleReceive(void *aContext, uint8_t *aBuf, uint16_t aLength)
+{
+    (void)aContext;
+    (void)aBuf;
+    (void)aLength;
+}
+
+/**
+ * This function delivers the next datagram of @p aQueue, the way the Commissioner and the Joiner pass relayed
+ * datagrams to their DTLS session.
+ *
+ * @returns TRUE if a datagram was delivered, FALSE if the queue was empty.
+ *
+ */
+static bool Deliver(MessageQueue &aQueue, MeshCoP::Dtls &aDtls, bool aServer)
+{
+    Message *message = aQueue.GetHead();
+
+    if (message != NULL)
+    {
+        aQueue.Dequeue(*message);
+
+        if (aServer)
+        {
+            aDtls.SetClientId(sClientId, sizeof(sClientId));
+        }
+
+        aDtls.Receive(*message, 0, message->GetLength());
+        message->Free();
+    }
+
+    return message != NULL;
+}
+
+static void Flush(MessageQueue &aQueue)
+{
+    Message *message;
+
+    while ((message = aQueue.GetHead()) != NULL)
+    {
+        aQueue.Dequeue(*message);
+        message->Free();
+    }
+}
+
+/**
+ * This function runs a handshake between a Joiner and a Commissioner and closes the session.
+ *
+ * @returns The number of ends that resumed a cached session.
+ *
+ */
+static uint32_t Handshake(void)
+{
+    MeshCoP::Dtls &client = sClientNetif.GetDtls();
+    MeshCoP::Dtls &server = sServerNetif.GetDtls();
+    uint32_t rval;
+
+    server.Start(false, HandleReceive, HandleServerSend, NULL);
+    client.Start(true, HandleReceive, HandleClientSend, NULL);
+
+    while (Deliver(sToServer, server, true) || Deliver(sToClient, client, false))
+    {
+    }
+
+    if (!client.IsConnected() || !server.IsConnected())
+    {
+        fprintf(stderr, "dtls: handshake failed\n");
+        exit(1);
+    }
+
+    rval = static_cast<uint32_t>(client.IsSessionResumed()) + static_cast<uint32_t>(server.IsSessionResumed());
+
+    client.Stop();
+    server.Stop();
+    Flush(sToServer);
+    Flush(sToClient);
+
+    return rval;
+}
+
+static void Prepare(void)
+{
+    mbedtls_memory_buffer_alloc_init(sHeap, sizeof(sHeap));
+
+    sClientNetif.GetDtls().SetPsk(sPskd, sizeof(sPskd) - 1);
+    sServerNetif.GetDtls().SetPsk(sPskd, sizeof(sPskd) - 1);
+    sClientNetif.GetDtls().ClearSessionCache();
+    sServerNetif.GetDtls().ClearSessionCache();
+}
+
+static uint32_t FullHandshake(Timing &aTiming, uint32_t aIterations)
+{
+    uint32_t rval = 0;
+
+    Prepare();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        sClientNetif.GetDtls().ClearSessionCache();
+        sServerNetif.GetDtls().ClearSessionCache();
+
+        aTiming.Start();
+        rval += Handshake();
+        aTiming.Stop();
+    }
+
+    return rval;
+}
+
+static uint32_t ResumedHandshake(Timing &aTiming, uint32_t aIterations)
+{
+    uint32_t rval = 0;
+
+    Prepare();
+    Handshake();
+
+    aTiming.Start();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        rval += Handshake();
+    }
+
+    aTiming.Stop();
+
+    return rval;
+}
+
+static Case sFullHandshake("dtls/handshake-full", FullHandshake, 4);
+static Case sResumedHandshake("dtls/handshake-resumed", ResumedHandshake, 8);
+
+}  // namespace Benchmark
+}  // namespace Thread
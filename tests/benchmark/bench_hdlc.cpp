@@ -0,0 +1,145 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <openthread.h>
+#include <ncp/hdlc.hpp>
+
+#include "benchmark.hpp"
+
+namespace Thread {
+namespace Benchmark {
+
+enum
+{
+    kFrameLength   = 127,
+    kBufferLength  = 2 * kFrameLength + 8,  ///< Room for a frame where every byte is escaped.
+};
+
+/**
+ * This class implements a write iterator over a fixed buffer for the HDLC encoder.
+ *
+ */
+class EncoderBuffer: public Hdlc::Encoder::BufferWriteIterator
+{
+public:
+    EncoderBuffer(void) { Clear(); }
+
+    void Clear(void) { mWritePointer = mBuffer; mRemainingLength = sizeof(mBuffer); }
+
+    const uint8_t *GetBuffer(void) const { return mBuffer; }
+
+    uint16_t GetLength(void) const { return static_cast<uint16_t>(mWritePointer - mBuffer); }
+
+private:
+    uint8_t mBuffer[kBufferLength];
+};
+
+static void PrepareFrame(uint8_t *aFrame)
+{
+    // about one byte in sixteen needs escaping, like spinel frames carrying IPv6 datagrams
+    FillRandom(aFrame, kFrameLength, 0x48444c43);
+
+    for (uint16_t i = 0; i < kFrameLength; i += 16)
+    {
+        aFrame[i] = 0x7e;
+    }
+}
+
+static uint32_t Encode(Timing &aTiming, uint32_t aIterations)
+{
+    Hdlc::Encoder encoder;
+    EncoderBuffer buffer;
+    uint8_t frame[kFrameLength];
+    uint32_t rval = 0;
+
+    PrepareFrame(frame);
+
+    aTiming.Start();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        buffer.Clear();
+        encoder.Init(buffer);
+        encoder.Encode(frame, sizeof(frame), buffer);
+        encoder.Finalize(buffer);
+        rval += buffer.GetLength();
+    }
+
+    aTiming.Stop();
+
+    return rval;
+}
+
+static void HandleFrame(void *aContext, uint8_t *aFrame, uint16_t aFrameLength)
+{
+    *static_cast<uint32_t *>(aContext) += aFrameLength + aFrame[aFrameLength - 1];
+}
+
+static void HandleError(void *aContext, ThreadError aError, uint8_t *aFrame, uint16_t aFrameLength)
+{
+    (void)aContext;
+    (void)aFrame;
+    (void)aFrameLength;
+    fprintf(stderr, "hdlc: decode error %d\n", aError);
+    exit(1);
+}
+
+static uint32_t Decode(Timing &aTiming, uint32_t aIterations)
+{
+    uint8_t frame[kFrameLength];
+    uint8_t decoded[kFrameLength + 2];
+    Hdlc::Encoder encoder;
+    EncoderBuffer buffer;
+    uint32_t rval = 0;
+    Hdlc::Decoder decoder(decoded, sizeof(decoded), HandleFrame, HandleError, &rval);
+
+    PrepareFrame(frame);
+    encoder.Init(buffer);
+    encoder.Encode(frame, sizeof(frame), buffer);
+    encoder.Finalize(buffer);
+
+    aTiming.Start();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        decoder.Decode(buffer.GetBuffer(), buffer.GetLength());
+    }
+
+    aTiming.Stop();
+
+    return rval;
+}
+
+static Case sEncode("hdlc/encode-127", Encode, 200000);
+static Case sDecode("hdlc/decode-127", Decode, 200000);
+
+}  // namespace Benchmark
+}  // namespace Thread
@@ -0,0 +1,122 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <openthread.h>
+#include <common/message.hpp>
+#include <net/ip6.hpp>
+
+#include "benchmark.hpp"
+
+namespace Thread {
+namespace Benchmark {
+
+enum
+{
+    kPayloadLength = 1280,
+};
+
+static uint32_t ChecksumBuffer(Timing &aTiming, uint32_t aIterations)
+{
+    uint8_t buf[kPayloadLength];
+    uint32_t rval = 0;
+
+    FillRandom(buf, sizeof(buf), 0x43686b73);
+
+    aTiming.Start();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        buf[0] = static_cast<uint8_t>(i);
+        rval += Ip6::Ip6::UpdateChecksum(0, buf, sizeof(buf));
+    }
+
+    aTiming.Stop();
+
+    return rval;
+}
+
+static uint32_t ChecksumMessage(Timing &aTiming, uint32_t aIterations)
+{
+    static MessagePool sMessagePool;
+    uint8_t buf[kPayloadLength];
+    Message *message = sMessagePool.New(Message::kTypeIp6, 0);
+    uint32_t rval = 0;
+
+    if (message == NULL || message->SetLength(sizeof(buf)) != kThreadError_None)
+    {
+        fprintf(stderr, "ip6: out of buffers\n");
+        exit(1);
+    }
+
+    FillRandom(buf, sizeof(buf), 0x43686b73);
+    message->Write(0, sizeof(buf), buf);
+
+    aTiming.Start();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        rval += message->UpdateChecksum(static_cast<uint16_t>(i), 0, sizeof(buf));
+    }
+
+    aTiming.Stop();
+
+    message->Free();
+
+    return rval;
+}
+
+static uint32_t ChecksumPseudoheader(Timing &aTiming, uint32_t aIterations)
+{
+    Ip6::Address source;
+    Ip6::Address destination;
+    uint32_t rval = 0;
+
+    FillRandom(source.mFields.m8, sizeof(source), 0x53726320);
+    FillRandom(destination.mFields.m8, sizeof(destination), 0x44737420);
+
+    aTiming.Start();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        rval += Ip6::Ip6::ComputePseudoheaderChecksum(source, destination, static_cast<uint16_t>(i), Ip6::kProtoUdp);
+    }
+
+    aTiming.Stop();
+
+    return rval;
+}
+
+static Case sChecksumBuffer("ip6/checksum-buffer-1280", ChecksumBuffer, 20000);
+static Case sChecksumMessage("ip6/checksum-message-1280", ChecksumMessage, 20000);
+static Case sChecksumPseudoheader("ip6/checksum-pseudoheader", ChecksumPseudoheader, 1000000);
+
+}  // namespace Benchmark
+}  // namespace Thread
@@ -0,0 +1,153 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <openthread.h>
+#include <mac/mac_frame.hpp>
+#include <thread/lowpan.hpp>
+#include <thread/thread_netif.hpp>
+
+#include "benchmark.hpp"
+
+namespace Thread {
+namespace Benchmark {
+
+// LL64 unicast ICMP ping request, the first vector of the lowpan unit test.
+static const uint8_t sFrame[] =
+{
+    0x61, 0xcc, 0x1d, 0xce, 0xfa, 0x03, 0x00, 0x00, 0x00, 0x00, 0x0a, 0x6e, 0x14, 0x01, 0x00, 0x00,
+    0x00, 0x00, 0x0a, 0x6e, 0x14, 0x7a, 0x33, 0x3a, 0x80, 0x00, 0x30, 0xbe, 0x00, 0x00, 0x00, 0x00,
+    0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x48, 0xff,
+};
+
+static Ip6::Ip6 sIp6;
+static ThreadNetif sThreadNetif(sIp6);
+static Lowpan::Lowpan sLowpan(sThreadNetif);
+
+/**
+ * This structure holds the parsed test frame and its decompressed IPv6 datagram.
+ *
+ */
+struct Datagram
+{
+    uint8_t       mPsdu[sizeof(sFrame)];
+    Mac::Frame    mFrame;
+    Mac::Address  mMacSource;
+    Mac::Address  mMacDest;
+    Message      *mMessage;
+};
+
+static void PrepareDatagram(Datagram &aDatagram)
+{
+    int headerLength;
+
+    memcpy(aDatagram.mPsdu, sFrame, sizeof(sFrame));
+    aDatagram.mFrame.mPsdu = aDatagram.mPsdu;
+    aDatagram.mFrame.mLength = sizeof(sFrame);
+    aDatagram.mMessage = sIp6.mMessagePool.New(Message::kTypeIp6, 0);
+
+    if (aDatagram.mMessage == NULL || aDatagram.mFrame.ParseHeader() != kThreadError_None)
+    {
+        fprintf(stderr, "lowpan: cannot prepare the datagram\n");
+        exit(1);
+    }
+
+    aDatagram.mFrame.GetSrcAddr(aDatagram.mMacSource);
+    aDatagram.mFrame.GetDstAddr(aDatagram.mMacDest);
+
+    headerLength = sLowpan.Decompress(*aDatagram.mMessage, aDatagram.mMacSource, aDatagram.mMacDest,
+                                      aDatagram.mFrame.GetPayload(), aDatagram.mFrame.GetPayloadLength(), 0);
+
+    if (headerLength < 0 ||
+        aDatagram.mMessage->Append(aDatagram.mFrame.GetPayload() + headerLength,
+                                   aDatagram.mFrame.GetPayloadLength() - static_cast<uint16_t>(headerLength)) !=
+        kThreadError_None)
+    {
+        fprintf(stderr, "lowpan: cannot decompress the datagram\n");
+        exit(1);
+    }
+}
+
+static uint32_t Compress(Timing &aTiming, uint32_t aIterations)
+{
+    Datagram datagram;
+    uint8_t buf[Mac::Frame::kMTU];
+    uint32_t rval = 0;
+
+    PrepareDatagram(datagram);
+
+    aTiming.Start();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        datagram.mMessage->SetOffset(0);
+        rval += static_cast<uint32_t>(sLowpan.Compress(*datagram.mMessage, datagram.mMacSource, datagram.mMacDest,
+                                                       buf));
+        rval += buf[1];
+    }
+
+    aTiming.Stop();
+
+    datagram.mMessage->Free();
+
+    return rval;
+}
+
+static uint32_t Decompress(Timing &aTiming, uint32_t aIterations)
+{
+    Datagram datagram;
+    uint32_t rval = 0;
+
+    PrepareDatagram(datagram);
+
+    aTiming.Start();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        datagram.mMessage->SetLength(0);
+        datagram.mMessage->SetOffset(0);
+        rval += static_cast<uint32_t>(sLowpan.Decompress(*datagram.mMessage, datagram.mMacSource, datagram.mMacDest,
+                                                         datagram.mFrame.GetPayload(),
+                                                         datagram.mFrame.GetPayloadLength(), 0));
+    }
+
+    aTiming.Stop();
+
+    datagram.mMessage->Free();
+
+    return rval;
+}
+
+static Case sCompress("lowpan/compress-ll64", Compress, 200000);
+static Case sDecompress("lowpan/decompress-ll64", Decompress, 200000);
+
+}  // namespace Benchmark
+}  // namespace Thread
@@ -0,0 +1,139 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <openthread.h>
+#include <common/message.hpp>
+
+#include "benchmark.hpp"
+
+namespace Thread {
+namespace Benchmark {
+
+enum
+{
+    kMessageLength = 1024,
+    kChunkLength   = 16,
+};
+
+static MessagePool sMessagePool;
+
+static Message *NewMessage(void)
+{
+    uint8_t buf[kMessageLength];
+    Message *message = sMessagePool.New(Message::kTypeIp6, 0);
+
+    if (message == NULL || message->SetLength(kMessageLength) != kThreadError_None)
+    {
+        fprintf(stderr, "message: out of buffers\n");
+        exit(1);
+    }
+
+    FillRandom(buf, sizeof(buf), 0x4d657373);
+    message->Write(0, sizeof(buf), buf);
+
+    return message;
+}
+
+static uint32_t WriteMessage(Timing &aTiming, uint32_t aIterations)
+{
+    uint8_t buf[kMessageLength];
+    Message *message = NewMessage();
+    uint32_t rval = 0;
+
+    FillRandom(buf, sizeof(buf), 1);
+
+    aTiming.Start();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        buf[0] = static_cast<uint8_t>(i);
+        rval += message->Write(0, sizeof(buf), buf);
+    }
+
+    aTiming.Stop();
+
+    message->Free();
+
+    return rval;
+}
+
+static uint32_t ReadMessage(Timing &aTiming, uint32_t aIterations)
+{
+    uint8_t buf[kMessageLength];
+    Message *message = NewMessage();
+    uint32_t rval = 0;
+
+    aTiming.Start();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        rval += message->Read(0, sizeof(buf), buf);
+        rval += buf[i % sizeof(buf)];
+    }
+
+    aTiming.Stop();
+
+    message->Free();
+
+    return rval;
+}
+
+static uint32_t ReadMessageChunks(Timing &aTiming, uint32_t aIterations)
+{
+    uint8_t buf[kChunkLength];
+    Message *message = NewMessage();
+    uint32_t state = 0x52656164;
+    uint32_t rval = 0;
+
+    aTiming.Start();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        // header fields are read at arbitrary offsets, often across buffer boundaries
+        uint16_t offset = static_cast<uint16_t>(GetRandom(state) % (kMessageLength - kChunkLength));
+
+        rval += message->Read(offset, sizeof(buf), buf);
+        rval += buf[0];
+    }
+
+    aTiming.Stop();
+
+    message->Free();
+
+    return rval;
+}
+
+static Case sWriteMessage("message/write-1024", WriteMessage, 20000);
+static Case sReadMessage("message/read-1024", ReadMessage, 20000);
+static Case sReadMessageChunks("message/read-16", ReadMessageChunks, 200000);
+
+}  // namespace Benchmark
+}  // namespace Thread
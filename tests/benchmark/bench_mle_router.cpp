@@ -0,0 +1,189 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <openthread.h>
+#include <thread/mle_router.hpp>
+#include <thread/thread_netif.hpp>
+
+#include "benchmark.hpp"
+
+namespace Thread {
+namespace Benchmark {
+
+enum
+{
+    kNumMeshRouters = Mle::kMaxRouters,  ///< A full mesh, including the device under test.
+    kNumNeighbors   = 6,
+    kNumVariants    = 2,                 ///< Advertisements alternate between two sets of route costs.
+};
+
+static Ip6::Ip6 sIp6;
+static ThreadNetif sThreadNetif(sIp6);
+
+// mesh node 0 is the device under test, neighbors are the nodes 1 to kNumNeighbors
+static uint8_t sRouterId[kNumMeshRouters];
+static Mle::RouteTlv sRouteTlv[kNumVariants][kNumNeighbors + 1];
+
+static void StartLeader(Mle::MleRouter &aMle)
+{
+    uint8_t routerId = 0;
+
+    if (aMle.GetDeviceState() != Mle::kDeviceStateLeader &&
+        (sThreadNetif.Up() != kThreadError_None || aMle.Start() != kThreadError_None ||
+         aMle.BecomeLeader() != kThreadError_None))
+    {
+        fprintf(stderr, "mle-router: cannot become leader\n");
+        exit(1);
+    }
+
+    // the nodes are numbered from the leader, so that the work does not depend on the Router ID it was assigned
+    sRouterId[0] = Mle::Mle::GetRouterId(aMle.GetRloc16());
+
+    for (uint8_t node = 1; node < kNumMeshRouters; node++, routerId++)
+    {
+        if (routerId == sRouterId[0])
+        {
+            routerId++;
+        }
+
+        sRouterId[node] = routerId;
+    }
+}
+
+static void FillRouteTlv(Mle::RouteTlv &aTlv, uint8_t aNeighbor, uint32_t &aState)
+{
+    uint8_t cost[kNumMeshRouters];
+    uint8_t routeCount = 0;
+
+    // the costs are drawn in the order of the nodes, so that they do not depend on the Router ID of the leader
+    for (uint8_t node = 0; node < kNumMeshRouters; node++)
+    {
+        cost[node] = static_cast<uint8_t>(GetRandom(aState) % (Mle::kMaxRouteCost - 1) + 1);
+    }
+
+    cost[aNeighbor] = 0;
+
+    aTlv.Init();
+    aTlv.SetRouterIdSequence(0);
+    aTlv.ClearRouterIdMask();
+
+    for (uint8_t routerId = 0; routerId <= Mle::kMaxRouterId; routerId++)
+    {
+        uint8_t node = 0;
+
+        while (node < kNumMeshRouters && sRouterId[node] != routerId)
+        {
+            node++;
+        }
+
+        if (node == kNumMeshRouters)
+        {
+            continue;
+        }
+
+        aTlv.SetRouterId(routerId);
+        aTlv.SetLinkQualityIn(routeCount, (node == 0) ? 3 : 0);
+        aTlv.SetLinkQualityOut(routeCount, (node == 0) ? 3 : 0);
+        aTlv.SetRouteCost(routeCount, cost[node]);
+        routeCount++;
+    }
+
+    aTlv.SetRouteDataLength(routeCount);
+}
+
+static void BuildMesh(Mle::MleRouter &aMle)
+{
+    Router *routers = aMle.GetRouters(NULL);
+    LinkQualityInfo &noiseFloor = sThreadNetif.GetMac().GetNoiseFloor();
+    uint32_t state = 0x4d6c6552;
+
+    StartLeader(aMle);
+
+    for (uint8_t node = 1; node < kNumMeshRouters; node++)
+    {
+        Router &router = routers[sRouterId[node]];
+
+        memset(&router, 0, sizeof(router));
+        router.mAllocated = true;
+        router.mNextHop = Mle::kInvalidRouterId;
+        router.mAltNextHop = Mle::kInvalidRouterId;
+
+        if (node <= kNumNeighbors)
+        {
+            router.mState = Neighbor::kStateValid;
+            router.mValid.mRloc16 = Mle::Mle::GetRloc16(sRouterId[node]);
+            router.mLinkInfo.AddRss(noiseFloor, -30);
+        }
+    }
+
+    for (uint8_t variant = 0; variant < kNumVariants; variant++)
+    {
+        for (uint8_t node = 1; node <= kNumNeighbors; node++)
+        {
+            FillRouteTlv(sRouteTlv[variant][node], node, state);
+        }
+    }
+}
+
+// a friend of MleRouter, the neighbors take turns to advertise and the route costs change every round
+uint32_t UpdateMleRoutes(Timing &aTiming, uint32_t aIterations)
+{
+    Mle::MleRouter &mle = sThreadNetif.GetMle();
+    Router *routers = mle.GetRouters(NULL);
+    uint32_t rval = 0;
+
+    BuildMesh(mle);
+
+    aTiming.Start();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        uint8_t node = static_cast<uint8_t>(i % kNumNeighbors + 1);
+        uint8_t variant = static_cast<uint8_t>((i / kNumNeighbors) % kNumVariants);
+
+        mle.UpdateRoutes(sRouteTlv[variant][node], sRouterId[node]);
+    }
+
+    aTiming.Stop();
+
+    for (uint8_t node = 1; node < kNumMeshRouters; node++)
+    {
+        rval += routers[sRouterId[node]].mCost;
+    }
+
+    return rval;
+}
+
+static Case sUpdateMleRoutes("mle-router/update-routes-32", UpdateMleRoutes, 2000);
+
+}  // namespace Benchmark
+}  // namespace Thread
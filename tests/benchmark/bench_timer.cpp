@@ -0,0 +1,91 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <openthread.h>
+#include <common/timer.hpp>
+#include <net/ip6.hpp>
+
+#include "benchmark.hpp"
+
+extern uint32_t sNow;
+
+namespace Thread {
+namespace Benchmark {
+
+enum
+{
+    kPendingTimers = 32,  ///< Roughly the number of timers running on a busy router.
+};
+
+static Ip6::Ip6 sIp6;
+
+static void HandleTimer(void *aContext)
+{
+    (void)aContext;
+}
+
+static uint32_t StartStop(Timing &aTiming, uint32_t aIterations)
+{
+    Timer *pending[kPendingTimers];
+    Timer timer(sIp6.mTimerScheduler, HandleTimer, NULL);
+    uint32_t state = 0x54696d72;
+    uint32_t rval = 0;
+
+    sNow = 1000;
+
+    for (unsigned i = 0; i < kPendingTimers; i++)
+    {
+        pending[i] = new Timer(sIp6.mTimerScheduler, HandleTimer, NULL);
+        pending[i]->Start(GetRandom(state) % 100000);
+    }
+
+    aTiming.Start();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        // the new timer lands anywhere in the list of pending timers
+        timer.Start(GetRandom(state) % 100000);
+        rval += timer.IsRunning();
+        timer.Stop();
+    }
+
+    aTiming.Stop();
+
+    for (unsigned i = 0; i < kPendingTimers; i++)
+    {
+        pending[i]->Stop();
+        delete pending[i];
+    }
+
+    return rval;
+}
+
+static Case sStartStop("timer/start-stop-32", StartStop, 500000);
+
+}  // namespace Benchmark
+}  // namespace Thread
@@ -0,0 +1,141 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <openthread.h>
+#include <common/code_utils.hpp>
+#include <common/message.hpp>
+#include <thread/mle_tlvs.hpp>
+
+#include "benchmark.hpp"
+
+namespace Thread {
+namespace Benchmark {
+
+/**
+ * The TLVs of an MLE Parent Response, in the order Mle::SendParentResponse() appends them.
+ *
+ */
+static const struct
+{
+    Mle::Tlv::Type mType;
+    uint8_t        mLength;
+} sParentResponseTlvs[] =
+{
+    { Mle::Tlv::kSourceAddress,    2 },
+    { Mle::Tlv::kLeaderData,       8 },
+    { Mle::Tlv::kLinkFrameCounter, 4 },
+    { Mle::Tlv::kMleFrameCounter,  4 },
+    { Mle::Tlv::kResponse,         8 },
+    { Mle::Tlv::kChallenge,        8 },
+    { Mle::Tlv::kLinkMargin,       1 },
+    { Mle::Tlv::kConnectivity,     7 },
+    { Mle::Tlv::kVersion,          2 },
+};
+
+enum
+{
+    kMleHeaderLength = 11,  ///< The security header and command of an MLE message, which precede the TLVs.
+};
+
+static Message *NewParentResponse(void)
+{
+    static MessagePool sMessagePool;
+    Message *message = sMessagePool.New(Message::kTypeIp6, 0);
+    uint8_t value[kMleHeaderLength];
+    Mle::Tlv tlv;
+    ThreadError error = kThreadError_NoBufs;
+
+    VerifyOrExit(message != NULL, ;);
+
+    FillRandom(value, sizeof(value), 0x544c5620);
+    SuccessOrExit(error = message->Append(value, kMleHeaderLength));
+
+    for (unsigned i = 0; i < sizeof(sParentResponseTlvs) / sizeof(sParentResponseTlvs[0]); i++)
+    {
+        tlv.SetType(sParentResponseTlvs[i].mType);
+        tlv.SetLength(sParentResponseTlvs[i].mLength);
+        SuccessOrExit(error = message->Append(&tlv, sizeof(tlv)));
+        SuccessOrExit(error = message->Append(value, sParentResponseTlvs[i].mLength));
+    }
+
+    message->SetOffset(kMleHeaderLength);
+
+exit:
+
+    if (error != kThreadError_None)
+    {
+        fprintf(stderr, "tlv: out of buffers\n");
+        exit(1);
+    }
+
+    return message;
+}
+
+static uint32_t GetTlv(Timing &aTiming, uint32_t aIterations, Mle::Tlv::Type aType)
+{
+    Message *message = NewParentResponse();
+    uint32_t rval = 0;
+    struct
+    {
+        Mle::Tlv mTlv;
+        uint8_t  mValue[8];
+    } tlv;
+
+    aTiming.Start();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        rval += static_cast<uint32_t>(Mle::Tlv::GetTlv(*message, aType, sizeof(tlv), tlv.mTlv));
+        rval += tlv.mTlv.GetLength();
+    }
+
+    aTiming.Stop();
+
+    message->Free();
+
+    return rval;
+}
+
+static uint32_t GetFirstTlv(Timing &aTiming, uint32_t aIterations)
+{
+    return GetTlv(aTiming, aIterations, Mle::Tlv::kSourceAddress);
+}
+
+static uint32_t GetLastTlv(Timing &aTiming, uint32_t aIterations)
+{
+    return GetTlv(aTiming, aIterations, Mle::Tlv::kVersion);
+}
+
+static Case sGetFirstTlv("tlv/mle-get-first", GetFirstTlv, 500000);
+static Case sGetLastTlv("tlv/mle-get-last", GetLastTlv, 200000);
+
+}  // namespace Benchmark
+}  // namespace Thread
@@ -0,0 +1,211 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the microbenchmark harness and the main function of the benchmark program.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <common/code_utils.hpp>
+
+#include "benchmark.hpp"
+
+namespace Thread {
+namespace Benchmark {
+
+enum
+{
+    kRepetitions = 11,  ///< Number of measured runs of each benchmark, after one warm-up run.
+};
+
+Case *Case::sHead = NULL;
+
+void Timing::Start(void)
+{
+    mStart = GetNow();
+}
+
+void Timing::Stop(void)
+{
+    mElapsed += GetNow() - mStart;
+}
+
+uint64_t Timing::GetNow(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ull + static_cast<uint64_t>(now.tv_nsec);
+}
+
+Case::Case(const char *aName, Handler aHandler, uint32_t aIterations):
+    mName(aName),
+    mHandler(aHandler),
+    mIterations(aIterations),
+    mNext(NULL)
+{
+    Case **link = &sHead;
+
+    while (*link != NULL && strcmp((*link)->mName, aName) < 0)
+    {
+        link = &(*link)->mNext;
+    }
+
+    mNext = *link;
+    *link = this;
+}
+
+uint64_t Case::Run(uint32_t &aResult) const
+{
+    Timing timing;
+
+    aResult = mHandler(timing, mIterations);
+
+    return timing.GetElapsed();
+}
+
+uint32_t GetRandom(uint32_t &aState)
+{
+    // xorshift32
+    aState ^= aState << 13;
+    aState ^= aState >> 17;
+    aState ^= aState << 5;
+
+    return aState;
+}
+
+void FillRandom(uint8_t *aBuf, uint16_t aLength, uint32_t aSeed)
+{
+    uint32_t state = aSeed;
+
+    for (uint16_t i = 0; i < aLength; i++)
+    {
+        aBuf[i] = static_cast<uint8_t>(GetRandom(state));
+    }
+}
+
+static int CompareSamples(const void *aA, const void *aB)
+{
+    uint64_t a = *static_cast<const uint64_t *>(aA);
+    uint64_t b = *static_cast<const uint64_t *>(aB);
+
+    return (a < b) ? -1 : ((a > b) ? 1 : 0);
+}
+
+static bool IsSelected(const Case &aCase, int aArgCount, char *aArgVector[])
+{
+    bool rval = (aArgCount <= 1);
+
+    for (int i = 1; i < aArgCount && !rval; i++)
+    {
+        rval = (strncmp(aCase.GetName(), aArgVector[i], strlen(aArgVector[i])) == 0);
+    }
+
+    return rval;
+}
+
+/**
+ * This function runs one benchmark and prints its results as a JSON object.
+ *
+ * @retval true   The benchmark computed the same result in every run.
+ * @retval false  The result changed between runs, so the benchmark is not deterministic.
+ *
+ */
+static bool RunCase(const Case &aCase, bool aFirst)
+{
+    uint64_t samples[kRepetitions];
+    uint32_t expected;
+    uint32_t result;
+    bool deterministic = true;
+    double iterations = static_cast<double>(aCase.GetIterations());
+
+    fprintf(stderr, "%s\n", aCase.GetName());
+
+    aCase.Run(expected);
+
+    for (unsigned i = 0; i < kRepetitions; i++)
+    {
+        samples[i] = aCase.Run(result);
+        deterministic = deterministic && (result == expected);
+    }
+
+    qsort(samples, kRepetitions, sizeof(samples[0]), CompareSamples);
+
+    printf("%s\n    {\"name\": \"%s\", \"iterations\": %u, \"min_ns\": %.2f, \"median_ns\": %.2f, \"max_ns\": %.2f, "
+           "\"checksum\": %u}", aFirst ? "" : ",", aCase.GetName(), aCase.GetIterations(),
+           static_cast<double>(samples[0]) / iterations,
+           static_cast<double>(samples[kRepetitions / 2]) / iterations,
+           static_cast<double>(samples[kRepetitions - 1]) / iterations,
+           expected);
+
+    if (!deterministic)
+    {
+        fprintf(stderr, "%s: result changed between runs\n", aCase.GetName());
+    }
+
+    return deterministic;
+}
+
+}  // namespace Benchmark
+}  // namespace Thread
+
+/**
+ * The benchmark program runs every benchmark, or those whose names start with one of the arguments, and prints the
+ * time per iteration as JSON on the standard output.
+ *
+ */
+int main(int argc, char *argv[])
+{
+    int rval = 0;
+    bool first = true;
+
+    printf("{\n  \"repetitions\": %u,\n  \"benchmarks\": [", Thread::Benchmark::kRepetitions);
+
+    for (const Thread::Benchmark::Case *cur = Thread::Benchmark::Case::GetHead(); cur != NULL; cur = cur->GetNext())
+    {
+        if (Thread::Benchmark::IsSelected(*cur, argc, argv))
+        {
+            if (!Thread::Benchmark::RunCase(*cur, first))
+            {
+                rval = 1;
+            }
+
+            first = false;
+        }
+    }
+
+    printf("\n  ]\n}\n");
+
+    return rval;
+}
@@ -0,0 +1,192 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the microbenchmark harness.
+ */
+
+#ifndef BENCHMARK_HPP_
+#define BENCHMARK_HPP_
+
+#include <stdint.h>
+
+namespace Thread {
+namespace Benchmark {
+
+/**
+ * This class measures the time spent in the timed section of a benchmark.
+ *
+ */
+class Timing
+{
+public:
+    /**
+     * This constructor initializes the object.
+     *
+     */
+    Timing(void): mStart(0), mElapsed(0) {}
+
+    /**
+     * This method starts timing, after the benchmark has prepared its inputs.
+     *
+     */
+    void Start(void);
+
+    /**
+     * This method stops timing, before the benchmark releases its inputs.
+     *
+     */
+    void Stop(void);
+
+    /**
+     * This method returns the time between the calls to Start() and Stop().
+     *
+     * @returns The elapsed time in nanoseconds.
+     *
+     */
+    uint64_t GetElapsed(void) const { return mElapsed; }
+
+    /**
+     * This static method returns a monotonic time stamp.
+     *
+     * @returns The time stamp in nanoseconds.
+     *
+     */
+    static uint64_t GetNow(void);
+
+private:
+    uint64_t mStart;
+    uint64_t mElapsed;
+};
+
+/**
+ * This class represents a microbenchmark.
+ *
+ * Benchmarks register themselves when they are constructed, so a benchmark source file only has to be linked into the
+ * benchmark program to be run.  Benchmarks are run in the order of their names.
+ *
+ */
+class Case
+{
+public:
+    /**
+     * This function pointer is called to run a benchmark.
+     *
+     * The function prepares its inputs, calls Timing::Start(), runs @p aIterations iterations of the measured operation
+     * and calls Timing::Stop().  All inputs must be derived from fixed values so that runs are repeatable.
+     *
+     * @param[in]  aTiming      A reference to the timing of this run.
+     * @param[in]  aIterations  The number of iterations to run.
+     *
+     * @returns A value computed from the results, which keeps the compiler from optimizing the work away.
+     *
+     */
+    typedef uint32_t (*Handler)(Timing &aTiming, uint32_t aIterations);
+
+    /**
+     * This constructor registers a benchmark.
+     *
+     * @param[in]  aName        The name of the benchmark, as "<module>/<operation>".
+     * @param[in]  aHandler     The function running the benchmark.
+     * @param[in]  aIterations  The number of iterations of one run, chosen so that a run takes a few milliseconds.
+     *
+     */
+    Case(const char *aName, Handler aHandler, uint32_t aIterations);
+
+    /**
+     * This method returns the name of the benchmark.
+     *
+     */
+    const char *GetName(void) const { return mName; }
+
+    /**
+     * This method returns the number of iterations of one run.
+     *
+     */
+    uint32_t GetIterations(void) const { return mIterations; }
+
+    /**
+     * This method runs the benchmark once.
+     *
+     * @param[out]  aResult  A value computed from the results.
+     *
+     * @returns The time spent in the timed section, in nanoseconds.
+     *
+     */
+    uint64_t Run(uint32_t &aResult) const;
+
+    /**
+     * This method returns the next benchmark, in the order of their names.
+     *
+     * @returns A pointer to the next benchmark or NULL if this is the last one.
+     *
+     */
+    const Case *GetNext(void) const { return mNext; }
+
+    /**
+     * This static method returns the first benchmark, in the order of their names.
+     *
+     * @returns A pointer to the first benchmark or NULL if there is none.
+     *
+     */
+    static const Case *GetHead(void) { return sHead; }
+
+private:
+    const char *mName;
+    Handler     mHandler;
+    uint32_t    mIterations;
+    Case       *mNext;
+
+    static Case *sHead;
+};
+
+/**
+ * This function returns a pseudo-random number from a fixed sequence.
+ *
+ * @param[inout]  aState  The state of the sequence, which the caller seeds with a fixed value.
+ *
+ * @returns The next number of the sequence.
+ *
+ */
+uint32_t GetRandom(uint32_t &aState);
+
+/**
+ * This function fills a buffer with bytes from a fixed pseudo-random sequence.
+ *
+ * @param[out]  aBuf     A pointer to the buffer.
+ * @param[in]   aLength  The length of the buffer.
+ * @param[in]   aSeed    The seed of the sequence.
+ *
+ */
+void FillRandom(uint8_t *aBuf, uint16_t aLength, uint32_t aSeed);
+
+}  // namespace Benchmark
+}  // namespace Thread
+
+#endif  // BENCHMARK_HPP_
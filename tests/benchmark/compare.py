@@ -0,0 +1,96 @@
+#!/usr/bin/python
+#
+#  Copyright (c) 2016, The OpenThread Authors.
+#  All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are met:
+#  1. Redistributions of source code must retain the above copyright
+#     notice, this list of conditions and the following disclaimer.
+#  2. Redistributions in binary form must reproduce the above copyright
+#     notice, this list of conditions and the following disclaimer in the
+#     documentation and/or other materials provided with the distribution.
+#  3. Neither the name of the copyright holder nor the
+#     names of its contributors may be used to endorse or promote products
+#     derived from this software without specific prior written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+#  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+#  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+#  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+#  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+#  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+#  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+#  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+#  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+#  POSSIBILITY OF SUCH DAMAGE.
+#
+""" Compare two result files of the OpenThread microbenchmarks. """
+
+import json
+import optparse
+import sys
+
+
+def load_results(path):
+    """ Return the benchmarks of a result file, by name. """
+    with open(path) as result_file:
+        return dict((benchmark["name"], benchmark) for benchmark in json.load(result_file)["benchmarks"])
+
+
+def compare(baseline, current, metric, threshold):
+    """ Return the report lines and the names of the benchmarks that became slower than the threshold. """
+    lines = ["%-32s %12s %12s %8s" % ("benchmark", "baseline ns", "current ns", "change")]
+    regressions = []
+
+    for name in sorted(set(baseline) | set(current)):
+        if name not in baseline or name not in current:
+            lines.append("%-32s %s" % (name, "only in baseline" if name in baseline else "only in current"))
+            continue
+
+        before = baseline[name][metric]
+        after = current[name][metric]
+        change = (after - before) / before if before else 0.0
+        note = ""
+
+        if change > threshold:
+            regressions.append(name)
+            note = " slower"
+
+        if baseline[name].get("checksum") != current[name].get("checksum"):
+            note += " (checksum changed, the benchmark or the code computes something else)"
+
+        lines.append("%-32s %12.2f %12.2f %+7.1f%%%s" % (name, before, after, 100.0 * change, note))
+
+    return lines, regressions
+
+
+def main():
+    """ Compare the times of two result files and fail if any benchmark got slower than the threshold. """
+    opt_parser = optparse.OptionParser(usage="%prog [-m METRIC] [-t PERCENT] BASELINE CURRENT")
+    opt_parser.add_option("-m", "--metric", dest="metric", default="min_ns",
+                          choices=["min_ns", "median_ns", "max_ns"],
+                          help="Time to compare, min_ns by default as it is the least affected by other load")
+    opt_parser.add_option("-t", "--threshold", type="float", dest="threshold", default=10.0,
+                          help="Largest slowdown in percent that is not reported as a regression, 10 by default")
+
+    (options, args) = opt_parser.parse_args()
+
+    if len(args) != 2:
+        opt_parser.error("expected a baseline and a current result file")
+
+    lines, regressions = compare(load_results(args[0]), load_results(args[1]), options.metric,
+                                  options.threshold / 100.0)
+
+    for line in lines:
+        print(line)
+
+    if regressions:
+        print("%d benchmark(s) slower by more than %.1f%%: %s" %
+              (len(regressions), options.threshold, ", ".join(regressions)))
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,94 @@
+#!/usr/bin/python
+#
+#  Copyright (c) 2016, The OpenThread Authors.
+#  All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are met:
+#  1. Redistributions of source code must retain the above copyright
+#     notice, this list of conditions and the following disclaimer.
+#  2. Redistributions in binary form must reproduce the above copyright
+#     notice, this list of conditions and the following disclaimer in the
+#     documentation and/or other materials provided with the distribution.
+#  3. Neither the name of the copyright holder nor the
+#     names of its contributors may be used to endorse or promote products
+#     derived from this software without specific prior written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+#  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+#  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+#  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+#  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+#  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+#  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+#  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+#  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+#  POSSIBILITY OF SUCH DAMAGE.
+
+import time
+import unittest
+
+import node
+
+LEADER = 1
+SED = 2
+
+CSL_PERIOD = 500       # milliseconds
+POLL_PERIOD = 60       # seconds, longer than the test so that data polls cannot deliver the pings
+CHILD_TIMEOUT = 20     # seconds, the sampling child resynchronizes its schedule every CHILD_TIMEOUT / 4
+
+class Test_Csl(unittest.TestCase):
+    def setUp(self):
+        self.nodes = {}
+        for i in range(1,3):
+            self.nodes[i] = node.Node(i)
+
+        self.nodes[LEADER].set_panid(0xface)
+        self.nodes[LEADER].set_mode('rsdn')
+        self.nodes[LEADER].add_whitelist(self.nodes[SED].get_addr64())
+        self.nodes[LEADER].enable_whitelist()
+
+        self.nodes[SED].set_panid(0xface)
+        self.nodes[SED].set_mode('s')
+        self.nodes[SED].set_timeout(CHILD_TIMEOUT)
+        self.nodes[SED].set_pollperiod(POLL_PERIOD)
+        self.nodes[SED].set_cslperiod(CSL_PERIOD)
+        self.nodes[SED].add_whitelist(self.nodes[LEADER].get_addr64())
+        self.nodes[SED].enable_whitelist()
+
+    def tearDown(self):
+        for node in list(self.nodes.values()):
+            node.stop()
+        del self.nodes
+
+    def ping_time(self, addr):
+        start = time.time()
+        self.assertTrue(self.nodes[LEADER].ping(addr))
+        return time.time() - start
+
+    def test(self):
+        self.nodes[LEADER].start()
+        self.nodes[LEADER].set_state('leader')
+        self.assertEqual(self.nodes[LEADER].get_state(), 'leader')
+
+        self.nodes[SED].start()
+        time.sleep(5)
+        self.assertEqual(self.nodes[SED].get_state(), 'child')
+
+        addrs = [addr for addr in self.nodes[SED].get_addrs() if addr[0:4] != 'fe80']
+
+        # the parent reaches the sampling child within about one CSL period, across several resynchronizations
+        for i in range(8):
+            time.sleep(3)
+            for addr in addrs:
+                self.assertLess(self.ping_time(addr), 2.0 * CSL_PERIOD / 1000)
+
+        # without sampling, the child only receives after its next data poll
+        self.nodes[SED].set_cslperiod(0)
+        time.sleep(5)
+        for addr in addrs:
+            self.assertFalse(self.nodes[LEADER].ping(addr))
+
+if __name__ == '__main__':
+    unittest.main()
@@ -345,6 +345,16 @@ class Node:
         self.send_command(cmd)
         self.pexpect.expect('Done')
 
+    def set_pollperiod(self, pollperiod):
+        cmd = 'pollperiod %d' % pollperiod
+        self.send_command(cmd)
+        self.pexpect.expect('Done')
+
+    def set_cslperiod(self, cslperiod):
+        cmd = 'cslperiod %d' % cslperiod
+        self.send_command(cmd)
+        self.pexpect.expect('Done')
+
     def set_max_children(self, number):
         cmd = 'childmax %d' % number
         self.send_command(cmd)
@@ -30,6 +30,7 @@
 #include <openthread.h>
 #include <common/debug.hpp>
 #include <crypto/aes_ccm.hpp>
+#include <crypto/aes_ccm_batch.hpp>
 #include <crypto/mbedtls.hpp>
 #include <string.h>
 
@@ -229,12 +230,212 @@ void TestMacCommandFrame()
                  "TestMacCommandFrame decrypt failed\n");
 }
 
+/**
+ * Verifies the test vectors of IEEE 802.15.4-2006 Annex C Sections C.2.2 and C.2.3 with AesCcmBatch, processing both
+ * frames in one batch, with every AES implementation available.
+ */
+void TestMacFramesBatch(void)
+{
+    const uint8_t key[] =
+    {
+        0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7,
+        0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xce, 0xcf,
+    };
+
+    const uint8_t dataFrame[] =
+    {
+        0x69, 0xDC, 0x84, 0x21, 0x43, 0x02, 0x00, 0x00,
+        0x00, 0x00, 0x48, 0xDE, 0xAC, 0x01, 0x00, 0x00,
+        0x00, 0x00, 0x48, 0xDE, 0xAC, 0x04, 0x05, 0x00,
+        0x00, 0x00, 0x61, 0x62, 0x63, 0x64
+    };
+
+    const uint8_t dataFrameEncrypted[] =
+    {
+        0x69, 0xDC, 0x84, 0x21, 0x43, 0x02, 0x00, 0x00,
+        0x00, 0x00, 0x48, 0xDE, 0xAC, 0x01, 0x00, 0x00,
+        0x00, 0x00, 0x48, 0xDE, 0xAC, 0x04, 0x05, 0x00,
+        0x00, 0x00, 0xD4, 0x3E, 0x02, 0x2B
+    };
+
+    const uint8_t dataNonce[] =
+    {
+        0xAC, 0xDE, 0x48, 0x00, 0x00, 0x00, 0x00, 0x01,
+        0x00, 0x00, 0x00, 0x05, 0x04,
+    };
+
+    const uint8_t commandFrame[] =
+    {
+        0x2B, 0xDC, 0x84, 0x21, 0x43, 0x02, 0x00, 0x00,
+        0x00, 0x00, 0x48, 0xDE, 0xAC, 0xFF, 0xFF, 0x01,
+        0x00, 0x00, 0x00, 0x00, 0x48, 0xDE, 0xAC, 0x06,
+        0x05, 0x00, 0x00, 0x00, 0x01, 0xCE, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    };
+
+    const uint8_t commandFrameEncrypted[] =
+    {
+        0x2B, 0xDC, 0x84, 0x21, 0x43, 0x02, 0x00, 0x00,
+        0x00, 0x00, 0x48, 0xDE, 0xAC, 0xFF, 0xFF, 0x01,
+        0x00, 0x00, 0x00, 0x00, 0x48, 0xDE, 0xAC, 0x06,
+        0x05, 0x00, 0x00, 0x00, 0x01, 0xD8, 0x4F, 0xDE,
+        0x52, 0x90, 0x61, 0xF9, 0xC6, 0xF1,
+    };
+
+    const uint8_t commandNonce[] =
+    {
+        0xAC, 0xDE, 0x48, 0x00, 0x00, 0x00, 0x00, 0x01,
+        0x00, 0x00, 0x00, 0x05, 0x06,
+    };
+
+    const Thread::Crypto::AesBatch::Backend backends[] =
+    {
+        Thread::Crypto::AesBatch::kBackendBitsliced,
+        Thread::Crypto::AesBatch::kBackendAesNi,
+        Thread::Crypto::AesBatch::kBackendArmCrypto,
+    };
+
+    for (size_t i = 0; i < sizeof(backends) / sizeof(backends[0]); i++)
+    {
+        Thread::Crypto::AesCcmBatch aesCcmBatch;
+        Thread::Crypto::AesCcmBatch::Frame frames[2];
+        uint8_t data[sizeof(dataFrame)];
+        uint8_t command[sizeof(commandFrame)];
+        uint8_t tag[8];
+
+        if (!Thread::Crypto::AesBatch::IsSupported(backends[i]))
+        {
+            continue;
+        }
+
+        memcpy(data, dataFrame, sizeof(data));
+        memcpy(command, commandFrame, sizeof(command));
+
+        frames[0].mNonce = dataNonce;
+        frames[0].mNonceLength = sizeof(dataNonce);
+        frames[0].mHeader = data;
+        frames[0].mHeaderLength = 26;
+        frames[0].mPlainText = data + 26;
+        frames[0].mCipherText = data + 26;
+        frames[0].mPayloadLength = 4;
+        frames[0].mTag = NULL;
+        frames[0].mTagLength = 0;
+
+        frames[1].mNonce = commandNonce;
+        frames[1].mNonceLength = sizeof(commandNonce);
+        frames[1].mHeader = command;
+        frames[1].mHeaderLength = 29;
+        frames[1].mPlainText = command + 29;
+        frames[1].mCipherText = command + 29;
+        frames[1].mPayloadLength = 1;
+        frames[1].mTag = command + 30;
+        frames[1].mTagLength = 8;
+
+        SuccessOrQuit(aesCcmBatch.SetKey(key, sizeof(key), backends[i]), "TestMacFramesBatch set key failed\n");
+        aesCcmBatch.Process(frames, 2, true);
+
+        VerifyOrQuit(memcmp(data, dataFrameEncrypted, sizeof(data)) == 0 &&
+                     memcmp(command, commandFrameEncrypted, sizeof(command)) == 0,
+                     "TestMacFramesBatch encrypt failed\n");
+
+        frames[1].mTag = tag;
+        aesCcmBatch.Process(frames, 2, false);
+
+        VerifyOrQuit(memcmp(data, dataFrame, sizeof(data)) == 0 &&
+                     memcmp(command, commandFrame, sizeof(commandFrame) - sizeof(tag)) == 0 &&
+                     memcmp(tag, commandFrameEncrypted + 30, sizeof(tag)) == 0,
+                     "TestMacFramesBatch decrypt failed\n");
+    }
+}
+
+/**
+ * Verifies that AesCcmBatch gives the same results as AesCcm for batches of frames with varied lengths.
+ */
+void TestAesCcmBatchMatchesAesCcm(void)
+{
+    enum
+    {
+        kNumFrames = 6,
+        kMaxLength = 150,
+    };
+
+    uint8_t key[16];
+    uint8_t nonces[kNumFrames][13];
+    uint8_t headers[kNumFrames][kMaxLength];
+    uint8_t payloads[kNumFrames][kMaxLength];
+    uint8_t expected[kNumFrames][kMaxLength];
+    uint8_t tags[kNumFrames][16];
+    uint8_t expectedTags[kNumFrames][16];
+    Thread::Crypto::AesCcmBatch::Frame frames[kNumFrames];
+    Thread::Crypto::AesCcmBatch aesCcmBatch;
+    uint32_t seed = 1;
+
+    for (uint16_t round = 0; round < 200; round++)
+    {
+        uint8_t numFrames = 1 + round % kNumFrames;
+
+        for (size_t i = 0; i < sizeof(key); i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            key[i] = static_cast<uint8_t>(seed >> 16);
+        }
+
+        for (uint8_t f = 0; f < numFrames; f++)
+        {
+            Thread::Crypto::AesCcm aesCcm;
+            uint8_t tagLength;
+
+            for (uint8_t i = 0; i < kMaxLength; i++)
+            {
+                seed = seed * 1103515245 + 12345;
+                headers[f][i] = static_cast<uint8_t>(seed >> 16);
+                payloads[f][i] = static_cast<uint8_t>(seed >> 24);
+
+                if (i < sizeof(nonces[f]))
+                {
+                    nonces[f][i] = static_cast<uint8_t>(seed >> 8);
+                }
+            }
+
+            frames[f].mNonce = nonces[f];
+            frames[f].mNonceLength = sizeof(nonces[f]);
+            frames[f].mHeader = headers[f];
+            frames[f].mHeaderLength = (seed >> 8) % 40;
+            frames[f].mPlainText = payloads[f];
+            frames[f].mCipherText = payloads[f];
+            frames[f].mPayloadLength = (seed >> 4) % kMaxLength;
+            frames[f].mTag = tags[f];
+            frames[f].mTagLength = 4 << (seed % 3);
+
+            memcpy(expected[f], payloads[f], sizeof(expected[f]));
+            aesCcm.SetKey(key, sizeof(key));
+            aesCcm.Init(frames[f].mHeaderLength, frames[f].mPayloadLength, frames[f].mTagLength,
+                        nonces[f], sizeof(nonces[f]));
+            aesCcm.Header(headers[f], frames[f].mHeaderLength);
+            aesCcm.Payload(expected[f], expected[f], frames[f].mPayloadLength, true);
+            aesCcm.Finalize(expectedTags[f], &tagLength);
+        }
+
+        SuccessOrQuit(aesCcmBatch.SetKey(key, sizeof(key)), "TestAesCcmBatchMatchesAesCcm set key failed\n");
+        aesCcmBatch.Process(frames, numFrames, true);
+
+        for (uint8_t f = 0; f < numFrames; f++)
+        {
+            VerifyOrQuit(memcmp(payloads[f], expected[f], sizeof(payloads[f])) == 0 &&
+                         memcmp(tags[f], expectedTags[f], frames[f].mTagLength) == 0,
+                         "TestAesCcmBatchMatchesAesCcm encrypt failed\n");
+        }
+    }
+}
+
 #ifdef ENABLE_TEST_MAIN
 int main(void)
 {
     TestMacBeaconFrame();
     TestMacDataFrame();
     TestMacCommandFrame();
+    TestMacFramesBatch();
+    TestAesCcmBatchMatchesAesCcm();
     printf("All tests passed\n");
     return 0;
 }
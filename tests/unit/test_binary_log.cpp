@@ -0,0 +1,232 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_util.h"
+#include <common/binary_log.hpp>
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace Thread {
+
+enum
+{
+    kLineSize = 128,
+};
+
+static void WriteLog(BinaryLog &aLog, otLogLevel aLogLevel, otLogRegion aLogRegion, const char *aFormat, ...)
+{
+    va_list args;
+
+    va_start(args, aFormat);
+    aLog.Write(aLogLevel, aLogRegion, aFormat, args);
+    va_end(args);
+}
+
+static uint32_t ReadUint32(const uint8_t *aBuf)
+{
+    return static_cast<uint32_t>(aBuf[0]) | (static_cast<uint32_t>(aBuf[1]) << 8) |
+           (static_cast<uint32_t>(aBuf[2]) << 16) | (static_cast<uint32_t>(aBuf[3]) << 24);
+}
+
+// Formats the arguments of a record, the way the host decoder does, one conversion at a time.
+static void DecodeRecord(const uint8_t *aRecord, const char *aFormat, char *aLine)
+{
+    const uint8_t *cur = aRecord + BinaryLog::kHeaderLength;
+    const uint8_t *end = aRecord + aRecord[0] + 1;
+    char *out = aLine;
+    char spec[16];
+    size_t specLength;
+    int longs;
+
+    VerifyOrQuit(end - aRecord >= BinaryLog::kHeaderLength, "BinaryLog record is too short\n");
+
+    while (*aFormat != '\0')
+    {
+        if (*aFormat != '%')
+        {
+            *out++ = *aFormat++;
+            continue;
+        }
+
+        specLength = strcspn(aFormat + 1, "diuxXocps%") + 2;
+        VerifyOrQuit(specLength < sizeof(spec), "BinaryLog conversion is too long\n");
+        memcpy(spec, aFormat, specLength);
+        spec[specLength] = '\0';
+        aFormat += specLength;
+        longs = (strstr(spec, "ll") != NULL) ? 2 : (strchr(spec, 'l') != NULL) ? 1 : 0;
+
+        switch (spec[specLength - 1])
+        {
+        case '%':
+            *out++ = '%';
+            break;
+
+        case 's':
+            VerifyOrQuit(memchr(cur, 0, static_cast<size_t>(end - cur)) != NULL, "BinaryLog string is truncated\n");
+            out += sprintf(out, spec, reinterpret_cast<const char *>(cur));
+            cur += strlen(reinterpret_cast<const char *>(cur)) + 1;
+            break;
+
+        default:
+            if (longs == 2)
+            {
+                VerifyOrQuit(end - cur >= 8, "BinaryLog argument is truncated\n");
+                out += sprintf(out, spec, static_cast<unsigned long long>(ReadUint32(cur)) |
+                               (static_cast<unsigned long long>(ReadUint32(cur + 4)) << 32));
+                cur += 8;
+            }
+            else if (longs == 1)
+            {
+                VerifyOrQuit(end - cur >= 4, "BinaryLog argument is truncated\n");
+                out += sprintf(out, spec, static_cast<unsigned long>(ReadUint32(cur)));
+                cur += 4;
+            }
+            else
+            {
+                VerifyOrQuit(end - cur >= 4, "BinaryLog argument is truncated\n");
+                out += sprintf(out, spec, ReadUint32(cur));
+                cur += 4;
+            }
+
+            break;
+        }
+    }
+
+    *out = '\0';
+    VerifyOrQuit(cur == end, "BinaryLog record has extra arguments\n");
+}
+
+static void VerifyRecord(BinaryLog &aLog, otLogLevel aLogLevel, otLogRegion aLogRegion, const char *aFormat,
+                         const char *aExpected)
+{
+    uint8_t record[BinaryLog::kMaxRecordLength];
+    char line[kLineSize];
+
+    VerifyOrQuit(aLog.Read(record, 1) == 1, "BinaryLog::Read() failed\n");
+    VerifyOrQuit(aLog.Read(record + 1, record[0]) == record[0], "BinaryLog::Read() returned a partial record\n");
+    VerifyOrQuit((record[1] & 0x07) == aLogLevel, "BinaryLog record level is wrong\n");
+    VerifyOrQuit(((record[1] >> 3) & 0x0f) == aLogRegion, "BinaryLog record region is wrong\n");
+    VerifyOrQuit((record[1] & BinaryLog::kDumpFlag) == 0, "BinaryLog record is flagged as a dump\n");
+    VerifyOrQuit(ReadUint32(&record[2]) == BinaryLog::GetFormatId(aFormat), "BinaryLog format ID is wrong\n");
+
+    DecodeRecord(record, aFormat, line);
+    VerifyOrQuit(strcmp(line, aExpected) == 0, "BinaryLog round trip does not match the formatted log\n");
+}
+
+void TestBinaryLogRoundTrip(void)
+{
+    static BinaryLog log;
+    uint8_t byte;
+    char expected[kLineSize];
+
+    static const char kFormat1[] = "Sent to child (0x%x), still queued message (%d)";
+    static const char kFormat2[] = "%s: %02x %04d%% [%-6s|%5u]";
+    static const char kFormat3[] = "ext addr %llX, frame counter %lu";
+
+    WriteLog(log, kLogLevelInfo, kLogRegionMac, kFormat1, 0xac01, -3);
+    WriteLog(log, kLogLevelDebg, kLogRegionMle, kFormat2, "route", 0x5, 42, "ab", 77u);
+    WriteLog(log, kLogLevelCrit, kLogRegionMeshCoP, kFormat3, 0x1122334455667788ULL, 123456UL);
+
+    snprintf(expected, sizeof(expected), kFormat1, 0xac01, -3);
+    VerifyRecord(log, kLogLevelInfo, kLogRegionMac, kFormat1, expected);
+    snprintf(expected, sizeof(expected), kFormat2, "route", 0x5, 42, "ab", 77u);
+    VerifyRecord(log, kLogLevelDebg, kLogRegionMle, kFormat2, expected);
+    snprintf(expected, sizeof(expected), kFormat3, 0x1122334455667788ULL, 123456UL);
+    VerifyRecord(log, kLogLevelCrit, kLogRegionMeshCoP, kFormat3, expected);
+
+    VerifyOrQuit(log.Read(&byte, sizeof(byte)) == 0, "BinaryLog::Read() returned bytes of an empty buffer\n");
+}
+
+void TestBinaryLogDump(void)
+{
+    static BinaryLog log;
+    uint8_t data[300];
+    uint8_t record[BinaryLog::kMaxDumpLength + 1];
+    uint16_t length;
+
+    for (uint16_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = static_cast<uint8_t>(i);
+    }
+
+    log.WriteDump(kLogLevelDebg, kLogRegionNetData, "set network data", data, sizeof(data));
+
+    length = log.Read(record, sizeof(record));
+    VerifyOrQuit(length == sizeof(record) && record[0] == BinaryLog::kMaxDumpLength,
+                 "BinaryLog dump record length is wrong\n");
+    VerifyOrQuit((record[1] & BinaryLog::kDumpFlag) != 0, "BinaryLog dump record is not flagged\n");
+    VerifyOrQuit(ReadUint32(&record[2]) == BinaryLog::GetFormatId("set network data"),
+                 "BinaryLog dump ID is wrong\n");
+    VerifyOrQuit((record[6] | (record[7] << 8)) == sizeof(data), "BinaryLog dump length is wrong\n");
+    VerifyOrQuit(memcmp(&record[8], data, length - 8u) == 0, "BinaryLog dump bytes are wrong\n");
+}
+
+void TestBinaryLogFull(void)
+{
+    static BinaryLog log;
+    uint8_t record[BinaryLog::kMaxRecordLength];
+    uint32_t written = 0;
+    uint32_t read = 0;
+    uint16_t length;
+
+    // Fill the buffer with 10-byte records until one is dropped.
+    while (log.GetDroppedCount() == 0)
+    {
+        WriteLog(log, kLogLevelWarn, kLogRegionIp6, "%d", written++);
+    }
+
+    written--;
+    VerifyOrQuit(written == BinaryLog::kBufferSize / 10, "BinaryLog accepted a record that does not fit\n");
+
+    // Drain and refill so that records wrap around the end of the buffer.
+    for (uint16_t i = 0; i < 3 * BinaryLog::kBufferSize / 10; i++)
+    {
+        length = log.Read(record, 10);
+        VerifyOrQuit(length == 10 && ReadUint32(&record[6]) == read, "BinaryLog record is out of order\n");
+        read++;
+
+        WriteLog(log, kLogLevelWarn, kLogRegionIp6, "%d", written++);
+    }
+
+    VerifyOrQuit(log.GetDroppedCount() == 1, "BinaryLog dropped a record that fits\n");
+}
+
+}  // namespace Thread
+
+#ifdef ENABLE_TEST_MAIN
+int main(void)
+{
+    Thread::TestBinaryLogRoundTrip();
+    Thread::TestBinaryLogDump();
+    Thread::TestBinaryLogFull();
+    printf("All tests passed\n");
+    return 0;
+}
+#endif
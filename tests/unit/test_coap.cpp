@@ -0,0 +1,589 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_util.h"
+#include <openthread.h>
+#include <common/debug.hpp>
+#include <string.h>
+
+#include <coap/coap_client.hpp>
+#include <coap/coap_server.hpp>
+#include <net/ip6.hpp>
+#include <net/netif.hpp>
+
+extern uint32_t sNow;
+
+namespace Thread {
+
+enum
+{
+    kServerPort = 5683,
+    kClientPort = 5684,
+    kOtherClientPort = 5685,
+    kBlockPayloadLength = 40,
+    kNumPendingRequests = OPENTHREAD_CONFIG_COAP_CLIENT_REQUEST_INDEX_SIZE + 4,
+};
+
+/**
+ * This class implements a network interface which only carries datagrams between its own addresses.
+ *
+ */
+class TestNetif: public Ip6::Netif
+{
+public:
+    TestNetif(Ip6::Ip6 &aIp6): Ip6::Netif(aIp6, 1) {}
+
+    ThreadError SendMessage(Message &aMessage) {
+        aMessage.Free();
+        return kThreadError_None;
+    }
+
+    ThreadError GetLinkAddress(Ip6::LinkAddress &) const { return kThreadError_NotImplemented; }
+
+    ThreadError RouteLookup(const Ip6::Address &, const Ip6::Address &, uint8_t *) { return kThreadError_NoRoute; }
+};
+
+static Ip6::Ip6 sIp6;
+static TestNetif sNetif(sIp6);
+static Ip6::NetifUnicastAddress sAddress;
+static Ip6::UdpSocket sClientSocket(sIp6.mUdp);
+static Ip6::UdpSocket sOtherClientSocket(sIp6.mUdp);
+static Coap::Server sServer(sNetif, kServerPort);
+
+static uint16_t sNumRequests;
+static uint16_t sNumResponses;
+static Coap::Header sResponseHeader;
+static uint16_t sResponsePayloadLength;
+static uint32_t sConsumedPositions[4];
+static uint8_t sNumConsumed;
+
+static void ProcessTasklets(void)
+{
+    while (sIp6.mTaskletScheduler.AreTaskletsPending())
+    {
+        sIp6.mTaskletScheduler.ProcessQueuedTasklets();
+    }
+}
+
+static void AdvanceTime(uint32_t aMilliseconds)
+{
+    sNow += aMilliseconds;
+    sIp6.mTimerScheduler.FireTimers();
+    ProcessTasklets();
+}
+
+static void HandleClientReceive(void *, otMessage aMessage, const otMessageInfo *)
+{
+    Message &message = *static_cast<Message *>(aMessage);
+
+    SuccessOrQuit(sResponseHeader.FromMessage(message), "Coap::Header::FromMessage() failed\n");
+    sResponsePayloadLength = message.GetLength() - message.GetOffset() - sResponseHeader.GetLength();
+    sNumResponses++;
+}
+
+static void SetUp(void)
+{
+    static bool sInitialized = false;
+    Ip6::SockAddr sockaddr;
+
+    if (!sInitialized)
+    {
+        memset(&sAddress, 0, sizeof(sAddress));
+        sAddress.GetAddress().mFields.m8[0] = 0xfd;
+        sAddress.GetAddress().mFields.m8[15] = 1;
+        sAddress.mPrefixLength = 64;
+        sAddress.mPreferredLifetime = 0xffffffff;
+        sAddress.mValidLifetime = 0xffffffff;
+
+        SuccessOrQuit(sIp6.AddNetif(sNetif), "Ip6::AddNetif() failed\n");
+        SuccessOrQuit(sNetif.AddUnicastAddress(sAddress), "Netif::AddUnicastAddress() failed\n");
+
+        sockaddr.mPort = kClientPort;
+        SuccessOrQuit(sClientSocket.Open(&HandleClientReceive, NULL), "UdpSocket::Open() failed\n");
+        SuccessOrQuit(sClientSocket.Bind(sockaddr), "UdpSocket::Bind() failed\n");
+
+        sockaddr.mPort = kOtherClientPort;
+        SuccessOrQuit(sOtherClientSocket.Open(&HandleClientReceive, NULL), "UdpSocket::Open() failed\n");
+        SuccessOrQuit(sOtherClientSocket.Bind(sockaddr), "UdpSocket::Bind() failed\n");
+        sInitialized = true;
+    }
+
+    SuccessOrQuit(sServer.Start(), "Coap::Server::Start() failed\n");
+    sNumRequests = 0;
+    sNumResponses = 0;
+    sNumConsumed = 0;
+}
+
+static void TearDown(void)
+{
+    SuccessOrQuit(sServer.Stop(), "Coap::Server::Stop() failed\n");
+    ProcessTasklets();
+}
+
+static void SendToServer(Ip6::UdpSocket &aSocket, const Coap::Header &aHeader, uint16_t aPayloadLength)
+{
+    Ip6::MessageInfo messageInfo;
+    Message *message;
+
+    VerifyOrQuit((message = aSocket.NewMessage(0)) != NULL, "UdpSocket::NewMessage() failed\n");
+    SuccessOrQuit(message->Append(aHeader.GetBytes(), aHeader.GetLength()), "Message::Append() failed\n");
+
+    for (uint16_t i = 0; i < aPayloadLength; i++)
+    {
+        uint8_t byte = static_cast<uint8_t>(i);
+        SuccessOrQuit(message->Append(&byte, sizeof(byte)), "Message::Append() failed\n");
+    }
+
+    memset(&messageInfo, 0, sizeof(messageInfo));
+    messageInfo.GetPeerAddr() = sAddress.GetAddress();
+    messageInfo.mPeerPort = kServerPort;
+    messageInfo.mInterfaceId = sNetif.GetInterfaceId();
+
+    SuccessOrQuit(aSocket.SendTo(*message, messageInfo), "UdpSocket::SendTo() failed\n");
+    ProcessTasklets();
+}
+
+static void SendRequest(uint16_t aMessageId, const char *aUriPath)
+{
+    Coap::Header header;
+
+    header.Init(kCoapTypeConfirmable, kCoapRequestPost);
+    header.SetMessageId(aMessageId);
+    header.SetToken(reinterpret_cast<const uint8_t *>(&aMessageId), sizeof(aMessageId));
+    SuccessOrQuit(header.AppendUriPathOptions(aUriPath), "Coap::Header::AppendUriPathOptions() failed\n");
+
+    SendToServer(sClientSocket, header, 0);
+}
+
+static void SendBlock1Request(Ip6::UdpSocket &aSocket, uint16_t aMessageId, uint16_t aToken, uint32_t aNumber,
+                              bool aMore)
+{
+    Coap::Header header;
+
+    header.Init(kCoapTypeConfirmable, kCoapRequestPost);
+    header.SetMessageId(aMessageId);
+    header.SetToken(reinterpret_cast<const uint8_t *>(&aToken), sizeof(aToken));
+    SuccessOrQuit(header.AppendUriPathOptions("b"), "Coap::Header::AppendUriPathOptions() failed\n");
+    SuccessOrQuit(header.AppendBlockOption(kCoapOptionBlock1, aNumber, aMore, kCoapBlockSize16),
+                  "Coap::Header::AppendBlockOption() failed\n");
+    SuccessOrQuit(header.SetPayloadMarker(), "Coap::Header::SetPayloadMarker() failed\n");
+
+    SendToServer(aSocket, header, aMore ? 16 : 8);
+}
+
+static void HandleCountedRequest(void *, Coap::Header &aHeader, Message &, const Ip6::MessageInfo &aMessageInfo)
+{
+    Coap::Header responseHeader;
+    Message *response;
+
+    sNumRequests++;
+
+    responseHeader.SetDefaultResponseHeader(aHeader);
+    VerifyOrQuit((response = sServer.NewMessage(0)) != NULL, "Coap::Server::NewMessage() failed\n");
+    SuccessOrQuit(response->Append(responseHeader.GetBytes(), responseHeader.GetLength()),
+                  "Message::Append() failed\n");
+    SuccessOrQuit(sServer.SendMessage(*response, aMessageInfo), "Coap::Server::SendMessage() failed\n");
+}
+
+void TestCoapResponseCache(void)
+{
+    Coap::Resource resource("c", &HandleCountedRequest, NULL);
+    const otCoapResponseCacheCounters &counters = sServer.GetResponsesQueueCounters();
+    uint32_t misses;
+    uint32_t evictions;
+    Message *evicted;
+
+    SetUp();
+    SuccessOrQuit(sServer.AddResource(resource), "Coap::Server::AddResource() failed\n");
+    misses = counters.mMisses;
+    evictions = counters.mEvictions;
+
+#if OPENTHREAD_CONFIG_COAP_SERVER_MAX_CACHED_RESPONSES == 0
+    // without a cache, a retransmitted request is handled again
+    SendRequest(1, "c");
+    SendRequest(1, "c");
+    VerifyOrQuit(sNumRequests == 2 && sNumResponses == 2 && counters.mCachedResponses == 0,
+                 "disabled cache kept a response\n");
+    (void)misses;
+    (void)evictions;
+    (void)evicted;
+#else
+    // a retransmitted request is answered from the cache without calling the handler again
+    SendRequest(1, "c");
+    VerifyOrQuit(sNumRequests == 1 && sNumResponses == 1, "request was not handled\n");
+    VerifyOrQuit(counters.mCachedResponses == 1 && counters.mMisses == misses + 1, "response was not cached\n");
+
+    SendRequest(1, "c");
+    VerifyOrQuit(sNumRequests == 1, "duplicate request was handled again\n");
+    VerifyOrQuit(sNumResponses == 2 && sResponseHeader.GetMessageId() == 1, "duplicate request was not answered\n");
+    VerifyOrQuit(counters.mHits == 1, "cache hit was not counted\n");
+
+    // a full cache evicts its oldest response
+    for (uint16_t messageId = 2; messageId <= OPENTHREAD_CONFIG_COAP_SERVER_MAX_CACHED_RESPONSES + 1; messageId++)
+    {
+        SendRequest(messageId, "c");
+    }
+
+    VerifyOrQuit(counters.mCachedResponses == OPENTHREAD_CONFIG_COAP_SERVER_MAX_CACHED_RESPONSES &&
+                 counters.mEvictions == evictions + 1, "full cache did not evict its oldest response\n");
+
+    SendRequest(1, "c");
+    VerifyOrQuit(sNumRequests == OPENTHREAD_CONFIG_COAP_SERVER_MAX_CACHED_RESPONSES + 2,
+                 "evicted response was answered from the cache\n");
+
+    // cached responses give their buffers up to messages of higher priority only
+    VerifyOrQuit(sServer.EvictCachedResponse(Message::kPriorityLow) == NULL,
+                 "cached response was evicted for a low priority message\n");
+    VerifyOrQuit((evicted = sServer.EvictCachedResponse(Message::kPriorityNormal)) != NULL,
+                 "cached response was not evicted for a normal priority message\n");
+    VerifyOrQuit(evicted->GetPriority() == Message::kPriorityLow, "cached response is not low priority\n");
+    evicted->Free();
+    VerifyOrQuit(counters.mCachedResponses == OPENTHREAD_CONFIG_COAP_SERVER_MAX_CACHED_RESPONSES - 1,
+                 "evicted response is still counted\n");
+
+    // responses expire after EXCHANGE_LIFETIME
+    AdvanceTime(Timer::SecToMsec(Coap::kExchangeLifetime));
+    VerifyOrQuit(counters.mCachedResponses == 0, "cached responses did not expire\n");
+
+    SendRequest(2, "c");
+    VerifyOrQuit(sNumRequests == OPENTHREAD_CONFIG_COAP_SERVER_MAX_CACHED_RESPONSES + 3,
+                 "expired response was answered from the cache\n");
+#endif
+
+    sServer.RemoveResource(resource);
+    TearDown();
+}
+
+void TestCoapResourceLookup(void)
+{
+    static const char *kUriPaths[] = { "a/an", "a/as", "c/cs", "c/cs/x", "d" };
+    Coap::Resource resources[] =
+    {
+        Coap::Resource(kUriPaths[0], &HandleCountedRequest, NULL),
+        Coap::Resource(kUriPaths[1], &HandleCountedRequest, NULL),
+        Coap::Resource(kUriPaths[2], &HandleCountedRequest, NULL),
+        Coap::Resource(kUriPaths[3], &HandleCountedRequest, NULL),
+        Coap::Resource(kUriPaths[4], &HandleCountedRequest, NULL),
+    };
+    uint16_t messageId = 0;
+
+    SetUp();
+
+    for (uint8_t i = 0; i < sizeof(resources) / sizeof(resources[0]); i++)
+    {
+        SuccessOrQuit(sServer.AddResource(resources[i]), "Coap::Server::AddResource() failed\n");
+    }
+
+    VerifyOrQuit(sServer.AddResource(resources[0]) == kThreadError_Already, "resource was added twice\n");
+
+    // every resource is found by its full Uri-Path
+    for (uint8_t i = 0; i < sizeof(resources) / sizeof(resources[0]); i++)
+    {
+        SendRequest(++messageId, kUriPaths[i]);
+        VerifyOrQuit(sNumRequests == i + 1 && sResponseHeader.GetCode() == kCoapResponseChanged,
+                     "resource was not found\n");
+    }
+
+    // prefixes, extensions and unknown paths are answered with 4.04
+    SendRequest(++messageId, "a");
+    VerifyOrQuit(sResponseHeader.GetCode() == kCoapResponseNotFound, "Uri-Path prefix matched a resource\n");
+    SendRequest(++messageId, "d/x");
+    VerifyOrQuit(sResponseHeader.GetCode() == kCoapResponseNotFound, "extended Uri-Path matched a resource\n");
+    SendRequest(++messageId, "a/ax");
+    VerifyOrQuit(sResponseHeader.GetCode() == kCoapResponseNotFound, "unknown Uri-Path matched a resource\n");
+
+    // a removed resource is no longer found while the others remain reachable
+    sServer.RemoveResource(resources[2]);
+    SendRequest(++messageId, "c/cs");
+    VerifyOrQuit(sResponseHeader.GetCode() == kCoapResponseNotFound, "removed resource was found\n");
+    SendRequest(++messageId, "c/cs/x");
+    VerifyOrQuit(sResponseHeader.GetCode() == kCoapResponseChanged, "remaining resource was not found\n");
+
+    for (uint8_t i = 0; i < sizeof(resources) / sizeof(resources[0]); i++)
+    {
+        sServer.RemoveResource(resources[i]);
+    }
+
+    VerifyOrQuit(sNumRequests == sizeof(resources) / sizeof(resources[0]) + 1, "unexpected request was handled\n");
+    TearDown();
+}
+
+static ThreadError ConsumeBlock(void *, const Message &, uint32_t aPosition, bool)
+{
+    VerifyOrQuit(sNumConsumed < sizeof(sConsumedPositions) / sizeof(sConsumedPositions[0]),
+                 "too many blocks were consumed\n");
+    sConsumedPositions[sNumConsumed++] = aPosition;
+    return kThreadError_None;
+}
+
+void TestCoapBlock1Transfer(void)
+{
+    Coap::Resource resource("b", &HandleCountedRequest, &ConsumeBlock, NULL, NULL);
+    uint16_t messageId = 0;
+
+    SetUp();
+    SuccessOrQuit(sServer.AddResource(resource), "Coap::Server::AddResource() failed\n");
+
+    // each block but the last one is acknowledged with 2.31 Continue
+    SendBlock1Request(sClientSocket, ++messageId, 1, 0, true);
+    VerifyOrQuit(sResponseHeader.GetCode() == kCoapResponseContinue, "first block was not continued\n");
+
+    // the resource receives one transfer at a time, whether from another port or with another token
+    SendBlock1Request(sOtherClientSocket, ++messageId, 2, 0, true);
+    VerifyOrQuit(sResponseHeader.GetCode() == kCoapResponseServiceUnavailable, "concurrent transfer was accepted\n");
+    SendBlock1Request(sClientSocket, ++messageId, 3, 1, true);
+    VerifyOrQuit(sResponseHeader.GetCode() == kCoapResponseServiceUnavailable, "other token continued transfer\n");
+
+    SendBlock1Request(sClientSocket, ++messageId, 1, 1, false);
+    VerifyOrQuit(sResponseHeader.GetCode() == kCoapResponseChanged && sNumRequests == 1,
+                 "last block was not handled\n");
+    VerifyOrQuit(sNumConsumed == 2 && sConsumedPositions[0] == 0 && sConsumedPositions[1] == 16,
+                 "blocks of other transfers were consumed\n");
+
+    // a block which does not continue a transfer is rejected
+    SendBlock1Request(sClientSocket, ++messageId, 1, 2, true);
+    VerifyOrQuit(sResponseHeader.GetCode() == kCoapResponseRequestEntityIncomplete,
+                 "block of a completed transfer was accepted\n");
+
+    // an abandoned transfer expires and lets another requester in
+    SendBlock1Request(sOtherClientSocket, ++messageId, 2, 0, true);
+    VerifyOrQuit(sResponseHeader.GetCode() == kCoapResponseContinue, "transfer of other port was not started\n");
+    SendBlock1Request(sClientSocket, ++messageId, 1, 0, true);
+    VerifyOrQuit(sResponseHeader.GetCode() == kCoapResponseServiceUnavailable, "concurrent transfer was accepted\n");
+
+    AdvanceTime(Timer::SecToMsec(Coap::kMaxTransmitWait));
+    SendBlock1Request(sClientSocket, ++messageId, 1, 0, true);
+    VerifyOrQuit(sResponseHeader.GetCode() == kCoapResponseContinue, "abandoned transfer did not expire\n");
+    SendBlock1Request(sOtherClientSocket, ++messageId, 2, 1, true);
+    VerifyOrQuit(sResponseHeader.GetCode() == kCoapResponseServiceUnavailable, "expired transfer was continued\n");
+
+    // removing the resource drops its transfer
+    sServer.RemoveResource(resource);
+    SuccessOrQuit(sServer.AddResource(resource), "Coap::Server::AddResource() failed\n");
+    SendBlock1Request(sClientSocket, ++messageId, 1, 1, true);
+    VerifyOrQuit(sResponseHeader.GetCode() == kCoapResponseRequestEntityIncomplete,
+                 "transfer survived the removal of its resource\n");
+
+    sServer.RemoveResource(resource);
+    TearDown();
+}
+
+static void HandleBlock2Request(void *, Coap::Header &, Message &, const Ip6::MessageInfo &)
+{
+    sNumRequests++;
+}
+
+static ThreadError ProduceBlock(void *, Message &aMessage, uint32_t aPosition, uint16_t aLength, bool &aMore)
+{
+    ThreadError error = kThreadError_None;
+
+    for (uint32_t position = aPosition; position < aPosition + aLength && position < kBlockPayloadLength; position++)
+    {
+        uint8_t byte = static_cast<uint8_t>(position);
+        SuccessOrExit(error = aMessage.Append(&byte, sizeof(byte)));
+    }
+
+    aMore = (aPosition + aLength < kBlockPayloadLength);
+
+exit:
+    return error;
+}
+
+static void SendBlock2Request(uint16_t aMessageId, bool aBlockOption, uint32_t aNumber, Coap::Header::BlockSize aSize)
+{
+    Coap::Header header;
+
+    header.Init(kCoapTypeConfirmable, kCoapRequestGet);
+    header.SetMessageId(aMessageId);
+    header.SetToken(reinterpret_cast<const uint8_t *>(&aMessageId), sizeof(aMessageId));
+    SuccessOrQuit(header.AppendUriPathOptions("p"), "Coap::Header::AppendUriPathOptions() failed\n");
+
+    if (aBlockOption)
+    {
+        SuccessOrQuit(header.AppendBlockOption(kCoapOptionBlock2, aNumber, false, aSize),
+                      "Coap::Header::AppendBlockOption() failed\n");
+    }
+
+    SendToServer(sClientSocket, header, 0);
+}
+
+static void VerifyBlock2Response(uint32_t aNumber, bool aMore, Coap::Header::BlockSize aSize, uint16_t aLength)
+{
+    uint32_t number;
+    bool more;
+    Coap::Header::BlockSize size;
+
+    VerifyOrQuit(sResponseHeader.GetCode() == kCoapResponseContent, "block was not produced\n");
+    SuccessOrQuit(sResponseHeader.GetBlockOption(kCoapOptionBlock2, number, more, size),
+                  "response has no Block2 option\n");
+    VerifyOrQuit(number == aNumber && more == aMore && size == aSize && sResponsePayloadLength == aLength,
+                 "unexpected response block\n");
+}
+
+void TestCoapBlock2Transfer(void)
+{
+    Coap::Resource resource("p", &HandleBlock2Request, NULL, &ProduceBlock, NULL);
+    Coap::Header::BlockSize preferredExponent = static_cast<Coap::Header::BlockSize>(OPENTHREAD_CONFIG_COAP_BLOCK_SIZE);
+    uint16_t preferredSize = Coap::Header::GetBlockSize(preferredExponent);
+    bool preferredMore = (kBlockPayloadLength > preferredSize);
+    uint16_t preferredLength = preferredMore ? preferredSize : static_cast<uint16_t>(kBlockPayloadLength);
+    uint16_t messageId = 0;
+
+    SetUp();
+    SuccessOrQuit(sServer.AddResource(resource), "Coap::Server::AddResource() failed\n");
+
+    // the handler prepares the payload before the first block only
+    SendBlock2Request(++messageId, true, 0, kCoapBlockSize16);
+    VerifyBlock2Response(0, true, kCoapBlockSize16, 16);
+    VerifyOrQuit(sNumRequests == 1, "handler was not called for the first block\n");
+
+    SendBlock2Request(++messageId, true, 2, kCoapBlockSize16);
+    VerifyBlock2Response(2, false, kCoapBlockSize16, kBlockPayloadLength - 32);
+    VerifyOrQuit(sNumRequests == 1, "handler was called for a later block\n");
+
+    // requests without a Block2 option or with larger blocks are answered with the preferred block size
+    SendBlock2Request(++messageId, false, 0, kCoapBlockSize16);
+    VerifyBlock2Response(0, preferredMore, preferredExponent, preferredLength);
+
+    SendBlock2Request(++messageId, true, 0, kCoapBlockSize1024);
+    VerifyBlock2Response(0, preferredMore, preferredExponent, preferredLength);
+    VerifyOrQuit(sNumRequests == 3, "handler was not called for the first blocks\n");
+
+    sServer.RemoveResource(resource);
+    TearDown();
+}
+
+static Message *NewPendingRequest(uint16_t aMessageId, Coap::Header &aHeader)
+{
+    Ip6::MessageInfo messageInfo;
+    Message *message;
+
+    aHeader.Init(kCoapTypeConfirmable, kCoapRequestPost);
+    aHeader.SetMessageId(aMessageId);
+    aHeader.SetToken(reinterpret_cast<const uint8_t *>(&aMessageId), sizeof(aMessageId));
+
+    memset(&messageInfo, 0, sizeof(messageInfo));
+    messageInfo.GetPeerAddr() = sAddress.GetAddress();
+    messageInfo.mPeerPort = kServerPort;
+
+    VerifyOrQuit((message = sIp6.mMessagePool.New(Message::kTypeIp6, 0, Message::kPriorityNetwork)) != NULL,
+                 "MessagePool::New() failed\n");
+    SuccessOrQuit(message->Append(aHeader.GetBytes(), aHeader.GetLength()), "Message::Append() failed\n");
+    SuccessOrQuit(Coap::RequestMetadata(true, messageInfo, NULL, NULL, 0).AppendTo(*message),
+                  "RequestMetadata::AppendTo() failed\n");
+
+    return message;
+}
+
+static Message *FindPendingRequest(const Coap::RequestIndex &aIndex, const MessageQueue &aQueue,
+                                   uint16_t aMessageId, Coap::Header::Type aType)
+{
+    Coap::Header responseHeader;
+    Coap::Header requestHeader;
+    Coap::RequestMetadata requestMetadata;
+    Ip6::MessageInfo messageInfo;
+
+    // acknowledgments are matched by Message ID and separate responses by token
+    responseHeader.Init(aType, kCoapResponseChanged);
+    responseHeader.SetMessageId((aType == kCoapTypeAcknowledgment) ? aMessageId : 0);
+    responseHeader.SetToken(reinterpret_cast<const uint8_t *>(&aMessageId), sizeof(aMessageId));
+
+    memset(&messageInfo, 0, sizeof(messageInfo));
+    messageInfo.GetPeerAddr() = sAddress.GetAddress();
+    messageInfo.mPeerPort = kServerPort;
+
+    return aIndex.Find(responseHeader, messageInfo, aQueue, requestHeader, requestMetadata);
+}
+
+void TestCoapRequestIndex(void)
+{
+    Coap::RequestIndex index;
+    MessageQueue queue;
+    Message *requests[kNumPendingRequests];
+    Coap::Header header;
+
+    // requests beyond the index are accepted and only counted
+    for (uint16_t i = 0; i < kNumPendingRequests; i++)
+    {
+        requests[i] = NewPendingRequest(i + 1, header);
+        index.Add(*requests[i], header);
+        SuccessOrQuit(queue.Enqueue(*requests[i]), "MessageQueue::Enqueue() failed\n");
+    }
+
+    VerifyOrQuit(index.GetNumUnindexed() == kNumPendingRequests - OPENTHREAD_CONFIG_COAP_CLIENT_REQUEST_INDEX_SIZE,
+                 "RequestIndex::Add() did not count the requests beyond the index\n");
+
+    // responses to indexed and unindexed requests are matched alike
+    for (uint16_t i = 0; i < kNumPendingRequests; i++)
+    {
+        VerifyOrQuit(FindPendingRequest(index, queue, i + 1, kCoapTypeAcknowledgment) == requests[i],
+                     "RequestIndex::Find() did not match an acknowledgment\n");
+        VerifyOrQuit(FindPendingRequest(index, queue, i + 1, kCoapTypeConfirmable) == requests[i],
+                     "RequestIndex::Find() did not match a separate response\n");
+    }
+
+    VerifyOrQuit(FindPendingRequest(index, queue, kNumPendingRequests + 1, kCoapTypeAcknowledgment) == NULL,
+                 "RequestIndex::Find() matched an unknown Message ID\n");
+
+    // removing requests, indexed or not, keeps the others reachable
+    for (uint16_t i = 0; i < kNumPendingRequests; i++)
+    {
+        uint16_t r = (i % 2 == 0) ? i / 2 : kNumPendingRequests - 1 - i / 2;
+
+        index.Remove(*requests[r]);
+        SuccessOrQuit(queue.Dequeue(*requests[r]), "MessageQueue::Dequeue() failed\n");
+        VerifyOrQuit(FindPendingRequest(index, queue, r + 1, kCoapTypeAcknowledgment) == NULL,
+                     "RequestIndex::Find() matched a removed request\n");
+        requests[r]->Free();
+        requests[r] = NULL;
+
+        for (uint16_t j = 0; j < kNumPendingRequests; j++)
+        {
+            VerifyOrQuit(requests[j] == NULL ||
+                         FindPendingRequest(index, queue, j + 1, kCoapTypeAcknowledgment) == requests[j],
+                         "RequestIndex::Find() lost a request after a removal\n");
+        }
+    }
+
+    VerifyOrQuit(index.GetNumUnindexed() == 0, "RequestIndex::Remove() did not count the unindexed requests\n");
+}
+
+}  // namespace Thread
+
+#ifdef ENABLE_TEST_MAIN
+int main(void)
+{
+    Thread::TestCoapResponseCache();
+    Thread::TestCoapRequestIndex();
+    Thread::TestCoapResourceLookup();
+    Thread::TestCoapBlock1Transfer();
+    Thread::TestCoapBlock2Transfer();
+    printf("All tests passed\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,508 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "test_util.h"
+#include <openthread.h>
+#include <common/debug.hpp>
+#include <string.h>
+
+#include <net/ip6.hpp>
+#include <net/ip6_headers.hpp>
+#include <net/netif.hpp>
+#include <net/udp6.hpp>
+
+extern uint32_t sNow;
+
+namespace Thread {
+
+enum
+{
+    kLocalPort = 5683,
+    kPeerPort = 5684,
+    kMaxSentFragments = 4,
+    kFragmentLength = 512,
+};
+
+/**
+ * This class implements a network interface which holds on to the datagrams sent over it.
+ *
+ */
+class TestNetif: public Ip6::Netif
+{
+public:
+    TestNetif(Ip6::Ip6 &aIp6): Ip6::Netif(aIp6, 1) {}
+
+    ThreadError SendMessage(Message &aMessage);
+
+    ThreadError GetLinkAddress(Ip6::LinkAddress &) const { return kThreadError_NotImplemented; }
+
+    ThreadError RouteLookup(const Ip6::Address &, const Ip6::Address &, uint8_t *) { return kThreadError_NoRoute; }
+};
+
+static Ip6::Ip6 sIp6;
+static TestNetif sNetif(sIp6);
+static Ip6::NetifUnicastAddress sAddress;
+static Ip6::Address sPeerAddress;
+static Ip6::UdpSocket sSocket(sIp6.mUdp);
+static const uint8_t sLinkInfo[4] = { 0 };
+
+static Message *sSentFragments[kMaxSentFragments];
+static uint8_t sNumSentFragments;
+
+static uint8_t sNumReceived;
+static uint16_t sReceivedLength;
+static bool sReceivedPayloadValid;
+static const void *sReceivedLinkInfo;
+
+ThreadError TestNetif::SendMessage(Message &aMessage)
+{
+    VerifyOrQuit(sNumSentFragments < kMaxSentFragments, "TestNetif::SendMessage() too many fragments\n");
+    sSentFragments[sNumSentFragments++] = &aMessage;
+    return kThreadError_None;
+}
+
+static void ProcessTasklets(void)
+{
+    while (sIp6.mTaskletScheduler.AreTaskletsPending())
+    {
+        sIp6.mTaskletScheduler.ProcessQueuedTasklets();
+    }
+}
+
+static void AdvanceTime(uint32_t aSeconds)
+{
+    // the reassembly timer ticks once per second
+    for (uint32_t i = 0; i < aSeconds; i++)
+    {
+        sNow += Timer::SecToMsec(1);
+        sIp6.mTimerScheduler.FireTimers();
+        ProcessTasklets();
+    }
+}
+
+static uint16_t GetFreeBuffers(void)
+{
+    return sIp6.mMessagePool.GetBufferCounters().mFreeBuffers;
+}
+
+static void HandleReceive(void *, otMessage aMessage, const otMessageInfo *aMessageInfo)
+{
+    Message &message = *static_cast<Message *>(aMessage);
+    uint8_t byte;
+
+    sNumReceived++;
+    sReceivedLength = message.GetLength() - message.GetOffset();
+    sReceivedLinkInfo = aMessageInfo->mLinkInfo;
+    sReceivedPayloadValid = true;
+
+    for (uint16_t i = 0; i < sReceivedLength; i++)
+    {
+        message.Read(message.GetOffset() + i, sizeof(byte), &byte);
+
+        if (byte != static_cast<uint8_t>(i))
+        {
+            sReceivedPayloadValid = false;
+        }
+    }
+}
+
+static void SetUp(void)
+{
+    static bool sInitialized = false;
+    Ip6::SockAddr sockaddr;
+
+    if (!sInitialized)
+    {
+        memset(&sAddress, 0, sizeof(sAddress));
+        sAddress.GetAddress().mFields.m8[0] = 0xfd;
+        sAddress.GetAddress().mFields.m8[15] = 1;
+        sAddress.mPrefixLength = 64;
+        sAddress.mPreferredLifetime = 0xffffffff;
+        sAddress.mValidLifetime = 0xffffffff;
+
+        memset(&sPeerAddress, 0, sizeof(sPeerAddress));
+        sPeerAddress.mFields.m8[0] = 0xfd;
+        sPeerAddress.mFields.m8[15] = 2;
+
+        SuccessOrQuit(sIp6.AddNetif(sNetif), "Ip6::AddNetif() failed\n");
+        SuccessOrQuit(sNetif.AddUnicastAddress(sAddress), "Netif::AddUnicastAddress() failed\n");
+
+        sockaddr.mPort = kLocalPort;
+        SuccessOrQuit(sSocket.Open(&HandleReceive, NULL), "UdpSocket::Open() failed\n");
+        SuccessOrQuit(sSocket.Bind(sockaddr), "UdpSocket::Bind() failed\n");
+        sInitialized = true;
+    }
+
+    sNumSentFragments = 0;
+    sNumReceived = 0;
+    sReceivedLength = 0;
+    sReceivedLinkInfo = NULL;
+}
+
+static void TearDown(void)
+{
+    for (uint8_t i = 0; i < sNumSentFragments; i++)
+    {
+        sSentFragments[i]->Free();
+    }
+
+    sNumSentFragments = 0;
+
+    // let any datagram left under reassembly time out
+    AdvanceTime(OPENTHREAD_CONFIG_IP6_REASSEMBLY_TIMEOUT);
+}
+
+/**
+ * This function builds a UDP datagram, optionally behind a Hop-by-Hop Options and a Destination Options header.
+ *
+ */
+static Message *NewDatagram(const Ip6::Address &aSource, const Ip6::Address &aDestination, uint16_t aPayloadLength,
+                            bool aExtensionHeaders)
+{
+    const uint8_t hopByHop[] = { Ip6::kProtoDstOpts, 0, Ip6::OptionPadN::kType, 4, 0, 0, 0, 0 };
+    const uint8_t destinationOptions[] = { Ip6::kProtoUdp, 0, Ip6::OptionPadN::kType, 4, 0, 0, 0, 0 };
+    Ip6::Header header;
+    Ip6::UdpHeader udpHeader;
+    uint16_t udpOffset = sizeof(header);
+    uint16_t udpLength = sizeof(udpHeader) + aPayloadLength;
+    Message *message;
+
+    if (aExtensionHeaders)
+    {
+        udpOffset += sizeof(hopByHop) + sizeof(destinationOptions);
+    }
+
+    header.Init();
+    header.SetPayloadLength(udpOffset - sizeof(header) + udpLength);
+    header.SetNextHeader(aExtensionHeaders ? Ip6::kProtoHopOpts : Ip6::kProtoUdp);
+    header.SetHopLimit(Ip6::Ip6::kDefaultHopLimit);
+    header.SetSource(aSource);
+    header.SetDestination(aDestination);
+
+    udpHeader.SetSourcePort(kPeerPort);
+    udpHeader.SetDestinationPort(kLocalPort);
+    udpHeader.SetLength(udpLength);
+    udpHeader.SetChecksum(0);
+
+    VerifyOrQuit((message = sIp6.mMessagePool.New(Message::kTypeIp6, 0)) != NULL, "MessagePool::New() failed\n");
+    SuccessOrQuit(message->Append(&header, sizeof(header)), "Message::Append() failed\n");
+
+    if (aExtensionHeaders)
+    {
+        SuccessOrQuit(message->Append(hopByHop, sizeof(hopByHop)), "Message::Append() failed\n");
+        SuccessOrQuit(message->Append(destinationOptions, sizeof(destinationOptions)), "Message::Append() failed\n");
+    }
+
+    SuccessOrQuit(message->Append(&udpHeader, sizeof(udpHeader)), "Message::Append() failed\n");
+
+    for (uint16_t i = 0; i < aPayloadLength; i++)
+    {
+        uint8_t byte = static_cast<uint8_t>(i);
+        SuccessOrQuit(message->Append(&byte, sizeof(byte)), "Message::Append() failed\n");
+    }
+
+    message->SetOffset(udpOffset);
+    SuccessOrQuit(sIp6.mUdp.UpdateChecksum(*message, Ip6::Ip6::ComputePseudoheaderChecksum(aSource, aDestination,
+                                                                                            udpLength,
+                                                                                            Ip6::kProtoUdp)),
+                  "Udp::UpdateChecksum() failed\n");
+    message->SetOffset(0);
+
+    return message;
+}
+
+/**
+ * This function copies a datagram out of the message pool, which is left to the datagrams under reassembly.
+ *
+ * @returns The length of the datagram following its IPv6 header.
+ *
+ */
+static uint16_t ReadDatagram(Message *aMessage, uint8_t *aBuffer)
+{
+    uint16_t length = aMessage->GetLength();
+
+    VerifyOrQuit(aMessage->Read(0, length, aBuffer) == length, "Message::Read() failed\n");
+    aMessage->Free();
+
+    return length - sizeof(Ip6::Header);
+}
+
+/**
+ * This function builds the fragment of @p aDatagram, which has no extension headers, carrying the @p aLength bytes
+ * that follow its IPv6 header from @p aStart on.
+ *
+ */
+static Message *NewFragment(const uint8_t *aDatagram, uint32_t aIdentification, uint16_t aStart, uint16_t aLength,
+                            bool aMore)
+{
+    Ip6::Header header;
+    Ip6::FragmentHeader fragmentHeader;
+    Message *fragment;
+
+    memcpy(&header, aDatagram, sizeof(header));
+    header.SetNextHeader(Ip6::kProtoFragment);
+    header.SetPayloadLength(sizeof(fragmentHeader) + aLength);
+
+    fragmentHeader.Init();
+    fragmentHeader.SetNextHeader(Ip6::kProtoUdp);
+    fragmentHeader.SetOffset(aStart / 8);
+    fragmentHeader.SetIdentification(aIdentification);
+
+    if (aMore)
+    {
+        fragmentHeader.SetMoreFlag();
+    }
+
+    VerifyOrQuit((fragment = sIp6.mMessagePool.New(Message::kTypeIp6, 0)) != NULL, "MessagePool::New() failed\n");
+    SuccessOrQuit(fragment->Append(&header, sizeof(header)), "Message::Append() failed\n");
+    SuccessOrQuit(fragment->Append(&fragmentHeader, sizeof(fragmentHeader)), "Message::Append() failed\n");
+    SuccessOrQuit(fragment->Append(aDatagram + sizeof(header) + aStart, aLength), "Message::Append() failed\n");
+
+    return fragment;
+}
+
+static void ReceiveFragment(Message &aFragment)
+{
+    sIp6.HandleDatagram(aFragment, &sNetif, sNetif.GetInterfaceId(), sLinkInfo, false);
+    ProcessTasklets();
+}
+
+/**
+ * This function feeds the fragments sent towards the peer back as if the peer had echoed them.
+ *
+ */
+static void ReceiveSentFragments(void)
+{
+    Ip6::Header header;
+
+    for (uint8_t i = 0; i < sNumSentFragments; i++)
+    {
+        // swapping the addresses leaves the UDP checksum valid
+        sSentFragments[i]->Read(0, sizeof(header), &header);
+        header.SetSource(sPeerAddress);
+        header.SetDestination(sAddress.GetAddress());
+        sSentFragments[i]->Write(0, sizeof(header), &header);
+        ReceiveFragment(*sSentFragments[i]);
+    }
+
+    sNumSentFragments = 0;
+}
+
+void TestIp6FragmentExtensionHeaders(void)
+{
+    Message *datagram;
+    Ip6::FragmentHeader fragmentHeader;
+    uint8_t nextHeader;
+    uint16_t unfragmentableLength = sizeof(Ip6::Header) + 16;  // both 8-byte option headers stay in each fragment
+    uint16_t freeBuffers;
+
+    SetUp();
+    freeBuffers = GetFreeBuffers();
+
+    datagram = NewDatagram(sAddress.GetAddress(), sPeerAddress, 1400, true);
+    SuccessOrQuit(sIp6.FragmentDatagram(*datagram, unfragmentableLength, Ip6::kProtoUdp),
+                  "Ip6::FragmentDatagram() failed\n");
+    datagram->Free();
+    ProcessTasklets();
+
+    VerifyOrQuit(sNumSentFragments == 2, "Ip6::FragmentDatagram() produced an unexpected number of fragments\n");
+
+    for (uint8_t i = 0; i < sNumSentFragments; i++)
+    {
+        VerifyOrQuit(sSentFragments[i]->GetLength() <= Ip6::Ip6::kLinkMtu, "fragment exceeds the link MTU\n");
+
+        sSentFragments[i]->Read(Ip6::Header::GetNextHeaderOffset(), sizeof(nextHeader), &nextHeader);
+        VerifyOrQuit(nextHeader == Ip6::kProtoHopOpts, "IPv6 header no longer refers to the Hop-by-Hop header\n");
+
+        sSentFragments[i]->Read(sizeof(Ip6::Header), sizeof(nextHeader), &nextHeader);
+        VerifyOrQuit(nextHeader == Ip6::kProtoDstOpts, "Hop-by-Hop header no longer refers to Destination Options\n");
+
+        sSentFragments[i]->Read(sizeof(Ip6::Header) + 8, sizeof(nextHeader), &nextHeader);
+        VerifyOrQuit(nextHeader == Ip6::kProtoFragment, "last unfragmentable header does not refer to the fragment\n");
+
+        sSentFragments[i]->Read(unfragmentableLength, sizeof(fragmentHeader), &fragmentHeader);
+        VerifyOrQuit(fragmentHeader.GetNextHeader() == Ip6::kProtoUdp, "fragment header lost the UDP protocol\n");
+    }
+
+    ReceiveSentFragments();
+
+    VerifyOrQuit(sNumReceived == 1, "reassembled datagram was not delivered\n");
+    VerifyOrQuit(sReceivedLength == 1400 && sReceivedPayloadValid, "reassembled payload is corrupt\n");
+    VerifyOrQuit(sReceivedLinkInfo == sLinkInfo, "reassembled datagram lost the link info of its fragments\n");
+
+    TearDown();
+    VerifyOrQuit(GetFreeBuffers() == freeBuffers, "fragmentation leaked buffers\n");
+}
+
+void TestIp6ReassembleInOrder(void)
+{
+    Message *datagram;
+    uint16_t freeBuffers;
+
+    SetUp();
+    freeBuffers = GetFreeBuffers();
+
+    // datagrams sent by this node above the link MTU leave in fragments
+    datagram = NewDatagram(sAddress.GetAddress(), sPeerAddress, 1400, false);
+    SuccessOrQuit(sIp6.HandleDatagram(*datagram, NULL, sNetif.GetInterfaceId(), NULL, true),
+                  "Ip6::HandleDatagram() failed\n");
+    ProcessTasklets();
+
+    VerifyOrQuit(sNumSentFragments == 2, "datagram above the link MTU was not fragmented\n");
+
+    ReceiveSentFragments();
+
+    VerifyOrQuit(sNumReceived == 1, "reassembled datagram was not delivered\n");
+    VerifyOrQuit(sReceivedLength == 1400 && sReceivedPayloadValid, "reassembled payload is corrupt\n");
+    VerifyOrQuit(sReceivedLinkInfo == sLinkInfo, "reassembled datagram lost the link info of its fragments\n");
+
+    TearDown();
+    VerifyOrQuit(GetFreeBuffers() == freeBuffers, "reassembly leaked buffers\n");
+}
+
+void TestIp6ReassembleOutOfOrder(void)
+{
+    uint8_t datagram[Ip6::Ip6::kMaxDatagramLength];
+    uint16_t length;
+    uint16_t freeBuffers;
+
+    SetUp();
+    freeBuffers = GetFreeBuffers();
+
+    length = ReadDatagram(NewDatagram(sPeerAddress, sAddress.GetAddress(), 1200, false), datagram);
+
+    ReceiveFragment(*NewFragment(datagram, 1, 2 * kFragmentLength, length - 2 * kFragmentLength, false));
+    ReceiveFragment(*NewFragment(datagram, 1, 0, kFragmentLength, true));
+    VerifyOrQuit(sNumReceived == 0, "incomplete datagram was delivered\n");
+
+    ReceiveFragment(*NewFragment(datagram, 1, kFragmentLength, kFragmentLength, true));
+    VerifyOrQuit(sNumReceived == 1, "reassembled datagram was not delivered\n");
+    VerifyOrQuit(sReceivedLength == 1200 && sReceivedPayloadValid, "reassembled payload is corrupt\n");
+    VerifyOrQuit(sReceivedLinkInfo == sLinkInfo, "reassembled datagram lost the link info of its fragments\n");
+
+    TearDown();
+    VerifyOrQuit(GetFreeBuffers() == freeBuffers, "reassembly leaked buffers\n");
+}
+
+void TestIp6ReassembleOverlap(void)
+{
+    uint8_t datagram[Ip6::Ip6::kMaxDatagramLength];
+    uint16_t length;
+    uint16_t freeBuffers;
+
+    SetUp();
+    freeBuffers = GetFreeBuffers();
+
+    length = ReadDatagram(NewDatagram(sPeerAddress, sAddress.GetAddress(), 1200, false), datagram);
+
+    // an overlapping fragment discards the whole datagram (RFC 5722), including the fragments already received
+    ReceiveFragment(*NewFragment(datagram, 2, 0, kFragmentLength, true));
+    ReceiveFragment(*NewFragment(datagram, 2, kFragmentLength / 2, kFragmentLength, true));
+    VerifyOrQuit(GetFreeBuffers() == freeBuffers, "overlapping fragments were not discarded\n");
+
+    ReceiveFragment(*NewFragment(datagram, 2, kFragmentLength + kFragmentLength / 2,
+                                 length - kFragmentLength - kFragmentLength / 2, false));
+    VerifyOrQuit(sNumReceived == 0, "datagram with overlapping fragments was delivered\n");
+
+    TearDown();
+    VerifyOrQuit(GetFreeBuffers() == freeBuffers, "reassembly leaked buffers\n");
+}
+
+void TestIp6ReassembleTimeout(void)
+{
+    uint8_t datagram[Ip6::Ip6::kMaxDatagramLength];
+    uint16_t length;
+    uint16_t freeBuffers;
+
+    SetUp();
+    freeBuffers = GetFreeBuffers();
+
+    length = ReadDatagram(NewDatagram(sPeerAddress, sAddress.GetAddress(), 1200, false), datagram);
+
+    ReceiveFragment(*NewFragment(datagram, 3, 0, kFragmentLength, true));
+    AdvanceTime(OPENTHREAD_CONFIG_IP6_REASSEMBLY_TIMEOUT - 1);
+    VerifyOrQuit(GetFreeBuffers() < freeBuffers, "datagram under reassembly was discarded early\n");
+
+    AdvanceTime(1);
+    VerifyOrQuit(GetFreeBuffers() == freeBuffers, "datagram under reassembly did not time out\n");
+
+    // the fragments received after the timeout cannot complete the datagram
+    ReceiveFragment(*NewFragment(datagram, 3, kFragmentLength, length - kFragmentLength, false));
+    VerifyOrQuit(sNumReceived == 0, "timed out datagram was delivered\n");
+
+    TearDown();
+    VerifyOrQuit(GetFreeBuffers() == freeBuffers, "reassembly leaked buffers\n");
+}
+
+void TestIp6ReassembleBufferBudget(void)
+{
+    uint8_t first[Ip6::Ip6::kMaxDatagramLength];
+    uint8_t second[Ip6::Ip6::kMaxDatagramLength];
+    uint16_t firstLength;
+    uint16_t secondLength;
+    uint16_t freeBuffers;
+
+    SetUp();
+    freeBuffers = GetFreeBuffers();
+
+    // two datagrams close to the maximum length do not both fit in the reassembly buffer
+    firstLength = ReadDatagram(NewDatagram(sPeerAddress, sAddress.GetAddress(), 1400, false), first);
+    secondLength = ReadDatagram(NewDatagram(sPeerAddress, sAddress.GetAddress(), 1392, false), second);
+    VerifyOrQuit(2 * sizeof(Ip6::Header) + firstLength + secondLength > OPENTHREAD_CONFIG_IP6_REASSEMBLY_BUFFER_SIZE,
+                 "datagrams fit in the reassembly buffer\n");
+
+    ReceiveFragment(*NewFragment(first, 4, 0, kFragmentLength, true));
+    ReceiveFragment(*NewFragment(first, 4, 2 * kFragmentLength, firstLength - 2 * kFragmentLength, false));
+    ReceiveFragment(*NewFragment(second, 5, 0, 2 * kFragmentLength, true));
+
+    // the fragment exceeding the budget discards its own datagram only
+    ReceiveFragment(*NewFragment(second, 5, 2 * kFragmentLength, secondLength - 2 * kFragmentLength, false));
+    VerifyOrQuit(sNumReceived == 0, "datagram exceeding the reassembly buffer was delivered\n");
+
+    ReceiveFragment(*NewFragment(first, 4, kFragmentLength, kFragmentLength, true));
+    VerifyOrQuit(sNumReceived == 1, "datagram within the reassembly buffer was not delivered\n");
+    VerifyOrQuit(sReceivedLength == 1400 && sReceivedPayloadValid, "reassembled payload is corrupt\n");
+
+    TearDown();
+    VerifyOrQuit(GetFreeBuffers() == freeBuffers, "reassembly leaked buffers\n");
+}
+
+}  // namespace Thread
+
+#ifdef ENABLE_TEST_MAIN
+int main(void)
+{
+    Thread::TestIp6FragmentExtensionHeaders();
+    Thread::TestIp6ReassembleInOrder();
+    Thread::TestIp6ReassembleOutOfOrder();
+    Thread::TestIp6ReassembleOverlap();
+    Thread::TestIp6ReassembleTimeout();
+    Thread::TestIp6ReassembleBufferBudget();
+    printf("All tests passed\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,462 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_util.h"
+#include <common/crc16.hpp>
+#include <meshcop/joiner_table.hpp>
+
+#include <string.h>
+
+namespace Thread {
+
+using MeshCoP::JoinerTable;
+using MeshCoP::SteeringDataTlv;
+
+enum
+{
+    kNumJoiners    = OPENTHREAD_CONFIG_MAX_JOINER_ENTRIES,
+    kNumAddresses  = 4 * kNumJoiners + 4,
+    kNumCollisions = (kNumJoiners < 3) ? kNumJoiners : 3,
+};
+
+static const char sPsk[] = "J01NME";
+
+static void InitAddress(Mac::ExtAddress &aAddress, uint16_t aSeed)
+{
+    memset(&aAddress, 0, sizeof(aAddress));
+    aAddress.m8[0] = 0x18;
+    aAddress.m8[6] = static_cast<uint8_t>(aSeed >> 8);
+    aAddress.m8[7] = static_cast<uint8_t>(aSeed);
+}
+
+// Mirrors the hash bucket the table picks for a Joiner ID.
+static uint16_t GetBucket(const Mac::ExtAddress &aAddress)
+{
+    Crc16 ccitt(Crc16::kCcitt);
+
+    for (size_t i = 0; i < sizeof(aAddress.m8); i++)
+    {
+        ccitt.Update(aAddress.m8[i]);
+    }
+
+    return ccitt.Get() % kNumJoiners;
+}
+
+// Computes the steering data from scratch, the way the Commissioner did before it kept a JoinerTable.
+static void ComputeSteeringData(const Mac::ExtAddress *aAddresses, const bool *aAdded, uint16_t aNumAddresses,
+                                bool aAny, SteeringDataTlv &aSteeringData)
+{
+    aSteeringData.Init();
+    aSteeringData.Clear();
+
+    if (aAny)
+    {
+        aSteeringData.SetLength(1);
+        aSteeringData.Set();
+        ExitNow();
+    }
+
+    for (uint16_t i = 0; i < aNumAddresses; i++)
+    {
+        Crc16 ccitt(Crc16::kCcitt);
+        Crc16 ansi(Crc16::kAnsi);
+
+        if (!aAdded[i])
+        {
+            continue;
+        }
+
+        for (size_t j = 0; j < sizeof(aAddresses[i].m8); j++)
+        {
+            ccitt.Update(aAddresses[i].m8[j]);
+            ansi.Update(aAddresses[i].m8[j]);
+        }
+
+        aSteeringData.SetBit(ccitt.Get() % aSteeringData.GetNumBits());
+        aSteeringData.SetBit(ansi.Get() % aSteeringData.GetNumBits());
+    }
+
+exit:
+    return;
+}
+
+static void VerifySteeringData(const JoinerTable &aTable, const Mac::ExtAddress *aAddresses, const bool *aAdded,
+                               uint16_t aNumAddresses, bool aAny)
+{
+    SteeringDataTlv steeringData;
+    SteeringDataTlv expected;
+
+    aTable.GetSteeringData(steeringData);
+    ComputeSteeringData(aAddresses, aAdded, aNumAddresses, aAny, expected);
+
+    VerifyOrQuit(steeringData.GetLength() == expected.GetLength() &&
+                 memcmp(steeringData.GetValue(), expected.GetValue(), expected.GetLength()) == 0,
+                 "JoinerTable::GetSteeringData() differs from the steering data of the Joiners\n");
+}
+
+void TestJoinerTableAddRemove(void)
+{
+    JoinerTable table;
+    JoinerTable::Joiner *joiner;
+    Mac::ExtAddress address;
+    Mac::ExtAddress other;
+    char longPsk[MeshCoP::Dtls::kPskMaxLength + 2];
+
+    InitAddress(address, 1);
+    InitAddress(other, 2);
+
+    memset(longPsk, 'A', sizeof(longPsk) - 1);
+    longPsk[sizeof(longPsk) - 1] = '\0';
+    VerifyOrQuit(table.Add(&address, longPsk, 10) == kThreadError_InvalidArgs,
+                 "JoinerTable::Add() accepted a PSKd that is too long\n");
+    VerifyOrQuit(table.GetNumJoiners() == 0 && table.Find(&address) == NULL,
+                 "JoinerTable::Add() kept a Joiner with an invalid PSKd\n");
+
+    SuccessOrQuit(table.Add(&address, sPsk, 10), "JoinerTable::Add() failed\n");
+    VerifyOrQuit(table.GetNumJoiners() == 1, "JoinerTable::GetNumJoiners() is wrong after Add()\n");
+    VerifyOrQuit((joiner = table.Find(&address)) != NULL, "JoinerTable::Find() did not find the Joiner\n");
+    VerifyOrQuit(!joiner->IsAny() && memcmp(&joiner->GetExtAddress(), &address, sizeof(address)) == 0 &&
+                 strcmp(joiner->GetPsk(), sPsk) == 0 && joiner->GetExpiration() == 10 &&
+                 joiner->GetState() == JoinerTable::kStatePending,
+                 "JoinerTable::Add() did not initialize the entry\n");
+
+    // Adding the same Joiner again updates its entry.
+    joiner->SetState(JoinerTable::kStateJoined);
+    SuccessOrQuit(table.Add(&address, "J01NME2", 20), "JoinerTable::Add() failed to update a Joiner\n");
+    VerifyOrQuit(table.GetNumJoiners() == 1 && table.Find(&address) == joiner,
+                 "JoinerTable::Add() allocated a second entry for the same Joiner\n");
+    VerifyOrQuit(strcmp(joiner->GetPsk(), "J01NME2") == 0 && joiner->GetExpiration() == 20 &&
+                 joiner->GetState() == JoinerTable::kStatePending,
+                 "JoinerTable::Add() did not update the entry\n");
+
+    VerifyOrQuit(table.Find(&other) == NULL && table.Find(NULL) == NULL && table.FindMatching(other) == NULL,
+                 "JoinerTable::Find() found a Joiner that was not added\n");
+    VerifyOrQuit(table.Remove(&other) == kThreadError_NotFound && table.Remove(NULL) == kThreadError_NotFound,
+                 "JoinerTable::Remove() removed a Joiner that was not added\n");
+
+    SuccessOrQuit(table.Remove(&address), "JoinerTable::Remove() failed\n");
+    VerifyOrQuit(table.GetNumJoiners() == 0 && table.Find(&address) == NULL && table.GetNextExpiring() == NULL,
+                 "JoinerTable::Remove() did not remove the Joiner\n");
+    VerifyOrQuit(table.Remove(&address) == kThreadError_NotFound,
+                 "JoinerTable::Remove() removed the same Joiner twice\n");
+}
+
+void TestJoinerTableAny(void)
+{
+    JoinerTable table;
+    JoinerTable::Joiner *any;
+    Mac::ExtAddress addresses[2];
+    bool added[2] = { false, false };
+
+    InitAddress(addresses[0], 1);
+    InitAddress(addresses[1], 2);
+
+    SuccessOrQuit(table.Add(NULL, sPsk, 10), "JoinerTable::Add() failed for any Joiner\n");
+    VerifyOrQuit((any = table.Find(NULL)) != NULL && any->IsAny() && table.GetNumJoiners() == 1,
+                 "JoinerTable::Find() did not find the entry for any Joiner\n");
+    VerifyOrQuit(table.Find(&addresses[0]) == NULL, "JoinerTable::Find() matched a Joiner ID to any Joiner\n");
+    VerifyOrQuit(table.FindMatching(addresses[0]) == any,
+                 "JoinerTable::FindMatching() did not fall back to any Joiner\n");
+    VerifySteeringData(table, addresses, added, 2, true);
+
+    SuccessOrQuit(table.Add(NULL, "J01NME2", 20), "JoinerTable::Add() failed to update any Joiner\n");
+    VerifyOrQuit(table.Find(NULL) == any && table.GetNumJoiners() == 1 && any->GetExpiration() == 20,
+                 "JoinerTable::Add() allocated a second entry for any Joiner\n");
+
+    if (kNumJoiners > 1)
+    {
+        JoinerTable::Joiner *joiner;
+
+        SuccessOrQuit(table.Add(&addresses[0], sPsk, 30), "JoinerTable::Add() failed\n");
+        added[0] = true;
+        VerifyOrQuit((joiner = table.FindMatching(addresses[0])) != NULL && joiner != any && !joiner->IsAny(),
+                     "JoinerTable::FindMatching() did not prefer the entry for the Joiner ID\n");
+        VerifyOrQuit(table.FindMatching(addresses[1]) == any,
+                     "JoinerTable::FindMatching() did not fall back to any Joiner\n");
+        VerifySteeringData(table, addresses, added, 2, true);
+    }
+
+    SuccessOrQuit(table.Remove(NULL), "JoinerTable::Remove() failed for any Joiner\n");
+    VerifyOrQuit(table.Find(NULL) == NULL && table.FindMatching(addresses[1]) == NULL,
+                 "JoinerTable::Remove() did not remove the entry for any Joiner\n");
+    VerifyOrQuit(table.Remove(NULL) == kThreadError_NotFound,
+                 "JoinerTable::Remove() removed any Joiner twice\n");
+    VerifySteeringData(table, addresses, added, 2, false);
+}
+
+void TestJoinerTableCollisions(void)
+{
+    JoinerTable table;
+    Mac::ExtAddress collisions[kNumCollisions + 1];
+    bool added[kNumCollisions + 1];
+    uint16_t removeOrder[kNumCollisions];
+    uint16_t count = 0;
+
+    // Find Joiner IDs that share a bucket, the last one is never added.
+    for (uint16_t seed = 0; count < kNumCollisions + 1; seed++)
+    {
+        InitAddress(collisions[count], seed);
+
+        if (count == 0 || GetBucket(collisions[count]) == GetBucket(collisions[0]))
+        {
+            added[count++] = false;
+        }
+    }
+
+    for (uint16_t i = 0; i < kNumCollisions; i++)
+    {
+        SuccessOrQuit(table.Add(&collisions[i], sPsk, i), "JoinerTable::Add() failed\n");
+        added[i] = true;
+        VerifySteeringData(table, collisions, added, kNumCollisions + 1, false);
+    }
+
+    // Remove the head of the bucket first, then its tail, then the rest.
+    removeOrder[0] = kNumCollisions - 1;
+
+    for (uint16_t i = 1; i < kNumCollisions; i++)
+    {
+        removeOrder[i] = i - 1;
+    }
+
+    for (uint16_t i = 0; i <= kNumCollisions; i++)
+    {
+        for (uint16_t j = 0; j <= kNumCollisions; j++)
+        {
+            JoinerTable::Joiner *joiner = table.Find(&collisions[j]);
+
+            VerifyOrQuit(added[j] ? (joiner != NULL &&
+                                     memcmp(&joiner->GetExtAddress(), &collisions[j], sizeof(collisions[j])) == 0) :
+                         joiner == NULL,
+                         "JoinerTable::Find() failed within a bucket\n");
+        }
+
+        if (i < kNumCollisions)
+        {
+            SuccessOrQuit(table.Remove(&collisions[removeOrder[i]]), "JoinerTable::Remove() failed\n");
+            added[removeOrder[i]] = false;
+            VerifySteeringData(table, collisions, added, kNumCollisions + 1, false);
+        }
+    }
+
+    VerifyOrQuit(table.GetNumJoiners() == 0, "JoinerTable::GetNumJoiners() is wrong after Remove()\n");
+}
+
+void TestJoinerTableExpiry(void)
+{
+    JoinerTable table;
+    JoinerTable::Joiner *joiner;
+    Mac::ExtAddress addresses[kNumJoiners];
+    uint32_t expected[kNumJoiners];
+    uint16_t numExpected = 0;
+
+    for (uint16_t i = 0; i < kNumJoiners; i++)
+    {
+        InitAddress(addresses[i], i);
+        SuccessOrQuit(table.Add(&addresses[i], sPsk, i), "JoinerTable::Add() failed\n");
+    }
+
+    VerifyOrQuit(table.GetNextExpiring() == table.Find(&addresses[0]),
+                 "JoinerTable::GetNextExpiring() is not the first Joiner added\n");
+
+    // Adding a Joiner again moves it to the end of the expiry list.
+    SuccessOrQuit(table.Add(&addresses[0], sPsk, kNumJoiners), "JoinerTable::Add() failed to update a Joiner\n");
+
+    if (kNumJoiners > 1)
+    {
+        // Remove the Joiner just ahead of the tail.
+        SuccessOrQuit(table.Remove(&addresses[kNumJoiners - 1]), "JoinerTable::Remove() failed\n");
+
+        for (uint16_t i = 1; i < kNumJoiners - 1; i++)
+        {
+            expected[numExpected++] = i;
+        }
+    }
+
+    expected[numExpected++] = kNumJoiners;
+
+    if (kNumJoiners > 1)
+    {
+        Mac::ExtAddress address;
+
+        InitAddress(address, kNumJoiners);
+        SuccessOrQuit(table.Add(&address, sPsk, kNumJoiners + 1), "JoinerTable::Add() failed\n");
+        expected[numExpected++] = kNumJoiners + 1;
+    }
+
+    // Drain the table the way the Commissioner expires its Joiners.
+    for (uint16_t i = 0; i < numExpected; i++)
+    {
+        VerifyOrQuit((joiner = table.GetNextExpiring()) != NULL && joiner->GetExpiration() == expected[i],
+                     "JoinerTable::GetNextExpiring() is out of order\n");
+        table.Remove(*joiner);
+    }
+
+    VerifyOrQuit(table.GetNextExpiring() == NULL && table.GetNumJoiners() == 0,
+                 "JoinerTable::GetNextExpiring() returned a removed Joiner\n");
+}
+
+void TestJoinerTableSteeringData(void)
+{
+    JoinerTable table;
+    Mac::ExtAddress addresses[kNumAddresses];
+    bool added[kNumAddresses];
+    bool any = false;
+    uint16_t numJoiners = 0;
+    uint32_t random = 1;
+
+    for (uint16_t i = 0; i < kNumAddresses; i++)
+    {
+        InitAddress(addresses[i], 0x1234 + 7 * i);
+        added[i] = false;
+    }
+
+    VerifySteeringData(table, addresses, added, kNumAddresses, any);
+
+    for (uint16_t step = 0; step < 1000; step++)
+    {
+        uint16_t index;
+        ThreadError error;
+
+        random = random * 1103515245 + 12345;
+        index = (random >> 16) % (kNumAddresses + 1);
+
+        if (index == kNumAddresses)
+        {
+            // Toggle any Joiner.
+            if (any)
+            {
+                SuccessOrQuit(table.Remove(NULL), "JoinerTable::Remove() failed for any Joiner\n");
+                any = false;
+                numJoiners--;
+            }
+            else if ((error = table.Add(NULL, sPsk, step)) == kThreadError_None)
+            {
+                any = true;
+                numJoiners++;
+            }
+            else
+            {
+                VerifyOrQuit(error == kThreadError_NoBufs && numJoiners == kNumJoiners,
+                             "JoinerTable::Add() failed for any Joiner\n");
+            }
+        }
+        else if (added[index])
+        {
+            SuccessOrQuit(table.Remove(&addresses[index]), "JoinerTable::Remove() failed\n");
+            added[index] = false;
+            numJoiners--;
+        }
+        else if ((error = table.Add(&addresses[index], sPsk, step)) == kThreadError_None)
+        {
+            added[index] = true;
+            numJoiners++;
+        }
+        else
+        {
+            VerifyOrQuit(error == kThreadError_NoBufs && numJoiners == kNumJoiners, "JoinerTable::Add() failed\n");
+        }
+
+        VerifyOrQuit(table.GetNumJoiners() == numJoiners, "JoinerTable::GetNumJoiners() is wrong\n");
+        VerifySteeringData(table, addresses, added, kNumAddresses, any);
+    }
+}
+
+void TestJoinerTableFull(void)
+{
+    JoinerTable table;
+    Mac::ExtAddress addresses[2 * kNumJoiners + 1];
+
+    for (uint16_t i = 0; i < 2 * kNumJoiners + 1; i++)
+    {
+        InitAddress(addresses[i], i);
+    }
+
+    for (uint16_t round = 0; round < 2; round++)
+    {
+        const Mac::ExtAddress *first = &addresses[round * kNumJoiners];
+
+        for (uint16_t i = 0; i < kNumJoiners; i++)
+        {
+            SuccessOrQuit(table.Add(&first[i], sPsk, i), "JoinerTable::Add() failed to reuse an entry\n");
+        }
+
+        VerifyOrQuit(table.GetNumJoiners() == kNumJoiners, "JoinerTable::GetNumJoiners() is wrong when full\n");
+        VerifyOrQuit(table.Add(&first[kNumJoiners], sPsk, 0) == kThreadError_NoBufs &&
+                     table.Add(NULL, sPsk, 0) == kThreadError_NoBufs,
+                     "JoinerTable::Add() succeeded on a full table\n");
+        SuccessOrQuit(table.Add(&first[0], sPsk, kNumJoiners), "JoinerTable::Add() failed to update a Joiner\n");
+
+        // Freeing a single entry makes room for exactly one Joiner.
+        table.Remove(*table.Find(&first[kNumJoiners - 1]));
+        SuccessOrQuit(table.Add(&first[kNumJoiners], sPsk, 0), "JoinerTable::Add() failed to reuse an entry\n");
+        VerifyOrQuit(table.Add(&first[kNumJoiners - 1], sPsk, 0) == kThreadError_NoBufs,
+                     "JoinerTable::Add() succeeded on a full table\n");
+        VerifyOrQuit(table.Find(&first[kNumJoiners]) != NULL && table.Find(&first[kNumJoiners - 1]) == NULL,
+                     "JoinerTable::Add() did not reuse the freed entry\n");
+
+        if (round == 0)
+        {
+            // Empty the table entry by entry, so that the second round allocates from a reordered free list.
+            for (uint16_t i = 0; i <= kNumJoiners; i++)
+            {
+                if (i != kNumJoiners - 1)
+                {
+                    SuccessOrQuit(table.Remove(&first[i]), "JoinerTable::Remove() failed\n");
+                }
+            }
+        }
+        else
+        {
+            table.Clear();
+        }
+
+        VerifyOrQuit(table.GetNumJoiners() == 0 && table.GetNextExpiring() == NULL,
+                     "JoinerTable is not empty\n");
+    }
+
+    for (uint16_t i = 0; i < kNumJoiners; i++)
+    {
+        SuccessOrQuit(table.Add(&addresses[i], sPsk, i), "JoinerTable::Add() failed after Clear()\n");
+    }
+}
+
+}  // namespace Thread
+
+#ifdef ENABLE_TEST_MAIN
+int main(void)
+{
+    Thread::TestJoinerTableAddRemove();
+    Thread::TestJoinerTableAny();
+    Thread::TestJoinerTableCollisions();
+    Thread::TestJoinerTableExpiry();
+    Thread::TestJoinerTableSteeringData();
+    Thread::TestJoinerTableFull();
+    printf("All tests passed\n");
+    return 0;
+}
+#endif
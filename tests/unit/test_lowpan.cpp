@@ -79,6 +79,7 @@ void TestLowpanIphc(void)
         Mac::Frame frame;
         frame.mPsdu = iphcVector.data();
         frame.mLength = static_cast<uint8_t>(iphcVector.size());
+        SuccessOrQuit(frame.ParseHeader(), "6lo: Frame::ParseHeader failed");
         frame.GetSrcAddr(macSource);
         frame.GetDstAddr(macDest);
 
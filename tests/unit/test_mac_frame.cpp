@@ -82,12 +82,81 @@ void TestMacHeader(void)
     }
 }
 
+static void InitTestFrame(Mac::Frame &aFrame)
+{
+    Mac::ExtAddress extAddress;
+
+    for (unsigned i = 0; i < sizeof(extAddress); i++)
+    {
+        extAddress.m8[i] = static_cast<uint8_t>(i + 1);
+    }
+
+    aFrame.InitMacHeader(Mac::Frame::kFcfFrameData | Mac::Frame::kFcfPanidCompression | Mac::Frame::kFcfDstAddrShort |
+                         Mac::Frame::kFcfSrcAddrExt | Mac::Frame::kFcfSecurityEnabled,
+                         Mac::Frame::kSecEncMic32 | Mac::Frame::kKeyIdMode1);
+    aFrame.SetSequence(0x5a);
+    aFrame.SetDstPanId(0xface);
+    aFrame.SetDstAddr(0x1234);
+    aFrame.SetSrcAddr(extAddress);
+    aFrame.SetFrameCounter(0x01020304);
+    aFrame.SetKeyId(7);
+    aFrame.SetPayloadLength(40);
+}
+
+void TestMacFrameParse(void)
+{
+    uint8_t txPsdu[Mac::Frame::kMTU];
+    uint8_t rxPsdu[Mac::Frame::kMTU];
+    Mac::Frame txFrame;
+    Mac::Frame rxFrame;
+    Mac::Address address;
+    Mac::PanId panid;
+    uint32_t frameCounter;
+    uint8_t keyId;
+
+    txFrame.mPsdu = txPsdu;
+    InitTestFrame(txFrame);
+
+    memcpy(rxPsdu, txPsdu, sizeof(rxPsdu));
+    rxFrame.mPsdu = rxPsdu;
+    rxFrame.SetPsduLength(txFrame.GetPsduLength());
+
+    VerifyOrQuit(rxFrame.ParseHeader() == kThreadError_None, "MacFrameParse failed to parse valid frame\n");
+    VerifyOrQuit(rxFrame.GetHeaderLength() == txFrame.GetHeaderLength() &&
+                 rxFrame.GetFooterLength() == txFrame.GetFooterLength() &&
+                 rxFrame.GetPayloadLength() == 40, "MacFrameParse header/footer length mismatch\n");
+
+    VerifyOrQuit(rxFrame.GetSequence() == 0x5a, "MacFrameParse sequence mismatch\n");
+    VerifyOrQuit(rxFrame.GetDstPanId(panid) == kThreadError_None && panid == 0xface, "MacFrameParse dst panid mismatch\n");
+    VerifyOrQuit(rxFrame.GetSrcPanId(panid) == kThreadError_None && panid == 0xface, "MacFrameParse src panid mismatch\n");
+    VerifyOrQuit(rxFrame.GetDstAddr(address) == kThreadError_None && address.mLength == sizeof(Mac::ShortAddress) &&
+                 address.mShortAddress == 0x1234, "MacFrameParse dst address mismatch\n");
+    VerifyOrQuit(rxFrame.GetSrcAddr(address) == kThreadError_None && address.mLength == sizeof(Mac::ExtAddress) &&
+                 address.mExtAddress.m8[0] == 1 && address.mExtAddress.m8[7] == 8, "MacFrameParse src address mismatch\n");
+    VerifyOrQuit(rxFrame.GetFrameCounter(frameCounter) == kThreadError_None && frameCounter == 0x01020304,
+                 "MacFrameParse frame counter mismatch\n");
+    VerifyOrQuit(rxFrame.GetKeyId(keyId) == kThreadError_None && keyId == 7, "MacFrameParse key id mismatch\n");
+
+    // Truncated frames must be rejected.
+    rxFrame.SetPsduLength(txFrame.GetHeaderLength() + txFrame.GetFooterLength() - 1);
+    VerifyOrQuit(rxFrame.ParseHeader() == kThreadError_Parse, "MacFrameParse accepted truncated frame\n");
+
+    rxFrame.SetPsduLength(2);
+    VerifyOrQuit(rxFrame.ParseHeader() == kThreadError_Parse, "MacFrameParse accepted short frame\n");
+
+    // Reserved addressing modes must be rejected.
+    rxFrame.SetPsduLength(txFrame.GetPsduLength());
+    rxPsdu[1] = (rxPsdu[1] & ~(Mac::Frame::kFcfDstAddrMask >> 8)) | (1 << 2);
+    VerifyOrQuit(rxFrame.ParseHeader() == kThreadError_Parse, "MacFrameParse accepted reserved address mode\n");
+}
+
 }  // namespace Thread
 
 #ifdef ENABLE_TEST_MAIN
 int main(void)
 {
     Thread::TestMacHeader();
+    Thread::TestMacFrameParse();
     printf("All tests passed\n");
     return 0;
 }
@@ -0,0 +1,166 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_util.h"
+#include <openthread.h>
+#include <common/debug.hpp>
+#include <string.h>
+
+#include <mac/mac_frame.hpp>
+#include <net/ip6_headers.hpp>
+#include <thread/mesh_forwarder.hpp>
+#include <thread/thread_netif.hpp>
+
+namespace Thread {
+
+enum
+{
+    kPayloadLength = 1000,
+};
+
+static Ip6::Ip6 sIp6;
+static ThreadNetif sMockThreadNetif(sIp6);
+
+static Message *NewDatagram(void)
+{
+    Ip6::Header ip6Header;
+    uint8_t payload[kPayloadLength];
+    Message *message;
+
+    memset(&ip6Header, 0, sizeof(ip6Header));
+    ip6Header.Init();
+    ip6Header.SetPayloadLength(sizeof(payload));
+    ip6Header.SetNextHeader(Ip6::kProtoIcmp6);
+    ip6Header.SetHopLimit(64);
+    ip6Header.GetSource().mFields.m16[0] = HostSwap16(0xfe80);
+    ip6Header.GetSource().mFields.m8[15] = 1;
+    ip6Header.GetDestination().mFields.m16[0] = HostSwap16(0xfe80);
+    ip6Header.GetDestination().mFields.m8[15] = 2;
+
+    for (uint16_t i = 0; i < sizeof(payload); i++)
+    {
+        payload[i] = static_cast<uint8_t>(i);
+    }
+
+    VerifyOrQuit((message = sIp6.mMessagePool.New(Message::kTypeIp6, 0)) != NULL, "MessagePool::New() failed\n");
+    SuccessOrQuit(message->Append(&ip6Header, sizeof(ip6Header)), "Message::Append() failed\n");
+    SuccessOrQuit(message->Append(payload, sizeof(payload)), "Message::Append() failed\n");
+    message->SetDirectTransmission();
+
+    return message;
+}
+
+static void SecureFrame(Mac::Frame &aFrame, uint8_t aValue)
+{
+    // the MAC layer encrypts a prepared frame in place, so its payload no longer holds the 6LoWPAN headers
+    memset(aFrame.GetPayload(), aValue, aFrame.GetPayloadLength());
+}
+
+void TestMeshForwarderPreparedFrame(void)
+{
+    MeshForwarder &forwarder = sMockThreadNetif.GetMeshForwarder();
+    uint8_t psdu[6][Mac::Frame::kMTU];
+    Mac::Frame frames[6];
+    Mac::Address macDest;
+    Message *message = NewDatagram();
+    uint16_t nextOffset;
+
+    for (uint8_t i = 0; i < 6; i++)
+    {
+        frames[i].mPsdu = psdu[i];
+    }
+
+    forwarder.mSendMessage = message;
+    forwarder.mMessageNextOffset = 0;
+    forwarder.mMacSource.mLength = sizeof(Mac::ShortAddress);
+    forwarder.mMacSource.mShortAddress = 0x0400;
+    forwarder.mMacDest.mLength = sizeof(Mac::ShortAddress);
+    forwarder.mMacDest.mShortAddress = 0x0800;
+    forwarder.mAddMeshHeader = false;
+
+    // the first fragment is formed on request, the second one while the first is on air
+    SuccessOrQuit(forwarder.HandleFrameRequest(frames[0]), "first fragment was not formed\n");
+    VerifyOrQuit(forwarder.mMessageNextOffset > 0 && forwarder.mMessageNextOffset < message->GetLength(),
+                 "datagram was not fragmented\n");
+
+    SuccessOrQuit(forwarder.HandleNextFrameRequest(frames[1]), "second fragment was not prepared\n");
+    nextOffset = forwarder.mPreparedNextOffset;
+    VerifyOrQuit(message->GetOffset() == 0, "preparing a fragment moved the datagram offset\n");
+
+    // a secured payload resembling a mesh header does not invalidate the prepared fragment
+    SecureFrame(frames[1], 0xbf);
+    forwarder.HandleSentFrame(frames[0], kThreadError_None);
+    VerifyOrQuit(forwarder.HandleFrameRequest(frames[1]) == kThreadError_Already, "prepared fragment was dropped\n");
+    VerifyOrQuit(forwarder.mMessageNextOffset == nextOffset, "prepared fragment did not advance the datagram\n");
+
+    // a route change while the fragment waits has it formed again
+    SuccessOrQuit(forwarder.HandleNextFrameRequest(frames[2]), "third fragment was not prepared\n");
+    SecureFrame(frames[2], 0x00);
+    forwarder.HandleSentFrame(frames[1], kThreadError_None);
+    forwarder.mMacDest.mShortAddress = 0x0c00;
+    SuccessOrQuit(forwarder.HandleFrameRequest(frames[2]), "stale fragment was kept\n");
+    frames[2].GetDstAddr(macDest);
+    VerifyOrQuit(macDest.mShortAddress == 0x0c00, "fragment was not formed for the new route\n");
+
+    // the mesh header is recorded when the fragment is prepared, not read back from the secured frame
+    forwarder.mAddMeshHeader = true;
+    forwarder.mMeshSource = 0x0400;
+    forwarder.mMeshDest = 0x1000;
+    SuccessOrQuit(forwarder.HandleNextFrameRequest(frames[3]), "fourth fragment was not prepared\n");
+    SecureFrame(frames[3], 0x00);
+    forwarder.HandleSentFrame(frames[2], kThreadError_None);
+    VerifyOrQuit(forwarder.HandleFrameRequest(frames[3]) == kThreadError_Already,
+                 "prepared mesh fragment was dropped\n");
+
+    SuccessOrQuit(forwarder.HandleNextFrameRequest(frames[4]), "fifth fragment was not prepared\n");
+    SecureFrame(frames[4], 0xbf);
+    forwarder.HandleSentFrame(frames[3], kThreadError_None);
+    forwarder.mMeshDest = 0x1400;
+    SuccessOrQuit(forwarder.HandleFrameRequest(frames[4]), "fragment with a stale mesh header was kept\n");
+
+    SuccessOrQuit(forwarder.HandleNextFrameRequest(frames[5]), "sixth fragment was not prepared\n");
+    forwarder.HandleSentFrame(frames[4], kThreadError_None);
+    forwarder.mAddMeshHeader = false;
+    SuccessOrQuit(forwarder.HandleFrameRequest(frames[5]), "fragment with a removed mesh header was kept\n");
+
+    forwarder.mPreparedMessage = NULL;
+    forwarder.mSendMessage = NULL;
+    forwarder.mSendBusy = false;
+    message->Free();
+}
+
+}  // namespace Thread
+
+#ifdef ENABLE_TEST_MAIN
+int main(void)
+{
+    Thread::TestMeshForwarderPreparedFrame();
+    printf("All tests passed\n");
+    return 0;
+}
+#endif
@@ -60,10 +60,180 @@ void TestMessage(void)
                   "Message::Free failed\n");
 }
 
+void TestMessageQueuePriority(void)
+{
+    static const uint8_t kPriorities[] =
+    {
+        Thread::Message::kPriorityNormal, Thread::Message::kPriorityLow, Thread::Message::kPriorityNetwork,
+        Thread::Message::kPriorityNormal, Thread::Message::kPriorityHigh, Thread::Message::kPriorityNetwork,
+    };
+    static const uint8_t kExpectedOrder[] = {2, 5, 4, 0, 3, 1};
+
+    Thread::MessagePool messagePool;
+    Thread::MessageQueue messageQueue;
+    Thread::Message *messages[sizeof(kPriorities)];
+    Thread::Message *message;
+    unsigned i;
+
+    for (i = 0; i < sizeof(kPriorities); i++)
+    {
+        VerifyOrQuit((messages[i] = messagePool.New(Thread::Message::kTypeIp6, 0)) != NULL,
+                     "Message::New failed\n");
+        VerifyOrQuit(messages[i]->GetPriority() == Thread::Message::kPriorityNormal,
+                     "Message::GetPriority failed\n");
+        SuccessOrQuit(messages[i]->SetPriority(kPriorities[i]),
+                      "Message::SetPriority failed\n");
+        SuccessOrQuit(messageQueue.Enqueue(*messages[i]),
+                      "MessageQueue::Enqueue failed\n");
+    }
+
+    VerifyOrQuit(messages[0]->SetPriority(Thread::Message::kNumPriorities) == kThreadError_InvalidArgs,
+                 "Message::SetPriority accepted an invalid priority\n");
+
+    // higher classes first, arrival order within a class
+    for (i = 0, message = messageQueue.GetHead(); i < sizeof(kExpectedOrder); i++, message = message->GetNext())
+    {
+        VerifyOrQuit(message == messages[kExpectedOrder[i]],
+                     "MessageQueue priority order failed\n");
+    }
+
+    VerifyOrQuit(message == NULL, "MessageQueue length failed\n");
+
+    // raising the priority of a queued message moves it behind the messages of its new class
+    SuccessOrQuit(messages[1]->SetPriority(Thread::Message::kPriorityNetwork),
+                  "Message::SetPriority failed\n");
+    VerifyOrQuit(messageQueue.GetHead()->GetNext()->GetNext() == messages[1],
+                 "Message::SetPriority reorder failed\n");
+
+    for (i = 0; i < sizeof(kPriorities); i++)
+    {
+        SuccessOrQuit(messageQueue.Dequeue(*messages[i]),
+                      "MessageQueue::Dequeue failed\n");
+        SuccessOrQuit(messages[i]->Free(),
+                      "Message::Free failed\n");
+    }
+
+    VerifyOrQuit(messageQueue.GetHead() == NULL, "MessageQueue::Dequeue failed\n");
+}
+
+static Thread::Message *HandleEvict(void *aContext, uint8_t aPriority)
+{
+    Thread::MessageQueue *queue = static_cast<Thread::MessageQueue *>(aContext);
+    Thread::Message *message = queue->GetHead();
+
+    if (message != NULL && message->GetPriority() < aPriority)
+    {
+        queue->Dequeue(*message);
+    }
+    else
+    {
+        message = NULL;
+    }
+
+    return message;
+}
+
+void TestMessagePoolReservation(void)
+{
+    Thread::MessagePool messagePool;
+    Thread::MessageQueue messageQueue;
+    Thread::Message *low[Thread::kMaxLowPriorityBuffers];
+    Thread::Message *normal[Thread::kNumBuffers];
+    Thread::Message *network[Thread::kNumReservedBuffers];
+    Thread::Message *message;
+    int numNormal;
+    int i;
+
+    // low priority messages are capped
+    for (i = 0; i < Thread::kMaxLowPriorityBuffers; i++)
+    {
+        VerifyOrQuit((low[i] = messagePool.New(Thread::Message::kTypeIp6, 0, Thread::Message::kPriorityLow)) != NULL,
+                     "MessagePool::New failed\n");
+        SuccessOrQuit(messageQueue.Enqueue(*low[i]), "MessageQueue::Enqueue failed\n");
+    }
+
+    VerifyOrQuit(messagePool.New(Thread::Message::kTypeIp6, 0, Thread::Message::kPriorityLow) == NULL,
+                 "MessagePool::New exceeded the low priority limit\n");
+
+    // other messages may not use the network reserve
+    for (numNormal = 0; (normal[numNormal] = messagePool.New(Thread::Message::kTypeIp6, 0)) != NULL; numNormal++)
+    {
+    }
+
+    VerifyOrQuit(numNormal == Thread::kNumBuffers - Thread::kMaxLowPriorityBuffers - Thread::kNumReservedBuffers,
+                 "MessagePool::New used the network reserve\n");
+
+    for (i = 0; i < Thread::kNumReservedBuffers; i++)
+    {
+        VerifyOrQuit((network[i] = messagePool.New(Thread::Message::kTypeIp6, 0,
+                                                   Thread::Message::kPriorityNetwork)) != NULL,
+                     "MessagePool::New failed to use the network reserve\n");
+    }
+
+    VerifyOrQuit(messagePool.New(Thread::Message::kTypeIp6, 0, Thread::Message::kPriorityNetwork) == NULL,
+                 "MessagePool::New exceeded the pool\n");
+
+    // with an evict handler, a higher priority request displaces a queued low priority message
+    messagePool.SetEvictHandler(&HandleEvict, &messageQueue);
+
+    VerifyOrQuit((normal[numNormal] = messagePool.New(Thread::Message::kTypeIp6, 0)) != NULL,
+                 "MessagePool::New failed to evict\n");
+    VerifyOrQuit(messageQueue.GetHead() == low[1], "MessagePool::New evicted the wrong message\n");
+    numNormal++;
+
+    // a low priority request cannot evict its own class
+    VerifyOrQuit(messagePool.New(Thread::Message::kTypeIp6, 0, Thread::Message::kPriorityLow) == NULL,
+                 "MessagePool::New evicted a message of the same class\n");
+
+    // changing the class of a message is subject to the class limit
+    SuccessOrQuit(normal[0]->SetPriority(Thread::Message::kPriorityLow), "Message::SetPriority failed\n");
+    VerifyOrQuit(normal[1]->SetPriority(Thread::Message::kPriorityLow) == kThreadError_NoBufs,
+                 "Message::SetPriority exceeded the low priority limit\n");
+
+    {
+        const otBufferCounters &counters = messagePool.GetBufferCounters();
+
+        VerifyOrQuit(counters.mFreeBuffers == 0, "free buffer count failed\n");
+        VerifyOrQuit(counters.mInUse[Thread::Message::kPriorityLow] == Thread::kMaxLowPriorityBuffers &&
+                     counters.mInUse[Thread::Message::kPriorityNormal] == numNormal - 1 &&
+                     counters.mInUse[Thread::Message::kPriorityNetwork] == Thread::kNumReservedBuffers,
+                     "in use count failed\n");
+        VerifyOrQuit(counters.mHighWater[Thread::Message::kPriorityLow] == Thread::kMaxLowPriorityBuffers &&
+                     counters.mHighWater[Thread::Message::kPriorityNormal] == numNormal,
+                     "high water count failed\n");
+        VerifyOrQuit(counters.mEvicted[Thread::Message::kPriorityLow] == 1, "evicted count failed\n");
+        VerifyOrQuit(counters.mFailed[Thread::Message::kPriorityLow] == 2 &&
+                     counters.mFailed[Thread::Message::kPriorityNormal] == 1 &&
+                     counters.mFailed[Thread::Message::kPriorityNetwork] == 1,
+                     "failed count failed\n");
+    }
+
+    while ((message = messageQueue.GetHead()) != NULL)
+    {
+        messageQueue.Dequeue(*message);
+        message->Free();
+    }
+
+    for (i = 0; i < numNormal; i++)
+    {
+        normal[i]->Free();
+    }
+
+    for (i = 0; i < Thread::kNumReservedBuffers; i++)
+    {
+        network[i]->Free();
+    }
+
+    VerifyOrQuit(messagePool.GetBufferCounters().mFreeBuffers == Thread::kNumBuffers,
+                 "MessagePool leaked buffers\n");
+}
+
 #ifdef ENABLE_TEST_MAIN
 int main(void)
 {
     TestMessage();
+    TestMessageQueuePriority();
+    TestMessagePoolReservation();
     printf("All tests passed\n");
     return 0;
 }
@@ -0,0 +1,360 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_util.h"
+#include <openthread.h>
+#include <common/debug.hpp>
+#include <string.h>
+
+#include <thread/mle_router.hpp>
+#include <thread/thread_netif.hpp>
+
+using namespace Thread;
+
+namespace Thread {
+
+enum
+{
+    kNumMeshRouters   = Mle::kMaxRouters,  // including the device under test
+    kNumNeighbors     = 6,
+    kNumUpdateRounds  = 3,
+    kUnreachable      = 0xff,
+};
+
+static Ip6::Ip6 sIp6;
+static ThreadNetif sMockThreadNetif(sIp6);
+
+// mesh node 0 is the device under test, neighbors are the nodes 1 to kNumNeighbors
+static uint8_t sRouterId[kNumMeshRouters];
+static uint8_t sLinkQuality[kNumNeighbors + 1];
+static uint8_t sLinkCost[kNumMeshRouters][kNumMeshRouters];
+static uint8_t sCost[kNumMeshRouters][kNumMeshRouters];
+static uint32_t sRandom = 0x12345678;
+
+static uint8_t GetMeshRouterId(uint8_t aNode)
+{
+    return sRouterId[aNode];
+}
+
+static uint8_t GetMeshNode(uint8_t aRouterId)
+{
+    uint8_t node = 0;
+
+    while (node < kNumMeshRouters && sRouterId[node] != aRouterId)
+    {
+        node++;
+    }
+
+    return node;
+}
+
+static uint8_t GetRandom(uint8_t aModulus)
+{
+    sRandom = sRandom * 1103515245 + 12345;
+    return static_cast<uint8_t>((sRandom >> 16) % aModulus);
+}
+
+static uint8_t GetRandomLinkQuality(void)
+{
+    // link quality 1, 2 or 3
+    return static_cast<uint8_t>(GetRandom(3) + 1);
+}
+
+static uint8_t LinkQualityToCost(uint8_t aLinkQuality)
+{
+    static const uint8_t kCosts[] = {Mle::kMaxRouteCost, 4, 2, 1};
+    return kCosts[aLinkQuality];
+}
+
+static void AddMeshLink(uint8_t aNode1, uint8_t aNode2, uint8_t aCost)
+{
+    sLinkCost[aNode1][aNode2] = aCost;
+    sLinkCost[aNode2][aNode1] = aCost;
+}
+
+static void ComputeMeshCosts(void)
+{
+    for (uint8_t i = 0; i < kNumMeshRouters; i++)
+    {
+        for (uint8_t j = 0; j < kNumMeshRouters; j++)
+        {
+            sCost[i][j] = (i == j) ? 0 : sLinkCost[i][j];
+        }
+    }
+
+    for (uint8_t k = 0; k < kNumMeshRouters; k++)
+    {
+        for (uint8_t i = 0; i < kNumMeshRouters; i++)
+        {
+            for (uint8_t j = 0; j < kNumMeshRouters; j++)
+            {
+                if (sCost[i][k] != kUnreachable && sCost[k][j] != kUnreachable &&
+                    sCost[i][k] + sCost[k][j] < sCost[i][j])
+                {
+                    sCost[i][j] = static_cast<uint8_t>(sCost[i][k] + sCost[k][j]);
+                }
+            }
+        }
+    }
+}
+
+static void StartLeader(Mle::MleRouter &aMle)
+{
+    uint8_t routerId;
+
+    if (aMle.GetDeviceState() != Mle::kDeviceStateLeader)
+    {
+        SuccessOrQuit(sMockThreadNetif.Up(), "ThreadNetif::Up() failed\n");
+        SuccessOrQuit(aMle.Start(), "Mle::Start() failed\n");
+        SuccessOrQuit(aMle.BecomeLeader(), "MleRouter::BecomeLeader() failed\n");
+    }
+
+    sRouterId[0] = Mle::Mle::GetRouterId(aMle.GetRloc16());
+    routerId = 0;
+
+    for (uint8_t node = 1; node < kNumMeshRouters; node++, routerId++)
+    {
+        if (routerId == sRouterId[0])
+        {
+            routerId++;
+        }
+
+        sRouterId[node] = routerId;
+    }
+}
+
+static void BuildMesh(Mle::MleRouter &aMle)
+{
+    Router *routers = aMle.GetRouters(NULL);
+    LinkQualityInfo &noiseFloor = sMockThreadNetif.GetMac().GetNoiseFloor();
+
+    StartLeader(aMle);
+    memset(sLinkCost, kUnreachable, sizeof(sLinkCost));
+
+    // a ring with random chords keeps every router within kMaxRouteCost of the others
+    for (uint8_t i = 1; i < kNumMeshRouters; i++)
+    {
+        AddMeshLink(i, (i % (kNumMeshRouters - 1)) + 1, LinkQualityToCost(GetRandomLinkQuality()));
+        AddMeshLink(i, GetRandom(kNumMeshRouters - 1) + 1, LinkQualityToCost(GetRandomLinkQuality()));
+    }
+
+    for (uint8_t i = 0; i <= Mle::kMaxRouterId; i++)
+    {
+        if (i != sRouterId[0])
+        {
+            memset(&routers[i], 0, sizeof(routers[i]));
+            routers[i].mNextHop = Mle::kInvalidRouterId;
+            routers[i].mAltNextHop = Mle::kInvalidRouterId;
+        }
+    }
+
+    for (uint8_t node = 1; node < kNumMeshRouters; node++)
+    {
+        Router &router = routers[GetMeshRouterId(node)];
+
+        router.mAllocated = true;
+
+        if (node <= kNumNeighbors)
+        {
+            // the link quality out is learned from the Route TLV of the neighbor
+            sLinkQuality[node] = GetRandomLinkQuality();
+            AddMeshLink(0, node, LinkQualityToCost(sLinkQuality[node]));
+
+            router.mState = Neighbor::kStateValid;
+            router.mValid.mRloc16 = Mle::Mle::GetRloc16(GetMeshRouterId(node));
+            router.mLinkInfo.AddRss(noiseFloor, -30);
+        }
+    }
+
+    ComputeMeshCosts();
+
+    for (uint8_t node = 1; node < kNumMeshRouters; node++)
+    {
+        VerifyOrQuit(sCost[0][node] < Mle::kMaxRouteCost, "mesh is not connected\n");
+    }
+}
+
+static void FillRouteTlv(Mle::RouteTlv &aTlv, uint8_t aNode)
+{
+    uint8_t routeCount = 0;
+
+    aTlv.Init();
+    aTlv.SetRouterIdSequence(0);
+    aTlv.ClearRouterIdMask();
+
+    for (uint8_t routerId = 0; routerId <= Mle::kMaxRouterId; routerId++)
+    {
+        uint8_t node = GetMeshNode(routerId);
+
+        if (node == kNumMeshRouters)
+        {
+            continue;
+        }
+
+        aTlv.SetRouterId(routerId);
+        aTlv.SetLinkQualityIn(routeCount, (node == 0) ? sLinkQuality[aNode] : 0);
+        aTlv.SetLinkQualityOut(routeCount, (node == 0) ? sLinkQuality[aNode] : 0);
+        aTlv.SetRouteCost(routeCount, (node == aNode || sCost[aNode][node] >= Mle::kMaxRouteCost) ?
+                          0 : sCost[aNode][node]);
+        routeCount++;
+    }
+
+    aTlv.SetRouteDataLength(routeCount);
+}
+
+static bool IsNeighborValid(Mle::MleRouter &aMle, uint8_t aNode)
+{
+    return aMle.GetRouters(NULL)[GetMeshRouterId(aNode)].mState == Neighbor::kStateValid;
+}
+
+static void VerifyRoutes(Mle::MleRouter &aMle)
+{
+    Router *routers = aMle.GetRouters(NULL);
+
+    for (uint8_t node = 1; node < kNumMeshRouters; node++)
+    {
+        const Router &router = routers[GetMeshRouterId(node)];
+        uint8_t nextHop = GetMeshNode(router.mNextHop);
+
+        VerifyOrQuit(router.mNextHop != Mle::kInvalidRouterId, "MleRouter::UpdateRoutes() missed a route\n");
+        VerifyOrQuit(nextHop <= kNumNeighbors && sLinkCost[0][nextHop] != kUnreachable,
+                     "MleRouter::UpdateRoutes() selected a next hop which is not a neighbor\n");
+        VerifyOrQuit(sLinkCost[0][nextHop] + sCost[nextHop][node] == sCost[0][node],
+                     "MleRouter::UpdateRoutes() did not select the least cost route\n");
+
+        if (router.mAltNextHop != Mle::kInvalidRouterId)
+        {
+            VerifyOrQuit(router.mAltNextHop != router.mNextHop,
+                         "MleRouter::UpdateRoutes() selected the primary next hop as alternate\n");
+            VerifyOrQuit(sCost[GetMeshNode(router.mAltNextHop)][node] < sCost[0][node],
+                         "MleRouter::UpdateRoutes() selected an alternate which may loop back\n");
+        }
+    }
+}
+
+void TestMleRouterUpdateRoutes(void)
+{
+    Mle::MleRouter &mle = sMockThreadNetif.GetMle();
+    Mle::RouteTlv tlv;
+
+    BuildMesh(mle);
+
+    // advertisements repeating the same routes must keep the routing table unchanged
+    for (int i = 0; i < kNumUpdateRounds; i++)
+    {
+        for (uint8_t node = 1; node <= kNumNeighbors; node++)
+        {
+            FillRouteTlv(tlv, node);
+            mle.UpdateRoutes(tlv, GetMeshRouterId(node));
+        }
+
+        VerifyRoutes(mle);
+    }
+}
+
+void TestMleRouterFailover(void)
+{
+    Mle::MleRouter &mle = sMockThreadNetif.GetMle();
+    Router *routers = mle.GetRouters(NULL);
+    uint8_t primary[Mle::kMaxRouterId + 1];
+    uint8_t alternate[Mle::kMaxRouterId + 1];
+    Mle::RouteTlv tlv;
+    uint16_t nextHop;
+    int failovers = 0;
+
+    for (uint8_t neighbor = 1; neighbor <= kNumNeighbors; neighbor++)
+    {
+        uint8_t failedRouterId = GetMeshRouterId(neighbor);
+
+        BuildMesh(mle);
+
+        for (uint8_t node = 1; node <= kNumNeighbors; node++)
+        {
+            FillRouteTlv(tlv, node);
+            mle.UpdateRoutes(tlv, GetMeshRouterId(node));
+        }
+
+        for (uint8_t i = 0; i <= Mle::kMaxRouterId; i++)
+        {
+            primary[i] = routers[i].mNextHop;
+            alternate[i] = routers[i].mAltNextHop;
+        }
+
+        // the link to the neighbor fails, routes must move over before the next advertisement
+        SuccessOrQuit(mle.RemoveNeighbor(routers[failedRouterId]), "MleRouter::RemoveNeighbor() failed\n");
+
+        for (uint8_t node = 1; node < kNumMeshRouters; node++)
+        {
+            uint8_t routerId = GetMeshRouterId(node);
+
+            if (primary[routerId] != failedRouterId || alternate[routerId] == Mle::kInvalidRouterId)
+            {
+                continue;
+            }
+
+            VerifyOrQuit(routers[routerId].mNextHop == alternate[routerId],
+                         "MleRouter::RemoveNeighbor() did not fail over to the alternate\n");
+
+            nextHop = mle.GetNextHop(Mle::Mle::GetRloc16(routerId));
+            VerifyOrQuit(nextHop != Mac::kShortAddrInvalid && nextHop != Mle::Mle::GetRloc16(failedRouterId),
+                         "MleRouter::GetNextHop() did not route around the failed link\n");
+
+            failovers++;
+        }
+
+        // the next advertisements restore least cost routes over the remaining links
+        for (uint8_t node = 1; node <= kNumNeighbors; node++)
+        {
+            if (IsNeighborValid(mle, node))
+            {
+                FillRouteTlv(tlv, node);
+                mle.UpdateRoutes(tlv, GetMeshRouterId(node));
+            }
+        }
+
+        for (uint8_t node = 1; node < kNumMeshRouters; node++)
+        {
+            VerifyOrQuit(routers[GetMeshRouterId(node)].mNextHop != failedRouterId,
+                         "MleRouter::UpdateRoutes() kept a route over the failed link\n");
+        }
+    }
+
+    VerifyOrQuit(failovers > 0, "no route was failed over\n");
+}
+
+}  // namespace Thread
+
+#ifdef ENABLE_TEST_MAIN
+int main(void)
+{
+    TestMleRouterUpdateRoutes();
+    TestMleRouterFailover();
+    printf("All tests passed\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,337 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_util.h"
+#include <string.h>
+#include <openthread.h>
+#include <ncp/ncp.h>
+#include <ncp/spinel.h>
+#include <platform/platform.h>
+#include <platform/spi-slave.h>
+
+// This module implements a loopback test of the NCP SPI interface against a simulated SPI master.
+
+enum
+{
+    kSpiHeaderLength   = 5,
+    kSpiBufferSize     = 1500,
+    kFlagReset         = 0x80,
+    kFlagAggregate     = 0x20,
+    kPatternValue      = 0x02,
+    kPatternMask       = 0x03,
+    kMaxResponses      = 8,
+};
+
+static otPlatSpiSlaveTransactionCompleteCallback sCompleteCallback;
+static void *sCompleteContext;
+static uint8_t *sOutputBuf;
+static uint16_t sOutputBufLen;
+static uint8_t *sInputBuf;
+static uint16_t sInputBufLen;
+
+static otInstance *sInstance;
+
+extern "C" void otSignalTaskletPending(otInstance *)
+{
+}
+
+extern "C" void otPlatUartSendDone(void)
+{
+}
+
+extern "C" void otPlatUartReceived(const uint8_t *aBuf, uint16_t aBufLength)
+{
+    (void)aBuf;
+    (void)aBufLength;
+}
+
+extern "C" ThreadError otPlatSpiSlaveEnable(otPlatSpiSlaveTransactionCompleteCallback aCallback, void *aContext)
+{
+    sCompleteCallback = aCallback;
+    sCompleteContext = aContext;
+    return kThreadError_None;
+}
+
+extern "C" void otPlatSpiSlaveDisable(void)
+{
+}
+
+extern "C" ThreadError otPlatSpiSlavePrepareTransaction(uint8_t *anOutputBuf, uint16_t anOutputBufLen,
+                                                        uint8_t *anInputBuf, uint16_t anInputBufLen,
+                                                        bool aRequestTransactionFlag)
+{
+    (void)aRequestTransactionFlag;
+
+    sOutputBuf = anOutputBuf;
+    sOutputBufLen = anOutputBufLen;
+    sInputBuf = anInputBuf;
+    sInputBufLen = anInputBufLen;
+
+    return kThreadError_None;
+}
+
+static uint16_t GetLittleEndian16(const uint8_t *aBuf)
+{
+    return static_cast<uint16_t>(aBuf[0] | (aBuf[1] << 8));
+}
+
+static void SetLittleEndian16(uint8_t *aBuf, uint16_t aValue)
+{
+    aBuf[0] = aValue & 0xff;
+    aBuf[1] = aValue >> 8;
+}
+
+/**
+ * This function clocks a single SPI transaction of `aLength` bytes, as a SPI master would.
+ *
+ */
+static void SpiTransaction(const uint8_t *aMosi, uint16_t aMosiLength, uint8_t *aMiso, uint16_t aLength)
+{
+    uint8_t *outputBuf = sOutputBuf;
+    uint16_t outputBufLen = sOutputBufLen;
+    uint8_t *inputBuf = sInputBuf;
+    uint16_t inputBufLen = sInputBufLen;
+
+    memset(aMiso, 0xff, aLength);
+    memcpy(aMiso, outputBuf, outputBufLen < aLength ? outputBufLen : aLength);
+
+    if (aMosiLength > aLength)
+    {
+        aMosiLength = aLength;
+    }
+
+    memcpy(inputBuf, aMosi, aMosiLength < inputBufLen ? aMosiLength : inputBufLen);
+
+    sOutputBuf = NULL;
+    sOutputBufLen = 0;
+    sInputBuf = NULL;
+    sInputBufLen = 0;
+
+    sCompleteCallback(sCompleteContext, outputBuf, outputBufLen, inputBuf, inputBufLen, aLength);
+}
+
+/**
+ * This function exchanges one frame in each direction: it first polls the slave with a header-only transaction and
+ * then clocks a transaction long enough for both the host data and the pending slave data.
+ *
+ * @returns The header flag byte of the slave's data frame, the slave data is copied to `aRxData`.
+ *
+ */
+static uint8_t SpiExchange(uint8_t aFlags, const uint8_t *aTxData, uint16_t aTxLength,
+                           uint8_t *aRxData, uint16_t &aRxLength, uint16_t &aSlaveAcceptLength)
+{
+    uint8_t mosi[kSpiBufferSize];
+    uint8_t miso[kSpiBufferSize];
+    uint16_t slaveDataLength;
+    uint16_t length;
+
+    mosi[0] = aFlags | kPatternValue;
+    SetLittleEndian16(&mosi[1], kSpiBufferSize - kSpiHeaderLength);
+    SetLittleEndian16(&mosi[3], 0);
+    SpiTransaction(mosi, kSpiHeaderLength, miso, kSpiHeaderLength);
+
+    VerifyOrQuit((miso[0] & kPatternMask) == kPatternValue, "SPI pattern bits not set by the slave\n");
+    aSlaveAcceptLength = GetLittleEndian16(&miso[1]);
+    slaveDataLength = GetLittleEndian16(&miso[3]);
+
+    if (aTxLength > aSlaveAcceptLength)
+    {
+        aTxLength = 0;
+    }
+
+    SetLittleEndian16(&mosi[3], aTxLength);
+    memcpy(mosi + kSpiHeaderLength, aTxData, aTxLength);
+
+    length = kSpiHeaderLength + (aTxLength > slaveDataLength ? aTxLength : slaveDataLength);
+    SpiTransaction(mosi, kSpiHeaderLength + aTxLength, miso, length);
+
+    aRxLength = GetLittleEndian16(&miso[3]);
+    VerifyOrQuit(aRxLength + kSpiHeaderLength <= length, "slave data does not fit in the transaction\n");
+    memcpy(aRxData, miso + kSpiHeaderLength, aRxLength);
+
+    return miso[0];
+}
+
+static uint16_t BuildPropGet(uint8_t *aBuf, uint8_t aTid, uint8_t aProp)
+{
+    aBuf[0] = SPINEL_HEADER_FLAG | aTid;
+    aBuf[1] = SPINEL_CMD_PROP_VALUE_GET;
+    aBuf[2] = aProp;
+    return 3;
+}
+
+/**
+ * This function splits the slave data into Spinel frames and returns the TID of each of them.
+ *
+ */
+static uint8_t ParseResponses(uint8_t aFlags, const uint8_t *aData, uint16_t aLength, uint8_t *aTids)
+{
+    uint8_t count = 0;
+    uint16_t frameLength;
+
+    if ((aFlags & kFlagAggregate) == 0)
+    {
+        if (aLength > 0)
+        {
+            aTids[count++] = SPINEL_HEADER_GET_TID(aData[0]);
+        }
+
+        return count;
+    }
+
+    while (aLength >= 2 && count < kMaxResponses)
+    {
+        frameLength = GetLittleEndian16(aData);
+        VerifyOrQuit(frameLength > 0 && frameLength + 2 <= aLength, "malformed aggregated frame\n");
+        aTids[count++] = SPINEL_HEADER_GET_TID(aData[2]);
+        aData += frameLength + 2;
+        aLength -= frameLength + 2;
+    }
+
+    VerifyOrQuit(aLength == 0, "trailing bytes in aggregated frame\n");
+
+    return count;
+}
+
+static void ProcessTasklets(void)
+{
+    while (otAreTaskletsPending(sInstance))
+    {
+        otProcessQueuedTasklets(sInstance);
+    }
+}
+
+static void DrainSlave(uint8_t aFlags)
+{
+    uint8_t data[kSpiBufferSize];
+    uint16_t length;
+    uint16_t acceptLength;
+
+    do
+    {
+        ProcessTasklets();
+        SpiExchange(aFlags, NULL, 0, data, length, acceptLength);
+    }
+    while (length > 0);
+}
+
+void TestNcpSpiAggregation(void)
+{
+    uint8_t txData[64];
+    uint16_t txLength = 0;
+    uint8_t rxData[kSpiBufferSize];
+    uint16_t rxLength;
+    uint16_t acceptLength;
+    uint8_t tids[kMaxResponses];
+    uint8_t flags;
+    uint8_t count;
+
+    DrainSlave(kFlagAggregate);
+
+    // Two requests in one aggregated transaction.
+    SetLittleEndian16(&txData[txLength], BuildPropGet(&txData[txLength + 2], 1, SPINEL_PROP_PROTOCOL_VERSION));
+    txLength += 2 + GetLittleEndian16(&txData[txLength]);
+    SetLittleEndian16(&txData[txLength], BuildPropGet(&txData[txLength + 2], 2, SPINEL_PROP_NCP_VERSION));
+    txLength += 2 + GetLittleEndian16(&txData[txLength]);
+
+    flags = SpiExchange(kFlagAggregate, txData, txLength, rxData, rxLength, acceptLength);
+    VerifyOrQuit(acceptLength >= txLength, "slave did not accept the aggregated frame\n");
+    VerifyOrQuit((flags & kFlagReset) == 0, "reset flag still set\n");
+    VerifyOrQuit(rxLength == 0, "unexpected slave data\n");
+
+    ProcessTasklets();
+
+    // Both responses must come back in a single aggregated transaction.
+    flags = SpiExchange(kFlagAggregate, NULL, 0, rxData, rxLength, acceptLength);
+    VerifyOrQuit(flags & kFlagAggregate, "slave data is not aggregated\n");
+    count = ParseResponses(flags, rxData, rxLength, tids);
+    VerifyOrQuit(count == 2 && tids[0] == 1 && tids[1] == 2, "responses were not aggregated in order\n");
+
+    DrainSlave(kFlagAggregate);
+}
+
+void TestNcpSpiDoubleBufferedReceive(void)
+{
+    uint8_t txData[8];
+    uint16_t txLength;
+    uint8_t rxData[kSpiBufferSize];
+    uint16_t rxLength;
+    uint16_t acceptLength;
+    uint8_t tids[kMaxResponses];
+    uint8_t flags;
+    uint8_t count;
+
+    DrainSlave(0);
+
+    // The second frame is accepted while the first one has not been handled yet.
+    txLength = BuildPropGet(txData, 3, SPINEL_PROP_PROTOCOL_VERSION);
+    SpiExchange(0, txData, txLength, rxData, rxLength, acceptLength);
+    VerifyOrQuit(acceptLength > 0, "slave did not accept the first frame\n");
+
+    txLength = BuildPropGet(txData, 4, SPINEL_PROP_NCP_VERSION);
+    SpiExchange(0, txData, txLength, rxData, rxLength, acceptLength);
+    VerifyOrQuit(acceptLength > 0, "slave did not accept a frame while handling the previous one\n");
+
+    // Both receive buffers are now in use.
+    SpiExchange(0, NULL, 0, rxData, rxLength, acceptLength);
+    VerifyOrQuit(acceptLength == 0, "slave accepted more frames than it has buffers\n");
+
+    ProcessTasklets();
+
+    // A host without aggregation support gets one frame per transaction.
+    flags = SpiExchange(0, NULL, 0, rxData, rxLength, acceptLength);
+    count = ParseResponses(flags, rxData, rxLength, tids);
+    VerifyOrQuit(count == 1 && tids[0] == 3, "first response missing\n");
+
+    ProcessTasklets();
+
+    flags = SpiExchange(0, NULL, 0, rxData, rxLength, acceptLength);
+    count = ParseResponses(flags, rxData, rxLength, tids);
+    VerifyOrQuit(count == 1 && tids[0] == 4, "second response missing\n");
+
+    DrainSlave(0);
+}
+
+#ifdef ENABLE_TEST_MAIN
+int main(void)
+{
+    int argc = 2;
+    char *argv[8] = {(char *)"test_ncp_spi", (char *)"1"};
+
+    PlatformInit(argc, argv);
+    sInstance = otInstanceInit();
+    otNcpInit(sInstance);
+
+    VerifyOrQuit(sCompleteCallback != NULL, "SPI slave was not enabled\n");
+
+    TestNcpSpiAggregation();
+    TestNcpSpiDoubleBufferedReceive();
+    printf("All tests passed\n");
+    return 0;
+}
+#endif
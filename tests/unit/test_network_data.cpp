@@ -0,0 +1,444 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_util.h"
+#include <string.h>
+
+#include <common/crc16.hpp>
+#include <thread/mle_tlvs.hpp>
+#include <thread/network_data_leader.hpp>
+#include <thread/thread_netif.hpp>
+
+namespace Thread {
+
+using NetworkData::Leader;
+
+enum
+{
+    kMaxDataSize       = Leader::kMaxSize,
+    kMaxDeltaLength    = sizeof(Mle::NetworkDataDeltaTlv) - sizeof(Mle::Tlv),
+    kDeltaHeaderLength = 3,  // length and CRC16-CCITT of the resulting Network Data
+    kRecordLength      = 5,  // old and new version, offset, removed and inserted length
+    kDeltaLogSize      = OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_LOG_SIZE,
+};
+
+static Ip6::Ip6 sIp6;
+static ThreadNetif sMockThreadNetif(sIp6);
+
+// the Leader that sends the deltas and a router that applies them
+static Leader sSender(sMockThreadNetif);
+static Leader sReceiver(sMockThreadNetif);
+
+struct Data
+{
+    uint8_t mTlvs[kMaxDataSize];
+    uint8_t mLength;
+};
+
+static void InitData(Data &aData, uint8_t aLength, uint8_t aSeed)
+{
+    for (uint8_t i = 0; i < aLength; i++)
+    {
+        aData.mTlvs[i] = static_cast<uint8_t>(aSeed + 3 * i);
+    }
+
+    aData.mLength = aLength;
+}
+
+// Replaces @p aRemoveLength bytes at @p aOffset with @p aInsertLength new bytes.
+static void ChangeData(Data &aData, uint8_t aOffset, uint8_t aRemoveLength, uint8_t aInsertLength, uint8_t aSeed)
+{
+    memmove(aData.mTlvs + aOffset + aInsertLength, aData.mTlvs + aOffset + aRemoveLength,
+            aData.mLength - aOffset - aRemoveLength);
+
+    for (uint8_t i = 0; i < aInsertLength; i++)
+    {
+        aData.mTlvs[aOffset + i] = static_cast<uint8_t>(aSeed + 7 * i + 1);
+    }
+
+    aData.mLength = static_cast<uint8_t>(aData.mLength - aRemoveLength + aInsertLength);
+}
+
+// Sets the Network Data of the Leader and logs the change, as MLE does when the Network Data is updated.
+static void UpdateSender(uint8_t aVersion, const Data &aData)
+{
+    sSender.SetNetworkData(aVersion, 0, false, aData.mTlvs, aData.mLength);
+    sSender.UpdateDeltaLog();
+}
+
+static void SetReceiver(uint8_t aVersion, const Data &aData)
+{
+    sReceiver.SetNetworkData(aVersion, 0, false, aData.mTlvs, aData.mLength);
+}
+
+static void VerifyReceiver(uint8_t aVersion, const Data &aData, const char *aMessage)
+{
+    uint8_t tlvs[kMaxDataSize];
+    uint8_t length;
+
+    sReceiver.GetNetworkData(false, tlvs, length);
+
+    VerifyOrQuit(sReceiver.GetVersion() == aVersion && length == aData.mLength &&
+                 memcmp(tlvs, aData.mTlvs, length) == 0, aMessage);
+}
+
+// Builds the Network Data Delta TLV the way MLE appends it to a Data Response.
+static ThreadError GetDeltaTlv(uint8_t aVersion, Mle::NetworkDataDeltaTlv &aTlv)
+{
+    ThreadError error;
+    uint8_t length = sizeof(aTlv) - sizeof(Mle::Tlv);
+
+    aTlv.Init();
+    SuccessOrExit(error = sSender.GetDelta(aVersion, aTlv.GetDelta(), length));
+    aTlv.SetLength(length);
+
+    VerifyOrQuit(aTlv.GetType() == Mle::Tlv::kNetworkDataDelta && aTlv.IsValid(),
+                 "NetworkDataDeltaTlv is not valid\n");
+
+exit:
+    return error;
+}
+
+void TestNetworkDataDeltaRoundTrip(void)
+{
+    Mle::NetworkDataDeltaTlv tlv;
+    Data data;
+    uint8_t delta[kMaxDeltaLength];
+    uint8_t length;
+    uint16_t checksum;
+    Crc16 ccitt(Crc16::kCcitt);
+
+    sSender.Reset();
+    sReceiver.Reset();
+
+    InitData(data, 100, 0);
+    UpdateSender(10, data);
+    SetReceiver(10, data);
+
+    VerifyOrQuit(GetDeltaTlv(10, tlv) == kThreadError_NotFound, "Leader::GetDelta() provided a delta to nothing\n");
+
+    // replace
+    ChangeData(data, 20, 4, 4, 10);
+    UpdateSender(11, data);
+
+    length = sizeof(delta);
+    SuccessOrQuit(sSender.GetDelta(10, delta, length), "Leader::GetDelta() failed\n");
+    VerifyOrQuit(length == kDeltaHeaderLength + kRecordLength + 4, "Leader::GetDelta() logged more than the change\n");
+
+    for (uint8_t i = 0; i < data.mLength; i++)
+    {
+        ccitt.Update(data.mTlvs[i]);
+    }
+
+    checksum = static_cast<uint16_t>((delta[1] << 8) | delta[2]);
+    VerifyOrQuit(delta[0] == data.mLength && checksum == ccitt.Get(),
+                 "Leader::GetDelta() header does not describe the Network Data\n");
+
+    length = kDeltaHeaderLength + kRecordLength + 3;
+    VerifyOrQuit(sSender.GetDelta(10, delta, length) == kThreadError_NotFound,
+                 "Leader::GetDelta() overflowed the delta buffer\n");
+
+    SuccessOrQuit(GetDeltaTlv(10, tlv), "Leader::GetDelta() failed\n");
+    SuccessOrQuit(sReceiver.ApplyDelta(11, 0, tlv.GetDelta(), tlv.GetLength()), "Leader::ApplyDelta() failed\n");
+    VerifyReceiver(11, data, "Leader::ApplyDelta() did not replace the bytes\n");
+
+    // insert
+    ChangeData(data, 50, 0, 6, 20);
+    UpdateSender(12, data);
+    SuccessOrQuit(GetDeltaTlv(11, tlv), "Leader::GetDelta() failed\n");
+    SuccessOrQuit(sReceiver.ApplyDelta(12, 0, tlv.GetDelta(), tlv.GetLength()), "Leader::ApplyDelta() failed\n");
+    VerifyReceiver(12, data, "Leader::ApplyDelta() did not insert the bytes\n");
+
+    // remove at the end
+    ChangeData(data, data.mLength - 10, 10, 0, 0);
+    UpdateSender(13, data);
+    SuccessOrQuit(GetDeltaTlv(12, tlv), "Leader::GetDelta() failed\n");
+    VerifyOrQuit(tlv.GetLength() == kDeltaHeaderLength + kRecordLength,
+                 "Leader::GetDelta() logged more than the change\n");
+    SuccessOrQuit(sReceiver.ApplyDelta(13, 0, tlv.GetDelta(), tlv.GetLength()), "Leader::ApplyDelta() failed\n");
+    VerifyReceiver(13, data, "Leader::ApplyDelta() did not remove the bytes\n");
+
+    // a delta that is not smaller than the Network Data is never sent
+    InitData(data, 6, 0);
+    UpdateSender(14, data);
+    SetReceiver(14, data);
+    ChangeData(data, 0, 6, 6, 30);
+    UpdateSender(15, data);
+    VerifyOrQuit(GetDeltaTlv(14, tlv) == kThreadError_NotFound,
+                 "Leader::GetDelta() provided a delta larger than the Network Data\n");
+
+    tlv.Init();
+    VerifyOrQuit(!tlv.IsValid(), "NetworkDataDeltaTlv accepted a length beyond its buffer\n");
+}
+
+void TestNetworkDataDeltaChain(void)
+{
+    enum
+    {
+        kNumChanges = 6,
+        kBaseVersion = 252,  // the versions wrap around during the test
+    };
+
+    Mle::NetworkDataDeltaTlv tlv;
+    Data data[kNumChanges + 1];
+    uint8_t lastLength = 0;
+
+    sSender.Reset();
+    sReceiver.Reset();
+
+    InitData(data[0], 120, 5);
+    UpdateSender(kBaseVersion, data[0]);
+
+    for (uint8_t i = 1; i <= kNumChanges; i++)
+    {
+        data[i] = data[i - 1];
+        ChangeData(data[i], 15 * i, i % 3, 2 + (i % 2), 40 * i);
+        UpdateSender(static_cast<uint8_t>(kBaseVersion + i), data[i]);
+    }
+
+    // a router that is k versions behind receives a chain of k records
+    for (uint8_t i = kNumChanges; i > 0; i--)
+    {
+        uint8_t version = static_cast<uint8_t>(kBaseVersion + i - 1);
+
+        SetReceiver(version, data[i - 1]);
+        SuccessOrQuit(GetDeltaTlv(version, tlv), "Leader::GetDelta() failed to chain the changes\n");
+        VerifyOrQuit(tlv.GetLength() > lastLength, "Leader::GetDelta() did not chain all newer changes\n");
+        lastLength = tlv.GetLength();
+
+        SuccessOrQuit(sReceiver.ApplyDelta(static_cast<uint8_t>(kBaseVersion + kNumChanges), 0, tlv.GetDelta(),
+                                           tlv.GetLength()),
+                      "Leader::ApplyDelta() failed to apply a chain of records\n");
+        VerifyReceiver(static_cast<uint8_t>(kBaseVersion + kNumChanges), data[kNumChanges],
+                       "Leader::ApplyDelta() did not apply a chain of records\n");
+    }
+
+    // two versions logged at once only reach back to the older one
+    data[0] = data[kNumChanges];
+    ChangeData(data[0], 10, 2, 2, 1);
+    sSender.SetNetworkData(static_cast<uint8_t>(kBaseVersion + kNumChanges + 1), 0, false, data[0].mTlvs,
+                           data[0].mLength);
+    ChangeData(data[0], 60, 0, 3, 2);
+    UpdateSender(static_cast<uint8_t>(kBaseVersion + kNumChanges + 2), data[0]);
+
+    VerifyOrQuit(GetDeltaTlv(static_cast<uint8_t>(kBaseVersion + kNumChanges + 1), tlv) == kThreadError_NotFound,
+                 "Leader::GetDelta() provided a delta from a version that was never logged\n");
+    SetReceiver(static_cast<uint8_t>(kBaseVersion + kNumChanges), data[kNumChanges]);
+    SuccessOrQuit(GetDeltaTlv(static_cast<uint8_t>(kBaseVersion + kNumChanges), tlv), "Leader::GetDelta() failed\n");
+    SuccessOrQuit(sReceiver.ApplyDelta(static_cast<uint8_t>(kBaseVersion + kNumChanges + 2), 0, tlv.GetDelta(),
+                                       tlv.GetLength()),
+                  "Leader::ApplyDelta() failed\n");
+    VerifyReceiver(static_cast<uint8_t>(kBaseVersion + kNumChanges + 2), data[0],
+                   "Leader::ApplyDelta() did not apply a change spanning two versions\n");
+
+    // a change without a new version invalidates the log
+    ChangeData(data[0], 0, 1, 1, 3);
+    UpdateSender(static_cast<uint8_t>(kBaseVersion + kNumChanges + 2), data[0]);
+    VerifyOrQuit(GetDeltaTlv(static_cast<uint8_t>(kBaseVersion + kNumChanges), tlv) == kThreadError_NotFound,
+                 "Leader::GetDelta() kept the log across a change without a new version\n");
+}
+
+void TestNetworkDataDeltaEviction(void)
+{
+    enum
+    {
+        kChangeLength = 8,
+        kNumLogged    = kDeltaLogSize / (kRecordLength + kChangeLength),
+        kNumChanges   = kNumLogged + 4,
+        kBaseVersion  = 100,
+    };
+
+    Mle::NetworkDataDeltaTlv tlv;
+    Data data;
+    Data oldest;
+    uint8_t newestVersion = kBaseVersion + kNumChanges;
+    uint8_t oldestVersion = newestVersion - kNumLogged;
+
+    sSender.Reset();
+    sReceiver.Reset();
+
+    InitData(data, 200, 9);
+    UpdateSender(kBaseVersion, data);
+
+    for (uint8_t i = 1; i <= kNumChanges; i++)
+    {
+        if (kBaseVersion + i - 1 == oldestVersion)
+        {
+            oldest = data;
+        }
+
+        ChangeData(data, 12 * i, kChangeLength, kChangeLength, 11 * i);
+        UpdateSender(kBaseVersion + i, data);
+    }
+
+    VerifyOrQuit(GetDeltaTlv(oldestVersion - 1, tlv) == kThreadError_NotFound,
+                 "Leader::GetDelta() did not evict the oldest change\n");
+    VerifyOrQuit(GetDeltaTlv(kBaseVersion, tlv) == kThreadError_NotFound,
+                 "Leader::GetDelta() did not evict the oldest change\n");
+
+    SetReceiver(oldestVersion, oldest);
+    SuccessOrQuit(GetDeltaTlv(oldestVersion, tlv), "Leader::GetDelta() evicted a change that fits\n");
+    VerifyOrQuit(tlv.GetLength() == kDeltaHeaderLength + kNumLogged * (kRecordLength + kChangeLength),
+                 "Leader::GetDelta() did not provide all logged changes\n");
+    SuccessOrQuit(sReceiver.ApplyDelta(newestVersion, 0, tlv.GetDelta(), tlv.GetLength()),
+                  "Leader::ApplyDelta() failed\n");
+    VerifyReceiver(newestVersion, data, "Leader::ApplyDelta() did not apply the logged changes\n");
+
+    // a change larger than the log evicts everything, and logging resumes from there
+    ChangeData(data, 0, kDeltaLogSize, kDeltaLogSize, 13);
+    UpdateSender(++newestVersion, data);
+    VerifyOrQuit(GetDeltaTlv(newestVersion - 1, tlv) == kThreadError_NotFound,
+                 "Leader::GetDelta() logged a change larger than the log\n");
+
+    SetReceiver(newestVersion, data);
+    ChangeData(data, 30, kChangeLength, kChangeLength, 17);
+    UpdateSender(++newestVersion, data);
+    SuccessOrQuit(GetDeltaTlv(newestVersion - 1, tlv), "Leader::GetDelta() did not resume logging\n");
+    SuccessOrQuit(sReceiver.ApplyDelta(newestVersion, 0, tlv.GetDelta(), tlv.GetLength()),
+                  "Leader::ApplyDelta() failed\n");
+    VerifyReceiver(newestVersion, data, "Leader::ApplyDelta() did not apply the change\n");
+}
+
+void TestNetworkDataDeltaChecksum(void)
+{
+    Mle::NetworkDataDeltaTlv tlv;
+    Data data;
+    Data stale;
+    Data diverged;
+
+    sSender.Reset();
+    sReceiver.Reset();
+
+    InitData(data, 80, 21);
+    UpdateSender(1, data);
+    stale = data;
+    ChangeData(data, 40, 3, 5, 23);
+    UpdateSender(2, data);
+    SuccessOrQuit(GetDeltaTlv(1, tlv), "Leader::GetDelta() failed\n");
+
+    // the receiver has different Network Data under the same version
+    diverged = stale;
+    diverged.mTlvs[5] ^= 0x01;
+    SetReceiver(1, diverged);
+    VerifyOrQuit(sReceiver.ApplyDelta(2, 0, tlv.GetDelta(), tlv.GetLength()) == kThreadError_Failed,
+                 "Leader::ApplyDelta() accepted a result that does not match the checksum\n");
+    VerifyReceiver(1, diverged, "Leader::ApplyDelta() changed the Network Data on failure\n");
+
+    // corrupted checksum and length
+    SetReceiver(1, stale);
+    tlv.GetDelta()[2] ^= 0x80;
+    VerifyOrQuit(sReceiver.ApplyDelta(2, 0, tlv.GetDelta(), tlv.GetLength()) == kThreadError_Failed,
+                 "Leader::ApplyDelta() ignored the checksum\n");
+    tlv.GetDelta()[2] ^= 0x80;
+    tlv.GetDelta()[0]++;
+    VerifyOrQuit(sReceiver.ApplyDelta(2, 0, tlv.GetDelta(), tlv.GetLength()) == kThreadError_Failed,
+                 "Leader::ApplyDelta() ignored the length\n");
+    tlv.GetDelta()[0]--;
+    VerifyOrQuit(sReceiver.ApplyDelta(3, 0, tlv.GetDelta(), tlv.GetLength()) == kThreadError_Failed,
+                 "Leader::ApplyDelta() accepted a delta ending at another version\n");
+    VerifyReceiver(1, stale, "Leader::ApplyDelta() changed the Network Data on failure\n");
+
+    // MLE then requests the full Network Data, after which deltas apply again
+    sReceiver.SetNetworkData(2, 0, false, data.mTlvs, data.mLength);
+    VerifyReceiver(2, data, "Leader::SetNetworkData() failed\n");
+
+    ChangeData(data, 10, 1, 1, 25);
+    UpdateSender(3, data);
+    SuccessOrQuit(GetDeltaTlv(2, tlv), "Leader::GetDelta() failed\n");
+    SuccessOrQuit(sReceiver.ApplyDelta(3, 0, tlv.GetDelta(), tlv.GetLength()),
+                  "Leader::ApplyDelta() failed after the full Network Data\n");
+    VerifyReceiver(3, data, "Leader::ApplyDelta() did not apply the change\n");
+}
+
+void TestNetworkDataDeltaMalformed(void)
+{
+    Mle::NetworkDataDeltaTlv tlv;
+    Data data;
+    Data changed;
+    uint8_t delta[kMaxDeltaLength];
+    uint8_t length;
+
+    sSender.Reset();
+    sReceiver.Reset();
+
+    InitData(data, 90, 31);
+    UpdateSender(7, data);
+    SetReceiver(7, data);
+    changed = data;
+    ChangeData(changed, 30, 2, 6, 33);
+    UpdateSender(8, changed);
+    SuccessOrQuit(GetDeltaTlv(7, tlv), "Leader::GetDelta() failed\n");
+    length = tlv.GetLength();
+    memcpy(delta, tlv.GetDelta(), length);
+
+    VerifyOrQuit(sReceiver.ApplyDelta(8, 0, delta, kDeltaHeaderLength) == kThreadError_Parse,
+                 "Leader::ApplyDelta() accepted a delta without records\n");
+    VerifyOrQuit(sReceiver.ApplyDelta(8, 0, delta, kDeltaHeaderLength + kRecordLength - 1) == kThreadError_Parse,
+                 "Leader::ApplyDelta() accepted a truncated record header\n");
+    VerifyOrQuit(sReceiver.ApplyDelta(8, 0, delta, length - 1) == kThreadError_Parse,
+                 "Leader::ApplyDelta() accepted truncated record data\n");
+
+    // the record replaces bytes beyond the end of the Network Data
+    delta[kDeltaHeaderLength + 2] = data.mLength - 1;
+    VerifyOrQuit(sReceiver.ApplyDelta(8, 0, delta, length) == kThreadError_Parse,
+                 "Leader::ApplyDelta() accepted a record beyond the Network Data\n");
+    delta[kDeltaHeaderLength + 2] = 30;
+
+    // the record starts at another version
+    delta[kDeltaHeaderLength]++;
+    VerifyOrQuit(sReceiver.ApplyDelta(8, 0, delta, length) == kThreadError_NotFound,
+                 "Leader::ApplyDelta() accepted a record from another version\n");
+    delta[kDeltaHeaderLength]--;
+
+    VerifyReceiver(7, data, "Leader::ApplyDelta() changed the Network Data on failure\n");
+
+    // the result does not fit in the Network Data
+    InitData(data, kMaxDataSize - 2, 35);
+    SetReceiver(7, data);
+    delta[0] = kMaxDataSize;
+    delta[kDeltaHeaderLength + 2] = 0;
+    delta[kDeltaHeaderLength + 3] = 0;
+    VerifyOrQuit(sReceiver.ApplyDelta(8, 0, delta, length) == kThreadError_Parse,
+                 "Leader::ApplyDelta() overflowed the Network Data\n");
+    VerifyReceiver(7, data, "Leader::ApplyDelta() changed the Network Data on failure\n");
+}
+
+}  // namespace Thread
+
+#ifdef ENABLE_TEST_MAIN
+int main(void)
+{
+    Thread::TestNetworkDataDeltaRoundTrip();
+    Thread::TestNetworkDataDeltaChain();
+    Thread::TestNetworkDataDeltaEviction();
+    Thread::TestNetworkDataDeltaChecksum();
+    Thread::TestNetworkDataDeltaMalformed();
+    printf("All tests passed\n");
+    return 0;
+}
+#endif
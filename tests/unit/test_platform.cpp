@@ -31,6 +31,12 @@
 #include <windows.h>
 #endif
 
+#ifdef OPENTHREAD_CONFIG_FILE
+#include OPENTHREAD_CONFIG_FILE
+#else
+#include <openthread-config.h>
+#endif
+
 #include <openthread.h>
 
 #include <common/code_utils.hpp>
@@ -59,6 +65,12 @@ uint32_t sPlatDt;
 bool     sTimerOn;
 uint32_t sCallCount[kCallCountIndexMax];
 
+uint32_t sNowMicro;
+uint32_t sPlatMicroT0;
+uint32_t sPlatMicroDt;
+bool     sMicroTimerOn;
+uint32_t sMicroStartCount;
+
 bool sDiagMode = false;
 
 enum
@@ -98,6 +110,27 @@ extern "C" {
         return sNow;
     }
 
+#if OPENTHREAD_ENABLE_PLATFORM_USEC_TIMER
+    void otPlatAlarmMicroStop(otInstance *)
+    {
+        sMicroTimerOn = false;
+    }
+
+    void otPlatAlarmMicroStartAt(otInstance *, uint32_t aT0, uint32_t aDt)
+    {
+        sMicroTimerOn = true;
+        sMicroStartCount++;
+        sPlatMicroT0 = aT0;
+        sPlatMicroDt = aDt;
+    }
+
+    uint32_t otPlatAlarmMicroGetNow(void)
+    {
+        // Follows the millisecond clock, sNowMicro adds the sub-millisecond part.
+        return sNow * 1000u + sNowMicro;
+    }
+#endif
+
     //
     // Radio
     //
@@ -152,6 +185,15 @@ extern "C" {
         return (RadioPacket *)0;
     }
 
+    RadioPacket *otPlatRadioGetNextTransmitBuffer(otInstance *)
+    {
+        return (RadioPacket *)0;
+    }
+
+    void otPlatRadioSwapTransmitBuffers(otInstance *)
+    {
+    }
+
     int8_t otPlatRadioGetRssi(otInstance *)
     {
         return 0;
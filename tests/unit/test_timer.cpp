@@ -49,6 +49,14 @@ extern uint32_t sPlatDt;
 extern bool     sTimerOn;
 extern uint32_t sCallCount[kCallCountIndexMax];
 
+#if OPENTHREAD_ENABLE_PLATFORM_USEC_TIMER
+extern uint32_t sNowMicro;
+extern uint32_t sPlatMicroT0;
+extern uint32_t sPlatMicroDt;
+extern bool     sMicroTimerOn;
+extern uint32_t sMicroStartCount;
+#endif
+
 void InitCounters(void)
 {
     memset(sCallCount, 0, sizeof(sCallCount));
@@ -383,10 +391,103 @@ int TestTenTimers(void)
     return 0;
 }
 
+#if OPENTHREAD_ENABLE_PLATFORM_USEC_TIMER
+/**
+ * Test the TimerMicroScheduler's behavior with microsecond timers.
+ */
+int TestMicroTimers(void)
+{
+    otInstance aInstance;
+    uint32_t counterA = 0;
+    uint32_t counterB = 0;
+    Thread::TimerMicro timerA(aInstance.mIp6.mTimerMicroScheduler, TestTimerHandler, &counterA);
+    Thread::TimerMicro timerB(aInstance.mIp6.mTimerMicroScheduler, TestTimerHandler, &counterB);
+
+    VerifyOrQuit(aInstance.mIp6.mTimerMicroScheduler.GetIp6() == &aInstance.mIp6,
+                 "TestMicroTimers: Scheduler Ip6 Failed.\n");
+    VerifyOrQuit(aInstance.mIp6.mTimerScheduler.GetIp6() == &aInstance.mIp6,
+                 "TestMicroTimers: Scheduler Ip6 Failed.\n");
+
+    // Microsecond timers run on the microsecond alarm only.
+
+    InitCounters();
+    sMicroStartCount = 0;
+
+    sNow = 0;
+    sNowMicro = 1000;
+    timerA.Start(500);
+
+    VerifyOrQuit(sMicroStartCount == 1 && sPlatMicroT0 == 1000 && sPlatMicroDt == 500,
+                 "TestMicroTimers: Start params Failed.\n");
+    VerifyOrQuit(sMicroTimerOn && timerA.IsRunning(),                  "TestMicroTimers: Timer running Failed.\n");
+    VerifyOrQuit(sCallCount[kCallCountIndexAlarmStart] == 0,            "TestMicroTimers: Millisecond alarm Failed.\n");
+
+    // An earlier timer moves the alarm, a later one does not.
+
+    sNowMicro += 100;
+    timerB.Start(200);
+
+    VerifyOrQuit(sMicroStartCount == 2 && sPlatMicroT0 == 1100 && sPlatMicroDt == 200,
+                 "TestMicroTimers: Start params Failed.\n");
+
+    sNowMicro += 200;
+    otPlatAlarmMicroFired(&aInstance);
+
+    VerifyOrQuit(counterA == 0 && counterB == 1,                        "TestMicroTimers: Handler Failed.\n");
+    VerifyOrQuit(sMicroStartCount == 3 && sPlatMicroT0 == 1300 && sPlatMicroDt == 200,
+                 "TestMicroTimers: Rearm params Failed.\n");
+
+    // A late alarm fires the timer and stops the alarm.
+
+    sNowMicro += 250;
+    otPlatAlarmMicroFired(&aInstance);
+
+    VerifyOrQuit(counterA == 1 && counterB == 1,                        "TestMicroTimers: Handler Failed.\n");
+    VerifyOrQuit(!sMicroTimerOn && !timerA.IsRunning(),                 "TestMicroTimers: Timer running Failed.\n");
+
+    // An early alarm does not fire the timer.
+
+    timerA.Start(100);
+    sNowMicro += 40;
+    otPlatAlarmMicroFired(&aInstance);
+
+    VerifyOrQuit(counterA == 1 && timerA.IsRunning(),                   "TestMicroTimers: Early fire Failed.\n");
+    VerifyOrQuit(sMicroTimerOn && sPlatMicroDt == 60,                   "TestMicroTimers: Rearm params Failed.\n");
+
+    timerA.Stop();
+    VerifyOrQuit(!sMicroTimerOn && !timerA.IsRunning(),                 "TestMicroTimers: Stop Failed.\n");
+
+    // A timer that spans the 32-bit wrap of the microsecond clock.
+
+    sNowMicro = 0u - 50;
+    timerA.Start(100);
+
+    VerifyOrQuit(sPlatMicroT0 == 0u - 50 && sPlatMicroDt == 100,       "TestMicroTimers: Start params Failed.\n");
+
+    sNowMicro += 60;
+    otPlatAlarmMicroFired(&aInstance);
+    VerifyOrQuit(counterA == 1 && timerA.IsRunning(),                   "TestMicroTimers: Early fire Failed.\n");
+
+    sNowMicro += 40;
+    otPlatAlarmMicroFired(&aInstance);
+    VerifyOrQuit(counterA == 2 && !timerA.IsRunning(),                  "TestMicroTimers: Wrap fire Failed.\n");
+
+    VerifyOrQuit(sCallCount[kCallCountIndexAlarmStart] == 0 && sCallCount[kCallCountIndexAlarmStop] == 0,
+                 "TestMicroTimers: Millisecond alarm Failed.\n");
+
+    sNowMicro = 0;
+
+    return 0;
+}
+#endif  // OPENTHREAD_ENABLE_PLATFORM_USEC_TIMER
+
 void RunTimerTests(void)
 {
     TestOneTimer();
     TestTenTimers();
+#if OPENTHREAD_ENABLE_PLATFORM_USEC_TIMER
+    TestMicroTimers();
+#endif
 }
 
 #ifdef ENABLE_TEST_MAIN
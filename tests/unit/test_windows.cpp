@@ -38,10 +38,52 @@ using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 void TestMacBeaconFrame();
 void TestMacDataFrame();
 void TestMacCommandFrame();
+void TestMacFramesBatch();
+void TestAesCcmBatchMatchesAesCcm();
+
+// test_binary_log.cpp
+namespace Thread
+{
+    void TestBinaryLogRoundTrip();
+    void TestBinaryLogDump();
+    void TestBinaryLogFull();
+}
+
+// test_coap.cpp
+namespace Thread
+{
+    void TestCoapResponseCache();
+    void TestCoapRequestIndex();
+    void TestCoapResourceLookup();
+    void TestCoapBlock1Transfer();
+    void TestCoapBlock2Transfer();
+}
 
 // test_hmac_sha256.cpp
 void TestHmacSha256();
 
+// test_ip6.cpp
+namespace Thread
+{
+    void TestIp6FragmentExtensionHeaders();
+    void TestIp6ReassembleInOrder();
+    void TestIp6ReassembleOutOfOrder();
+    void TestIp6ReassembleOverlap();
+    void TestIp6ReassembleTimeout();
+    void TestIp6ReassembleBufferBudget();
+}
+
+// test_joiner_table.cpp
+namespace Thread
+{
+    void TestJoinerTableAddRemove();
+    void TestJoinerTableAny();
+    void TestJoinerTableCollisions();
+    void TestJoinerTableExpiry();
+    void TestJoinerTableSteeringData();
+    void TestJoinerTableFull();
+}
+
 // test_link_quality.cpp
 namespace Thread
 {
@@ -61,8 +103,23 @@ namespace Thread
     void TestMacHeader();
 }
 
+// test_mesh_forwarder.cpp
+namespace Thread
+{
+    void TestMeshForwarderPreparedFrame();
+}
+
 // test_message.cpp
 void TestMessage();
+void TestMessageQueuePriority();
+void TestMessagePoolReservation();
+
+// test_mle_router.cpp
+namespace Thread
+{
+    void TestMleRouterUpdateRoutes();
+    void TestMleRouterFailover();
+}
 
 // test_ncp_buffer.cpp
 namespace Thread
@@ -70,6 +127,16 @@ namespace Thread
     void TestNcpFrameBuffer(void);
 }
 
+// test_network_data.cpp
+namespace Thread
+{
+    void TestNetworkDataDeltaRoundTrip();
+    void TestNetworkDataDeltaChain();
+    void TestNetworkDataDeltaEviction();
+    void TestNetworkDataDeltaChecksum();
+    void TestNetworkDataDeltaMalformed();
+}
+
 // test_timer.cpp
 int TestOneTimer();
 int TestTenTimers();
@@ -105,10 +172,40 @@ namespace Thread
         TEST_METHOD(TestMacBeaconFrame) { ::TestMacBeaconFrame(); }
         TEST_METHOD(TestMacDataFrame) { ::TestMacDataFrame(); }
         TEST_METHOD(TestMacCommandFrame) { ::TestMacCommandFrame(); }
+        TEST_METHOD(TestMacFramesBatch) { ::TestMacFramesBatch(); }
+        TEST_METHOD(TestAesCcmBatchMatchesAesCcm) { ::TestAesCcmBatchMatchesAesCcm(); }
+
+        // test_binary_log.cpp
+        TEST_METHOD(TestBinaryLogRoundTrip) { Thread::TestBinaryLogRoundTrip(); }
+        TEST_METHOD(TestBinaryLogDump) { Thread::TestBinaryLogDump(); }
+        TEST_METHOD(TestBinaryLogFull) { Thread::TestBinaryLogFull(); }
+
+        // test_coap.cpp
+        TEST_METHOD(TestCoapResponseCache) { Thread::TestCoapResponseCache(); }
+        TEST_METHOD(TestCoapRequestIndex) { Thread::TestCoapRequestIndex(); }
+        TEST_METHOD(TestCoapResourceLookup) { Thread::TestCoapResourceLookup(); }
+        TEST_METHOD(TestCoapBlock1Transfer) { Thread::TestCoapBlock1Transfer(); }
+        TEST_METHOD(TestCoapBlock2Transfer) { Thread::TestCoapBlock2Transfer(); }
 
         // test_hmac_sha256.cpp
         TEST_METHOD(TestHmacSha256) { ::TestHmacSha256(); }
 
+        // test_ip6.cpp
+        TEST_METHOD(TestIp6FragmentExtensionHeaders) { Thread::TestIp6FragmentExtensionHeaders(); }
+        TEST_METHOD(TestIp6ReassembleInOrder) { Thread::TestIp6ReassembleInOrder(); }
+        TEST_METHOD(TestIp6ReassembleOutOfOrder) { Thread::TestIp6ReassembleOutOfOrder(); }
+        TEST_METHOD(TestIp6ReassembleOverlap) { Thread::TestIp6ReassembleOverlap(); }
+        TEST_METHOD(TestIp6ReassembleTimeout) { Thread::TestIp6ReassembleTimeout(); }
+        TEST_METHOD(TestIp6ReassembleBufferBudget) { Thread::TestIp6ReassembleBufferBudget(); }
+
+        // test_joiner_table.cpp
+        TEST_METHOD(TestJoinerTableAddRemove) { Thread::TestJoinerTableAddRemove(); }
+        TEST_METHOD(TestJoinerTableAny) { Thread::TestJoinerTableAny(); }
+        TEST_METHOD(TestJoinerTableCollisions) { Thread::TestJoinerTableCollisions(); }
+        TEST_METHOD(TestJoinerTableExpiry) { Thread::TestJoinerTableExpiry(); }
+        TEST_METHOD(TestJoinerTableSteeringData) { Thread::TestJoinerTableSteeringData(); }
+        TEST_METHOD(TestJoinerTableFull) { Thread::TestJoinerTableFull(); }
+
         // test_link_quality.cpp
         TEST_METHOD(TestRssAveraging) { Thread::TestRssAveraging(); }
         TEST_METHOD(TestLinkQualityCalculations) { Thread::TestLinkQualityCalculations(); }
@@ -119,8 +216,17 @@ namespace Thread
         // test_mac_frame.cpp
         TEST_METHOD(TestMacHeader) { Thread::TestMacHeader(); }
 
+        // test_mesh_forwarder.cpp
+        TEST_METHOD(TestMeshForwarderPreparedFrame) { Thread::TestMeshForwarderPreparedFrame(); }
+
         // test_message.cpp
         TEST_METHOD(TestMessage) { ::TestMessage(); }
+        TEST_METHOD(TestMessageQueuePriority) { ::TestMessageQueuePriority(); }
+        TEST_METHOD(TestMessagePoolReservation) { ::TestMessagePoolReservation(); }
+
+        // test_mle_router.cpp
+        TEST_METHOD(TestMleRouterUpdateRoutes) { Thread::TestMleRouterUpdateRoutes(); }
+        TEST_METHOD(TestMleRouterFailover) { Thread::TestMleRouterFailover(); }
 
         // test_message.cpp
         TEST_METHOD(TestOneTimer) { ::TestOneTimer(); }
@@ -129,6 +235,13 @@ namespace Thread
         // test_ncp_buffer.cpp
         TEST_METHOD(TestNcpFrameBuffer) { Thread::TestNcpFrameBuffer(); }
 
+        // test_network_data.cpp
+        TEST_METHOD(TestNetworkDataDeltaRoundTrip) { Thread::TestNetworkDataDeltaRoundTrip(); }
+        TEST_METHOD(TestNetworkDataDeltaChain) { Thread::TestNetworkDataDeltaChain(); }
+        TEST_METHOD(TestNetworkDataDeltaEviction) { Thread::TestNetworkDataDeltaEviction(); }
+        TEST_METHOD(TestNetworkDataDeltaChecksum) { Thread::TestNetworkDataDeltaChecksum(); }
+        TEST_METHOD(TestNetworkDataDeltaMalformed) { Thread::TestNetworkDataDeltaMalformed(); }
+
         // test_toolchain.cpp
         TEST_METHOD(test_packed1) { ::test_packed1(); }
         TEST_METHOD(test_packed2) { ::test_packed2(); }
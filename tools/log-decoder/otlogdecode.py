@@ -0,0 +1,304 @@
+#!/usr/bin/python
+#
+#  Copyright (c) 2016, The OpenThread Authors.
+#  All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are met:
+#  1. Redistributions of source code must retain the above copyright
+#     notice, this list of conditions and the following disclaimer.
+#  2. Redistributions in binary form must reproduce the above copyright
+#     notice, this list of conditions and the following disclaimer in the
+#     documentation and/or other materials provided with the distribution.
+#  3. Neither the name of the copyright holder nor the
+#     names of its contributors may be used to endorse or promote products
+#     derived from this software without specific prior written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+#  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+#  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+#  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+#  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+#  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+#  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+#  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+#  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+#  POSSIBILITY OF SUCH DAMAGE.
+#
+""" Decode the binary log records of an OpenThread build with OPENTHREAD_CONFIG_LOG_BINARY. """
+
+import optparse
+import os
+import re
+import struct
+import sys
+
+LEVELS = {
+    0: "NONE",
+    1: "CRIT",
+    2: "WARN",
+    3: "INFO",
+    4: "DEBG",
+}
+
+REGIONS = {
+    1: "API  ",
+    2: "MLE  ",
+    3: "ARP  ",
+    4: "NETD ",
+    5: "ICMP ",
+    6: "IPV6 ",
+    7: "MAC  ",
+    8: "MEM  ",
+    9: "NCP  ",
+    10: "MCOP ",
+    11: "NDG  ",
+}
+
+HEADER_LENGTH = 6
+DUMP_FLAG = 0x80
+DUMP_WIDTH = 72
+
+SOURCE_EXTENSIONS = (".c", ".cpp", ".h", ".hpp")
+
+CONVERSION = re.compile(
+    r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(hh|h|ll|l|z|j|t)?([diuxXocps%])")
+
+ESCAPES = {
+    "n": "\n", "r": "\r", "t": "\t", "0": "\0", "\\": "\\",
+    "\"": "\"", "'": "'", "a": "\a", "b": "\b", "f": "\f", "v": "\v",
+}
+
+
+def format_id(text):
+    """ Return the FNV-1a hash of a format string, as computed on the device. """
+    value = 2166136261
+    for char in bytearray(text.encode("latin-1")):
+        value = ((value ^ char) * 16777619) & 0xffffffff
+    return value
+
+
+def unescape(literal):
+    """ Return the value of the body of a C string literal. """
+    result = []
+    i = 0
+    while i < len(literal):
+        char = literal[i]
+        i += 1
+        if char != "\\" or i == len(literal):
+            result.append(char)
+            continue
+        char = literal[i]
+        i += 1
+        if char == "x":
+            digits = re.match(r"[0-9a-fA-F]+", literal[i:]).group(0)
+            result.append(chr(int(digits, 16) & 0xff))
+            i += len(digits)
+        elif char in "01234567":
+            digits = re.match(r"[0-7]{1,3}", literal[i - 1:]).group(0)
+            result.append(chr(int(digits, 8)))
+            i += len(digits) - 1
+        else:
+            result.append(ESCAPES.get(char, char))
+    return "".join(result)
+
+
+def string_literals(text):
+    """ Yield the string literals of a C or C++ source, joining adjacent ones. """
+    i = 0
+    pending = None
+    while i < len(text):
+        char = text[i]
+        if text.startswith("//", i):
+            i = text.find("\n", i)
+            i = len(text) if i < 0 else i
+            continue
+        if text.startswith("/*", i):
+            i = text.find("*/", i + 2)
+            i = len(text) if i < 0 else i + 2
+            continue
+        if char == "'":
+            match = re.match(r"'(\\.|[^'\\])*'", text[i:])
+            i += len(match.group(0)) if match else 1
+            continue
+        if char == "\"":
+            match = re.match(r"\"((?:\\.|[^\"\\\n])*)\"", text[i:])
+            if match:
+                value = unescape(match.group(1))
+                pending = value if pending is None else pending + value
+                i += len(match.group(0))
+                continue
+        if not char.isspace() and pending is not None:
+            yield pending
+            pending = None
+        i += 1
+    if pending is not None:
+        yield pending
+
+
+def build_dictionary(paths):
+    """ Map the format IDs of all string literals found under the given paths to their strings. """
+    dictionary = {}
+    for path in paths:
+        if os.path.isfile(path):
+            files = [path]
+        else:
+            files = [os.path.join(root, name)
+                     for root, _, names in os.walk(path)
+                     for name in names if name.endswith(SOURCE_EXTENSIONS)]
+        for name in sorted(files):
+            with open(name, "rb") as source:
+                text = source.read().decode("latin-1")
+            for literal in string_literals(text):
+                dictionary.setdefault(format_id(literal), literal)
+    return dictionary
+
+
+class ArgumentReader(object):
+    """ Read the raw arguments of a record. """
+
+    def __init__(self, data):
+        self.data = data
+        self.offset = 0
+
+    def integer(self, size, signed):
+        """ Read a little-endian integer of 4 or 8 bytes. """
+        if self.offset + size > len(self.data):
+            raise IndexError
+        code = {4: "<I", 8: "<Q"}[size]
+        if signed:
+            code = code.lower()
+        value = struct.unpack_from(code, self.data, self.offset)[0]
+        self.offset += size
+        return value
+
+    def string(self):
+        """ Read a NULL-terminated string. """
+        end = self.data.find(b"\0", self.offset)
+        if end < 0:
+            raise IndexError
+        value = self.data[self.offset:end].decode("latin-1")
+        self.offset = end + 1
+        return value
+
+
+def format_message(fmt, data):
+    """ Render a format string with the raw arguments of a record. """
+    reader = ArgumentReader(data)
+    output = []
+    position = 0
+    truncated = False
+    for match in CONVERSION.finditer(fmt):
+        flags, width, precision, length, conversion = match.groups()
+        output.append(fmt[position:match.start()])
+        position = match.end()
+        if conversion == "%":
+            output.append("%")
+            continue
+        if truncated:
+            output.append("?")
+            continue
+        try:
+            if width == "*":
+                width = str(reader.integer(4, True))
+            if precision == "*":
+                precision = str(reader.integer(4, True))
+            spec = "%" + flags + (width or "") + ("." + precision if precision is not None else "")
+            if conversion == "s":
+                output.append((spec + "s") % reader.string())
+            elif conversion == "p":
+                output.append((spec + "s") % ("0x%x" % reader.integer(4, False)))
+            else:
+                size = 8 if length == "ll" else 4
+                value = reader.integer(size, conversion in "di")
+                if conversion == "c":
+                    output.append((spec + "c") % chr(value & 0xff))
+                else:
+                    output.append((spec + conversion.replace("u", "d").replace("i", "d")) % value)
+        except IndexError:
+            truncated = True
+            output.append("?")
+    output.append(fmt[position:])
+    return "".join(output)
+
+
+def format_dump(ident, length, data):
+    """ Render a memory dump record the way otDump() formats it. """
+    lines = []
+    fill = (DUMP_WIDTH - len(ident)) // 2
+    lines.append("=" * (fill - 5) + "[%s len=%03u]" % (ident, length) + "=" * (fill - 4))
+    for offset in range(0, len(data), 16):
+        chunk = bytearray(data[offset:offset + 16])
+        line = "|"
+        for i in range(16):
+            line += " %02X" % chunk[i] if i < len(chunk) else " .."
+            if (i + 1) % 8 == 0:
+                line += " |"
+        line += " "
+        for i in range(16):
+            char = chr(chunk[i] & 0x7f) if i < len(chunk) else ""
+            line += char if char and 0x20 <= ord(char) < 0x7f else "."
+        lines.append(line)
+    if len(data) < length:
+        lines.append("| %d more bytes were not logged" % (length - len(data)))
+    lines.append("-" * DUMP_WIDTH)
+    return lines
+
+
+def decode_record(record, dictionary):
+    """ Return the log lines of one record, without its length byte. """
+    if len(record) < HEADER_LENGTH - 1:
+        return ["<short record %s>" % repr(bytes(record))]
+    info = bytearray(record[:1])[0]
+    ident = struct.unpack_from("<I", record, 1)[0]
+    data = record[HEADER_LENGTH - 1:]
+    prefix = "%s %s" % (LEVELS.get(info & 0x07, "????"), REGIONS.get((info >> 3) & 0x0f, "???? "))
+    text = dictionary.get(ident)
+    if text is None:
+        lines = ["<unknown format %08x> %s" % (ident, " ".join("%02x" % b for b in bytearray(data)))]
+    elif info & DUMP_FLAG:
+        length = struct.unpack_from("<H", data)[0] if len(data) >= 2 else 0
+        lines = format_dump(text, length, data[2:])
+    else:
+        lines = [format_message(text, data)]
+    return [prefix + line for line in lines]
+
+
+def decode_stream(data, dictionary):
+    """ Yield the log lines of a stream of records. """
+    offset = 0
+    data = bytes(data)
+    while offset < len(data):
+        length = bytearray(data[offset:offset + 1])[0]
+        if offset + 1 + length > len(data):
+            break
+        for line in decode_record(data[offset + 1:offset + 1 + length], dictionary):
+            yield line
+        offset += 1 + length
+
+
+def main():
+    """ Decode a binary log file, or the standard input, to text. """
+    default_source = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..")
+    opt_parser = optparse.OptionParser(usage="%prog [-s PATH]... [FILE]")
+    opt_parser.add_option("-s", "--source", action="append", dest="sources", default=[],
+                          help="Source file or directory of the firmware, the OpenThread tree by default")
+
+    (options, args) = opt_parser.parse_args()
+
+    dictionary = build_dictionary(options.sources or [os.path.join(default_source, "src"),
+                                                      os.path.join(default_source, "examples")])
+
+    if args:
+        with open(args[0], "rb") as log_file:
+            data = log_file.read()
+    else:
+        data = getattr(sys.stdin, "buffer", sys.stdin).read()
+
+    for line in decode_stream(data, dictionary):
+        print(line)
+
+
+if __name__ == "__main__":
+    main()
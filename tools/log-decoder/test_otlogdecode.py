@@ -0,0 +1,116 @@
+#!/usr/bin/python
+#
+#  Copyright (c) 2016, The OpenThread Authors.
+#  All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are met:
+#  1. Redistributions of source code must retain the above copyright
+#     notice, this list of conditions and the following disclaimer.
+#  2. Redistributions in binary form must reproduce the above copyright
+#     notice, this list of conditions and the following disclaimer in the
+#     documentation and/or other materials provided with the distribution.
+#  3. Neither the name of the copyright holder nor the
+#     names of its contributors may be used to endorse or promote products
+#     derived from this software without specific prior written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+#  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+#  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+#  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+#  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+#  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+#  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+#  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+#  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+#  POSSIBILITY OF SUCH DAMAGE.
+#
+""" Unit tests for the binary log decoder. """
+
+import os
+import shutil
+import struct
+import tempfile
+import unittest
+
+import otlogdecode
+
+
+def encode_record(level, region, fmt, args=b"", dump=False):
+    """ Encode a record the way the device does. """
+    info = (level & 0x07) | ((region & 0x0f) << 3) | (otlogdecode.DUMP_FLAG if dump else 0)
+    body = struct.pack("<BI", info, otlogdecode.format_id(fmt)) + args
+    return struct.pack("<B", len(body)) + body
+
+
+class TestLogDecoder(unittest.TestCase):
+    """ Test the binary log decoder against records encoded as on the device. """
+
+    def test_format_id(self):
+        """ The format ID is the 32-bit FNV-1a hash. """
+        self.assertEqual(otlogdecode.format_id(""), 0x811c9dc5)
+        self.assertEqual(otlogdecode.format_id("a"), 0xe40c292c)
+        self.assertEqual(otlogdecode.format_id("foobar"), 0xbf9cf968)
+
+    def test_message(self):
+        """ Integer, string and 64-bit arguments are formatted like printf. """
+        fmts = ["Sent to child (0x%x), still queued message (%d)",
+                "%s: %02x %04d%% [%-6s|%5u]",
+                "ext addr %llX, frame counter %lu %c"]
+        dictionary = dict((otlogdecode.format_id(fmt), fmt) for fmt in fmts)
+        data = (encode_record(3, 7, fmts[0], struct.pack("<Ii", 0xac01, -3)) +
+                encode_record(4, 2, fmts[1], b"route\0" + struct.pack("<II", 5, 42) + b"ab\0" +
+                              struct.pack("<I", 77)) +
+                encode_record(1, 10, fmts[2], struct.pack("<QII", 0x1122334455667788, 123456, ord("z"))))
+
+        self.assertEqual(list(otlogdecode.decode_stream(data, dictionary)),
+                         ["INFO MAC  Sent to child (0xac01), still queued message (-3)",
+                          "DEBG MLE  route: 05 0042% [ab    |   77]",
+                          "CRIT MCOP ext addr 1122334455667788, frame counter 123456 z"])
+
+    def test_truncated(self):
+        """ Missing arguments and partial records do not stop the decoder. """
+        fmt = "%d %s %d"
+        dictionary = {otlogdecode.format_id(fmt): fmt}
+        data = encode_record(2, 6, fmt, struct.pack("<i", 7) + b"abc") + b"\x09\x00"
+
+        self.assertEqual(list(otlogdecode.decode_stream(data, dictionary)), ["WARN IPV6 7 ? ?"])
+
+    def test_unknown(self):
+        """ Records with an unknown format ID are shown raw. """
+        data = encode_record(3, 9, "not in the dictionary", b"\x01\x02")
+
+        self.assertEqual(list(otlogdecode.decode_stream(data, {})),
+                         ["INFO NCP  <unknown format %08x> 01 02" % otlogdecode.format_id("not in the dictionary")])
+
+    def test_dump(self):
+        """ Dump records are shown like otDump() output. """
+        ident = "NO ACK"
+        data = encode_record(4, 7, ident, struct.pack("<H", 20) + b"0123456789ABCDEF\x00\x01", dump=True)
+        lines = list(otlogdecode.decode_stream(data, {otlogdecode.format_id(ident): ident}))
+
+        self.assertEqual(lines[0], "DEBG MAC  " + "=" * 28 + "[NO ACK len=020]" + "=" * 29)
+        self.assertEqual(lines[1], "DEBG MAC  | 30 31 32 33 34 35 36 37 | 38 39 41 42 43 44 45 46 | 0123456789ABCDEF")
+        self.assertEqual(lines[2], "DEBG MAC  | 00 01 .. .. .. .. .. .. | .. .. .. .. .. .. .. .. | " + "." * 16)
+        self.assertEqual(lines[3], "DEBG MAC  | 2 more bytes were not logged")
+        self.assertEqual(lines[4], "DEBG MAC  " + "-" * 72)
+
+    def test_dictionary(self):
+        """ String literals are collected from the sources, with escapes and concatenation. """
+        directory = tempfile.mkdtemp()
+        try:
+            with open(os.path.join(directory, "source.cpp"), "w") as source:
+                source.write('// "not a literal"\n'
+                             'otLogInfoMac("Sent %d\\r\\n"\n'
+                             '             " frames \\"%s\\"", count, name);\n'
+                             '/* "in a comment" */ char c = \'"\';\n')
+            dictionary = otlogdecode.build_dictionary([directory])
+        finally:
+            shutil.rmtree(directory)
+
+        self.assertEqual(sorted(dictionary.values()), ['Sent %d\r\n frames "%s"'])
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,112 @@
+#!/usr/bin/python
+#
+#  Copyright (c) 2016, The OpenThread Authors.
+#  All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are met:
+#  1. Redistributions of source code must retain the above copyright
+#     notice, this list of conditions and the following disclaimer.
+#  2. Redistributions in binary form must reproduce the above copyright
+#     notice, this list of conditions and the following disclaimer in the
+#     documentation and/or other materials provided with the distribution.
+#  3. Neither the name of the copyright holder nor the
+#     names of its contributors may be used to endorse or promote products
+#     derived from this software without specific prior written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+#  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+#  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+#  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+#  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+#  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+#  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+#  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+#  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+#  POSSIBILITY OF SUCH DAMAGE.
+#
+""" Check the binary log of a POSIX node against the decoder. """
+
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+import unittest
+
+import otlogdecode
+
+SKIP = 77
+
+# The commands of the session with the time, in seconds, to wait after each.
+SESSION = [("panid 0xface", 0.5), ("ifconfig up", 0.5), ("thread start", 8), ("thread stop", 0.5)]
+
+EXPECTED = [r"INFO API  otInstanceInit$",
+            r"INFO MLE  Mode -> Detached$",
+            r"INFO MLE  Sent parent request to routers$",
+            r"INFO MLE  add router id \d+$",
+            r"INFO MLE  Mode -> Leader -?\d+$"]
+
+
+def find_cli():
+    """ Return the path of the POSIX CLI when it was built with OPENTHREAD_CONFIG_LOG_BINARY, or None. """
+    path = os.path.join(os.environ.get("top_builddir", "."), "examples", "apps", "cli", "ot-cli")
+    if not os.path.isfile(path):
+        return None
+    with open(path, "rb") as image:
+        if b"otLogBinaryRead" not in image.read():
+            return None
+    return path
+
+
+def run_session(cli, workdir):
+    """ Run a short session on node 1 and return what it wrote to the standard error. """
+    node = subprocess.Popen([os.path.abspath(cli), "1"], cwd=workdir,
+                            stdin=subprocess.PIPE, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+    for command, delay in SESSION:
+        node.stdin.write((command + "\r\n").encode("ascii"))
+        node.stdin.flush()
+        time.sleep(delay)
+    node.stdin.close()
+    for _ in range(50):
+        if node.poll() is not None:
+            break
+        time.sleep(0.1)
+    else:
+        node.kill()
+    node.stdout.read()
+    data = node.stderr.read()
+    node.stdout.close()
+    node.stderr.close()
+    return data
+
+
+class TestPosixRoundTrip(unittest.TestCase):
+    """ Decode the log of a POSIX node with the dictionary of the OpenThread tree. """
+
+    def setUp(self):
+        self.workdir = tempfile.mkdtemp()
+
+    def tearDown(self):
+        shutil.rmtree(self.workdir)
+
+    def test_session(self):
+        """ The messages of a short session decode to their text. """
+        data = run_session(find_cli(), self.workdir)
+        self.assertTrue(data)
+
+        source = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..")
+        dictionary = otlogdecode.build_dictionary([os.path.join(source, "src"), os.path.join(source, "examples")])
+        lines = list(otlogdecode.decode_stream(data, dictionary))
+
+        for pattern in EXPECTED:
+            self.assertTrue([line for line in lines if re.match(pattern, line)], pattern)
+
+
+if __name__ == "__main__":
+    if find_cli() is None:
+        sys.exit(SKIP)
+    unittest.main()